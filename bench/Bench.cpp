@@ -0,0 +1,443 @@
+#include "Bench.hpp"
+
+#include "Core/FileReader.hpp"
+#include "Core/FileWriter.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+MOE_BEGIN_NAMESPACE
+
+namespace Bench {
+    namespace {
+        // just enough json to read back what toJson writes:
+        // a top level object with a "results" array of flat objects holding strings and numbers
+        struct JsonReader {
+        public:
+            explicit JsonReader(StringView text)
+                : m_text(text) {}
+
+            Optional<Vector<Result>> readResults() {
+                if (!accept('{')) {
+                    return std::nullopt;
+                }
+
+                Optional<Vector<Result>> results;
+                while (true) {
+                    auto key = readString();
+                    if (!key || !accept(':')) {
+                        return std::nullopt;
+                    }
+
+                    if (*key == "results") {
+                        results = readResultArray();
+                        if (!results) {
+                            return std::nullopt;
+                        }
+                    } else if (!skipValue()) {
+                        return std::nullopt;
+                    }
+
+                    if (accept(',')) {
+                        continue;
+                    }
+                    if (!accept('}')) {
+                        return std::nullopt;
+                    }
+                    return results;
+                }
+            }
+
+        private:
+            StringView m_text;
+            size_t m_pos{0};
+
+            void skipWhitespace() {
+                while (m_pos < m_text.size() && std::isspace(static_cast<unsigned char>(m_text[m_pos]))) {
+                    ++m_pos;
+                }
+            }
+
+            bool accept(char c) {
+                skipWhitespace();
+                if (m_pos < m_text.size() && m_text[m_pos] == c) {
+                    ++m_pos;
+                    return true;
+                }
+                return false;
+            }
+
+            Optional<String> readString() {
+                if (!accept('"')) {
+                    return std::nullopt;
+                }
+
+                String out;
+                while (m_pos < m_text.size() && m_text[m_pos] != '"') {
+                    if (m_text[m_pos] == '\\' && m_pos + 1 < m_text.size()) {
+                        ++m_pos;
+                    }
+                    out += m_text[m_pos++];
+                }
+
+                if (m_pos >= m_text.size()) {
+                    return std::nullopt;
+                }
+                ++m_pos;
+                return out;
+            }
+
+            Optional<double> readNumber() {
+                skipWhitespace();
+                size_t begin = m_pos;
+                while (m_pos < m_text.size() && (std::isdigit(static_cast<unsigned char>(m_text[m_pos])) || std::strchr("+-.eE", m_text[m_pos]))) {
+                    ++m_pos;
+                }
+                if (begin == m_pos) {
+                    return std::nullopt;
+                }
+                return std::strtod(String(m_text.substr(begin, m_pos - begin)).c_str(), nullptr);
+            }
+
+            bool skipValue() {
+                skipWhitespace();
+                if (m_pos >= m_text.size()) {
+                    return false;
+                }
+
+                char c = m_text[m_pos];
+                if (c == '"') {
+                    return readString().has_value();
+                }
+
+                if (c == '{' || c == '[') {
+                    char close = c == '{' ? '}' : ']';
+                    ++m_pos;
+                    if (accept(close)) {
+                        return true;
+                    }
+                    do {
+                        if (c == '{' && (!readString() || !accept(':'))) {
+                            return false;
+                        }
+                        if (!skipValue()) {
+                            return false;
+                        }
+                    } while (accept(','));
+                    return accept(close);
+                }
+
+                // number, true, false, null
+                size_t begin = m_pos;
+                while (m_pos < m_text.size() && !std::strchr(",}] \t\r\n", m_text[m_pos])) {
+                    ++m_pos;
+                }
+                return m_pos != begin;
+            }
+
+            Optional<Vector<Result>> readResultArray() {
+                Vector<Result> results;
+                if (!accept('[')) {
+                    return std::nullopt;
+                }
+                if (accept(']')) {
+                    return results;
+                }
+
+                do {
+                    auto result = readResult();
+                    if (!result) {
+                        return std::nullopt;
+                    }
+                    results.push_back(std::move(*result));
+                } while (accept(','));
+
+                if (!accept(']')) {
+                    return std::nullopt;
+                }
+                return results;
+            }
+
+            Optional<Result> readResult() {
+                Result result;
+                if (!accept('{')) {
+                    return std::nullopt;
+                }
+                if (accept('}')) {
+                    return result;
+                }
+
+                do {
+                    auto key = readString();
+                    if (!key || !accept(':')) {
+                        return std::nullopt;
+                    }
+
+                    if (*key == "name") {
+                        auto name = readString();
+                        if (!name) {
+                            return std::nullopt;
+                        }
+                        result.name = std::move(*name);
+                        continue;
+                    }
+
+                    double* field = nullptr;
+                    if (*key == "min_ns") field = &result.minNs;
+                    if (*key == "median_ns") field = &result.medianNs;
+                    if (*key == "mean_ns") field = &result.meanNs;
+                    if (*key == "p99_ns") field = &result.p99Ns;
+                    if (*key == "max_ns") field = &result.maxNs;
+                    if (*key == "stddev_ns") field = &result.stddevNs;
+
+                    if (*key == "iterations_per_sample" || *key == "samples") {
+                        auto value = readNumber();
+                        if (!value) {
+                            return std::nullopt;
+                        }
+                        if (*key == "samples") {
+                            result.samples = static_cast<size_t>(*value);
+                        } else {
+                            result.iterationsPerSample = static_cast<uint64_t>(*value);
+                        }
+                    } else if (field) {
+                        auto value = readNumber();
+                        if (!value) {
+                            return std::nullopt;
+                        }
+                        *field = *value;
+                    } else if (!skipValue()) {
+                        return std::nullopt;
+                    }
+                } while (accept(','));
+
+                if (!accept('}')) {
+                    return std::nullopt;
+                }
+                return result;
+            }
+        };
+
+        String formatTime(double ns) {
+            if (ns < 1e3) {
+                return fmt::format("{:.1f} ns", ns);
+            }
+            if (ns < 1e6) {
+                return fmt::format("{:.2f} us", ns / 1e3);
+            }
+            return fmt::format("{:.2f} ms", ns / 1e6);
+        }
+
+        String escapeJson(StringView str) {
+            String out;
+            out.reserve(str.size());
+            for (char c: str) {
+                if (c == '"' || c == '\\') {
+                    out += '\\';
+                }
+                out += c;
+            }
+            return out;
+        }
+    }// namespace
+
+    Vector<Case>& getRegistry() {
+        static Vector<Case> registry;
+        return registry;
+    }
+
+    Registrar::Registrar(StringView name, CaseFn fn) {
+        getRegistry().push_back({String(name), String(name), fn, 0});
+    }
+
+    Registrar::Registrar(StringView name, CaseFn fn, std::initializer_list<int64_t> args) {
+        for (auto arg: args) {
+            getRegistry().push_back({fmt::format("{}/{}", name, arg), String(name), fn, arg});
+        }
+    }
+
+    Vector<Case> getSortedCases() {
+        auto cases = getRegistry();
+        std::sort(cases.begin(), cases.end(), [](const Case& a, const Case& b) {
+            if (a.baseName != b.baseName) {
+                return a.baseName < b.baseName;
+            }
+            return a.arg < b.arg;
+        });
+        return cases;
+    }
+
+    Result summarize(StringView name, const State& state) {
+        Vector<double> sorted = state.sampleNs();
+        std::sort(sorted.begin(), sorted.end());
+
+        Result result;
+        result.name = String(name);
+        result.iterationsPerSample = state.iterationsPerSample();
+        result.samples = sorted.size();
+        if (sorted.empty()) {
+            return result;
+        }
+
+        auto percentile = [&sorted](double p) {
+            // nearest rank
+            size_t rank = static_cast<size_t>(std::ceil(p * static_cast<double>(sorted.size())));
+            return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+        };
+
+        size_t mid = sorted.size() / 2;
+        result.minNs = sorted.front();
+        result.maxNs = sorted.back();
+        result.medianNs = sorted.size() % 2 == 0 ? (sorted[mid - 1] + sorted[mid]) * 0.5 : sorted[mid];
+        result.p99Ns = percentile(0.99);
+
+        double sum = 0.0;
+        for (auto ns: sorted) {
+            sum += ns;
+        }
+        result.meanNs = sum / static_cast<double>(sorted.size());
+
+        double variance = 0.0;
+        for (auto ns: sorted) {
+            variance += (ns - result.meanNs) * (ns - result.meanNs);
+        }
+        result.stddevNs = std::sqrt(variance / static_cast<double>(sorted.size()));
+
+        return result;
+    }
+
+    Vector<Result> runAll(const Options& options) {
+        auto cases = getSortedCases();
+
+        Vector<Result> results;
+        fmt::print("{:<48} {:>12} {:>12} {:>12} {:>10}\n", "benchmark", "median", "p99", "min", "iters");
+        for (auto& benchCase: cases) {
+            if (!options.filter.empty() && benchCase.name.find(options.filter) == String::npos) {
+                continue;
+            }
+
+            State state(options, benchCase.arg);
+            benchCase.fn(state);
+            if (!state.finished()) {
+                Logger::warn("moe-bench: case '{}' never called state.run, skipped", benchCase.name);
+                continue;
+            }
+
+            auto result = summarize(benchCase.name, state);
+            fmt::print("{:<48} {:>12} {:>12} {:>12} {:>10}\n",
+                       result.name,
+                       formatTime(result.medianNs),
+                       formatTime(result.p99Ns),
+                       formatTime(result.minNs),
+                       result.iterationsPerSample);
+            std::fflush(stdout);
+
+            results.push_back(std::move(result));
+        }
+
+        return results;
+    }
+
+    String toJson(const Vector<Result>& results, const Options& options) {
+        String json;
+        json += "{\n";
+        json += fmt::format("  \"version\": 1,\n");
+        json += fmt::format("  \"warmup_samples\": {},\n", options.warmupSamples);
+        json += fmt::format("  \"samples\": {},\n", options.samples);
+        json += fmt::format("  \"min_sample_ns\": {},\n", options.minSampleNs);
+        json += "  \"results\": [";
+
+        for (size_t i = 0; i < results.size(); ++i) {
+            auto& result = results[i];
+            json += i == 0 ? "\n" : ",\n";
+            json += fmt::format(
+                    "    {{\"name\": \"{}\", \"iterations_per_sample\": {}, \"samples\": {}, "
+                    "\"min_ns\": {:.3f}, \"median_ns\": {:.3f}, \"mean_ns\": {:.3f}, "
+                    "\"p99_ns\": {:.3f}, \"max_ns\": {:.3f}, \"stddev_ns\": {:.3f}}}",
+                    escapeJson(result.name),
+                    result.iterationsPerSample,
+                    result.samples,
+                    result.minNs,
+                    result.medianNs,
+                    result.meanNs,
+                    result.p99Ns,
+                    result.maxNs,
+                    result.stddevNs);
+        }
+
+        json += "\n  ]\n}\n";
+        return json;
+    }
+
+    bool writeJson(StringView path, const Vector<Result>& results, const Options& options) {
+        auto json = toJson(results, options);
+        return FileWriter::writeToFile(path, StringView(json));
+    }
+
+    Optional<Vector<Result>> readJson(StringView path) {
+        size_t fileSize = 0;
+        auto content = DefaultFileReader{}.readFile(path, fileSize);
+        if (!content) {
+            return std::nullopt;
+        }
+
+        String text(content->begin(), content->end());
+        auto results = JsonReader(text).readResults();
+        if (!results) {
+            Logger::error("moe-bench: {} is not a moe-bench result file", path);
+        }
+        return results;
+    }
+
+    size_t compare(const Vector<Result>& baseline, const Vector<Result>& current, double thresholdPercent) {
+        UnorderedMap<String, const Result*> baselineByName;
+        for (auto& result: baseline) {
+            baselineByName[result.name] = &result;
+        }
+
+        size_t regressions = 0;
+        fmt::print("{:<48} {:>12} {:>12} {:>9} {:>9}  {}\n", "benchmark", "base median", "new median", "median", "p99", "verdict");
+        for (auto& result: current) {
+            auto it = baselineByName.find(result.name);
+            if (it == baselineByName.end()) {
+                fmt::print("{:<48} {:>12} {:>12} {:>9} {:>9}  new\n", result.name, "-", formatTime(result.medianNs), "-", "-");
+                continue;
+            }
+
+            auto& base = *it->second;
+            double medianDelta = base.medianNs > 0.0 ? (result.medianNs / base.medianNs - 1.0) * 100.0 : 0.0;
+            double p99Delta = base.p99Ns > 0.0 ? (result.p99Ns / base.p99Ns - 1.0) * 100.0 : 0.0;
+
+            const char* verdict = "";
+            if (medianDelta > thresholdPercent) {
+                verdict = "REGRESSION";
+                regressions++;
+            } else if (medianDelta < -thresholdPercent) {
+                verdict = "improved";
+            }
+
+            fmt::print("{:<48} {:>12} {:>12} {:>+8.1f}% {:>+8.1f}%  {}\n",
+                       result.name,
+                       formatTime(base.medianNs),
+                       formatTime(result.medianNs),
+                       medianDelta,
+                       p99Delta,
+                       verdict);
+        }
+
+        for (auto& base: baseline) {
+            bool present = std::any_of(current.begin(), current.end(), [&base](const Result& r) {
+                return r.name == base.name;
+            });
+            if (!present) {
+                fmt::print("{:<48} {:>12} {:>12} {:>9} {:>9}  missing\n", base.name, formatTime(base.medianNs), "-", "-", "-");
+            }
+        }
+
+        fmt::print("\n{} regression(s) above {:.1f}%\n", regressions, thresholdPercent);
+        return regressions;
+    }
+}// namespace Bench
+
+MOE_END_NAMESPACE
\ No newline at end of file
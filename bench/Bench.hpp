@@ -0,0 +1,174 @@
+#pragma once
+
+#include "Core/Common.hpp"
+
+#include <chrono>
+#include <initializer_list>
+
+// minimal microbenchmark harness for moe-bench
+// every case measures one operation; the harness calibrates how many operations
+// go into a sample, runs warmup samples, then reports statistics over the per-op times
+
+MOE_BEGIN_NAMESPACE
+
+namespace Bench {
+    using Clock = std::chrono::steady_clock;
+
+    struct Options {
+        size_t warmupSamples{10};
+        size_t samples{100};
+        // samples shorter than this are dominated by timer overhead, batch more operations
+        uint64_t minSampleNs{200'000};
+        String filter;
+    };
+
+    struct Result {
+        String name;
+        uint64_t iterationsPerSample{0};
+        size_t samples{0};
+
+        // all times are per operation
+        double minNs{0.0};
+        double medianNs{0.0};
+        double meanNs{0.0};
+        double p99Ns{0.0};
+        double maxNs{0.0};
+        double stddevNs{0.0};
+    };
+
+    // keeps a value alive so the optimizer cannot drop the computation producing it
+    template<typename T>
+    inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const void* s_sink;
+        s_sink = &value;
+#endif
+    }
+
+    struct State {
+    public:
+        State(const Options& options, int64_t arg)
+            : m_options(options), m_arg(arg) {}
+
+        // argument of the registered variant, 0 for cases without arguments
+        int64_t arg() const { return m_arg; }
+
+        // measure fn, one call is one operation
+        // must be called exactly once per case, setup goes before it
+        template<typename F>
+        void run(F&& fn) {
+            MOE_ASSERT(!m_finished, "Bench::State::run called twice");
+
+            uint64_t iterations = calibrate(fn);
+            m_iterations = iterations;
+
+            for (size_t i = 0; i < m_options.warmupSamples; ++i) {
+                timeBatch(fn, iterations);
+            }
+
+            m_sampleNs.clear();
+            m_sampleNs.reserve(m_options.samples);
+            for (size_t i = 0; i < m_options.samples; ++i) {
+                auto elapsed = timeBatch(fn, iterations);
+                m_sampleNs.push_back(static_cast<double>(elapsed) / static_cast<double>(iterations));
+            }
+
+            m_finished = true;
+        }
+
+        bool finished() const { return m_finished; }
+
+        uint64_t iterationsPerSample() const { return m_iterations; }
+
+        const Vector<double>& sampleNs() const { return m_sampleNs; }
+
+    private:
+        static constexpr uint64_t MAX_ITERATIONS_PER_SAMPLE = 1ull << 24;
+
+        const Options& m_options;
+        int64_t m_arg{0};
+
+        bool m_finished{false};
+        uint64_t m_iterations{1};
+        Vector<double> m_sampleNs;
+
+        template<typename F>
+        static uint64_t timeBatch(F& fn, uint64_t iterations) {
+            auto start = Clock::now();
+            for (uint64_t i = 0; i < iterations; ++i) {
+                fn();
+            }
+            auto end = Clock::now();
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+        }
+
+        template<typename F>
+        uint64_t calibrate(F& fn) {
+            uint64_t iterations = 1;
+            while (iterations < MAX_ITERATIONS_PER_SAMPLE) {
+                auto elapsed = timeBatch(fn, iterations);
+                if (elapsed >= m_options.minSampleNs) {
+                    break;
+                }
+
+                // aim slightly above the minimum, but never grow more than 10x per step
+                uint64_t scale = elapsed == 0 ? 10 : (m_options.minSampleNs * 12 / 10) / elapsed + 1;
+                iterations *= std::min<uint64_t>(std::max<uint64_t>(scale, 2), 10);
+            }
+            return std::min(iterations, MAX_ITERATIONS_PER_SAMPLE);
+        }
+    };
+
+    using CaseFn = void (*)(State&);
+
+    struct Case {
+        String name;
+        String baseName;
+        CaseFn fn;
+        int64_t arg{0};
+    };
+
+    Vector<Case>& getRegistry();
+
+    // registry order depends on link order, this sorts by name, then numerically by argument
+    Vector<Case> getSortedCases();
+
+    struct Registrar {
+        Registrar(StringView name, CaseFn fn);
+
+        // registers one variant per argument, named "<name>/<arg>"
+        Registrar(StringView name, CaseFn fn, std::initializer_list<int64_t> args);
+    };
+
+    Result summarize(StringView name, const State& state);
+
+    Vector<Result> runAll(const Options& options);
+
+    String toJson(const Vector<Result>& results, const Options& options);
+
+    bool writeJson(StringView path, const Vector<Result>& results, const Options& options);
+
+    Optional<Vector<Result>> readJson(StringView path);
+
+    // prints a side by side table, returns the number of regressions
+    // a case regresses when its median grows by more than thresholdPercent
+    size_t compare(const Vector<Result>& baseline, const Vector<Result>& current, double thresholdPercent);
+}// namespace Bench
+
+MOE_END_NAMESPACE
+
+#define MOE_BENCH_CONCAT_IMPL(_a, _b) _a##_b
+#define MOE_BENCH_CONCAT(_a, _b) MOE_BENCH_CONCAT_IMPL(_a, _b)
+
+#define MOE_BENCH_IMPL(_fn, _name, ...)                                                      \
+    static void _fn(::moe::Bench::State& state);                                             \
+    static ::moe::Bench::Registrar MOE_BENCH_CONCAT(_fn, Registrar)(_name, &_fn, ##__VA_ARGS__); \
+    static void _fn(::moe::Bench::State& state)
+
+// MOE_BENCH("group/case") { setup; state.run([&]() { operation; }); }
+#define MOE_BENCH(_name) MOE_BENCH_IMPL(MOE_BENCH_CONCAT(moeBenchCase, __COUNTER__), _name)
+
+// MOE_BENCH_ARGS("group/case", {16, 256}) { ... state.arg() ... }
+#define MOE_BENCH_ARGS(_name, ...) MOE_BENCH_IMPL(MOE_BENCH_CONCAT(moeBenchCase, __COUNTER__), _name, __VA_ARGS__)
\ No newline at end of file
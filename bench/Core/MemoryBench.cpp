@@ -0,0 +1,25 @@
+#include "Bench.hpp"
+
+#include "Core/Memory.hpp"
+
+#include <cstdlib>
+
+// the tracked path against the allocator underneath it, the difference is what tracking costs every new/delete
+
+MOE_BENCH_ARGS("core/memory/malloc_free", {64, 4096}) {
+    auto size = static_cast<size_t>(state.arg());
+    state.run([&]() {
+        void* ptr = std::malloc(size);
+        moe::Bench::doNotOptimize(ptr);
+        std::free(ptr);
+    });
+}
+
+MOE_BENCH_ARGS("core/memory/tracked_alloc_free", {64, 4096}) {
+    auto size = static_cast<size_t>(state.arg());
+    state.run([&]() {
+        void* ptr = moe::Memory::allocate(size, alignof(std::max_align_t), moe::Memory::getThreadTag());
+        moe::Bench::doNotOptimize(ptr);
+        moe::Memory::deallocate(ptr);
+    });
+}
\ No newline at end of file
@@ -0,0 +1,71 @@
+#include "Bench.hpp"
+
+#include "Core/ResourceCache.hpp"
+
+#include <algorithm>
+#include <random>
+
+namespace {
+    struct BenchResource {
+        uint64_t payload[8]{};
+    };
+
+    struct BenchResourceLoader {
+        moe::SharedResource<BenchResource> operator()(uint64_t seed) {
+            auto resource = std::make_shared<BenchResource>();
+            resource->payload[0] = seed;
+            return resource;
+        }
+    };
+
+    using BenchResourceCache = moe::ResourceCache<uint32_t, BenchResource, BenchResourceLoader>;
+
+    // ids in a shuffled order, so lookups do not walk the buckets sequentially
+    moe::Vector<uint32_t> fillCache(BenchResourceCache& cache, size_t count) {
+        moe::Vector<uint32_t> ids;
+        ids.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            ids.push_back(cache.load(static_cast<uint64_t>(i)).first);
+        }
+
+        std::mt19937 rng(1234);
+        std::shuffle(ids.begin(), ids.end(), rng);
+        return ids;
+    }
+}// namespace
+
+// get() returns a SharedPtr copy, i.e. an atomic increment/decrement per lookup
+MOE_BENCH_ARGS("core/resource_cache/get", {64, 4096, 65536}) {
+    BenchResourceCache cache;
+    auto ids = fillCache(cache, static_cast<size_t>(state.arg()));
+
+    size_t cursor = 0;
+    state.run([&]() {
+        auto resource = cache.get(ids[cursor]);
+        moe::Bench::doNotOptimize(resource.value()->payload[0]);
+        cursor = cursor + 1 == ids.size() ? 0 : cursor + 1;
+    });
+}
+
+MOE_BENCH_ARGS("core/resource_cache/get_raw", {64, 4096, 65536}) {
+    BenchResourceCache cache;
+    auto ids = fillCache(cache, static_cast<size_t>(state.arg()));
+
+    size_t cursor = 0;
+    state.run([&]() {
+        auto resource = cache.getRaw(ids[cursor]);
+        moe::Bench::doNotOptimize(resource.value()->payload[0]);
+        cursor = cursor + 1 == ids.size() ? 0 : cursor + 1;
+    });
+}
+
+MOE_BENCH("core/resource_cache/get_miss") {
+    BenchResourceCache cache;
+    fillCache(cache, 4096);
+
+    uint32_t missingId = 1u << 20;
+    state.run([&]() {
+        auto resource = cache.get(missingId++);
+        moe::Bench::doNotOptimize(resource.has_value());
+    });
+}
\ No newline at end of file
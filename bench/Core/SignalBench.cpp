@@ -0,0 +1,61 @@
+#include "Bench.hpp"
+
+#include "Core/Signal/Signal.hpp"
+#include "Core/Signal/Slot.hpp"
+
+namespace {
+    struct CounterSlot : moe::Slot<CounterSlot> {
+    public:
+        explicit CounterSlot(uint64_t* counter)
+            : m_counter(counter) {}
+
+        void signal(uint64_t value) {
+            *m_counter += value;
+        }
+
+    private:
+        uint64_t* m_counter{nullptr};
+    };
+
+    struct SyncCounterSlot : moe::SyncSlot<SyncCounterSlot> {
+    public:
+        explicit SyncCounterSlot(uint64_t* counter)
+            : m_counter(counter) {}
+
+        void signal(uint64_t value) {
+            *m_counter += value;
+        }
+
+    private:
+        uint64_t* m_counter{nullptr};
+    };
+
+    template<typename SignalT, typename SlotT>
+    void runEmit(moe::Bench::State& state) {
+        auto slotCount = static_cast<size_t>(state.arg());
+        uint64_t counter = 0;
+
+        // instantiate the signal type before naming Ref<SignalT>, its ref-counted check needs a complete type
+        auto* rawSignal = new SignalT();
+        moe::Ref<SignalT> signal(rawSignal);
+        moe::Vector<decltype(signal->connect(SlotT(&counter)))> connections;
+        connections.reserve(slotCount);
+        for (size_t i = 0; i < slotCount; ++i) {
+            connections.push_back(signal->connect(SlotT(&counter)));
+        }
+
+        uint64_t value = 0;
+        state.run([&]() {
+            signal->emit(++value);
+        });
+        moe::Bench::doNotOptimize(counter);
+    }
+}// namespace
+
+MOE_BENCH_ARGS("core/signal/emit", {1, 16, 256}) {
+    runEmit<moe::Signal<CounterSlot>, CounterSlot>(state);
+}
+
+MOE_BENCH_ARGS("core/signal/sync_emit", {1, 16, 256}) {
+    runEmit<moe::SyncSignal<SyncCounterSlot>, SyncCounterSlot>(state);
+}
\ No newline at end of file
@@ -0,0 +1,84 @@
+#include "Bench.hpp"
+
+#include "Core/Task/Future.hpp"
+#include "Core/Task/Scheduler.hpp"
+#include "Core/Task/Utils.hpp"
+
+#include <atomic>
+#include <thread>
+
+namespace {
+    void waitForZero(const std::atomic_size_t& counter) {
+        while (counter.load(std::memory_order_acquire) != 0) {
+            std::this_thread::yield();
+        }
+    }
+}// namespace
+
+// one task scheduled and observed as done, i.e. the wakeup latency of a worker
+MOE_BENCH("core/scheduler/round_trip") {
+    auto& scheduler = moe::ThreadPoolScheduler::getInstance();
+    std::atomic_size_t pending{0};
+
+    state.run([&]() {
+        pending.store(1, std::memory_order_relaxed);
+        scheduler.schedule([&pending]() {
+            pending.fetch_sub(1, std::memory_order_release);
+        });
+        waitForZero(pending);
+    });
+}
+
+// fan out N small tasks and wait for all of them
+MOE_BENCH_ARGS("core/scheduler/fan_out", {16, 256}) {
+    auto& scheduler = moe::ThreadPoolScheduler::getInstance();
+    auto taskCount = static_cast<size_t>(state.arg());
+    std::atomic_size_t pending{0};
+    std::atomic_uint64_t sink{0};
+
+    state.run([&]() {
+        pending.store(taskCount, std::memory_order_relaxed);
+        for (size_t i = 0; i < taskCount; ++i) {
+            scheduler.schedule([&pending, &sink, i]() {
+                sink.fetch_add(i, std::memory_order_relaxed);
+                pending.fetch_sub(1, std::memory_order_release);
+            });
+        }
+        waitForZero(pending);
+    });
+}
+
+MOE_BENCH("core/future/async_get") {
+    state.run([]() {
+        auto future = moe::async([]() { return 42; });
+        moe::Bench::doNotOptimize(future.get());
+    });
+}
+
+// async followed by N continuations, each one scheduled when its predecessor is ready
+MOE_BENCH_ARGS("core/future/then_chain", {4, 16}) {
+    auto chainLength = state.arg();
+
+    state.run([chainLength]() {
+        auto future = moe::async([]() { return 0; });
+        for (int64_t i = 0; i < chainLength; ++i) {
+            future = future.then([](int value) { return value + 1; });
+        }
+        moe::Bench::doNotOptimize(future.get());
+    });
+}
+
+MOE_BENCH_ARGS("core/future/when_all", {8, 64}) {
+    auto futureCount = state.arg();
+
+    state.run([futureCount]() {
+        moe::Vector<moe::Future<int, moe::ThreadPoolScheduler>> futures;
+        futures.reserve(futureCount);
+        for (int64_t i = 0; i < futureCount; ++i) {
+            futures.push_back(moe::async([i]() { return static_cast<int>(i); }));
+        }
+
+        auto all = moe::whenAll(std::move(futures));
+        moe::Bench::doNotOptimize(all.get().size());
+    });
+}
\ No newline at end of file
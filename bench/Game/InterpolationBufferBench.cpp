@@ -0,0 +1,62 @@
+#include "Bench.hpp"
+
+#include "InterpolationBuffer.hpp"
+
+namespace {
+    // same layout as RemotePlayerState::RemotePlayerMotionInterpolationData
+    struct MotionSample {
+        glm::vec3 position;
+        glm::vec3 velocity;
+        glm::vec3 heading;
+        float health;
+
+        static MotionSample interpolate(const MotionSample& a, const MotionSample& b, float factor) {
+            MotionSample result;
+            result.position = glm::mix(a.position, b.position, factor);
+            result.velocity = glm::mix(a.velocity, b.velocity, factor);
+            result.heading = glm::mix(a.heading, b.heading, factor);
+            result.health = glm::mix(a.health, b.health, factor);
+            return result;
+        }
+    };
+
+    MotionSample makeSample(uint64_t tick) {
+        float t = static_cast<float>(tick);
+        return MotionSample{
+                .position = glm::vec3(t, 0.0f, -t),
+                .velocity = glm::vec3(1.0f, 0.0f, -1.0f),
+                .heading = glm::vec3(0.0f, 0.0f, 1.0f),
+                .health = 100.0f,
+        };
+    }
+
+    constexpr float FRAME_TIME_SECS = 1.0f / 144.0f;
+}// namespace
+
+// render frames sampling a full buffer between two network updates
+MOE_BENCH("game/interpolation_buffer/sample") {
+    game::InterpolationBuffer<MotionSample> buffer;
+    uint64_t tick = 0;
+    for (; tick < game::InterpolationBuffer<MotionSample>::bufferSize; ++tick) {
+        buffer.pushBack(makeSample(tick), tick);
+    }
+
+    state.run([&]() {
+        moe::Bench::doNotOptimize(buffer.interpolate(FRAME_TIME_SECS));
+    });
+}
+
+// one update per physics tick, a few render frames in between
+MOE_BENCH("game/interpolation_buffer/push_and_sample") {
+    game::InterpolationBuffer<MotionSample> buffer;
+    uint64_t tick = 0;
+    uint32_t frame = 0;
+
+    state.run([&]() {
+        if (frame++ % 3 == 0) {
+            ++tick;
+            buffer.pushBack(makeSample(tick), tick);
+        }
+        moe::Bench::doNotOptimize(buffer.interpolate(FRAME_TIME_SECS));
+    });
+}
\ No newline at end of file
@@ -0,0 +1,110 @@
+#include "Bench.hpp"
+
+#include "FlatBuffers/Generated/Received/Main_generated.h"
+
+#include "Math/Common.hpp"
+
+namespace {
+    struct DecodedPlayerUpdate {
+        glm::vec3 position;
+        glm::vec3 velocity;
+        glm::vec3 head;
+        uint64_t serverTick;
+        float health;
+    };
+
+    // the same message the server broadcasts every tick
+    void encodeAllPlayerUpdate(flatbuffers::FlatBufferBuilder& fbb, size_t playerCount, uint64_t tick) {
+        moe::Vector<flatbuffers::Offset<moe::net::PlayerUpdate>> updates;
+        updates.reserve(playerCount);
+        for (size_t i = 0; i < playerCount; ++i) {
+            float f = static_cast<float>(i) + static_cast<float>(tick) * 0.01f;
+            moe::net::Vec3 pos(f, 1.0f, -f);
+            moe::net::Vec3 vel(1.0f, 0.0f, 0.5f);
+            moe::net::Vec3 head(0.0f, 1.8f, 0.0f);
+
+            updates.push_back(moe::net::CreatePlayerUpdate(
+                    fbb,
+                    static_cast<uint16_t>(i),
+                    &pos, &vel, &head,
+                    moe::net::PlayerMotionState::NORMAL,
+                    moe::net::Weapon::AK47,
+                    100.0f));
+        }
+
+        auto allUpdates = moe::net::CreateAllPlayerUpdate(fbb, fbb.CreateVector(updates));
+        auto header = moe::net::CreateReceivedHeader(fbb, tick, tick * 16);
+        auto message = moe::net::CreateReceivedNetMessage(
+                fbb,
+                header,
+                moe::net::ReceivedPacketUnion::AllPlayerUpdate,
+                allUpdates.Union());
+        fbb.Finish(message);
+    }
+
+    // mirrors NetworkDispatcher::handlePlayerUpdateEvent without the per-player queues
+    size_t decodeAllPlayerUpdate(const uint8_t* data, moe::Vector<DecodedPlayerUpdate>& out) {
+        out.clear();
+
+        auto* message = moe::net::GetReceivedNetMessage(data);
+        auto* allUpdates = message->packet_as_AllPlayerUpdate();
+        if (!allUpdates) {
+            return 0;
+        }
+
+        uint64_t serverTick = message->header()->serverTick();
+        for (const auto playerUpdate: *allUpdates->updates()) {
+            auto pos = playerUpdate->pos();
+            auto vel = playerUpdate->vel();
+            auto head = playerUpdate->head();
+
+            out.push_back({
+                    glm::vec3(pos->x(), pos->y(), pos->z()),
+                    glm::vec3(vel->x(), vel->y(), vel->z()),
+                    glm::vec3(head->x(), head->y(), head->z()),
+                    serverTick,
+                    playerUpdate->health(),
+            });
+        }
+        return out.size();
+    }
+}// namespace
+
+MOE_BENCH_ARGS("net/player_update/encode", {10, 64}) {
+    auto playerCount = static_cast<size_t>(state.arg());
+    flatbuffers::FlatBufferBuilder fbb(1024);
+    uint64_t tick = 0;
+
+    state.run([&]() {
+        fbb.Clear();
+        encodeAllPlayerUpdate(fbb, playerCount, ++tick);
+        moe::Bench::doNotOptimize(fbb.GetSize());
+    });
+}
+
+MOE_BENCH_ARGS("net/player_update/decode", {10, 64}) {
+    flatbuffers::FlatBufferBuilder fbb(1024);
+    encodeAllPlayerUpdate(fbb, static_cast<size_t>(state.arg()), 1);
+    moe::Vector<uint8_t> payload(fbb.GetBufferPointer(), fbb.GetBufferPointer() + fbb.GetSize());
+
+    moe::Vector<DecodedPlayerUpdate> decoded;
+    state.run([&]() {
+        moe::Bench::doNotOptimize(decodeAllPlayerUpdate(payload.data(), decoded));
+    });
+}
+
+// the cost of validating untrusted packets before decoding them
+MOE_BENCH_ARGS("net/player_update/verify_decode", {10, 64}) {
+    flatbuffers::FlatBufferBuilder fbb(1024);
+    encodeAllPlayerUpdate(fbb, static_cast<size_t>(state.arg()), 1);
+    moe::Vector<uint8_t> payload(fbb.GetBufferPointer(), fbb.GetBufferPointer() + fbb.GetSize());
+
+    moe::Vector<DecodedPlayerUpdate> decoded;
+    state.run([&]() {
+        flatbuffers::Verifier verifier(payload.data(), payload.size());
+        if (!moe::net::VerifyReceivedNetMessageBuffer(verifier)) {
+            return;
+        }
+        moe::Bench::doNotOptimize(decodeAllPlayerUpdate(payload.data(), decoded));
+    });
+}
\ No newline at end of file
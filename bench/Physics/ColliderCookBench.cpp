@@ -0,0 +1,83 @@
+#include "Bench.hpp"
+#include "PhysicsBenchUtil.hpp"
+
+#include "Physics/CookedShape.hpp"
+
+#include <Jolt/Physics/Collision/Shape/MeshShape.h>
+#include <Jolt/Physics/Collision/Shape/StaticCompoundShape.h>
+
+#include <cmath>
+
+// level collider load time, building the mesh bvhs against restoring a cooked shape
+// the arg is the grid size of each of the four terrain tiles, two triangles per cell
+
+namespace {
+    constexpr int TILE_COUNT = 4;
+
+    struct TerrainSettings {
+    public:
+        JPH::Ref<JPH::StaticCompoundShapeSettings> compound;
+        JPH::Array<JPH::Ref<JPH::MeshShapeSettings>> tiles;
+
+        // settings keep the shape they created, without this only the first build would be measured
+        void clearCachedResults() {
+            compound->ClearCachedResult();
+            for (auto& tile: tiles) {
+                tile->ClearCachedResult();
+            }
+        }
+    };
+
+    TerrainSettings makeTerrainSettings(int gridSize) {
+        TerrainSettings terrain;
+        terrain.compound = new JPH::StaticCompoundShapeSettings();
+        for (int tile = 0; tile < TILE_COUNT; ++tile) {
+            JPH::VertexList vertices;
+            JPH::IndexedTriangleList triangles;
+            for (int z = 0; z <= gridSize; ++z) {
+                for (int x = 0; x <= gridSize; ++x) {
+                    float height = std::sin(static_cast<float>(x) * 0.3f) * std::cos(static_cast<float>(z + tile) * 0.2f);
+                    vertices.push_back(JPH::Float3(static_cast<float>(x), height, static_cast<float>(z)));
+                }
+            }
+
+            auto index = [gridSize](int x, int z) { return static_cast<JPH::uint32>(z * (gridSize + 1) + x); };
+            for (int z = 0; z < gridSize; ++z) {
+                for (int x = 0; x < gridSize; ++x) {
+                    triangles.push_back(JPH::IndexedTriangle(index(x, z), index(x, z + 1), index(x + 1, z + 1), 0));
+                    triangles.push_back(JPH::IndexedTriangle(index(x, z), index(x + 1, z + 1), index(x + 1, z), 0));
+                }
+            }
+
+            JPH::Ref<JPH::MeshShapeSettings> mesh = new JPH::MeshShapeSettings(std::move(vertices), std::move(triangles));
+            terrain.compound->AddShape(
+                    JPH::Vec3(static_cast<float>(tile * gridSize), 0.0f, 0.0f),
+                    JPH::Quat::sIdentity(),
+                    mesh);
+            terrain.tiles.push_back(mesh);
+        }
+        return terrain;
+    }
+}// namespace
+
+MOE_BENCH_ARGS("physics/collider/build", {64, 256}) {
+    moe::Bench::ensureJoltInitialized();
+    auto terrain = makeTerrainSettings(static_cast<int>(state.arg()));
+
+    state.run([&]() {
+        terrain.clearCachedResults();
+        auto result = terrain.compound->Create();
+        moe::Bench::doNotOptimize(result.Get().GetPtr());
+    });
+}
+
+MOE_BENCH_ARGS("physics/collider/restore", {64, 256}) {
+    moe::Bench::ensureJoltInitialized();
+    auto terrain = makeTerrainSettings(static_cast<int>(state.arg()));
+    auto cooked = moe::Physics::CookedShape{terrain.compound->Create().Get()}.serialize();
+
+    state.run([&]() {
+        auto restored = moe::Physics::CookedShape::deserialize({cooked.data(), cooked.size()});
+        moe::Bench::doNotOptimize(restored->shape.GetPtr());
+    });
+}
\ No newline at end of file
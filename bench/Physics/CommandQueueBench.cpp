@@ -0,0 +1,143 @@
+#include "Bench.hpp"
+
+#include "Physics/PhysicsCommand.hpp"
+
+#include "Core/MpscQueue.hpp"
+
+#include <mutex>
+#include <thread>
+
+// producer side latency of dispatching to the physics thread, one push is one operation
+// the arg is the number of producer threads including the measuring one, the others push a callback every 20us
+// a fake physics thread drains every 100us and spends 2us on each background callback, the old mutex scheme
+// ran callbacks while holding the lock, so every producer waited for the whole drain
+// the measured thread pushes empty callbacks back to back, the queue is sized so it rarely runs full
+
+namespace {
+    constexpr auto DRAIN_INTERVAL = std::chrono::microseconds(100);
+    constexpr auto CALLBACK_WORK = std::chrono::microseconds(2);
+
+    void spinFor(std::chrono::nanoseconds duration) {
+        auto until = std::chrono::steady_clock::now() + duration;
+        while (std::chrono::steady_clock::now() < until) {
+        }
+    }
+
+    moe::Physics::CallbackCommand makeWorkCallback() {
+        return [](moe::PhysicsEngine&) { spinFor(CALLBACK_WORK); };
+    }
+
+    moe::Physics::CallbackCommand makeEmptyCallback() {
+        return [](moe::PhysicsEngine&) {};
+    }
+
+    // what PhysicsEngine::dispatchOnPhysicsThread used before
+    struct MutexDispatcher {
+    public:
+        std::mutex mutex;
+        moe::Vector<moe::Physics::CallbackCommand> commands;
+
+        void push(moe::Physics::CallbackCommand&& command) {
+            std::lock_guard<std::mutex> lk(mutex);
+            commands.push_back(std::move(command));
+        }
+
+        void drain(moe::PhysicsEngine& engine) {
+            std::lock_guard<std::mutex> lk(mutex);
+            for (auto& command: commands) {
+                command(engine);
+            }
+            commands.clear();
+        }
+    };
+
+    struct QueueDispatcher {
+    public:
+        moe::MpscQueue<moe::Physics::PhysicsCommand> queue{16384};
+
+        void push(moe::Physics::CallbackCommand&& command) {
+            moe::Physics::PhysicsCommand wrapped(std::move(command));
+            while (!queue.tryPush(std::move(wrapped))) {
+                std::this_thread::yield();
+            }
+        }
+
+        void drain(moe::PhysicsEngine& engine) {
+            queue.drain(
+                    [&](moe::Physics::PhysicsCommand& command) {
+                        if (auto* fn = std::get_if<moe::Physics::CallbackCommand>(&command)) {
+                            (*fn)(engine);
+                        }
+                    },
+                    queue.sizeApprox());
+        }
+    };
+
+    template<typename Dispatcher>
+    struct LoadedDispatcher {
+    public:
+        Dispatcher dispatcher;
+
+        explicit LoadedDispatcher(size_t producerCount) {
+            m_threads.emplace_back([this]() {
+                // never dereferenced, the callbacks only burn time
+                auto& engine = *reinterpret_cast<moe::PhysicsEngine*>(this);
+                while (m_running.load()) {
+                    auto next = std::chrono::steady_clock::now() + DRAIN_INTERVAL;
+                    dispatcher.drain(engine);
+                    std::this_thread::sleep_until(next);
+                }
+                dispatcher.drain(engine);
+            });
+
+            for (size_t i = 1; i < producerCount; ++i) {
+                m_threads.emplace_back([this]() {
+                    while (m_running.load()) {
+                        dispatcher.push(makeWorkCallback());
+                        // roughly what a busy game thread dispatches, not a flood
+                        spinFor(std::chrono::microseconds(20));
+                    }
+                });
+            }
+        }
+
+        ~LoadedDispatcher() {
+            m_running.store(false);
+            for (auto& thread: m_threads) {
+                thread.join();
+            }
+        }
+
+    private:
+        std::atomic_bool m_running{true};
+        moe::Vector<std::thread> m_threads;
+    };
+}// namespace
+
+MOE_BENCH_ARGS("physics/command_queue/mutex_push", {1, 4}) {
+    LoadedDispatcher<MutexDispatcher> loaded(static_cast<size_t>(state.arg()));
+
+    state.run([&]() {
+        loaded.dispatcher.push(makeEmptyCallback());
+    });
+}
+
+MOE_BENCH_ARGS("physics/command_queue/lock_free_push", {1, 4}) {
+    LoadedDispatcher<QueueDispatcher> loaded(static_cast<size_t>(state.arg()));
+
+    state.run([&]() {
+        loaded.dispatcher.push(makeEmptyCallback());
+    });
+}
+
+// a typed command fits the queue cell, nothing is allocated on the producer side
+MOE_BENCH_ARGS("physics/command_queue/lock_free_push_typed", {1, 4}) {
+    LoadedDispatcher<QueueDispatcher> loaded(static_cast<size_t>(state.arg()));
+
+    state.run([&]() {
+        moe::Physics::PhysicsCommand command(moe::Physics::SetVelocityCommand{JPH::BodyID(1), JPH::Vec3::sAxisY()});
+        while (!loaded.dispatcher.queue.tryPush(std::move(command))) {
+            std::this_thread::yield();
+        }
+    });
+}
\ No newline at end of file
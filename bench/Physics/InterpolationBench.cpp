@@ -0,0 +1,72 @@
+#include "Bench.hpp"
+
+#include "Physics/SnapshotInterpolator.hpp"
+
+// main thread cost of render interpolation, the arg is the number of bodies, all of them moving every tick
+// publish_only is the shared per tick setup, subtract it from publish_and_update
+// update is paid once per physics tick, query_all once per rendered frame
+
+namespace {
+    constexpr auto STEP = std::chrono::microseconds(16667);
+
+    struct MovingBodies {
+    public:
+        moe::Physics::SnapshotView::Channel channel;
+        moe::Physics::SnapshotInterpolator interpolator;
+        moe::Physics::SnapshotInterpolator::Clock::time_point start{moe::Physics::SnapshotInterpolator::Clock::now()};
+        uint64_t tick{0};
+        bool interpolate{true};
+
+        explicit MovingBodies(size_t bodyCount) {
+            channel.resize(bodyCount);
+            publish();
+            publish();
+        }
+
+        void publish() {
+            float t = static_cast<float>(tick) / 60.0f;
+            for (size_t i = 0; i < channel.size(); ++i) {
+                auto& entry = channel.edit(i);
+                entry.bodyID = JPH::BodyID(static_cast<JPH::uint>(i), 1);
+                entry.position = JPH::Vec3(static_cast<float>(i), t, 0.0f);
+                entry.rotation = JPH::Quat::sRotation(JPH::Vec3::sAxisY(), t);
+            }
+            channel.publish(tick, start + STEP * tick);
+            ++tick;
+
+            channel.acquire();
+            if (interpolate) {
+                interpolator.update(moe::Physics::SnapshotView(channel.view()));
+            }
+        }
+    };
+}// namespace
+
+MOE_BENCH_ARGS("physics/interpolation/publish_only", {1000, 10000}) {
+    MovingBodies bodies(static_cast<size_t>(state.arg()));
+    bodies.interpolate = false;
+
+    state.run([&]() {
+        bodies.publish();
+    });
+}
+
+MOE_BENCH_ARGS("physics/interpolation/publish_and_update", {1000, 10000}) {
+    MovingBodies bodies(static_cast<size_t>(state.arg()));
+
+    state.run([&]() {
+        bodies.publish();
+    });
+}
+
+MOE_BENCH_ARGS("physics/interpolation/query_all", {1000, 10000}) {
+    MovingBodies bodies(static_cast<size_t>(state.arg()));
+    // halfway between the two ticks, the blending path
+    float alpha = bodies.interpolator.computeAlpha(bodies.start + STEP * bodies.tick - STEP / 2);
+
+    state.run([&]() {
+        for (size_t i = 0; i < bodies.channel.size(); ++i) {
+            moe::Bench::doNotOptimize(bodies.interpolator.getTransform(JPH::BodyID(static_cast<JPH::uint>(i), 1), alpha));
+        }
+    });
+}
\ No newline at end of file
@@ -0,0 +1,133 @@
+#include "Bench.hpp"
+#include "PhysicsBenchUtil.hpp"
+
+#include "Physics/SchedulerJobSystem.hpp"
+
+#include <atomic>
+#include <thread>
+
+// one physics step of a settled pile with jolt's own thread pool against the engine scheduler
+// the arg is the number of simulated asset loading tasks kept queued on the scheduler, 0 runs idle
+
+namespace {
+    constexpr int PILE_SIZE = 20;
+    constexpr int PILE_HEIGHT = 5;
+
+    struct PileWorld {
+    public:
+        moe::Bench::BenchLayers layers;
+        JPH::PhysicsSystem system;
+        JPH::TempAllocatorImpl tempAllocator{32 * 1024 * 1024};
+
+        PileWorld() {
+            layers.initSystem(system, PILE_SIZE * PILE_SIZE * PILE_HEIGHT + 1, 65536, 32768);
+
+            auto& bodyInterface = system.GetBodyInterface();
+            bodyInterface.CreateAndAddBody(
+                    JPH::BodyCreationSettings(
+                            new JPH::BoxShape(JPH::Vec3(50.0f, 0.5f, 50.0f)),
+                            JPH::RVec3(0.0f, -0.5f, 0.0f),
+                            JPH::Quat::sIdentity(),
+                            JPH::EMotionType::Static,
+                            moe::Physics::Details::Layers::STATIC),
+                    JPH::EActivation::DontActivate);
+
+            JPH::RefConst<JPH::Shape> sphere = new JPH::SphereShape(0.5f);
+            for (int y = 0; y < PILE_HEIGHT; ++y) {
+                for (int x = 0; x < PILE_SIZE; ++x) {
+                    for (int z = 0; z < PILE_SIZE; ++z) {
+                        JPH::BodyCreationSettings settings(
+                                sphere,
+                                JPH::RVec3(static_cast<float>(x - PILE_SIZE / 2), 0.5f + static_cast<float>(y) * 1.05f, static_cast<float>(z - PILE_SIZE / 2)),
+                                JPH::Quat::sIdentity(),
+                                JPH::EMotionType::Dynamic,
+                                moe::Physics::Details::Layers::DYNAMIC);
+                        // a sleeping pile would measure nothing
+                        settings.mAllowSleeping = false;
+                        bodyInterface.CreateAndAddBody(settings, JPH::EActivation::Activate);
+                    }
+                }
+            }
+            system.OptimizeBroadPhase();
+        }
+
+        void step(JPH::JobSystem& jobSystem) {
+            system.Update(1.0f / 60.0f, 1, &tempAllocator, &jobSystem);
+        }
+    };
+
+    // keeps a number of normal priority tasks of ~0.5ms busy work queued, like decoding textures and meshes
+    struct BackgroundLoad {
+    public:
+        explicit BackgroundLoad(size_t depth)
+            : m_depth(depth) {
+            if (m_depth > 0) {
+                m_feeder = std::thread([this]() { feed(); });
+            }
+        }
+
+        ~BackgroundLoad() {
+            m_running.store(false);
+            if (m_feeder.joinable()) {
+                m_feeder.join();
+            }
+            while (m_pending.load() != 0) {
+                std::this_thread::yield();
+            }
+        }
+
+    private:
+        size_t m_depth;
+        std::atomic_bool m_running{true};
+        std::atomic_size_t m_pending{0};
+        std::thread m_feeder;
+
+        void feed() {
+            auto& scheduler = moe::ThreadPoolScheduler::getInstance();
+            while (m_running.load()) {
+                while (m_pending.load() < m_depth) {
+                    m_pending.fetch_add(1);
+                    scheduler.schedule([this]() {
+                        auto until = std::chrono::steady_clock::now() + std::chrono::microseconds(500);
+                        while (std::chrono::steady_clock::now() < until) {
+                        }
+                        m_pending.fetch_sub(1);
+                    });
+                }
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+            }
+        }
+    };
+
+    void settle(PileWorld& world, JPH::JobSystem& jobSystem) {
+        for (int i = 0; i < 60; ++i) {
+            world.step(jobSystem);
+        }
+    }
+}// namespace
+
+// what PhysicsEngine used before, a second pool sized to the machine next to the scheduler's workers
+MOE_BENCH_ARGS("physics/job_system/thread_pool_step", {0, 16}) {
+    PileWorld world;
+    JPH::JobSystemThreadPool jobSystem(JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers);
+    settle(world, jobSystem);
+
+    BackgroundLoad load(static_cast<size_t>(state.arg()));
+    state.run([&]() {
+        world.step(jobSystem);
+    });
+}
+
+MOE_BENCH_ARGS("physics/job_system/scheduler_step", {0, 16}) {
+    PileWorld world;
+    moe::Physics::SchedulerJobSystem jobSystem(
+            moe::ThreadPoolScheduler::getInstance(),
+            JPH::cMaxPhysicsJobs,
+            JPH::cMaxPhysicsBarriers);
+    settle(world, jobSystem);
+
+    BackgroundLoad load(static_cast<size_t>(state.arg()));
+    state.run([&]() {
+        world.step(jobSystem);
+    });
+}
\ No newline at end of file
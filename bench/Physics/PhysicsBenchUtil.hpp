@@ -0,0 +1,33 @@
+#pragma once
+
+#include "Physics/CollisionLayers.hpp"
+
+namespace moe::Bench {
+    // jolt's globals are set up once per process and never torn down
+    inline void ensureJoltInitialized() {
+        static bool s_initialized = []() {
+            JPH::RegisterDefaultAllocator();
+            JPH::Factory::sInstance = new JPH::Factory();
+            JPH::RegisterTypes();
+            return true;
+        }();
+        (void) s_initialized;
+    }
+
+    // the default collision layers and the filters jolt needs from them, must outlive the physics system
+    struct BenchLayers {
+    public:
+        Physics::CollisionLayerConfig config{Physics::CollisionLayerConfig::createDefault()};
+        Physics::Details::BPLayerInterfaceImpl broadPhaseLayerInterface{config};
+        Physics::Details::ObjectVsBroadPhaseLayerFilterImpl objectVsBroadPhaseLayerFilter{config};
+        Physics::Details::ObjectLayerFilterImpl objectLayerFilter{config};
+
+        void initSystem(JPH::PhysicsSystem& system, JPH::uint maxBodies, JPH::uint maxBodyPairs, JPH::uint maxContactConstraints) {
+            ensureJoltInitialized();
+            system.Init(maxBodies, 0, maxBodyPairs, maxContactConstraints,
+                        broadPhaseLayerInterface,
+                        objectVsBroadPhaseLayerFilter,
+                        objectLayerFilter);
+        }
+    };
+}// namespace moe::Bench
\ No newline at end of file
@@ -0,0 +1,103 @@
+#include "Bench.hpp"
+#include "PhysicsBenchUtil.hpp"
+
+#include "Physics/RollbackBuffer.hpp"
+
+// per tick cost of keeping a world rollback-ready, and of a 30 tick correction
+// the arg is the number of awake dynamic bodies, the static floor is never saved
+
+namespace {
+    constexpr float DELTA_TIME = 1.0f / 60.0f;
+    constexpr size_t ROLLBACK_TICKS = 30;
+
+    struct RollbackWorld {
+    public:
+        moe::Bench::BenchLayers layers;
+        JPH::PhysicsSystem system;
+        JPH::TempAllocatorImpl tempAllocator{32 * 1024 * 1024};
+        JPH::JobSystemThreadPool jobSystem{JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers};
+        moe::Physics::RollbackBuffer rollback{64};
+        size_t tick{0};
+
+        explicit RollbackWorld(JPH::uint bodyCount) {
+            layers.initSystem(system, bodyCount + 1, 65536, 32768);
+
+            auto& bodyInterface = system.GetBodyInterface();
+            bodyInterface.CreateAndAddBody(
+                    JPH::BodyCreationSettings(
+                            new JPH::BoxShape(JPH::Vec3(100.0f, 0.5f, 100.0f)),
+                            JPH::RVec3(0.0f, -0.5f, 0.0f),
+                            JPH::Quat::sIdentity(),
+                            JPH::EMotionType::Static,
+                            moe::Physics::Details::Layers::STATIC),
+                    JPH::EActivation::DontActivate);
+
+            JPH::RefConst<JPH::Shape> sphere = new JPH::SphereShape(0.5f);
+            for (JPH::uint i = 0; i < bodyCount; ++i) {
+                JPH::BodyCreationSettings settings(
+                        sphere,
+                        JPH::RVec3(static_cast<float>(i % 32) * 1.1f - 16.0f, 0.5f + static_cast<float>(i / 1024) * 1.1f, static_cast<float>((i / 32) % 32) * 1.1f - 16.0f),
+                        JPH::Quat::sIdentity(),
+                        JPH::EMotionType::Dynamic,
+                        moe::Physics::Details::Layers::DYNAMIC);
+                // a sleeping world saves the same bytes but resimulates for free
+                settings.mAllowSleeping = false;
+                bodyInterface.CreateAndAddBody(settings, JPH::EActivation::Activate);
+            }
+            system.OptimizeBroadPhase();
+
+            // fill the ring with real history
+            for (size_t i = 0; i <= ROLLBACK_TICKS; ++i) {
+                step();
+            }
+        }
+
+        void step() {
+            rollback.save(system, tick);
+            system.Update(DELTA_TIME, 1, &tempAllocator, &jobSystem);
+            ++tick;
+        }
+    };
+}// namespace
+
+MOE_BENCH_ARGS("physics/rollback/save", {100, 1000}) {
+    RollbackWorld world(static_cast<JPH::uint>(state.arg()));
+    size_t tick = world.tick;
+
+    state.run([&]() {
+        world.rollback.save(world.system, tick++);
+    });
+}
+
+MOE_BENCH_ARGS("physics/rollback/restore", {100, 1000}) {
+    RollbackWorld world(static_cast<JPH::uint>(state.arg()));
+    world.rollback.save(world.system, world.tick);
+
+    state.run([&]() {
+        moe::Bench::doNotOptimize(world.rollback.restore(world.system, world.tick));
+    });
+}
+
+// plain steps with a save each, the baseline a resimulated tick is compared against
+MOE_BENCH_ARGS("physics/rollback/step_and_save", {100, 1000}) {
+    RollbackWorld world(static_cast<JPH::uint>(state.arg()));
+
+    state.run([&]() {
+        world.step();
+    });
+}
+
+// one whole correction, divide by 30 for the cost per resimulated tick
+MOE_BENCH_ARGS("physics/rollback/resimulate_30", {100, 1000}) {
+    RollbackWorld world(static_cast<JPH::uint>(state.arg()));
+    world.rollback.save(world.system, world.tick);
+
+    state.run([&]() {
+        moe::Bench::doNotOptimize(world.rollback.resimulate(
+                world.system,
+                world.tick - ROLLBACK_TICKS, world.tick,
+                DELTA_TIME,
+                world.tempAllocator,
+                world.jobSystem));
+    });
+}
\ No newline at end of file
@@ -0,0 +1,159 @@
+#include "Bench.hpp"
+#include "PhysicsBenchUtil.hpp"
+
+#include "Physics/SceneQuery.hpp"
+
+#include <Jolt/Physics/Collision/CastResult.h>
+#include <Jolt/Physics/Collision/RayCast.h>
+
+#include <condition_variable>
+#include <future>
+#include <random>
+
+// rays per tick through one-off dispatches to the physics thread against one batch split across the scheduler
+// both go through a stand-in physics thread, so the batch pays the same hand-off once instead of per ray
+
+namespace {
+    constexpr int GRID_SIZE = 32;
+
+    struct QueryWorld {
+    public:
+        moe::Bench::BenchLayers layers;
+        JPH::PhysicsSystem system;
+        moe::Vector<moe::Physics::RayQuery> rays;
+
+        explicit QueryWorld(size_t rayCount) {
+            layers.initSystem(system, GRID_SIZE * GRID_SIZE + 1, 1024, 1024);
+
+            auto& bodyInterface = system.GetBodyInterface();
+            bodyInterface.CreateAndAddBody(
+                    JPH::BodyCreationSettings(
+                            new JPH::BoxShape(JPH::Vec3(100.0f, 0.5f, 100.0f)),
+                            JPH::RVec3(0.0f, -0.5f, 0.0f),
+                            JPH::Quat::sIdentity(),
+                            JPH::EMotionType::Static,
+                            moe::Physics::Details::Layers::STATIC),
+                    JPH::EActivation::DontActivate);
+
+            JPH::RefConst<JPH::Shape> box = new JPH::BoxShape(JPH::Vec3::sReplicate(0.5f));
+            for (int x = 0; x < GRID_SIZE; ++x) {
+                for (int z = 0; z < GRID_SIZE; ++z) {
+                    bodyInterface.CreateAndAddBody(
+                            JPH::BodyCreationSettings(
+                                    box,
+                                    JPH::RVec3(static_cast<float>(x * 3 - 48), 0.5f, static_cast<float>(z * 3 - 48)),
+                                    JPH::Quat::sIdentity(),
+                                    JPH::EMotionType::Dynamic,
+                                    moe::Physics::Details::Layers::DYNAMIC),
+                            JPH::EActivation::DontActivate);
+                }
+            }
+            system.OptimizeBroadPhase();
+
+            // weapon fire from head height in every direction, some hit boxes, most the floor
+            std::mt19937 rng(42);
+            std::uniform_real_distribution<float> position(-48.0f, 48.0f);
+            std::uniform_real_distribution<float> direction(-1.0f, 1.0f);
+            for (size_t i = 0; i < rayCount; ++i) {
+                JPH::Vec3 dir(direction(rng), -0.5f + 0.5f * direction(rng), direction(rng));
+                rays.push_back({
+                        JPH::RVec3(position(rng), 1.7f, position(rng)),
+                        dir.NormalizedOr(JPH::Vec3::sAxisX()) * 100.0f,
+                });
+            }
+        }
+    };
+
+    // what PhysicsEngine::dispatchOnPhysicsThread gives a caller, a queue drained by one thread
+    class FakePhysicsThread {
+    public:
+        FakePhysicsThread() {
+            m_thread = std::thread([this]() { run(); });
+        }
+
+        ~FakePhysicsThread() {
+            {
+                std::lock_guard<std::mutex> lk(m_mutex);
+                m_running = false;
+            }
+            m_cv.notify_one();
+            m_thread.join();
+        }
+
+        void dispatch(moe::Function<void()> fn) {
+            {
+                std::lock_guard<std::mutex> lk(m_mutex);
+                m_queue.push_back(std::move(fn));
+            }
+            m_cv.notify_one();
+        }
+
+    private:
+        std::mutex m_mutex;
+        std::condition_variable m_cv;
+        moe::Vector<moe::Function<void()>> m_queue;
+        bool m_running{true};
+        std::thread m_thread;
+
+        void run() {
+            moe::Vector<moe::Function<void()>> tasks;
+            while (true) {
+                {
+                    std::unique_lock<std::mutex> lk(m_mutex);
+                    m_cv.wait(lk, [this]() { return !m_queue.empty() || !m_running; });
+                    if (m_queue.empty()) {
+                        return;
+                    }
+                    tasks.swap(m_queue);
+                }
+                for (auto& task: tasks) {
+                    task();
+                }
+                tasks.clear();
+            }
+        }
+    };
+}// namespace
+
+MOE_BENCH_ARGS("physics/scene_query/per_query_rays", {1000, 10000}) {
+    QueryWorld world(static_cast<size_t>(state.arg()));
+    FakePhysicsThread physicsThread;
+
+    state.run([&]() {
+        moe::Vector<std::future<bool>> results;
+        results.reserve(world.rays.size());
+        for (const auto& ray: world.rays) {
+            auto promise = std::make_shared<std::promise<bool>>();
+            results.push_back(promise->get_future());
+            physicsThread.dispatch([&world, ray, promise]() {
+                JPH::RayCastResult hit;
+                promise->set_value(world.system.GetNarrowPhaseQuery().CastRay({ray.origin, ray.direction}, hit));
+            });
+        }
+
+        size_t hitCount = 0;
+        for (auto& result: results) {
+            hitCount += result.get() ? 1 : 0;
+        }
+        moe::Bench::doNotOptimize(hitCount);
+    });
+}
+
+MOE_BENCH_ARGS("physics/scene_query/batched_rays", {1000, 10000}) {
+    QueryWorld world(static_cast<size_t>(state.arg()));
+    FakePhysicsThread physicsThread;
+    moe::Physics::SceneQueryBatcher batcher;
+
+    state.run([&]() {
+        auto future = batcher.castRays(world.rays);
+        physicsThread.dispatch([&]() {
+            batcher.execute(world.system, moe::ThreadPoolScheduler::getInstance());
+        });
+
+        size_t hitCount = 0;
+        for (const auto& hit: future.get()) {
+            hitCount += hit.hasHit() ? 1 : 0;
+        }
+        moe::Bench::doNotOptimize(hitCount);
+    });
+}
\ No newline at end of file
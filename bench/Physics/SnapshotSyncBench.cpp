@@ -0,0 +1,110 @@
+#include "Bench.hpp"
+#include "PhysicsBenchUtil.hpp"
+
+#include "Physics/BodySnapshotTracker.hpp"
+#include "Physics/PhysicsEngine.hpp"
+
+// per tick snapshot sync for worlds of mostly sleeping bodies, one body in a hundred is awake and moving
+// move_only is the shared per tick setup, subtract it from the other two
+
+namespace {
+    constexpr JPH::uint ACTIVE_BODY_STRIDE = 100;
+
+    struct BenchWorld {
+    public:
+        moe::Bench::BenchLayers layers;
+        JPH::PhysicsSystem system;
+
+        JPH::BodyIDVector activeBodies;
+        float offset{0.01f};
+
+        explicit BenchWorld(JPH::uint bodyCount) {
+            layers.initSystem(system, bodyCount, 1024, 1024);
+
+            auto& bodyInterface = system.GetBodyInterfaceNoLock();
+            JPH::RefConst<JPH::Shape> shape = new JPH::BoxShape(JPH::Vec3::sReplicate(0.5f));
+
+            JPH::BodyIDVector bodies;
+            bodies.reserve(bodyCount);
+            for (JPH::uint i = 0; i < bodyCount; ++i) {
+                JPH::BodyCreationSettings settings(
+                        shape,
+                        JPH::RVec3(static_cast<float>(i % 256) * 2.0f, 0.0f, static_cast<float>(i / 256) * 2.0f),
+                        JPH::Quat::sIdentity(),
+                        JPH::EMotionType::Dynamic,
+                        moe::Physics::Details::Layers::MOVING);
+                bodies.push_back(bodyInterface.CreateBody(settings)->GetID());
+            }
+
+            auto addState = bodyInterface.AddBodiesPrepare(bodies.data(), static_cast<int>(bodies.size()));
+            bodyInterface.AddBodiesFinalize(bodies.data(), static_cast<int>(bodies.size()), addState, JPH::EActivation::DontActivate);
+
+            for (JPH::uint i = 0; i < bodyCount; i += ACTIVE_BODY_STRIDE) {
+                activeBodies.push_back(bodies[i]);
+            }
+            bodyInterface.ActivateBodies(activeBodies.data(), static_cast<int>(activeBodies.size()));
+        }
+
+        // what a step does to the awake bodies, minus the broadphase so only the sync is measured
+        void moveActiveBodies() {
+            offset = -offset;
+
+            const auto& lockInterface = system.GetBodyLockInterfaceNoLock();
+            for (auto id: activeBodies) {
+                JPH::BodyLockWrite lock(lockInterface, id);
+                auto& body = lock.GetBody();
+                body.SetPositionAndRotationInternal(body.GetPosition() + JPH::Vec3(0.0f, offset, 0.0f), body.GetRotation());
+            }
+        }
+    };
+}// namespace
+
+MOE_BENCH_ARGS("physics/snapshot_sync/move_only", {1000, 10000, 50000}) {
+    BenchWorld world(static_cast<JPH::uint>(state.arg()));
+
+    state.run([&]() {
+        world.moveActiveBodies();
+    });
+}
+
+// what PhysicsEngine did before the dense snapshots, every body rehashed and copied every tick
+MOE_BENCH_ARGS("physics/snapshot_sync/map_rebuild", {1000, 10000, 50000}) {
+    BenchWorld world(static_cast<JPH::uint>(state.arg()));
+
+    moe::UnorderedMap<JPH::BodyID, moe::Physics::ObjectSnapshot> snapshots;
+    JPH::BodyIDVector bodyIds;
+    const auto& bodyInterface = world.system.GetBodyInterface();
+
+    state.run([&]() {
+        world.moveActiveBodies();
+
+        snapshots.clear();
+        bodyIds.clear();
+        world.system.GetBodies(bodyIds);
+        for (const auto& bodyID: bodyIds) {
+            moe::Physics::ObjectSnapshot snapshot{};
+            snapshot.bodyID = bodyID;
+            bodyInterface.GetPositionAndRotation(bodyID, snapshot.position, snapshot.rotation);
+            snapshots.emplace(bodyID, snapshot);
+        }
+        moe::Bench::doNotOptimize(snapshots.size());
+    });
+}
+
+MOE_BENCH_ARGS("physics/snapshot_sync/dense", {1000, 10000, 50000}) {
+    BenchWorld world(static_cast<JPH::uint>(state.arg()));
+
+    moe::Physics::BodySnapshotTracker tracker;
+    uint64_t tick = 0;
+
+    // the first sync rescans every body, keep it out of the timing
+    tracker.sync(world.system, tick++);
+    tracker.acquire();
+
+    state.run([&]() {
+        world.moveActiveBodies();
+
+        moe::Bench::doNotOptimize(tracker.sync(world.system, tick++));
+        tracker.acquire();
+    });
+}
\ No newline at end of file
@@ -0,0 +1,119 @@
+#include "Bench.hpp"
+
+#include "Render/Vulkan/VulkanCamera.hpp"
+#include "Render/Vulkan/VulkanRenderable.hpp"
+
+#include <random>
+
+// the arg is the packet count, boxes of 0.5 - 2m scattered over a 400m wide field around the camera
+// roughly a tenth of them end up inside the camera frustum
+
+namespace {
+    constexpr float FIELD_SIZE = 400.0f;
+    constexpr float ASPECT = 16.0f / 9.0f;
+
+    moe::Vector<moe::VulkanRenderPacket> buildPackets(size_t count) {
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<float> position(-FIELD_SIZE * 0.5f, FIELD_SIZE * 0.5f);
+        std::uniform_real_distribution<float> height(0.0f, 20.0f);
+        std::uniform_real_distribution<float> size(0.25f, 1.0f);
+
+        moe::Vector<moe::VulkanRenderPacket> packets(count);
+        for (auto& packet: packets) {
+            glm::vec3 center{position(rng), height(rng), position(rng)};
+            packet.transform = glm::translate(glm::mat4(1.0f), center);
+            packet.bounds = moe::VulkanBounds{center, glm::vec3(size(rng))};
+        }
+        return packets;
+    }
+
+    moe::VulkanFrustum cameraFrustum() {
+        moe::VulkanCamera camera{glm::vec3(0.0f, 5.0f, 0.0f), -10.0f, 30.0f, 45.0f, 0.1f, 200.0f};
+        return moe::VulkanFrustum::fromViewProjection(camera.projectionMatrix(ASPECT) * camera.viewMatrix());
+    }
+
+    moe::VulkanCullingBatch buildBatch(const moe::Vector<moe::VulkanRenderPacket>& packets) {
+        moe::VulkanCullingBatch batch;
+        batch.reserve(packets.size());
+        for (auto& packet: packets) {
+            batch.push(packet.bounds);
+        }
+        return batch;
+    }
+}// namespace
+
+// one box at a time straight from the packets, the baseline
+MOE_BENCH_ARGS("render/culling/camera_per_packet", {100000}) {
+    auto packets = buildPackets(static_cast<size_t>(state.arg()));
+    auto frustum = cameraFrustum();
+
+    moe::Vector<uint32_t> visible;
+    visible.reserve(packets.size());
+    state.run([&]() {
+        visible.clear();
+        for (size_t i = 0; i < packets.size(); ++i) {
+            if (frustum.intersects(packets[i].bounds)) {
+                visible.push_back(static_cast<uint32_t>(i));
+            }
+        }
+        moe::Bench::doNotOptimize(visible.data());
+    });
+}
+
+MOE_BENCH_ARGS("render/culling/camera_batch", {100000}) {
+    auto packets = buildPackets(static_cast<size_t>(state.arg()));
+    auto frustum = cameraFrustum();
+    auto batch = buildBatch(packets);
+
+    moe::Vector<uint32_t> visible;
+    visible.reserve(packets.size());
+    state.run([&]() {
+        visible.clear();
+        batch.cull(frustum, visible);
+        moe::Bench::doNotOptimize(visible.data());
+    });
+}
+
+// what VulkanEngine::draw pays per frame: copy the bounds out of the packets, then cull
+MOE_BENCH_ARGS("render/culling/camera_build_and_cull", {100000}) {
+    auto packets = buildPackets(static_cast<size_t>(state.arg()));
+    auto frustum = cameraFrustum();
+
+    moe::VulkanCullingBatch batch;
+    moe::Vector<uint32_t> visible;
+    visible.reserve(packets.size());
+    state.run([&]() {
+        batch.clear();
+        batch.reserve(packets.size());
+        for (auto& packet: packets) {
+            batch.push(packet.bounds);
+        }
+        visible.clear();
+        batch.cull(frustum, visible);
+        moe::Bench::doNotOptimize(visible.data());
+    });
+}
+
+// four orthographic light frustums along the sun, one per shadow cascade
+MOE_BENCH_ARGS("render/culling/cascades_batch", {100000}) {
+    auto packets = buildPackets(static_cast<size_t>(state.arg()));
+    auto batch = buildBatch(packets);
+
+    glm::vec3 lightDir = glm::normalize(glm::vec3(-0.3f, -1.0f, -0.2f));
+    glm::mat4 lightView = glm::lookAt(-lightDir * 100.0f, glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, 1.0f));
+    moe::Array<moe::VulkanFrustum, 4> cascades;
+    for (size_t i = 0; i < cascades.size(); ++i) {
+        float halfSize = 10.0f * static_cast<float>(1 << (2 * i));
+        cascades[i] = moe::VulkanFrustum::fromViewProjection(
+                glm::ortho(-halfSize, halfSize, -halfSize, halfSize, 0.1f, 300.0f) * lightView);
+    }
+
+    moe::Array<moe::Vector<uint32_t>, 4> visible;
+    state.run([&]() {
+        for (size_t i = 0; i < cascades.size(); ++i) {
+            visible[i].clear();
+            batch.cull(cascades[i], visible[i]);
+            moe::Bench::doNotOptimize(visible[i].data());
+        }
+    });
+}
\ No newline at end of file
@@ -0,0 +1,119 @@
+#include "Bench.hpp"
+
+#include "Render/Vulkan/VulkanInstancing.hpp"
+
+#include <random>
+
+// the arg is the packet count, the crowd of VulkanEngine::draw's shadow and g-buffer passes:
+// 16 meshes in 4 materials each scattered over a 400m field, about a tenth of them inside the camera
+// compares what the cpu pays per frame before recording on either path, the gpu path then records
+// one draw per group while the cpu path records one per instanced run
+
+namespace {
+    constexpr uint32_t MESH_COUNT = 16;
+    constexpr uint32_t MATERIALS_PER_MESH = 4;
+    constexpr uint32_t CASCADE_COUNT = 4;
+    constexpr float FIELD_SIZE = 400.0f;
+
+    moe::Vector<moe::VulkanRenderPacket> buildCrowd(size_t count) {
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<uint32_t> mesh(0, MESH_COUNT - 1);
+        std::uniform_int_distribution<uint32_t> material(0, MATERIALS_PER_MESH - 1);
+        std::uniform_real_distribution<float> position(-FIELD_SIZE * 0.5f, FIELD_SIZE * 0.5f);
+
+        moe::Vector<moe::VulkanRenderPacket> packets(count);
+        for (auto& packet: packets) {
+            packet.meshId = mesh(rng);
+            packet.materialId = packet.meshId * MATERIALS_PER_MESH + material(rng);
+            glm::vec3 center{position(rng), 0.0f, position(rng)};
+            packet.transform = glm::translate(glm::mat4(1.0f), center);
+            packet.bounds = moe::VulkanBounds{center, glm::vec3(1.0f)};
+            packet.sortKey = moe::VkSortKey::make(
+                    moe::VkSortKey::Pass::Opaque, moe::VkSortKey::Pipeline::Static,
+                    packet.materialId, packet.meshId, 0);
+        }
+        return packets;
+    }
+
+    struct Views {
+        glm::mat4 camera;
+        moe::Array<glm::mat4, CASCADE_COUNT> cascades;
+    };
+
+    Views buildViews() {
+        Views views;
+        auto view = glm::lookAt(glm::vec3(0.0f, 5.0f, 0.0f), glm::vec3(50.0f, 0.0f, 50.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+        views.camera = glm::perspective(glm::radians(45.0f), 16.0f / 9.0f, 0.1f, 200.0f) * view;
+
+        glm::vec3 lightDir = glm::normalize(glm::vec3(-0.3f, -1.0f, -0.2f));
+        glm::mat4 lightView = glm::lookAt(-lightDir * 100.0f, glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, 1.0f));
+        for (size_t i = 0; i < CASCADE_COUNT; ++i) {
+            float halfSize = 10.0f * static_cast<float>(1 << (2 * i));
+            views.cascades[i] = glm::ortho(-halfSize, halfSize, -halfSize, halfSize, 0.1f, 300.0f) * lightView;
+        }
+        return views;
+    }
+}// namespace
+
+// cull, sort and group the camera and every cascade, as the cpu path does
+MOE_BENCH_ARGS("render/indirect/cpu_path", {1000, 10000, 100000}) {
+    auto packets = buildCrowd(static_cast<size_t>(state.arg()));
+    auto views = buildViews();
+
+    moe::VulkanCullingBatch batch;
+    moe::Vector<uint32_t> visible;
+    moe::Vector<uint64_t> keys;
+    moe::VulkanDrawSorter sorter;
+    moe::VulkanInstanceBatcher gBufferBatcher;
+    moe::VulkanInstanceBatcher shadowBatcher{false};
+    moe::Vector<moe::VulkanInstancedDraw> draws;
+
+    auto cullSortAndGroup = [&](const glm::mat4& viewProjection, bool shadow) {
+        visible.clear();
+        batch.cull(moe::VulkanFrustum::fromViewProjection(viewProjection), visible);
+
+        keys.clear();
+        for (auto index: visible) {
+            auto depth = moe::VkSortKey::quantizeDepth(viewProjection, packets[index].getSortPosition());
+            keys.push_back(shadow ? moe::VkSortKey::shadowDepth(packets[index].sortKey, depth)
+                                  : moe::VkSortKey::opaque(packets[index].sortKey, depth));
+        }
+        sorter.sort(keys, visible);
+
+        draws.clear();
+        for (auto index: visible) {
+            if (shadow) {
+                shadowBatcher.push(packets[index], moe::VulkanInstanceBatcher::Grouping::Mesh, draws);
+            } else {
+                gBufferBatcher.push(packets[index], moe::VulkanInstanceBatcher::Grouping::MeshAndMaterial, draws);
+            }
+        }
+        moe::Bench::doNotOptimize(draws.data());
+    };
+
+    state.run([&]() {
+        batch.clear();
+        batch.reserve(packets.size());
+        for (auto& packet: packets) {
+            batch.push(packet.bounds);
+        }
+
+        gBufferBatcher.clear();
+        shadowBatcher.clear();
+        cullSortAndGroup(views.camera, false);
+        for (auto& cascade: views.cascades) {
+            cullSortAndGroup(cascade, true);
+        }
+    });
+}
+
+// group every packet for the culling dispatch, what CullingPipeline::prepare does before its uploads
+MOE_BENCH_ARGS("render/indirect/gpu_path_prepare", {1000, 10000, 100000}) {
+    auto packets = buildCrowd(static_cast<size_t>(state.arg()));
+
+    moe::VulkanIndirectDrawBuilder builder;
+    state.run([&]() {
+        builder.build(packets);
+        moe::Bench::doNotOptimize(builder.getObjects().data());
+    });
+}
\ No newline at end of file
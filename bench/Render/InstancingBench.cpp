@@ -0,0 +1,79 @@
+#include "Bench.hpp"
+
+#include "Render/Vulkan/VulkanInstancing.hpp"
+
+#include <random>
+
+// the arg is the packet count, a crowd of pooled objects: 16 meshes in 4 materials each, no skinning
+// packets are pushed in VkSortKey order like the g-buffer pass does, so every mesh and material forms one run
+// grouped passes end with 64 draws against one per packet ungrouped, the cost measured is the cpu side batching
+
+namespace {
+    constexpr uint32_t MESH_COUNT = 16;
+    constexpr uint32_t MATERIALS_PER_MESH = 4;
+
+    moe::Vector<moe::VulkanRenderPacket> buildSortedCrowd(size_t count) {
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<uint32_t> mesh(0, MESH_COUNT - 1);
+        std::uniform_int_distribution<uint32_t> material(0, MATERIALS_PER_MESH - 1);
+        std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+        std::uniform_real_distribution<float> heading(0.0f, 6.283f);
+
+        moe::Vector<moe::VulkanRenderPacket> packets(count);
+        moe::Vector<uint64_t> keys;
+        moe::Vector<uint32_t> indices;
+        for (uint32_t i = 0; i < count; ++i) {
+            auto& packet = packets[i];
+            packet.meshId = mesh(rng);
+            packet.materialId = packet.meshId * MATERIALS_PER_MESH + material(rng);
+            packet.transform = glm::rotate(
+                    glm::translate(glm::mat4(1.0f), glm::vec3(position(rng), 0.0f, position(rng))),
+                    heading(rng), glm::vec3(0.0f, 1.0f, 0.0f));
+            keys.push_back(moe::VkSortKey::make(
+                    moe::VkSortKey::Pass::Opaque, moe::VkSortKey::Pipeline::Static,
+                    packet.materialId, packet.meshId, 0));
+            indices.push_back(i);
+        }
+
+        moe::VulkanDrawSorter sorter;
+        sorter.sort(keys, indices);
+
+        moe::Vector<moe::VulkanRenderPacket> sorted;
+        sorted.reserve(count);
+        for (auto index: indices) {
+            sorted.push_back(packets[index]);
+        }
+        return sorted;
+    }
+
+    void runBatching(moe::Bench::State& state, moe::VulkanInstanceBatcher::Grouping grouping, bool normalMatrices) {
+        auto packets = buildSortedCrowd(static_cast<size_t>(state.arg()));
+
+        moe::VulkanInstanceBatcher batcher{normalMatrices};
+        moe::Vector<moe::VulkanInstancedDraw> draws;
+        state.run([&]() {
+            batcher.clear();
+            batcher.reserve(packets.size());
+            draws.clear();
+            for (auto& packet: packets) {
+                batcher.push(packet, grouping, draws);
+            }
+            moe::Bench::doNotOptimize(draws.data());
+            moe::Bench::doNotOptimize(batcher.getInstances().data());
+        });
+    }
+}// namespace
+
+// one draw per packet, what the g-buffer pass recorded before grouping
+MOE_BENCH_ARGS("render/instancing/crowd_per_packet", {10000, 100000}) {
+    runBatching(state, moe::VulkanInstanceBatcher::Grouping::None, true);
+}
+
+MOE_BENCH_ARGS("render/instancing/crowd_mesh_and_material", {10000, 100000}) {
+    runBatching(state, moe::VulkanInstanceBatcher::Grouping::MeshAndMaterial, true);
+}
+
+// a shadow cascade, no normal matrices and no material in the grouping
+MOE_BENCH_ARGS("render/instancing/crowd_depth_only", {10000, 100000}) {
+    runBatching(state, moe::VulkanInstanceBatcher::Grouping::Mesh, false);
+}
\ No newline at end of file
@@ -0,0 +1,62 @@
+#include "Bench.hpp"
+
+#include "Render/Vulkan/VulkanRangeAllocator.hpp"
+
+#include <random>
+
+// the arg is the mesh count, vertex counts of 100 - 20000 like props up to characters
+// the arena starts small and grows by doubling, the way VulkanMeshArena does on a map load
+
+namespace {
+    moe::Vector<uint32_t> buildMeshSizes(size_t count) {
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<uint32_t> vertices(100, 20000);
+
+        moe::Vector<uint32_t> sizes(count);
+        for (auto& size: sizes) {
+            size = vertices(rng);
+        }
+        return sizes;
+    }
+
+    uint32_t allocateGrowing(moe::VulkanRangeAllocator& allocator, uint32_t count) {
+        auto offset = allocator.allocate(count);
+        while (!offset.has_value()) {
+            allocator.grow(allocator.getCapacity() * 2);
+            offset = allocator.allocate(count);
+        }
+        return offset.value();
+    }
+}// namespace
+
+MOE_BENCH_ARGS("render/arena/load_map", {1000, 10000}) {
+    auto sizes = buildMeshSizes(static_cast<size_t>(state.arg()));
+
+    state.run([&]() {
+        moe::VulkanRangeAllocator allocator(1u << 18);
+        for (auto size: sizes) {
+            moe::Bench::doNotOptimize(allocateGrowing(allocator, size));
+        }
+    });
+}
+
+// unload every other mesh, load as many back in at other sizes, then pack what is left
+MOE_BENCH_ARGS("render/arena/churn_and_compact", {1000, 10000}) {
+    auto sizes = buildMeshSizes(static_cast<size_t>(state.arg()));
+
+    moe::Vector<uint32_t> offsets(sizes.size());
+    state.run([&]() {
+        moe::VulkanRangeAllocator allocator(1u << 18);
+        for (size_t i = 0; i < sizes.size(); ++i) {
+            offsets[i] = allocateGrowing(allocator, sizes[i]);
+        }
+        for (size_t i = 0; i < sizes.size(); i += 2) {
+            allocator.free(offsets[i]);
+        }
+        for (size_t i = 0; i < sizes.size(); i += 2) {
+            offsets[i] = allocateGrowing(allocator, sizes[sizes.size() - 1 - i]);
+        }
+        auto moves = allocator.compact();
+        moe::Bench::doNotOptimize(moves.data());
+    });
+}
\ No newline at end of file
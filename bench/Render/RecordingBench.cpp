@@ -0,0 +1,199 @@
+#include "Bench.hpp"
+
+#include "Core/Task/ParallelFor.hpp"
+#include "Math/Common.hpp"
+#include "Render/Vulkan/VulkanParallelRecording.hpp"
+
+#include <cstring>
+#include <random>
+
+// the arg is the number of threads recording, the render thread included, moe-bench runs 4 workers
+// a heavy frame's cpu recording: 20000 g-buffer draws in chunks, 4 shadow cascades of 5000 draws and 2000 sprites,
+// split the way the pipelines split them for VulkanCommandRecorder
+// a command buffer is stood in for by a byte stream every command is encoded into, what a driver does when recording,
+// per slot streams are cleared and refilled like command pools reset each frame, the gpu side is not measured
+
+namespace {
+    constexpr uint32_t MESH_COUNT = 256;
+    constexpr size_t GBUFFER_DRAWS = 20000;
+    constexpr uint32_t CASCADE_COUNT = 4;
+    constexpr size_t CASCADE_DRAWS = 5000;
+    constexpr size_t SPRITES = 2000;
+    // VulkanCommandRecorder::MIN_DRAWS_PER_CHUNK
+    constexpr size_t MIN_DRAWS_PER_CHUNK = 64;
+
+    struct Mesh {
+        uint64_t indexBuffer;
+        uint64_t vertexBufferAddr;
+        uint32_t indexCount;
+        uint32_t firstIndex;
+    };
+
+    struct Draw {
+        uint32_t meshId;
+        uint32_t materialId;
+        uint32_t firstInstance;
+        uint32_t instanceCount;
+    };
+
+    struct CommandStream {
+        moe::Vector<uint8_t> bytes;
+
+        template<typename T>
+        void push(uint32_t opcode, const T& payload) {
+            auto offset = bytes.size();
+            bytes.resize(offset + sizeof(uint32_t) + sizeof(T));
+            std::memcpy(bytes.data() + offset, &opcode, sizeof(uint32_t));
+            std::memcpy(bytes.data() + offset + sizeof(uint32_t), &payload, sizeof(T));
+        }
+    };
+
+    // one pool per slot, streams stay allocated across frames and are handed out again after the reset
+    struct SlotPool {
+        moe::Vector<CommandStream> streams;
+        size_t used{0};
+
+        CommandStream& acquire() {
+            if (used == streams.size()) {
+                streams.emplace_back();
+            }
+            auto& stream = streams[used++];
+            stream.bytes.clear();
+            return stream;
+        }
+    };
+
+    struct Scene {
+        moe::UnorderedMap<uint32_t, Mesh> meshes;
+        moe::Vector<Draw> gBufferDraws;
+        moe::Array<moe::Vector<Draw>, CASCADE_COUNT> cascadeDraws;
+        moe::Vector<glm::mat4> sprites;
+        glm::mat4 viewProjection{1.0f};
+    };
+
+    Scene buildScene() {
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<uint32_t> mesh(0, MESH_COUNT - 1);
+        std::uniform_int_distribution<uint32_t> instances(1, 4);
+        std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+
+        Scene scene;
+        for (uint32_t i = 0; i < MESH_COUNT; ++i) {
+            scene.meshes[i] = Mesh{1, 0x10000ull * i, 3000 + i, 4000 * i};
+        }
+
+        auto buildDraws = [&](size_t count) {
+            moe::Vector<Draw> draws(count);
+            uint32_t firstInstance = 0;
+            for (auto& draw: draws) {
+                draw.meshId = mesh(rng);
+                draw.materialId = draw.meshId * 4 + (firstInstance & 3);
+                draw.firstInstance = firstInstance;
+                draw.instanceCount = instances(rng);
+                firstInstance += draw.instanceCount;
+            }
+            return draws;
+        };
+        scene.gBufferDraws = buildDraws(GBUFFER_DRAWS);
+        for (auto& draws: scene.cascadeDraws) {
+            draws = buildDraws(CASCADE_DRAWS);
+        }
+
+        scene.sprites.resize(SPRITES);
+        for (auto& sprite: scene.sprites) {
+            sprite = glm::translate(glm::mat4(1.0f), glm::vec3(position(rng), position(rng), 0.0f));
+        }
+        return scene;
+    }
+
+    // the state a secondary inherits nothing of: pipeline, descriptor set, viewport and scissor
+    void bindState(CommandStream& stream) {
+        stream.push(0, uint64_t{1});
+        stream.push(1, moe::Array<uint64_t, 2>{1, 0});
+        stream.push(2, glm::vec4(0.0f, 0.0f, 1920.0f, 1080.0f));
+        stream.push(3, glm::ivec4(0, 0, 1920, 1080));
+    }
+
+    // the loop of GBufferPipeline::draw and CSMPipeline::draw over a range of draws
+    void recordDraws(CommandStream& stream, const Scene& scene, const moe::Vector<Draw>& draws, moe::VkParallel::ChunkRange range) {
+        struct PushConstants {
+            glm::mat4 viewProjection;
+            uint64_t instanceBufferAddr;
+            uint64_t vertexBufferAddr;
+            uint32_t materialId;
+        };
+
+        bindState(stream);
+        uint64_t boundIndexBuffer = 0;
+        for (size_t i = range.begin; i < range.end; ++i) {
+            auto& draw = draws[i];
+            auto it = scene.meshes.find(draw.meshId);
+            if (it == scene.meshes.end()) {
+                continue;
+            }
+            auto mesh = it->second;
+            if (mesh.indexBuffer != boundIndexBuffer) {
+                boundIndexBuffer = mesh.indexBuffer;
+                stream.push(4, boundIndexBuffer);
+            }
+            stream.push(5, PushConstants{scene.viewProjection, 0x1000, mesh.vertexBufferAddr, draw.materialId});
+            stream.push(6, moe::Array<uint32_t, 4>{mesh.indexCount, draw.instanceCount, mesh.firstIndex, draw.firstInstance});
+        }
+    }
+
+    // the loop of SpritePipeline::draw, one draw per sprite
+    void recordSprites(CommandStream& stream, const Scene& scene, moe::VkParallel::ChunkRange range) {
+        bindState(stream);
+        for (size_t i = range.begin; i < range.end; ++i) {
+            stream.push(5, scene.viewProjection * scene.sprites[i]);
+            stream.push(4, uint64_t{1});
+            stream.push(6, moe::Array<uint32_t, 4>{6, 1, 0, 0});
+        }
+    }
+}// namespace
+
+// a whole frame's recordable passes, each pass recorded at once across the threads and then "executed" in order
+MOE_BENCH_ARGS("render/recording/frame", {1, 2, 4}) {
+    auto& scheduler = moe::ThreadPoolScheduler::getInstance();
+    auto threads = static_cast<uint32_t>(state.arg());
+    auto scene = buildScene();
+
+    moe::Vector<SlotPool> pools(threads);
+    moe::Vector<CommandStream*> recorded;
+    uint64_t recordedBytes = 0;
+
+    auto record = [&](uint32_t chunks, const moe::Function<void(CommandStream&, uint32_t)>& fn) {
+        recorded.assign(chunks, nullptr);
+        moe::parallelFor(scheduler, threads, chunks, [&](uint32_t slot, uint32_t chunk) {
+            auto& stream = pools[slot].acquire();
+            fn(stream, chunk);
+            recorded[chunk] = &stream;
+        });
+        for (auto* stream: recorded) {
+            recordedBytes += stream->bytes.size();
+        }
+    };
+
+    state.run([&]() {
+        for (auto& pool: pools) {
+            pool.used = 0;
+        }
+
+        record(CASCADE_COUNT, [&](CommandStream& stream, uint32_t cascade) {
+            auto& draws = scene.cascadeDraws[cascade];
+            recordDraws(stream, scene, draws, {0, draws.size()});
+        });
+
+        auto gBufferChunks = moe::VkParallel::chunkCount(scene.gBufferDraws.size(), MIN_DRAWS_PER_CHUNK, threads);
+        record(gBufferChunks, [&](CommandStream& stream, uint32_t chunk) {
+            recordDraws(stream, scene, scene.gBufferDraws, moe::VkParallel::chunkRange(scene.gBufferDraws.size(), gBufferChunks, chunk));
+        });
+
+        auto spriteChunks = moe::VkParallel::chunkCount(scene.sprites.size(), MIN_DRAWS_PER_CHUNK, threads);
+        record(spriteChunks, [&](CommandStream& stream, uint32_t chunk) {
+            recordSprites(stream, scene, moe::VkParallel::chunkRange(scene.sprites.size(), spriteChunks, chunk));
+        });
+
+        moe::Bench::doNotOptimize(recordedBytes);
+    });
+}
\ No newline at end of file
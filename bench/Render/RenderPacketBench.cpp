@@ -0,0 +1,71 @@
+#include "Bench.hpp"
+
+#include "Render/Vulkan/VulkanScene.hpp"
+
+namespace {
+    constexpr size_t NODES_PER_SCENE = 16;
+    constexpr size_t PRIMITIVES_PER_MESH = 2;
+
+    // a small gltf-like scene: one root node with a shallow tree of mesh nodes below it
+    moe::UniquePtr<moe::VulkanScene> buildScene(size_t seed) {
+        auto scene = std::make_unique<moe::VulkanScene>();
+
+        for (size_t m = 0; m < NODES_PER_SCENE; ++m) {
+            moe::VulkanSceneMesh mesh;
+            for (size_t p = 0; p < PRIMITIVES_PER_MESH; ++p) {
+                mesh.primitives.push_back(static_cast<moe::MeshId>(seed * 64 + m * PRIMITIVES_PER_MESH + p));
+                mesh.primitiveMaterials.push_back(static_cast<moe::MaterialId>(p));
+            }
+            scene->meshes.push_back(std::move(mesh));
+        }
+
+        auto root = std::make_unique<moe::VulkanSceneNode>();
+        root->parent = scene.get();
+        root->resourceInternalId = 0;
+
+        moe::VulkanSceneNode* group = nullptr;
+        for (size_t n = 1; n < NODES_PER_SCENE; ++n) {
+            auto node = std::make_unique<moe::VulkanSceneNode>();
+            node->resourceInternalId = static_cast<moe::SceneResourceInternalId>(n);
+            node->localTransform = glm::translate(glm::mat4(1.0f), glm::vec3(0.1f * n, 0.0f, 0.0f));
+
+            // every fourth node starts a new group, the rest hang below it
+            if (n % 4 == 1) {
+                node->parent = root.get();
+                group = node.get();
+                root->children.push_back(std::move(node));
+            } else {
+                node->parent = group;
+                group->children.push_back(std::move(node));
+            }
+        }
+
+        scene->children.push_back(std::move(root));
+        return scene;
+    }
+}// namespace
+
+// mirrors the render packet loop in VulkanEngine::draw:
+// per render command, update the transform hierarchy and gather its packets
+MOE_BENCH_ARGS("render/scene/gather_render_packets", {16, 256}) {
+    auto objectCount = static_cast<size_t>(state.arg());
+
+    moe::Vector<moe::UniquePtr<moe::VulkanScene>> scenes;
+    moe::Vector<glm::mat4> transforms;
+    for (size_t i = 0; i < objectCount; ++i) {
+        scenes.push_back(buildScene(i));
+        transforms.push_back(glm::translate(glm::mat4(1.0f), glm::vec3(static_cast<float>(i), 0.0f, 0.0f)));
+    }
+
+    moe::Vector<moe::VulkanRenderPacket> packets;
+    state.run([&]() {
+        // the render target keeps its capacity across frames
+        packets.clear();
+        for (size_t i = 0; i < objectCount; ++i) {
+            moe::VulkanDrawContext ctx = moe::NULL_DRAW_CONTEXT;
+            scenes[i]->updateTransform(transforms[i]);
+            scenes[i]->gatherRenderPackets(packets, ctx);
+        }
+        moe::Bench::doNotOptimize(packets.data());
+    });
+}
\ No newline at end of file
@@ -0,0 +1,68 @@
+#include "Bench.hpp"
+
+#include "Render/Vulkan/VulkanSkeleton.hpp"
+
+namespace {
+    constexpr size_t KEY_FRAME_COUNT = 48;
+    constexpr float ANIMATION_LENGTH_SECS = 2.0f;
+
+    // binary tree of joints, every joint animated on all three channels
+    void buildSkeleton(
+            size_t jointCount,
+            moe::VulkanSkeleton& skeleton,
+            moe::VulkanSkeletonAnimation& animation) {
+        skeleton.hierarchy.resize(jointCount);
+        skeleton.inverseBindMatrices.resize(jointCount);
+        skeleton.joints.resize(jointCount);
+        skeleton.jointNames.resize(jointCount);
+
+        animation.tracks.resize(jointCount);
+        animation.loop = true;
+        animation.startFrame = 0;
+        animation.name = "bench";
+
+        for (size_t i = 0; i < jointCount; ++i) {
+            auto id = static_cast<moe::JointId>(i);
+            skeleton.joints[i] = {id, glm::mat4(1.0f)};
+            skeleton.inverseBindMatrices[i] = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, -0.1f * i, 0.0f));
+            skeleton.jointNames[i] = fmt::format("joint_{}", i);
+            if (i > 0) {
+                skeleton.hierarchy[(i - 1) / 2].children.push_back(id);
+            }
+
+            auto& track = animation.tracks[i];
+            for (size_t k = 0; k < KEY_FRAME_COUNT; ++k) {
+                float t = ANIMATION_LENGTH_SECS * static_cast<float>(k) / static_cast<float>(KEY_FRAME_COUNT - 1);
+                float phase = t + 0.1f * static_cast<float>(i);
+
+                track.translations.push_back(glm::vec3(0.0f, 0.1f, 0.01f * glm::sin(phase)));
+                track.rotations.push_back(glm::angleAxis(0.3f * glm::sin(phase), glm::vec3(1.0f, 0.0f, 0.0f)));
+                track.scales.push_back(glm::vec3(1.0f));
+
+                track.keyTimes.translations.push_back(t);
+                track.keyTimes.rotations.push_back(t);
+                track.keyTimes.scales.push_back(t);
+            }
+        }
+    }
+}// namespace
+
+// the per-character cpu work of the skinning path in VulkanEngine::draw
+MOE_BENCH_ARGS("render/skeleton/joint_matrices", {32, 128}) {
+    moe::VulkanSkeleton skeleton;
+    moe::VulkanSkeletonAnimation animation;
+    buildSkeleton(static_cast<size_t>(state.arg()), skeleton, animation);
+
+    moe::Vector<glm::mat4> jointMatrices;
+    float time = 0.0f;
+
+    state.run([&]() {
+        time += 1.0f / 144.0f;
+        if (time > ANIMATION_LENGTH_SECS) {
+            time -= ANIMATION_LENGTH_SECS;
+        }
+
+        moe::calculateJointMatrices(jointMatrices, skeleton, animation, time);
+        moe::Bench::doNotOptimize(jointMatrices.data());
+    });
+}
\ No newline at end of file
@@ -0,0 +1,129 @@
+#include "Bench.hpp"
+
+#include "Render/Vulkan/VulkanRenderable.hpp"
+
+#include <algorithm>
+#include <random>
+
+// the arg is the packet count, spread over 64 materials and 512 meshes with a tenth of them skinned
+// every operation sorts a fresh copy of the keys, the copy is part of the cost in all cases
+
+namespace {
+    constexpr uint32_t MATERIAL_COUNT = 64;
+    constexpr uint32_t MESH_COUNT = 512;
+
+    moe::Vector<moe::VulkanRenderPacket> buildPackets(size_t count) {
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<uint32_t> material(0, MATERIAL_COUNT - 1);
+        std::uniform_int_distribution<uint32_t> mesh(0, MESH_COUNT - 1);
+        std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+
+        moe::Vector<moe::VulkanRenderPacket> packets(count);
+        for (size_t i = 0; i < count; ++i) {
+            auto& packet = packets[i];
+            packet.meshId = mesh(rng);
+            packet.materialId = material(rng);
+            packet.skinned = i % 10 == 0;
+            packet.transform = glm::translate(glm::mat4(1.0f), glm::vec3(position(rng), 0.0f, position(rng)));
+            packet.bounds = moe::VulkanBounds{glm::vec3(packet.transform[3]), glm::vec3(1.0f)};
+            packet.sortKey = moe::VkSortKey::make(
+                    moe::VkSortKey::Pass::Opaque,
+                    packet.skinned ? moe::VkSortKey::Pipeline::Skinned : moe::VkSortKey::Pipeline::Static,
+                    packet.materialId, packet.meshId, 0);
+        }
+        return packets;
+    }
+
+    glm::mat4 cameraViewProjection() {
+        auto view = glm::lookAt(glm::vec3(0.0f, 10.0f, 0.0f), glm::vec3(50.0f, 0.0f, 50.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+        return glm::perspective(glm::radians(45.0f), 16.0f / 9.0f, 0.1f, 300.0f) * view;
+    }
+
+    moe::Vector<uint64_t> buildOpaqueKeys(const moe::Vector<moe::VulkanRenderPacket>& packets) {
+        auto viewProjection = cameraViewProjection();
+        moe::Vector<uint64_t> keys;
+        keys.reserve(packets.size());
+        for (auto& packet: packets) {
+            keys.push_back(moe::VkSortKey::opaque(packet.sortKey, moe::VkSortKey::quantizeDepth(viewProjection, packet.getSortPosition())));
+        }
+        return keys;
+    }
+}// namespace
+
+// the comparison sort the radix sort replaces
+MOE_BENCH_ARGS("render/sort/opaque_std_stable_sort", {10000, 100000}) {
+    auto packets = buildPackets(static_cast<size_t>(state.arg()));
+    auto keys = buildOpaqueKeys(packets);
+
+    moe::Vector<std::pair<uint64_t, uint32_t>> pairs;
+    state.run([&]() {
+        pairs.clear();
+        for (uint32_t i = 0; i < keys.size(); ++i) {
+            pairs.emplace_back(keys[i], i);
+        }
+        std::stable_sort(pairs.begin(), pairs.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+        moe::Bench::doNotOptimize(pairs.data());
+    });
+}
+
+MOE_BENCH_ARGS("render/sort/opaque_radix", {10000, 100000}) {
+    auto packets = buildPackets(static_cast<size_t>(state.arg()));
+    auto keys = buildOpaqueKeys(packets);
+
+    moe::VulkanDrawSorter sorter;
+    moe::Vector<uint64_t> sortKeys;
+    moe::Vector<uint32_t> indices;
+    state.run([&]() {
+        sortKeys.assign(keys.begin(), keys.end());
+        indices.resize(keys.size());
+        for (uint32_t i = 0; i < indices.size(); ++i) {
+            indices[i] = i;
+        }
+        sorter.sort(sortKeys, indices);
+        moe::Bench::doNotOptimize(indices.data());
+    });
+}
+
+// what VulkanEngine::draw pays for the g-buffer pass: depth and key per packet, then the sort
+MOE_BENCH_ARGS("render/sort/opaque_build_keys_and_radix", {10000, 100000}) {
+    auto packets = buildPackets(static_cast<size_t>(state.arg()));
+    auto viewProjection = cameraViewProjection();
+
+    moe::VulkanDrawSorter sorter;
+    moe::Vector<uint64_t> sortKeys;
+    moe::Vector<uint32_t> indices;
+    state.run([&]() {
+        sortKeys.clear();
+        indices.clear();
+        for (uint32_t i = 0; i < packets.size(); ++i) {
+            auto& packet = packets[i];
+            sortKeys.push_back(moe::VkSortKey::opaque(packet.sortKey, moe::VkSortKey::quantizeDepth(viewProjection, packet.getSortPosition())));
+            indices.push_back(i);
+        }
+        sorter.sort(sortKeys, indices);
+        moe::Bench::doNotOptimize(indices.data());
+    });
+}
+
+// the shadow policy drops the material, so the sort skips the digits that held it
+MOE_BENCH_ARGS("render/sort/shadow_build_keys_and_radix", {10000, 100000}) {
+    auto packets = buildPackets(static_cast<size_t>(state.arg()));
+    auto lightViewProjection =
+            glm::ortho(-100.0f, 100.0f, -100.0f, 100.0f, 0.1f, 300.0f)
+            * glm::lookAt(glm::vec3(0.0f, 150.0f, 0.0f), glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, 1.0f));
+
+    moe::VulkanDrawSorter sorter;
+    moe::Vector<uint64_t> sortKeys;
+    moe::Vector<uint32_t> indices;
+    state.run([&]() {
+        sortKeys.clear();
+        indices.clear();
+        for (uint32_t i = 0; i < packets.size(); ++i) {
+            auto& packet = packets[i];
+            sortKeys.push_back(moe::VkSortKey::shadowDepth(packet.sortKey, moe::VkSortKey::quantizeDepth(lightViewProjection, packet.getSortPosition())));
+            indices.push_back(i);
+        }
+        sorter.sort(sortKeys, indices);
+        moe::Bench::doNotOptimize(indices.data());
+    });
+}
\ No newline at end of file
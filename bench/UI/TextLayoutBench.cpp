@@ -0,0 +1,39 @@
+#include "Bench.hpp"
+
+#include "UI/TextWidget.hpp"
+
+namespace {
+    moe::U32String makeText(size_t length) {
+        static constexpr std::u32string_view SAMPLE =
+                U"The quick brown fox jumps over the lazy dog. "
+                U"こんにちは世界. ";
+
+        moe::U32String text;
+        text.reserve(length);
+        while (text.size() < length) {
+            text += SAMPLE.substr(0, std::min(SAMPLE.size(), length - text.size()));
+        }
+        return text;
+    }
+}// namespace
+
+// line breaking of the base text widget, the part of text layout that needs no font atlas
+MOE_BENCH_ARGS("ui/text/layout", {64, 1024}) {
+    moe::TextWidget widget(makeText(static_cast<size_t>(state.arg())), 16.0f);
+
+    state.run([&]() {
+        widget.layout(moe::LayoutRect{0.0f, 0.0f, 480.0f, 4096.0f});
+        moe::Bench::doNotOptimize(widget.lines().size());
+    });
+}
+
+MOE_BENCH_ARGS("ui/text/preferred_size", {64, 1024}) {
+    moe::TextWidget widget(makeText(static_cast<size_t>(state.arg())), 16.0f);
+    moe::LayoutConstraints constraints;
+    constraints.maxWidth = 480.0f;
+    constraints.maxHeight = 4096.0f;
+
+    state.run([&]() {
+        moe::Bench::doNotOptimize(widget.preferredSize(constraints));
+    });
+}
\ No newline at end of file
@@ -0,0 +1,116 @@
+#include "Bench.hpp"
+
+#include "Core/Task/Scheduler.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace {
+    void printUsage() {
+        fmt::print(
+                "usage:\n"
+                "  moe-bench [options]                    run benchmarks\n"
+                "  moe-bench --compare <base> <new>       compare two result files\n"
+                "\n"
+                "options:\n"
+                "  --filter <text>        only run cases whose name contains <text>\n"
+                "  --samples <n>          measured samples per case (default 100)\n"
+                "  --warmup <n>           discarded warmup samples per case (default 10)\n"
+                "  --min-sample-us <n>    minimum duration of one sample (default 200)\n"
+                "  --quick                few short samples, for smoke testing\n"
+                "  --json <path>          write results as json\n"
+                "  --baseline <path>      compare the results of this run against <path>\n"
+                "  --threshold <percent>  median slowdown counted as regression (default 5)\n"
+                "  --list                 list all cases\n");
+    }
+}// namespace
+
+int main(int argc, char** argv) {
+    moe::Bench::Options options;
+    moe::String jsonPath;
+    moe::String baselinePath;
+    moe::String comparePaths[2];
+    bool compareOnly = false;
+    bool listOnly = false;
+    double thresholdPercent = 5.0;
+
+    for (int i = 1; i < argc; ++i) {
+        moe::StringView arg = argv[i];
+        auto next = [&]() -> moe::StringView {
+            if (i + 1 >= argc) {
+                fmt::print(stderr, "missing value for {}\n", arg);
+                std::exit(2);
+            }
+            return argv[++i];
+        };
+
+        if (arg == "--filter") {
+            options.filter = moe::String(next());
+        } else if (arg == "--samples") {
+            options.samples = std::max<size_t>(1, std::strtoull(next().data(), nullptr, 10));
+        } else if (arg == "--warmup") {
+            options.warmupSamples = std::strtoull(next().data(), nullptr, 10);
+        } else if (arg == "--min-sample-us") {
+            options.minSampleNs = std::strtoull(next().data(), nullptr, 10) * 1000;
+        } else if (arg == "--quick") {
+            options.samples = 5;
+            options.warmupSamples = 1;
+            options.minSampleNs = 20'000;
+        } else if (arg == "--json") {
+            jsonPath = moe::String(next());
+        } else if (arg == "--baseline") {
+            baselinePath = moe::String(next());
+        } else if (arg == "--threshold") {
+            thresholdPercent = std::strtod(next().data(), nullptr);
+        } else if (arg == "--compare") {
+            comparePaths[0] = moe::String(next());
+            comparePaths[1] = moe::String(next());
+            compareOnly = true;
+        } else if (arg == "--list") {
+            listOnly = true;
+        } else {
+            printUsage();
+            return arg == "--help" || arg == "-h" ? 0 : 2;
+        }
+    }
+
+    if (listOnly) {
+        for (auto& benchCase: moe::Bench::getSortedCases()) {
+            fmt::print("{}\n", benchCase.name);
+        }
+        return 0;
+    }
+
+    if (compareOnly) {
+        auto baseline = moe::Bench::readJson(comparePaths[0]);
+        auto current = moe::Bench::readJson(comparePaths[1]);
+        if (!baseline || !current) {
+            return 2;
+        }
+        return moe::Bench::compare(*baseline, *current, thresholdPercent) > 0 ? 1 : 0;
+    }
+
+    // keep the worker count fixed, so results are comparable across machines with more cores
+    moe::ThreadPoolScheduler::init(4);
+    moe::MainScheduler::getInstance().init();
+
+    auto results = moe::Bench::runAll(options);
+
+    moe::MainScheduler::getInstance().shutdown();
+    moe::ThreadPoolScheduler::shutdown();
+
+    if (!jsonPath.empty() && !moe::Bench::writeJson(jsonPath, results, options)) {
+        return 2;
+    }
+
+    if (!baselinePath.empty()) {
+        auto baseline = moe::Bench::readJson(baselinePath);
+        if (!baseline) {
+            return 2;
+        }
+        fmt::print("\n");
+        return moe::Bench::compare(*baseline, results, thresholdPercent) > 0 ? 1 : 0;
+    }
+
+    return 0;
+}
\ No newline at end of file
@@ -8,9 +8,13 @@
 #include "Input.hpp"
 #include "Localization.hpp"
 #include "Param.hpp"
+#include "PhysicsConfig.hpp"
 
 
 #include "Core/FileReader.hpp"
+#include "Core/FileWriter.hpp"
+#include "Core/Memory.hpp"
+#include "Core/Profiler.hpp"
 #include "Core/Task/Scheduler.hpp"
 
 #ifndef NDEBUG
@@ -32,8 +36,19 @@ namespace game {
 
     static ParamS PROJECT_NAME("project.name", "Operation Theta Force", ParamScope::System);
 
+    // 0 means unlimited; the render rate only matters when it is below the update rate
+    static ParamF UPDATE_RATE_HZ("frame_pacing.update_rate_hz", 0.0f, ParamScope::UserConfig);
+    static ParamF RENDER_RATE_HZ("frame_pacing.render_rate_hz", 0.0f, ParamScope::UserConfig);
+    static ParamF LIMITER_SPIN_WINDOW_MS("frame_pacing.spin_window_ms", 1.5f, ParamScope::UserConfig);
+    // written on shutdown when set, for automated runs
+    static ParamS FRAME_STATS_EXPORT_PATH("frame_pacing.stats_export_path", "", ParamScope::UserConfig);
+
+    // logs per-tag memory usage every n seconds, 0 disables the dump
+    static ParamF MEMORY_DUMP_INTERVAL_SECS("debug.memory_dump_interval_secs", 0.0f, ParamScope::UserConfig);
+
     void App::init() {
         moe::Logger::setThreadName("Graphics");
+        MOE_PROFILE_THREAD("Graphics");
 
         moe::Logger::info(
                 "Initializing Application...\n"
@@ -74,7 +89,7 @@ namespace game {
         });
 
         m_physicsEngine = &moe::PhysicsEngine::getInstance();
-        m_physicsEngine->init();
+        m_physicsEngine->init(loadPhysicsInitializers());
 
         m_gameManager = std::make_unique<game::GameManager>(this);
 
@@ -95,6 +110,10 @@ namespace game {
     }
 
     void App::shutdown() {
+        if (!FRAME_STATS_EXPORT_PATH.get().empty()) {
+            exportFrameStats(FRAME_STATS_EXPORT_PATH.get());
+        }
+
         m_networkAdaptor->shutdown();
         m_graphicsEngine->cleanup();
         m_physicsEngine->destroy();
@@ -112,9 +131,60 @@ namespace game {
         moe::Logger::info("Application shutdown complete. Bye!");
     }
 
+    bool App::exportFrameStats(moe::StringView path) const {
+        auto json = fmt::format(
+                "{{\"update\":{},\"render\":{}}}",
+                m_updateFrameStats.toJson("update"),
+                m_renderFrameStats.toJson("render"));
+
+        if (!moe::FileWriter::writeToFile(path, json)) {
+            moe::Logger::error("Failed to export frame stats to {}", path);
+            return false;
+        }
+
+        moe::Logger::info("Frame stats exported to {}", path);
+        return true;
+    }
+
+    void App::applyFramePacingParams() {
+        auto spinWindow = std::chrono::duration_cast<moe::FrameLimiter::Clock::duration>(
+                std::chrono::duration<float, std::milli>(LIMITER_SPIN_WINDOW_MS.get()));
+
+        m_updateLimiter.setTargetRate(UPDATE_RATE_HZ.get());
+        m_updateLimiter.setSpinWindow(spinWindow);
+        m_renderLimiter.setTargetRate(RENDER_RATE_HZ.get());
+
+        auto periodMs = [](const moe::FrameLimiter& limiter) {
+            return std::chrono::duration<float, std::milli>(limiter.getTargetPeriod()).count();
+        };
+
+        m_updateFrameStats.setTargetMs(periodMs(m_updateLimiter));
+        // a render rate above the update rate is capped by the update rate
+        m_renderFrameStats.setTargetMs(std::max(periodMs(m_renderLimiter), periodMs(m_updateLimiter)));
+    }
+
+    void App::updateMemoryStats() {
+        constexpr auto RATE_SAMPLE_INTERVAL = std::chrono::seconds(1);
+
+        auto now = std::chrono::steady_clock::now();
+        if (now - m_lastMemorySampleTime >= RATE_SAMPLE_INTERVAL) {
+            moe::Memory::sampleRates();
+            m_lastMemorySampleTime = now;
+        }
+
+        auto dumpInterval = MEMORY_DUMP_INTERVAL_SECS.get();
+        if (dumpInterval > 0.0f && now - m_lastMemoryDumpTime >= std::chrono::duration<float>(dumpInterval)) {
+            moe::Memory::logStats();
+            m_lastMemoryDumpTime = now;
+        }
+    }
+
     void App::run() {
+        moe::Timing::HighResolutionTimerScope timerResolution;
+
         bool running = true;
         auto lastTime = std::chrono::high_resolution_clock::now();
+        moe::Optional<moe::FrameLimiter::Clock::time_point> lastRenderTime;
 
         auto worldEnv = moe::Ref(new State::WorldEnvironment());
         m_gameManager->addPersistGameState(worldEnv);
@@ -126,7 +196,18 @@ namespace game {
         m_gameManager->pushState(splashScreenState);
 
         while (running) {
-            m_graphicsEngine->beginFrame();
+            MOE_PROFILE_SCOPE("Frame");
+
+            applyFramePacingParams();
+            {
+                MOE_PROFILE_SCOPE("Frame limiter");
+                m_updateLimiter.wait();
+            }
+
+            auto frameStart = moe::FrameLimiter::Clock::now();
+            bool shouldRender = m_renderLimiter.poll(frameStart);
+
+            m_graphicsEngine->beginFrame(shouldRender);
 
             // reset key events, remove unused events
             m_input->update();
@@ -148,21 +229,39 @@ namespace game {
 
             // switch read buffer
             m_physicsEngine->updateReadBuffer();
-            m_gameManager->update(deltaTime);
+            {
+                MOE_MEMORY_TAG(Game);
+                m_gameManager->update(deltaTime);
+            }
 
-            m_graphicsEngine->endFrame();
+            if (shouldRender) {
+                MOE_PROFILE_SCOPE("VulkanEngine::endFrame");
+                m_graphicsEngine->endFrame();
+            }
 
             // update stats
             {
                 float frameTimeMs = deltaTime * 1000.0f;
                 m_stats.frameTimeMs = frameTimeMs;
                 m_stats.fps = 1.0f / deltaTime;
+
+                m_updateFrameStats.push(frameTimeMs);
+                if (shouldRender) {
+                    if (lastRenderTime.has_value()) {
+                        m_renderFrameStats.push(std::chrono::duration<float, std::milli>(frameStart - *lastRenderTime).count());
+                    }
+                    lastRenderTime = frameStart;
+                }
             }
 
+            updateMemoryStats();
+
             // check exit request
             if (m_isExitRequested.load()) {
                 running = false;
             }
+
+            MOE_PROFILE_FRAME();
         }
     }
 }// namespace game
\ No newline at end of file
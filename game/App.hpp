@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Audio/AudioEngine.hpp"
+#include "Core/FrameLimiter.hpp"
 #include "Physics/PhysicsEngine.hpp"
 #include "Render/Vulkan/VulkanEngine.hpp"
 
@@ -28,6 +29,19 @@ namespace game {
 
         const Stats& getStats() const { return m_stats; }
 
+        // time between main loop iterations
+        const moe::FrameTimeStats& getUpdateFrameStats() const { return m_updateFrameStats; }
+
+        // time between presented frames, equal to the update stats unless a lower render rate is set
+        const moe::FrameTimeStats& getRenderFrameStats() const { return m_renderFrameStats; }
+
+        void resetFrameStats() {
+            m_updateFrameStats.reset();
+            m_renderFrameStats.reset();
+        }
+
+        bool exportFrameStats(moe::StringView path) const;
+
         void requestExit() {
             m_isExitRequested.store(true);
         }
@@ -44,6 +58,19 @@ namespace game {
 
         Stats m_stats;
 
+        // the update limiter paces the main loop, the render limiter decides which iterations present a frame
+        moe::FrameLimiter m_updateLimiter;
+        moe::FrameLimiter m_renderLimiter;
+        moe::FrameTimeStats m_updateFrameStats;
+        moe::FrameTimeStats m_renderFrameStats;
+
+        void applyFramePacingParams();
+
+        std::chrono::steady_clock::time_point m_lastMemorySampleTime{};
+        std::chrono::steady_clock::time_point m_lastMemoryDumpTime{};
+
+        void updateMemoryStats();
+
         std::atomic_bool m_isExitRequested{false};
     };
 }// namespace game
\ No newline at end of file
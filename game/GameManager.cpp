@@ -1,6 +1,7 @@
 #include "GameManager.hpp"
 #include "App.hpp"
 
+#include "Core/Profiler.hpp"
 #include "Render/Vulkan/VulkanEngine.hpp"
 
 namespace game {
@@ -99,6 +100,8 @@ namespace game {
     }
 
     void GameManager::update(float deltaTimeSecs) {
+        MOE_PROFILE_FUNCTION();
+
         bool diff = processPendingActions();
 
         if (m_gameStateStack.empty()) return;
@@ -121,6 +124,8 @@ namespace game {
     }
 
     void GameManager::physicsUpdate(float deltaTimeSecs) {
+        MOE_PROFILE_FUNCTION();
+
         moe::Vector<moe::Ref<game::GameState>> stackCopy;
         {
             std::lock_guard<std::mutex> lock(m_gameStateStackCopyMutex);
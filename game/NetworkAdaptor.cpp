@@ -1,5 +1,7 @@
 #include "NetworkAdaptor.hpp"
 
+#include "Core/Profiler.hpp"
+
 #include <enet/types.h>
 
 namespace game {
@@ -166,6 +168,8 @@ namespace game {
 
     void NetworkAdaptor::networkMain() {
         moe::Logger::setThreadName("Network");
+        MOE_PROFILE_THREAD("Network");
+        moe::Memory::setThreadTag(moe::MemoryTag::Network);
         moe::Logger::info("Network thread started");
 
         if (enet_initialize() != 0) {
@@ -189,10 +193,12 @@ namespace game {
         while (m_running) {
             ENetEvent event;
             while (enet_host_service(m_client, &event, NETWORK_LOOP_TIME_WAIT_MS) > 0) {
+                MOE_PROFILE_SCOPE("NetworkAdaptor::handleEnetEvent");
                 handleEnetEvent(event);
             }
 
             // process send requests
+            MOE_PROFILE_SCOPE("NetworkAdaptor::handleEnetSendRequest");
             handleEnetSendRequest();
         }
 
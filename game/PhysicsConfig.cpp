@@ -0,0 +1,126 @@
+#include "PhysicsConfig.hpp"
+
+#include "Param.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <limits>
+
+namespace game {
+    static ParamF PHYSICS_SPIN_WINDOW_MS("physics.spin_window_ms", 1.0f, ParamScope::UserConfig);
+    static ParamI PHYSICS_MAX_CATCH_UP_SUBSTEPS("physics.max_catch_up_substeps", 4, ParamScope::System);
+
+    static ParamI PHYSICS_MAX_BODIES("physics.max_bodies", 1024, ParamScope::System);
+    // 0 lets jolt pick
+    static ParamI PHYSICS_NUM_BODY_MUTEXES("physics.num_body_mutexes", 0, ParamScope::System);
+    static ParamI PHYSICS_MAX_BODY_PAIRS("physics.max_body_pairs", 1024, ParamScope::System);
+    static ParamI PHYSICS_MAX_CONTACT_CONSTRAINTS("physics.max_contact_constraints", 1024, ParamScope::System);
+    static ParamI PHYSICS_TEMP_ALLOCATOR_KB("physics.temp_allocator_kb", 1024, ParamScope::System);
+
+    // false gives jolt its own thread pool next to the scheduler's workers
+    static ParamB PHYSICS_USE_ENGINE_SCHEDULER("physics.use_engine_scheduler", true, ParamScope::System);
+
+    // ticks of world state kept for rollback, 0 disables saving; must cover the round trip to reconcile
+    static ParamI PHYSICS_ROLLBACK_FRAMES("physics.rollback_frames", 0, ParamScope::System);
+
+    // per phase job timings in the debug stats, an extra std::function per jolt job
+    static ParamB PHYSICS_PROFILE_PHASES("physics.profile_phases", true, ParamScope::System);
+
+    // per object layer overrides of the default matrix, empty keeps the engine default
+    // broad_phase names a broad phase layer, collides_with is a comma separated list of object layers
+    struct LayerParams {
+        moe::StringView layer;
+        ParamS broadPhase;
+        ParamS collidesWith;
+    };
+
+    static LayerParams LAYER_PARAMS[] = {
+            {"static", ParamS("physics.layers.static.broad_phase", ""), ParamS("physics.layers.static.collides_with", "")},
+            {"dynamic", ParamS("physics.layers.dynamic.broad_phase", ""), ParamS("physics.layers.dynamic.collides_with", "")},
+            {"character", ParamS("physics.layers.character.broad_phase", ""), ParamS("physics.layers.character.collides_with", "")},
+            {"projectile", ParamS("physics.layers.projectile.broad_phase", ""), ParamS("physics.layers.projectile.collides_with", "")},
+            {"trigger", ParamS("physics.layers.trigger.broad_phase", ""), ParamS("physics.layers.trigger.collides_with", "")},
+            {"debris", ParamS("physics.layers.debris.broad_phase", ""), ParamS("physics.layers.debris.collides_with", "")},
+    };
+
+    static uint32_t toCapacity(const ParamI& param, int64_t minimum) {
+        return static_cast<uint32_t>(std::clamp<int64_t>(param.get(), minimum, std::numeric_limits<uint32_t>::max()));
+    }
+
+    static moe::StringView trim(moe::StringView str) {
+        while (!str.empty() && std::isspace(static_cast<unsigned char>(str.front()))) {
+            str.remove_prefix(1);
+        }
+        while (!str.empty() && std::isspace(static_cast<unsigned char>(str.back()))) {
+            str.remove_suffix(1);
+        }
+        return str;
+    }
+
+    // the layer's whole row is replaced, a later layer that names this one can still add the pair back
+    static void applyLayerOverrides(moe::Physics::CollisionLayerConfig& config, const LayerParams& params) {
+        auto layer = config.findObjectLayer(params.layer);
+        if (!layer) {
+            return;
+        }
+
+        auto broadPhaseParam = params.broadPhase.get();
+        auto broadPhaseName = trim(broadPhaseParam);
+        if (!broadPhaseName.empty()) {
+            if (auto broadPhase = config.findBroadPhaseLayer(broadPhaseName)) {
+                config.objectLayers[*layer].broadPhaseLayer = *broadPhase;
+            } else {
+                moe::Logger::warn("Unknown broad phase layer '{}' for object layer '{}'", broadPhaseName, params.layer);
+            }
+        }
+
+        auto collidesWithParam = params.collidesWith.get();
+        moe::StringView collidesWith = collidesWithParam;
+        if (trim(collidesWith).empty()) {
+            return;
+        }
+
+        for (JPH::ObjectLayer other = 0; other < config.objectLayers.size(); ++other) {
+            config.setCollides(*layer, other, false);
+        }
+
+        // "none" clears the row
+        while (!collidesWith.empty()) {
+            auto comma = collidesWith.find(',');
+            auto name = trim(collidesWith.substr(0, comma));
+            collidesWith = comma == moe::StringView::npos ? moe::StringView{} : collidesWith.substr(comma + 1);
+
+            if (name.empty() || name == "none") {
+                continue;
+            }
+
+            if (auto other = config.findObjectLayer(name)) {
+                config.setCollides(*layer, *other, true);
+            } else {
+                moe::Logger::warn("Unknown object layer '{}' in collides_with of '{}'", name, params.layer);
+            }
+        }
+    }
+
+    moe::PhysicsEngineInitializers loadPhysicsInitializers() {
+        auto layers = moe::Physics::CollisionLayerConfig::createDefault();
+        for (auto& params: LAYER_PARAMS) {
+            applyLayerOverrides(layers, params);
+        }
+
+        return moe::PhysicsEngineInitializers{
+                .spinWindow = std::chrono::duration_cast<std::chrono::microseconds>(
+                        std::chrono::duration<float, std::milli>(PHYSICS_SPIN_WINDOW_MS.get())),
+                .maxCatchUpSubsteps = toCapacity(PHYSICS_MAX_CATCH_UP_SUBSTEPS, 1),
+                .maxBodies = toCapacity(PHYSICS_MAX_BODIES, 1),
+                .numBodyMutexes = toCapacity(PHYSICS_NUM_BODY_MUTEXES, 0),
+                .maxBodyPairs = toCapacity(PHYSICS_MAX_BODY_PAIRS, 1),
+                .maxContactConstraints = toCapacity(PHYSICS_MAX_CONTACT_CONSTRAINTS, 1),
+                .tempAllocatorBytes = static_cast<size_t>(toCapacity(PHYSICS_TEMP_ALLOCATOR_KB, 64)) * 1024,
+                .collisionLayers = std::move(layers),
+                .useEngineScheduler = PHYSICS_USE_ENGINE_SCHEDULER.get(),
+                .rollbackFrames = toCapacity(PHYSICS_ROLLBACK_FRAMES, 0),
+                .profileJobPhases = PHYSICS_PROFILE_PHASES.get(),
+        };
+    }
+}// namespace game
\ No newline at end of file
@@ -0,0 +1,8 @@
+#pragma once
+
+#include "Physics/PhysicsEngine.hpp"
+
+namespace game {
+    // physics engine settings from the params, capacities and the collision layer matrix live in config.toml
+    moe::PhysicsEngineInitializers loadPhysicsInitializers();
+}// namespace game
\ No newline at end of file
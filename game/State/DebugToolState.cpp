@@ -7,9 +7,14 @@
 #include "Math/Util.hpp"
 #include "Param.hpp"
 
+#include "Core/Memory.hpp"
+#include "Core/Profiler.hpp"
 
 #include "imgui.h"
 
+#include <algorithm>
+#include <cmath>
+
 namespace game::State {
     static ParamF IM3D_CAMERA_MOVE_SPEED("debug_tool.im3d_camera_move_speed", 0.1f, ParamScope::UserConfig);
 
@@ -192,9 +197,72 @@ namespace game::State {
         cam.setPitch(cameraPitch);
     }
 
+    static void plotTickStat(const char* label, const moe::Deque<moe::Physics::TickStats>& history, float moe::Physics::TickStats::*field) {
+        struct PlotData {
+            const moe::Deque<moe::Physics::TickStats>* history;
+            float moe::Physics::TickStats::*field;
+        };
+
+        PlotData data{&history, field};
+        ImGui::PlotLines(
+                label,
+                [](void* data, int idx) -> float {
+                    auto& plot = *static_cast<PlotData*>(data);
+                    return (*plot.history)[idx].*plot.field;
+                },
+                &data,
+                static_cast<int>(history.size()),
+                0,
+                nullptr,
+                0.0f);
+    }
+
+    static void drawTickStats(moe::Deque<moe::Physics::TickStats>& history, const moe::PhysicsEngine::Stats& physicsStats) {
+        if (history.empty()) {
+            return;
+        }
+
+        auto& last = history.back();
+        ImGui::Separator();
+        ImGui::TextUnformatted("Physics Step (per tick):");
+        plotTickStat("Step (ms)", history, &moe::Physics::TickStats::stepMs);
+        ImGui::Text("Step %.3f ms, job cpu time broad / narrow / solver / integrate / other: %.3f / %.3f / %.3f / %.3f / %.3f ms",
+                    last.stepMs, last.broadPhaseMs, last.narrowPhaseMs, last.solverMs, last.integrateMs, last.otherJobsMs);
+        plotTickStat("Broad Phase (ms)", history, &moe::Physics::TickStats::broadPhaseMs);
+        plotTickStat("Narrow Phase (ms)", history, &moe::Physics::TickStats::narrowPhaseMs);
+        plotTickStat("Solver (ms)", history, &moe::Physics::TickStats::solverMs);
+
+        ImGui::PlotLines(
+                "Contacts",
+                [](void* data, int idx) -> float {
+                    auto& stats = *static_cast<moe::Deque<moe::Physics::TickStats>*>(data);
+                    return static_cast<float>(stats[idx].numContacts);
+                },
+                &history,
+                static_cast<int>(history.size()));
+        ImGui::Text("Contacts %u, active bodies %u, constraints %u",
+                    last.numContacts, last.numActiveBodies, physicsStats.numConstraints);
+
+        ImGui::PlotLines(
+                "Temp Memory (KiB)",
+                [](void* data, int idx) -> float {
+                    auto& stats = *static_cast<moe::Deque<moe::Physics::TickStats>*>(data);
+                    return static_cast<float>(stats[idx].tempAllocatorPeakBytes) / 1024.0f;
+                },
+                &history,
+                static_cast<int>(history.size()));
+        ImGui::Text("Temp allocator peak %.1f / %.1f KiB",
+                    static_cast<float>(physicsStats.tempAllocatorPeakBytes) / 1024.0f,
+                    static_cast<float>(physicsStats.tempAllocatorBytes) / 1024.0f);
+
+        auto color = physicsStats.tickOverruns > 0 ? ImVec4(1.0f, 0.3f, 0.3f, 1.0f) : ImVec4(0.0f, 1.0f, 0.0f, 1.0f);
+        ImGui::TextColored(color, "Physics Tick Overruns: %llu", static_cast<unsigned long long>(physicsStats.tickOverruns));
+    }
+
     static void drawStats(GameManager& ctx) {
         static moe::Deque<App::Stats> historyStats;
         static moe::Deque<moe::PhysicsEngine::Stats> physicsHistoryStats;
+        static moe::Deque<moe::Physics::TickStats> tickHistoryStats;
 
         auto appStats = ctx.app().getStats();
         auto physicsStats = ctx.physics().getStats();
@@ -209,6 +277,15 @@ namespace game::State {
             physicsHistoryStats.pop_front();
         }
 
+        // one entry per physics tick, frames that saw no new tick add nothing
+        auto tickStats = ctx.physics().getLastTickStats();
+        if (tickHistoryStats.empty() || tickHistoryStats.back().tick != tickStats.tick) {
+            tickHistoryStats.push_back(tickStats);
+            if (tickHistoryStats.size() > 240) {
+                tickHistoryStats.pop_front();
+            }
+        }
+
         float avgFrameTime = 0.0f;
         for (auto& stats: historyStats) {
             avgFrameTime += stats.frameTimeMs;
@@ -257,6 +334,103 @@ namespace game::State {
         ImGui::TextColored(ImVec4(0.0f, 1.0f, 0.0f, 1.0f),
                            "Avg FPS: %.2f", avgFps);
 
+        // draws after culling against what the pass would draw without it
+        auto& renderer = ctx.renderer();
+        const auto& drawStats = renderer.getDrawStats();
+        uint32_t shadowDraws = 0;
+        for (auto draws: drawStats.cascadeDraws) {
+            shadowDraws += draws;
+        }
+        if (drawStats.gpuDriven) {
+            ImGui::Text("Packets: %u, culled on the GPU", drawStats.packets);
+        } else {
+            ImGui::Text("Camera Draws: %u / %u", drawStats.cameraDraws, drawStats.packets);
+            ImGui::Text("Shadow Draws: %u / %u (cascades %u, %u, %u, %u)",
+                        shadowDraws, drawStats.packets * static_cast<uint32_t>(drawStats.cascadeDraws.size()),
+                        drawStats.cascadeDraws[0], drawStats.cascadeDraws[1],
+                        drawStats.cascadeDraws[2], drawStats.cascadeDraws[3]);
+        }
+        // every draw used to bind its own index buffer
+        ImGui::Text("Index Buffer Binds: g-buffer %u / %u, shadow %u / %u",
+                    drawStats.gBuffer.indexBufferBinds, drawStats.gBuffer.draws,
+                    drawStats.shadow.indexBufferBinds, drawStats.shadow.draws);
+        ImGui::Text("Material Changes: %u / %u", drawStats.gBuffer.materialChanges, drawStats.gBuffer.draws);
+        ImGui::Text("Sort: g-buffer %.1f us, shadow %.1f us", drawStats.gBuffer.sortUs, drawStats.shadow.sortUs);
+        // instances are the packets drawn, draws the vkCmdDrawIndexed calls they were grouped into
+        ImGui::Text("Instanced Draws: g-buffer %u / %u, shadow %u / %u",
+                    drawStats.gBuffer.draws, drawStats.gBuffer.instances,
+                    drawStats.shadow.draws, drawStats.shadow.instances);
+        ImGui::Text("Submit: g-buffer %.1f us, shadow %.1f us", drawStats.gBuffer.submitUs, drawStats.shadow.submitUs);
+        // every mesh used to own two or three buffers of its own
+        const auto& meshArena = renderer.getMeshArena();
+        const auto& arenaStats = meshArena.getStats();
+        ImGui::Text("Mesh Arena: %zu meshes, vertices %u / %u, indices %u / %u",
+                    meshArena.getIndexAllocator().getAllocationCount(),
+                    meshArena.getVertexAllocator().getUsed(), meshArena.getVertexAllocator().getCapacity(),
+                    meshArena.getIndexAllocator().getUsed(), meshArena.getIndexAllocator().getCapacity());
+        ImGui::Text("Mesh Uploads: %u in %.1f ms, %u growths, %zu free ranges",
+                    arenaStats.uploads, arenaStats.uploadMs, arenaStats.growths,
+                    meshArena.getVertexAllocator().getFreeRangeCount());
+        // every upload used to submit on its own and wait for a fence
+        const auto& uploadService = renderer.getUploadService();
+        const auto& uploadStats = uploadService.getStats();
+        ImGui::Text("Uploads: %u copies in %u submissions (%s), %.1f MB, stalls %u / %.1f ms",
+                    uploadStats.copies, uploadStats.submissions,
+                    uploadService.isDedicatedQueue() ? "transfer queue" : "graphics queue",
+                    static_cast<float>(uploadStats.bytes) / (1024.0f * 1024.0f),
+                    uploadStats.stalls, uploadStats.stallMs);
+        const auto& pipelineCacheStats = renderer.getPipelineCache().getStats();
+        ImGui::Text("Pipelines: %u created in %.1f ms, cache %s",
+                    pipelineCacheStats.pipelines, pipelineCacheStats.createMs,
+                    pipelineCacheStats.warm ? "warm" : "cold");
+        // every post fx stage used to keep an image of its own and fence itself with two full barriers
+        const auto& postFXStats = renderer.getPostFXStats();
+        ImGui::Text("Post FX: %u images for %u stages, %.1f / %.1f MB, %u barriers in %u batches",
+                    postFXStats.physicalImages, postFXStats.logicalImages,
+                    static_cast<float>(postFXStats.transientBytes) / (1024.0f * 1024.0f),
+                    static_cast<float>(postFXStats.unaliasedBytes) / (1024.0f * 1024.0f),
+                    postFXStats.imageBarriers, postFXStats.barrierBatches);
+        // the frame used to transition every target by hand, mostly with full barriers
+        const auto& frameGraphStats = renderer.getFrameGraphStats();
+        ImGui::Text("Frame Graph: %u passes (%u culled), %u image + %u buffer barriers in %u batches",
+                    frameGraphStats.passes, frameGraphStats.culledPasses,
+                    frameGraphStats.imageBarriers, frameGraphStats.bufferBarriers, frameGraphStats.barrierBatches);
+        // the render thread used to record every draw itself
+        const auto& recordingStats = renderer.getRecordingStats();
+        ImGui::Text("Parallel Recording: %u passes, %u secondaries in %.1f us",
+                    recordingStats.passes, recordingStats.secondaryBuffers, recordingStats.recordUs);
+        bool frustumCulling = renderer.isFrustumCullingEnabled();
+        if (ImGui::Checkbox("Frustum Culling", &frustumCulling)) {
+            renderer.setFrustumCullingEnabled(frustumCulling);
+        }
+        ImGui::SameLine();
+        bool drawSorting = renderer.isDrawSortingEnabled();
+        if (ImGui::Checkbox("Draw Sorting", &drawSorting)) {
+            renderer.setDrawSortingEnabled(drawSorting);
+        }
+        ImGui::SameLine();
+        bool instancing = renderer.isInstancingEnabled();
+        if (ImGui::Checkbox("Instancing", &instancing)) {
+            renderer.setInstancingEnabled(instancing);
+        }
+        ImGui::SameLine();
+        // devices without indirect count draws cannot run it
+        ImGui::BeginDisabled(!renderer.isGpuDrivenSupported());
+        bool gpuDriven = renderer.isGpuDrivenEnabled();
+        if (ImGui::Checkbox("GPU Driven", &gpuDriven)) {
+            renderer.setGpuDrivenEnabled(gpuDriven);
+        }
+        ImGui::EndDisabled();
+        bool parallelRecording = renderer.isParallelRecordingEnabled();
+        if (ImGui::Checkbox("Parallel Recording", &parallelRecording)) {
+            renderer.setParallelRecordingEnabled(parallelRecording);
+        }
+        ImGui::SameLine();
+        int recordingThreads = static_cast<int>(renderer.getRecordingThreads());
+        if (ImGui::SliderInt("Recording Threads", &recordingThreads, 1, static_cast<int>(renderer.getMaxRecordingThreads()))) {
+            renderer.setRecordingThreads(static_cast<uint32_t>(recordingThreads));
+        }
+
         ImGui::PlotLines(
                 "Physics Frame Time (ms)",
                 [](void* data, int idx) -> float {
@@ -279,6 +453,306 @@ namespace game::State {
         ImGui::TextColored(ImVec4(0.0f, 1.0f, 0.0f, 1.0f),
                            "Avg Physics TPS: %.2f", avgPhysicsTPS);
 
+        ImGui::Text("Physics Jitter p50/p99/max: %.3f / %.3f / %.3f ms",
+                    physicsStats.jitterP50Ms, physicsStats.jitterP99Ms, physicsStats.jitterMaxMs);
+        ImGui::Text("Physics Wake-up Error p99: %.3f ms", physicsStats.timingErrorP99Ms);
+        ImGui::Text("Physics Tick Work p50/p99: %.3f / %.3f ms", physicsStats.workP50Ms, physicsStats.workP99Ms);
+        ImGui::Text("Physics Thread Busy: %.1f%% (spin %.1f%%)", physicsStats.busyPercent, physicsStats.spinPercent);
+        ImGui::Text("Physics Bodies: %u / %u (%u active)",
+                    physicsStats.numBodies, physicsStats.maxBodies, physicsStats.numActiveBodies);
+        if (physicsStats.capacityOverflowTicks > 0) {
+            ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f),
+                               "Physics Capacity Overflow Ticks: %llu",
+                               static_cast<unsigned long long>(physicsStats.capacityOverflowTicks));
+        }
+        ImGui::Text("Physics Catch-up / Dropped Ticks: %llu / %llu",
+                    static_cast<unsigned long long>(physicsStats.catchUpTicks),
+                    static_cast<unsigned long long>(physicsStats.droppedTicks));
+        if (physicsStats.rollbackFrameBytes > 0) {
+            ImGui::Text("Physics Rollback save / restore / resim: %.1f / %.1f / %.1f us per tick (%u bytes per tick)",
+                        physicsStats.rollbackSaveUs, physicsStats.rollbackRestoreUs,
+                        physicsStats.rollbackResimulateUsPerTick, physicsStats.rollbackFrameBytes);
+        }
+
+        drawTickStats(tickHistoryStats, physicsStats);
+
+        ImGui::End();
+    }
+
+    static void drawFrameTimeSummary(const char* label, const moe::FrameTimeStats& stats) {
+        constexpr size_t HISTOGRAM_BUCKETS = 40;
+
+        auto summary = stats.summarize();
+
+        ImGui::Separator();
+        ImGui::TextUnformatted(label);
+        if (summary.targetMs > 0.0f) {
+            ImGui::Text("Target: %.2f ms (%.1f Hz)", summary.targetMs, 1000.0f / summary.targetMs);
+        } else {
+            ImGui::TextUnformatted("Target: unlimited");
+        }
+
+        if (ImGui::BeginTable(label, 5, ImGuiTableFlags_Borders)) {
+            ImGui::TableSetupColumn("p50");
+            ImGui::TableSetupColumn("p95");
+            ImGui::TableSetupColumn("p99");
+            ImGui::TableSetupColumn("max");
+            ImGui::TableSetupColumn("mean");
+            ImGui::TableHeadersRow();
+
+            ImGui::TableNextRow();
+            for (auto value: {summary.p50Ms, summary.p95Ms, summary.p99Ms, summary.maxMs, summary.meanMs}) {
+                ImGui::TableNextColumn();
+                ImGui::Text("%.2f ms", value);
+            }
+            ImGui::EndTable();
+        }
+
+        if (summary.targetMs > 0.0f) {
+            auto color = summary.missedFrames > 0 ? ImVec4(1.0f, 0.4f, 0.4f, 1.0f) : ImVec4(0.0f, 1.0f, 0.0f, 1.0f);
+            ImGui::TextColored(color, "Missed: %zu / %zu in window, %llu / %llu total",
+                               summary.missedFrames, summary.samples,
+                               static_cast<unsigned long long>(summary.totalMissedFrames),
+                               static_cast<unsigned long long>(summary.totalFrames));
+        }
+
+        // range covers the slowest frame with a little headroom, or two target periods when everything is on time
+        float rangeMs = std::max(summary.maxMs * 1.1f, summary.targetMs * 2.0f);
+        float buckets[HISTOGRAM_BUCKETS];
+        stats.buildHistogram(buckets, rangeMs);
+
+        auto histogramLabel = fmt::format("0 - {:.1f} ms##{}", rangeMs, label);
+        ImGui::PlotHistogram(
+                histogramLabel.c_str(),
+                buckets, static_cast<int>(HISTOGRAM_BUCKETS),
+                0, nullptr, 0.0f, FLT_MAX, ImVec2(0.0f, 60.0f));
+    }
+
+    static void drawFramePacing(GameManager& ctx) {
+        auto& app = ctx.app();
+
+        ImGui::Begin("Debug Tool - Frame Pacing");
+        ImGui::TextUnformatted("Rates are set by frame_pacing.* parameters, 0 is unlimited.");
+
+        if (ImGui::Button("Reset")) {
+            app.resetFrameStats();
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("Export")) {
+            app.exportFrameStats(moe::userdata("frame_stats.json"));
+        }
+
+        drawFrameTimeSummary("Update", app.getUpdateFrameStats());
+        drawFrameTimeSummary("Render", app.getRenderFrameStats());
+
+        ImGui::End();
+    }
+
+    static moe::String formatMemorySize(double bytes) {
+        if (std::abs(bytes) >= 1024.0 * 1024.0) {
+            return fmt::format("{:.2f} MiB", bytes / (1024.0 * 1024.0));
+        }
+        if (std::abs(bytes) >= 1024.0) {
+            return fmt::format("{:.2f} KiB", bytes / 1024.0);
+        }
+        return fmt::format("{:.0f} B", bytes);
+    }
+
+    static void drawMemory() {
+        auto stats = moe::Memory::getStats();
+
+        ImGui::Begin("Debug Tool - Memory");
+        if (!moe::Memory::isGlobalTrackingEnabled()) {
+            ImGui::TextColored(ImVec4(1.0f, 1.0f, 0.0f, 1.0f), "Global new/delete tracking is off, only explicit allocations are counted.");
+        }
+
+        if (ImGui::Button("Dump to Log")) {
+            moe::Memory::logStats();
+        }
+
+        int64_t totalCurrent = 0;
+        double totalRate = 0.0;
+        if (ImGui::BeginTable("MemoryTags", 6, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+            ImGui::TableSetupColumn("Tag");
+            ImGui::TableSetupColumn("Current");
+            ImGui::TableSetupColumn("Peak");
+            ImGui::TableSetupColumn("Live Blocks");
+            ImGui::TableSetupColumn("Rate");
+            ImGui::TableSetupColumn("Allocs/s");
+            ImGui::TableHeadersRow();
+
+            for (auto& tagStats: stats) {
+                totalCurrent += tagStats.currentBytes;
+                totalRate += tagStats.bytesPerSecond;
+
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(moe::Memory::getTagName(tagStats.tag));
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(formatMemorySize(static_cast<double>(tagStats.currentBytes)).c_str());
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(formatMemorySize(static_cast<double>(tagStats.peakBytes)).c_str());
+                ImGui::TableNextColumn();
+                ImGui::Text("%lld", static_cast<long long>(tagStats.liveAllocations));
+                ImGui::TableNextColumn();
+                ImGui::Text("%s/s", formatMemorySize(tagStats.bytesPerSecond).c_str());
+                ImGui::TableNextColumn();
+                ImGui::Text("%.0f", tagStats.allocationsPerSecond);
+            }
+            ImGui::EndTable();
+        }
+
+        ImGui::Text("Total: %s, %s/s", formatMemorySize(static_cast<double>(totalCurrent)).c_str(), formatMemorySize(totalRate).c_str());
+        ImGui::End();
+    }
+
+    static ImU32 profilerZoneColor(const char* name) {
+        // names are static strings, hashing the pointer is stable for the whole run
+        auto hash = std::hash<const void*>{}(name);
+        float hue = static_cast<float>(hash % 360) / 360.0f;
+        ImVec4 color;
+        ImGui::ColorConvertHSVtoRGB(hue, 0.55f, 0.85f, color.x, color.y, color.z);
+        color.w = 1.0f;
+        return ImGui::GetColorU32(color);
+    }
+
+    static void drawProfilerFlameGraph(const moe::Profiling::FrameRecord& frame, const moe::Vector<moe::Profiling::ThreadInfo>& threads) {
+        constexpr float ROW_HEIGHT = 18.0f;
+        constexpr float LANE_PADDING = 6.0f;
+
+        // depth of the deepest zone per thread, decides the lane height
+        moe::Vector<uint32_t> maxDepths(threads.size(), 0);
+        moe::Vector<bool> hasEvents(threads.size(), false);
+        for (auto& event: frame.events) {
+            if (event.threadIndex >= maxDepths.size()) {
+                continue;
+            }
+            maxDepths[event.threadIndex] = std::max(maxDepths[event.threadIndex], event.depth);
+            hasEvents[event.threadIndex] = true;
+        }
+
+        auto* drawList = ImGui::GetWindowDrawList();
+        float width = ImGui::GetContentRegionAvail().x;
+        float frameNs = static_cast<float>(std::max<moe::Profiling::TimestampNs>(frame.endNs - frame.startNs, 1));
+
+        for (auto& thread: threads) {
+            if (!hasEvents[thread.threadIndex]) {
+                continue;
+            }
+
+            ImGui::TextUnformatted(thread.threadName.c_str());
+
+            ImVec2 origin = ImGui::GetCursorScreenPos();
+            float laneHeight = static_cast<float>(maxDepths[thread.threadIndex] + 1) * ROW_HEIGHT;
+            drawList->AddRectFilled(origin, ImVec2(origin.x + width, origin.y + laneHeight), IM_COL32(30, 30, 30, 255));
+
+            for (auto& event: frame.events) {
+                if (event.threadIndex != thread.threadIndex) {
+                    continue;
+                }
+
+                // zones of free running threads may cross the frame boundaries
+                auto startNs = std::clamp(event.startNs, frame.startNs, frame.endNs);
+                auto endNs = std::clamp(event.endNs, frame.startNs, frame.endNs);
+
+                float x0 = origin.x + static_cast<float>(startNs - frame.startNs) / frameNs * width;
+                float x1 = origin.x + static_cast<float>(endNs - frame.startNs) / frameNs * width;
+                x1 = std::max(x1, x0 + 1.0f);
+                float y0 = origin.y + static_cast<float>(event.depth) * ROW_HEIGHT;
+                float y1 = y0 + ROW_HEIGHT - 1.0f;
+
+                drawList->AddRectFilled(ImVec2(x0, y0), ImVec2(x1, y1), profilerZoneColor(event.name));
+
+                float textWidth = ImGui::CalcTextSize(event.name).x;
+                if (x1 - x0 > textWidth + 4.0f) {
+                    drawList->AddText(ImVec2(x0 + 2.0f, y0 + 2.0f), IM_COL32(0, 0, 0, 255), event.name);
+                }
+
+                if (ImGui::IsMouseHoveringRect(ImVec2(x0, y0), ImVec2(x1, y1))) {
+                    ImGui::BeginTooltip();
+                    ImGui::Text("%s", event.name);
+                    ImGui::Text("%.3f ms", static_cast<float>(event.endNs - event.startNs) / 1e6f);
+                    ImGui::Text("Thread: %s, depth %u", thread.threadName.c_str(), event.depth);
+                    ImGui::EndTooltip();
+                }
+            }
+
+            ImGui::Dummy(ImVec2(width, laneHeight + LANE_PADDING));
+        }
+    }
+
+    static void drawProfiler() {
+        static int selectedFrameOffset = 0;
+
+        auto& profiler = moe::Profiler::getInstance();
+        auto& history = profiler.getFrameHistory();
+
+        ImGui::Begin("Debug Tool - Profiler");
+
+#ifndef MOE_ENABLE_PROFILER
+        ImGui::TextColored(ImVec4(1.0f, 0.5f, 0.0f, 1.0f), "Profiler zones are compiled out (MOE_ENABLE_PROFILER is off)");
+#endif
+
+        bool enabled = profiler.isEnabled();
+        if (ImGui::Checkbox("Enabled", &enabled)) {
+            profiler.setEnabled(enabled);
+        }
+        ImGui::SameLine();
+        bool paused = profiler.isPaused();
+        if (ImGui::Checkbox("Paused", &paused)) {
+            profiler.setPaused(paused);
+        }
+        ImGui::SameLine();
+        if (!profiler.isCapturing()) {
+            if (ImGui::Button("Start Capture")) {
+                profiler.beginCapture();
+            }
+        } else {
+            if (ImGui::Button("Stop Capture")) {
+                profiler.endCapture(moe::userdata("profile_capture.json"));
+            }
+            ImGui::SameLine();
+            ImGui::Text("%zu events", profiler.getCapturedEventCount());
+        }
+
+        if (history.empty()) {
+            ImGui::TextUnformatted("No frames collected yet.");
+            ImGui::End();
+            return;
+        }
+
+        ImGui::PlotHistogram(
+                "Frame Time (ms)",
+                [](void* data, int idx) -> float {
+                    auto& frames = *static_cast<const moe::Deque<moe::Profiling::FrameRecord>*>(data);
+                    return frames[idx].durationMs();
+                },
+                const_cast<moe::Deque<moe::Profiling::FrameRecord>*>(&history),
+                static_cast<int>(history.size()),
+                0, nullptr, 0.0f, FLT_MAX, ImVec2(0.0f, 60.0f));
+
+        // 0 is the latest frame
+        int maxOffset = static_cast<int>(history.size()) - 1;
+        selectedFrameOffset = std::min(selectedFrameOffset, maxOffset);
+        ImGui::SliderInt("Frames Ago", &selectedFrameOffset, 0, maxOffset);
+
+        auto& frame = history[history.size() - 1 - selectedFrameOffset];
+        ImGui::Text("Frame %llu: %.3f ms, %zu zones",
+                    static_cast<unsigned long long>(frame.frameIndex), frame.durationMs(), frame.events.size());
+
+        auto threads = profiler.getThreadInfos();
+
+        ImGui::Separator();
+        drawProfilerFlameGraph(frame, threads);
+
+        if (ImGui::CollapsingHeader("Threads")) {
+            for (auto& thread: threads) {
+                ImGui::Text("#%u %s, dropped events: %llu",
+                            thread.threadIndex, thread.threadName.c_str(),
+                            static_cast<unsigned long long>(thread.droppedEvents));
+            }
+        }
+
         ImGui::End();
     }
 
@@ -382,6 +856,24 @@ namespace game::State {
                 [this, &ctx]() {
                     drawStats(ctx);
                 });
+
+        ctx.addDebugDrawFunction(
+                "Frame Pacing",
+                [this, &ctx]() {
+                    drawFramePacing(ctx);
+                });
+
+        ctx.addDebugDrawFunction(
+                "Memory",
+                [this, &ctx]() {
+                    drawMemory();
+                });
+
+        ctx.addDebugDrawFunction(
+                "Profiler",
+                [this, &ctx]() {
+                    drawProfiler();
+                });
     }
 
     void DebugToolState::onExit(GameManager& ctx) {
@@ -394,6 +886,9 @@ namespace game::State {
         ctx.removeDebugDrawFunction("Game State Tree");
         ctx.removeDebugDrawFunction("Im3d Gizmo");
         ctx.removeDebugDrawFunction("Stats");
+        ctx.removeDebugDrawFunction("Frame Pacing");
+        ctx.removeDebugDrawFunction("Memory");
+        ctx.removeDebugDrawFunction("Profiler");
     }
 
     void DebugToolState::onUpdate(GameManager& ctx, float deltaTime) {
@@ -1,5 +1,6 @@
 #include "PlaygroundState.hpp"
 #include "GameManager.hpp"
+#include "Param.hpp"
 
 #include "Math/Transform.hpp"
 #include "Physics/GltfColliderFactory.hpp"
@@ -9,6 +10,9 @@
 
 
 namespace game::State {
+    // restore built colliders from the cache instead of rebuilding mesh bvhs on every load
+    static ParamB COOK_COLLIDERS("physics.cook_colliders", true, ParamScope::System);
+
     void PlaygroundState::onEnter(GameManager& ctx) {
         auto path = moe::asset("assets/models/playground.glb");
 
@@ -23,7 +27,26 @@ namespace game::State {
                 [state = this->asRef<PlaygroundState>(), path](moe::PhysicsEngine& physics) mutable {
                     moe::Logger::debug("Creating playground collider");
 
-                    auto collider = moe::Physics::GltfColliderFactory::shapeFromGltf(path);
+                    auto start = std::chrono::steady_clock::now();
+                    JPH::ShapeRefC collider;
+                    if (COOK_COLLIDERS.get()) {
+                        collider = moe::Physics::GltfColliderFactory::cookedShapeFromGltf(path);
+                    } else {
+                        auto shapeResult = moe::Physics::GltfColliderFactory::shapeFromGltf(path)->Create();
+                        if (!shapeResult.HasError()) {
+                            collider = shapeResult.Get();
+                        }
+                    }
+
+                    if (collider == nullptr) {
+                        moe::Logger::error("PlaygroundState::onEnter: failed to create playground collider");
+                        return;
+                    }
+                    moe::Logger::info(
+                            "Playground collider ready in {:.2f} ms{}",
+                            std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count(),
+                            COOK_COLLIDERS.get() ? "" : " (cooking disabled)");
+
                     JPH::BodyCreationSettings settings = JPH::BodyCreationSettings(
                             collider,
                             JPH::RVec3(0.0f, 0.0f, 0.0f),
@@ -40,16 +63,28 @@ namespace game::State {
         ctx.physics().dispatchOnPhysicsThread([state = this->asRef<PlaygroundState>()](moe::PhysicsEngine& physics) {
             moe::Logger::debug("Removing playground collider");
 
+            // collider creation failed
+            if (!state->m_playgroundBody.isSet()) {
+                return;
+            }
+
+            auto body = state->m_playgroundBody.get();
+
             auto& bodyInterface = physics.getPhysicsSystem().GetBodyInterface();
-            bodyInterface.RemoveBody(state->m_playgroundBody.get().value());
-            bodyInterface.DestroyBody(state->m_playgroundBody.get().value());
+            bodyInterface.RemoveBody(body.value());
+            bodyInterface.DestroyBody(body.value());
         });
     }
 
     void PlaygroundState::onUpdate(GameManager& ctx, float) {
-        auto& physicsSwap = ctx.physics().getCurrentRead();
         if (auto body = m_playgroundBody.get()) {
-            auto pos = physicsSwap.getSnapshot(body.value())->position;
+            auto snapshot = ctx.physics().getRenderTransform(body.value());
+            if (!snapshot) {
+                // added after the last published tick
+                return;
+            }
+
+            auto pos = snapshot->position;
             ctx.renderer()
                     .getBus<moe::VulkanRenderObjectBus>()
                     .submitRender(m_playgroundRenderable, moe::Transform{}.setPosition(moe::Physics::fromJoltType<glm::vec3>(pos)));
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "Core/Common.hpp"
+#include "Core/FrameLimiter.hpp"
+
+MOE_BEGIN_NAMESPACE
+
+// drives a fixed timestep loop
+// ticks are scheduled on an absolute grid so timing errors never accumulate; the wait sleeps most of the gap
+// and spins the last spinWindow; a loop that falls behind runs up to maxSubsteps ticks back to back,
+// anything beyond that is dropped and the grid restarts from now
+struct FixedStepClock {
+public:
+    using Clock = Timing::Clock;
+
+    struct Config {
+        Clock::duration step{std::chrono::microseconds(16667)};
+        Clock::duration spinWindow{FrameLimiter::DEFAULT_SPIN_WINDOW};
+        uint32_t maxSubsteps{4};
+        size_t statsWindow{FrameTimeStats::DEFAULT_WINDOW_SIZE};
+    };
+
+    using TimeSource = Timing::TimeSource;
+
+    struct Stats {
+        // how late each wake-up was against the grid
+        FrameTimeStats::Summary timingError;
+        // deviation of each interval between wake-ups from the step
+        FrameTimeStats::Summary jitter;
+        // time spent in the ticks, excluding the wait
+        FrameTimeStats::Summary work;
+
+        // work plus spin over wall time since the previous collectStats, 100% is one core kept busy
+        float busyPercent{0.0f};
+        float spinPercent{0.0f};
+
+        uint64_t ticks{0};
+        // ticks run back to back to catch up
+        uint64_t catchUpTicks{0};
+        uint64_t droppedTicks{0};
+    };
+
+    FixedStepClock();
+    explicit FixedStepClock(const Config& config, TimeSource timeSource = {});
+
+    const Config& getConfig() const { return m_config; }
+
+    // the first tick is due at now
+    void start();
+    void start(Clock::time_point now);
+
+    // blocks until the next tick is due, returns how many ticks to run now, at least 1 and at most maxSubsteps
+    uint32_t waitForNextTick();
+
+    // marks the end of the ticks returned by the last waitForNextTick
+    void endTick();
+
+    // percentiles over the stats windows, the busy and spin percentages restart on every call
+    Stats collectStats();
+
+private:
+    Config m_config;
+    TimeSource m_time;
+
+    Clock::time_point m_nextDeadline{};
+    Clock::time_point m_tickStart{};
+    Optional<Clock::time_point> m_lastWake;
+    bool m_started{false};
+
+    FrameTimeStats m_timingErrorStats;
+    FrameTimeStats m_jitterStats;
+    FrameTimeStats m_workStats;
+
+    Clock::time_point m_intervalStart{};
+    Clock::duration m_intervalBusy{Clock::duration::zero()};
+    Clock::duration m_intervalSpin{Clock::duration::zero()};
+    Clock::duration m_lastSpin{Clock::duration::zero()};
+
+    uint64_t m_ticks{0};
+    uint64_t m_catchUpTicks{0};
+    uint64_t m_droppedTicks{0};
+};
+
+MOE_END_NAMESPACE
\ No newline at end of file
@@ -0,0 +1,163 @@
+#pragma once
+
+#include "Core/Common.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+MOE_BEGIN_NAMESPACE
+
+namespace Timing {
+    using Clock = std::chrono::steady_clock;
+
+    // os sleeps overshoot by up to a scheduler quantum, so sleep until spinWindow before the deadline
+    // and spin (yielding) for the rest; returns how late the deadline was actually reached
+    // outSpinTime receives the time spent spinning, the part of the wait that costs cpu
+    Clock::duration sleepUntil(Clock::time_point deadline, Clock::duration spinWindow, Clock::duration* outSpinTime = nullptr);
+
+    // where a paced loop reads time and waits, empty members fall back to Clock::now and sleepUntil;
+    // tests drive a simulated clock through this so pacing is checked without real sleeps
+    struct TimeSource {
+        Function<Clock::time_point()> now;
+        Function<Clock::duration(Clock::time_point deadline, Clock::duration spinWindow, Clock::duration* outSpinTime)> sleepUntil;
+    };
+
+    // fills the empty members of source with the real clock
+    TimeSource withDefaults(TimeSource source);
+
+    // windows sleeps in ~15.6ms scheduler quanta by default, which is why short sleeps overshoot so badly there;
+    // this raises the system timer resolution to 1ms while alive, other platforms need nothing
+    struct HighResolutionTimerScope {
+    public:
+        HighResolutionTimerScope();
+        ~HighResolutionTimerScope();
+
+        HighResolutionTimerScope(const HighResolutionTimerScope&) = delete;
+        HighResolutionTimerScope& operator=(const HighResolutionTimerScope&) = delete;
+    };
+
+    inline Clock::duration rateToPeriod(double hz) {
+        if (hz <= 0.0) {
+            return Clock::duration::zero();
+        }
+        return std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / hz));
+    }
+}// namespace Timing
+
+// paces a loop to a target rate, a rate of 0 means unlimited
+// deadlines advance by a fixed period so the average rate does not drift with wake-up latency,
+// a loop that falls more than a full period behind is resynced instead of bursting to catch up
+struct FrameLimiter {
+public:
+    using Clock = Timing::Clock;
+
+    static constexpr Clock::duration DEFAULT_SPIN_WINDOW = std::chrono::microseconds(1500);
+
+    explicit FrameLimiter(double targetRate = 0.0, Clock::duration spinWindow = DEFAULT_SPIN_WINDOW, Timing::TimeSource timeSource = {})
+        : m_time(Timing::withDefaults(std::move(timeSource))) {
+        setTargetRate(targetRate);
+        setSpinWindow(spinWindow);
+    }
+
+    void setTargetRate(double hz);
+
+    double getTargetRate() const { return m_targetRate; }
+
+    Clock::duration getTargetPeriod() const { return m_period; }
+
+    bool isLimited() const { return m_period > Clock::duration::zero(); }
+
+    void setSpinWindow(Clock::duration spinWindow) {
+        m_spinWindow = std::max(spinWindow, Clock::duration::zero());
+    }
+
+    Clock::duration getSpinWindow() const { return m_spinWindow; }
+
+    // blocks until the next slot, returns immediately when unlimited
+    void wait();
+
+    // non-blocking variant for loops driven by another limiter, true when a slot is due and consumes it
+    bool poll() { return poll(m_time.now()); }
+    bool poll(Clock::time_point now);
+
+    void reset() { m_hasDeadline = false; }
+
+private:
+    Timing::TimeSource m_time;
+    double m_targetRate{0.0};
+    Clock::duration m_period{Clock::duration::zero()};
+    Clock::duration m_spinWindow{DEFAULT_SPIN_WINDOW};
+
+    Clock::time_point m_nextDeadline{};
+    bool m_hasDeadline{false};
+
+    // advances the deadline past now, returns the slot that is due
+    Clock::time_point advance(Clock::time_point now);
+};
+
+// rolling window of frame times with percentile statistics
+// a frame misses its target when it takes longer than the target plus a small tolerance
+struct FrameTimeStats {
+public:
+    static constexpr size_t DEFAULT_WINDOW_SIZE = 1024;
+    // 5% over the target, tolerates timer noise without hiding dropped frames
+    static constexpr float MISS_TOLERANCE = 0.05f;
+
+    struct Summary {
+        size_t samples{0};
+        float meanMs{0.0f};
+        float p50Ms{0.0f};
+        float p95Ms{0.0f};
+        float p99Ms{0.0f};
+        float maxMs{0.0f};
+        float targetMs{0.0f};
+        // within the window
+        size_t missedFrames{0};
+        // since the last reset
+        uint64_t totalFrames{0};
+        uint64_t totalMissedFrames{0};
+    };
+
+    explicit FrameTimeStats(size_t windowSize = DEFAULT_WINDOW_SIZE);
+
+    // 0 disables miss counting, e.g. when the loop is not limited
+    void setTargetMs(float targetMs) { m_targetMs = targetMs; }
+
+    float getTargetMs() const { return m_targetMs; }
+
+    void push(float frameTimeMs);
+
+    void reset();
+
+    size_t size() const { return m_count; }
+
+    size_t capacity() const { return m_samples.size(); }
+
+    // 0 is the oldest sample in the window
+    float getSample(size_t index) const;
+
+    Summary summarize() const;
+
+    // counts the window into buckets.size() equal buckets over [0, maxMs], the last bucket also holds anything slower
+    void buildHistogram(Span<float> buckets, float maxMs) const;
+
+    String toJson(StringView name) const;
+
+private:
+    Vector<float> m_samples;
+    Vector<bool> m_missed;
+    size_t m_head{0};
+    size_t m_count{0};
+    size_t m_missedInWindow{0};
+
+    float m_targetMs{0.0f};
+    uint64_t m_totalFrames{0};
+    uint64_t m_totalMissedFrames{0};
+
+    bool isMiss(float frameTimeMs) const {
+        return m_targetMs > 0.0f && frameTimeMs > m_targetMs * (1.0f + MISS_TOLERANCE);
+    }
+};
+
+MOE_END_NAMESPACE
\ No newline at end of file
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "Core/Memory.hpp"
+
 #include <memory>
 #include <spdlog/logger.h>
 #include <spdlog/spdlog.h>
@@ -45,6 +47,7 @@ namespace moe {
 
         template<typename... Args>
         void log(spdlog::level::level_enum lvl, const char* fmt, Args&&... args) {
+            MemoryTagScope memoryTag(MemoryTag::Logging);
             auto threadName = getThreadName();
             auto output = fmt::format(fmt, std::forward<Args>(args)...);
             if (m_logger) m_logger->log(lvl, "[{}] {}", threadName, output);
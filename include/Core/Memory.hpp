@@ -0,0 +1,99 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// kept free of Common.hpp, the logger tags its own allocations and Common.hpp includes the logger
+
+namespace moe {
+    enum class MemoryTag : uint8_t {
+        General,
+        Render,
+        Physics,
+        Audio,
+        Network,
+        Font,
+        Logging,
+        Game,
+        Count,
+    };
+
+    namespace Memory {
+        constexpr size_t TAG_COUNT = static_cast<size_t>(MemoryTag::Count);
+
+        struct TagStats {
+            MemoryTag tag{MemoryTag::General};
+            int64_t currentBytes{0};
+            int64_t peakBytes{0};
+            int64_t liveAllocations{0};
+            uint64_t totalAllocations{0};
+            uint64_t totalBytes{0};
+
+            // over the last sampling interval, see sampleRates
+            double bytesPerSecond{0.0};
+            double allocationsPerSecond{0.0};
+        };
+
+        namespace Details {
+            // trivially initialized, safe to touch from operator new before the thread has run any other code
+            inline thread_local MemoryTag t_threadTag{MemoryTag::General};
+        }// namespace Details
+
+        const char* getTagName(MemoryTag tag);
+
+        // tag charged by allocations on this thread that do not name one explicitly
+        inline MemoryTag getThreadTag() {
+            return Details::t_threadTag;
+        }
+
+        // owner threads (physics, audio, network) set their tag once on startup
+        inline void setThreadTag(MemoryTag tag) {
+            Details::t_threadTag = tag;
+        }
+
+        // every tracked block carries a small header, so it must be released through deallocate
+        void* allocate(size_t size, size_t alignment, MemoryTag tag);
+
+        void deallocate(void* ptr);
+
+        // grows or shrinks a tracked block, the block keeps its original alignment
+        void* reallocate(void* ptr, size_t newSize);
+
+        // true when global new/delete route through the tracker, only the game executable installs the hooks
+        bool isGlobalTrackingEnabled();
+
+        void setGlobalTrackingEnabled(bool enabled);
+
+        std::array<TagStats, TAG_COUNT> getStats();
+
+        // recomputes the per-tag rates from the totals since the previous call
+        void sampleRates();
+
+        void logStats();
+    }// namespace Memory
+
+    // charges allocations in the enclosing scope to tag, restoring the previous tag on exit
+    struct MemoryTagScope {
+    public:
+        explicit MemoryTagScope(MemoryTag tag)
+            : m_previous(Memory::getThreadTag()) {
+            Memory::setThreadTag(tag);
+        }
+
+        ~MemoryTagScope() {
+            Memory::setThreadTag(m_previous);
+        }
+
+        MemoryTagScope(const MemoryTagScope&) = delete;
+        MemoryTagScope& operator=(const MemoryTagScope&) = delete;
+
+    private:
+        MemoryTag m_previous;
+    };
+}// namespace moe
+
+#define MOE_MEMORY_TAG_CONCAT_IMPL(_a, _b) _a##_b
+#define MOE_MEMORY_TAG_CONCAT(_a, _b) MOE_MEMORY_TAG_CONCAT_IMPL(_a, _b)
+
+#define MOE_MEMORY_TAG(_tag) ::moe::MemoryTagScope MOE_MEMORY_TAG_CONCAT(moeMemoryTagScope, __LINE__)(::moe::MemoryTag::_tag)
\ No newline at end of file
@@ -0,0 +1,121 @@
+#pragma once
+
+#include "Core/Common.hpp"
+
+#include <atomic>
+#include <memory>
+
+MOE_BEGIN_NAMESPACE
+
+// bounded lock-free queue, any number of producer threads, one consumer thread
+// cells are allocated once up front and reused, pushing and popping never allocate
+//
+// every cell carries a sequence number telling whose turn it is:
+// - sequence == position: free, the producer that claims position may fill it
+// - sequence == position + 1: filled, the consumer may take it
+// - after popping, the consumer hands the cell to the producer one lap ahead
+// producers claim positions with a CAS on the shared tail; a producer stalled between
+// claiming and filling a cell only delays the consumer at that cell, never other producers
+template<typename T>
+struct MpscQueue {
+public:
+    // rounded up to a power of two
+    explicit MpscQueue(size_t capacity) {
+        size_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+
+        m_mask = size - 1;
+        m_cells = std::make_unique<Cell[]>(size);
+        for (size_t i = 0; i < size; ++i) {
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    size_t capacity() const { return m_mask + 1; }
+
+    // any thread, false if the queue is full
+    bool tryPush(T&& value) {
+        size_t position = m_tail.load(std::memory_order_relaxed);
+        while (true) {
+            auto& cell = m_cells[position & m_mask];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+
+            if (diff == 0) {
+                if (m_tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    cell.value = std::move(value);
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                // the consumer has not freed this cell from the previous lap yet
+                return false;
+            } else {
+                position = m_tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool tryPush(const T& value) {
+        T copy = value;
+        return tryPush(std::move(copy));
+    }
+
+    // consumer thread only, false if the queue is empty
+    // or the oldest claimed cell is still being filled
+    bool tryPop(T& out) {
+        auto& cell = m_cells[m_head & m_mask];
+        size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        if (sequence != m_head + 1) {
+            return false;
+        }
+
+        out = std::move(cell.value);
+        // drop whatever the moved-from value still holds, it may keep captures alive for a whole lap
+        cell.value = T{};
+        cell.sequence.store(m_head + m_mask + 1, std::memory_order_release);
+        ++m_head;
+        return true;
+    }
+
+    // consumer thread only, pops at most maxCount values, returns how many were handled
+    // values pushed while draining wait for the next call once maxCount is reached
+    template<typename F>
+    size_t drain(F&& fn, size_t maxCount) {
+        size_t count = 0;
+        T value;
+        while (count < maxCount && tryPop(value)) {
+            fn(value);
+            ++count;
+        }
+        return count;
+    }
+
+    // consumer thread only, approximate while other threads push
+    size_t sizeApprox() const {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        return tail >= m_head ? tail - m_head : 0;
+    }
+
+private:
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+
+    struct Cell {
+        std::atomic_size_t sequence{0};
+        T value{};
+    };
+
+    UniquePtr<Cell[]> m_cells;
+    size_t m_mask{0};
+
+    // producers and the consumer hammer different lines
+    alignas(CACHE_LINE_SIZE) std::atomic_size_t m_tail{0};
+    alignas(CACHE_LINE_SIZE) size_t m_head{0};
+};
+
+MOE_END_NAMESPACE
\ No newline at end of file
@@ -0,0 +1,219 @@
+#pragma once
+
+#include "Core/Common.hpp"
+#include "Core/Meta/Feature.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+
+MOE_BEGIN_NAMESPACE
+
+namespace Profiling {
+    using TimestampNs = uint64_t;
+
+    inline TimestampNs now() {
+        return static_cast<TimestampNs>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now().time_since_epoch())
+                        .count());
+    }
+
+    struct ZoneEvent {
+        // must point to static storage, e.g. a string literal or __func__
+        const char* name{nullptr};
+        TimestampNs startNs{0};
+        TimestampNs endNs{0};
+        uint32_t depth{0};
+        uint32_t threadIndex{0};
+    };
+
+    // single producer (the owning thread), single consumer (the collector on main thread)
+    // events are dropped rather than blocking when the collector falls behind
+    struct ThreadBuffer : Meta::NonCopyable<ThreadBuffer> {
+    public:
+        static constexpr size_t CAPACITY = 1 << 14;
+
+        ThreadBuffer(uint32_t index, StringView name)
+            : threadIndex(index), threadName(name), m_events(std::make_unique<ZoneEvent[]>(CAPACITY)) {}
+
+        const uint32_t threadIndex;
+        String threadName;
+
+        // owner thread only
+        uint32_t depth{0};
+
+        bool push(const ZoneEvent& event) {
+            uint64_t head = m_head.load(std::memory_order_relaxed);
+            if (head - m_tail.load(std::memory_order_acquire) >= CAPACITY) {
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+
+            m_events[head & (CAPACITY - 1)] = event;
+            m_head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        template<typename F>
+        size_t drain(F&& fn) {
+            uint64_t tail = m_tail.load(std::memory_order_relaxed);
+            uint64_t head = m_head.load(std::memory_order_acquire);
+            for (uint64_t i = tail; i < head; ++i) {
+                fn(m_events[i & (CAPACITY - 1)]);
+            }
+            m_tail.store(head, std::memory_order_release);
+            return static_cast<size_t>(head - tail);
+        }
+
+        uint64_t droppedCount() const {
+            return m_dropped.load(std::memory_order_relaxed);
+        }
+
+    private:
+        UniquePtr<ZoneEvent[]> m_events;
+        std::atomic<uint64_t> m_head{0};
+        std::atomic<uint64_t> m_tail{0};
+        std::atomic<uint64_t> m_dropped{0};
+    };
+
+    struct FrameRecord {
+        uint64_t frameIndex{0};
+        TimestampNs startNs{0};
+        TimestampNs endNs{0};
+
+        // every event collected at the end of this frame, from all threads
+        // events of free running threads (e.g. physics) may start in an earlier frame
+        Vector<ZoneEvent> events;
+
+        float durationMs() const {
+            return static_cast<float>(endNs - startNs) / 1e6f;
+        }
+    };
+
+    struct ThreadInfo {
+        uint32_t threadIndex;
+        String threadName;
+        uint64_t droppedEvents;
+    };
+}// namespace Profiling
+
+// hierarchical cpu profiler
+// zones are recorded into lock-free per-thread buffers and collected once per frame on main thread
+struct Profiler : Meta::Singleton<Profiler> {
+public:
+    MOE_SINGLETON(Profiler)
+
+    static constexpr size_t HISTORY_FRAMES = 120;
+
+    void setEnabled(bool enabled) { m_enabled.store(enabled, std::memory_order_relaxed); }
+
+    bool isEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+    // stop appending to the frame history, buffers are still drained
+    void setPaused(bool paused) { m_paused = paused; }
+
+    bool isPaused() const { return m_paused; }
+
+    // name the calling thread, call once at the start of the thread
+    void registerThread(StringView name);
+
+    // lazily registers unnamed threads
+    Profiling::ThreadBuffer& getThreadBuffer();
+
+    // main thread only
+    // collects all thread buffers and closes the current frame
+    void endFrame();
+
+    // main thread only
+    const Deque<Profiling::FrameRecord>& getFrameHistory() const { return m_history; }
+
+    Vector<Profiling::ThreadInfo> getThreadInfos() const;
+
+    // captures record every collected event until endCapture,
+    // which writes a chrome://tracing / Perfetto compatible json file
+    void beginCapture();
+    bool endCapture(StringView filePath);
+
+    bool isCapturing() const { return m_capturing; }
+
+    size_t getCapturedEventCount() const { return m_captureEvents.size(); }
+
+private:
+    Profiler() = default;
+    ~Profiler() = default;
+
+    std::atomic_bool m_enabled{true};
+    bool m_paused{false};
+
+    mutable std::mutex m_threadsMutex;
+    Vector<UniquePtr<Profiling::ThreadBuffer>> m_threads;
+
+    Deque<Profiling::FrameRecord> m_history;
+    Vector<Profiling::FrameRecord> m_recycledRecords;
+    Profiling::TimestampNs m_frameStartNs{Profiling::now()};
+    uint64_t m_frameIndex{0};
+
+    bool m_capturing{false};
+    Vector<Profiling::ZoneEvent> m_captureEvents;
+
+    Profiling::ThreadBuffer& createThreadBuffer(StringView name);
+};
+
+struct ProfileZone {
+public:
+    explicit ProfileZone(const char* name) {
+        auto& profiler = Profiler::getInstance();
+        if (!profiler.isEnabled()) {
+            return;
+        }
+
+        m_buffer = &profiler.getThreadBuffer();
+        m_event.name = name;
+        m_event.depth = m_buffer->depth++;
+        m_event.threadIndex = m_buffer->threadIndex;
+        m_event.startNs = Profiling::now();
+    }
+
+    ~ProfileZone() {
+        if (!m_buffer) {
+            return;
+        }
+
+        m_event.endNs = Profiling::now();
+        m_buffer->depth--;
+        m_buffer->push(m_event);
+    }
+
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+
+private:
+    Profiling::ThreadBuffer* m_buffer{nullptr};
+    Profiling::ZoneEvent m_event;
+};
+
+MOE_END_NAMESPACE
+
+#define MOE_PROFILE_CONCAT_IMPL(_a, _b) _a##_b
+#define MOE_PROFILE_CONCAT(_a, _b) MOE_PROFILE_CONCAT_IMPL(_a, _b)
+
+#ifdef MOE_ENABLE_PROFILER
+
+#define MOE_PROFILE_SCOPE(_name) \
+    ::moe::ProfileZone MOE_PROFILE_CONCAT(_moeProfileZone, __COUNTER__)(_name)
+
+#define MOE_PROFILE_FUNCTION() MOE_PROFILE_SCOPE(__func__)
+
+#define MOE_PROFILE_THREAD(_name) ::moe::Profiler::getInstance().registerThread(_name)
+
+#define MOE_PROFILE_FRAME() ::moe::Profiler::getInstance().endFrame()
+
+#else
+
+#define MOE_PROFILE_SCOPE(_name) ((void) 0)
+#define MOE_PROFILE_FUNCTION() ((void) 0)
+#define MOE_PROFILE_THREAD(_name) ((void) 0)
+#define MOE_PROFILE_FRAME() ((void) 0)
+
+#endif// MOE_ENABLE_PROFILER
\ No newline at end of file
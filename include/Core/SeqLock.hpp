@@ -0,0 +1,83 @@
+#pragma once
+
+#include "Core/Common.hpp"
+
+#include <atomic>
+#include <cstring>
+#include <thread>
+
+MOE_BEGIN_NAMESPACE
+
+// sequence lock for small, trivially copyable values
+// single writer, any number of readers
+// writes never block; readers retry if they observe a concurrent write
+//
+// the payload is stored as atomic words instead of a raw T,
+// so a torn read is never a data race (and ThreadSanitizer stays quiet);
+// the sequence number decides whether the copy is kept or discarded
+template<typename T>
+struct SeqLock {
+public:
+    static_assert(std::is_trivially_copyable_v<T>, "SeqLock requires a trivially copyable type");
+
+    SeqLock() = default;
+
+    explicit SeqLock(const T& value) {
+        store(value);
+    }
+
+    // writer side, must not be called concurrently with itself
+    void store(const T& value) {
+        uint64_t words[WORD_COUNT]{};
+        std::memcpy(words, &value, sizeof(T));
+
+        uint64_t seq = m_sequence.load(std::memory_order_relaxed);
+        m_sequence.store(seq + 1, std::memory_order_relaxed);
+
+        // release keeps the odd sequence number ordered before the payload
+        for (size_t i = 0; i < WORD_COUNT; ++i) {
+            m_words[i].store(words[i], std::memory_order_release);
+        }
+
+        m_sequence.store(seq + 2, std::memory_order_release);
+    }
+
+    // reader side, safe from any thread
+    T load() const {
+        uint64_t words[WORD_COUNT];
+        while (true) {
+            uint64_t before = m_sequence.load(std::memory_order_acquire);
+            if (before & 1) {
+                // writer is in the middle of a store
+                std::this_thread::yield();
+                continue;
+            }
+
+            // acquire keeps the payload ordered before the second sequence check
+            for (size_t i = 0; i < WORD_COUNT; ++i) {
+                words[i] = m_words[i].load(std::memory_order_acquire);
+            }
+
+            if (m_sequence.load(std::memory_order_relaxed) == before) {
+                break;
+            }
+        }
+
+        T value;
+        std::memcpy(&value, words, sizeof(T));
+        return value;
+    }
+
+    // even number, increases by 2 per store
+    uint64_t sequence() const {
+        return m_sequence.load(std::memory_order_acquire);
+    }
+
+private:
+    static constexpr size_t WORD_COUNT = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    std::atomic<uint64_t> m_sequence{0};
+    std::atomic<uint64_t> m_words[WORD_COUNT]{};
+};
+
+MOE_END_NAMESPACE
\ No newline at end of file
@@ -25,10 +25,8 @@ public:
         }
     }
 
-    Connection(Connection&& other) noexcept {
-        m_signal = other.m_signal;
-        m_id = other.m_id;
-        other.m_signal.release();
+    Connection(Connection&& other) noexcept
+        : m_signal(std::move(other.m_signal)), m_id(other.m_id) {
         other.m_id = INVALID_CONNECTION_ID;
     }
 
@@ -37,9 +35,8 @@ public:
             if (isConnected()) {
                 disconnect();
             }
-            m_signal = other.m_signal;
+            m_signal = std::move(other.m_signal);
             m_id = other.m_id;
-            other.m_signal.release();
             other.m_id = INVALID_CONNECTION_ID;
         }
         return *this;
@@ -48,7 +45,7 @@ public:
     void disconnect() {
         if (m_signal) {
             m_signal->disconnect(m_id);
-            m_signal.release();
+            m_signal.reset();
             m_id = INVALID_CONNECTION_ID;
         }
     }
@@ -0,0 +1,232 @@
+#pragma once
+
+#include "Core/Common.hpp"
+#include "Core/SeqLock.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+
+MOE_BEGIN_NAMESPACE
+
+// versioned snapshot channel for large, array-like payloads
+// one producer thread, one consumer thread (plus any number of stamp observers)
+//
+// consistency model:
+// - the producer edits a private master array and calls publish(tick);
+//   every publish gets a strictly increasing version
+// - the consumer calls acquire() once per frame; it is wait-free
+//   (a single atomic exchange) and yields the newest published snapshot,
+//   which stays immutable until the next acquire()
+// - a snapshot is always complete: all entries belong to the same publish,
+//   never a mix of two publishes
+// - each entry carries the version it was last changed at,
+//   so consumers can skip entries they have already seen
+// - latest() may be called from any thread, it returns the version/tick
+//   of the newest publish (seqlock protected), which together with the
+//   acquired view tells how stale the consumer is
+// - every publish carries the time it stands for, consumers interpolate
+//   between two publishes with it
+//
+// publishing is incremental: only entries written since the recycled slot
+// was last filled are copied into it, so the cost scales with the number of
+// changed entries, not with the size of the payload
+template<typename T>
+struct SnapshotChannel {
+public:
+    static constexpr size_t SLOT_COUNT = 3;
+    static constexpr size_t JOURNAL_LENGTH = 4;
+
+    using Clock = std::chrono::steady_clock;
+
+    struct Stamp {
+        uint64_t version{0};
+        uint64_t tick{0};
+        Clock::time_point time{};
+    };
+
+    struct View {
+    public:
+        Span<const T> entries;
+        Span<const uint64_t> entryVersions;
+        uint64_t version{0};
+        uint64_t tick{0};
+        Clock::time_point time{};
+
+        size_t size() const { return entries.size(); }
+
+        bool empty() const { return entries.empty(); }
+
+        const T& operator[](size_t index) const { return entries[index]; }
+
+        // whether the entry changed after the given version was published
+        bool changedSince(size_t index, uint64_t sinceVersion) const {
+            return entryVersions[index] > sinceVersion;
+        }
+    };
+
+    SnapshotChannel() {
+        for (size_t i = 0; i < SLOT_COUNT; ++i) {
+            m_slots[i].index = static_cast<uint32_t>(i);
+        }
+        m_writeSlot = &m_slots[0];
+        m_pendingSlot.store(1, std::memory_order_relaxed);
+        m_readSlot = &m_slots[2];
+    }
+
+    // producer
+
+    // entries added by growing are default constructed and count as changed
+    void resize(size_t count) {
+        size_t oldCount = m_entries.size();
+        if (count < oldCount) {
+            m_dirtyIndices.erase(
+                    std::remove_if(
+                            m_dirtyIndices.begin(), m_dirtyIndices.end(),
+                            [count](uint32_t index) { return index >= count; }),
+                    m_dirtyIndices.end());
+        }
+
+        m_entries.resize(count);
+        m_entryVersions.resize(count, 0);
+        m_dirtyFlags.resize(count, 0);
+        for (size_t i = oldCount; i < count; ++i) {
+            markDirty(i);
+        }
+    }
+
+    size_t size() const { return m_entries.size(); }
+
+    const T& peek(size_t index) const { return m_entries[index]; }
+
+    // mutable access to an entry, marks it as changed
+    T& edit(size_t index) {
+        markDirty(index);
+        return m_entries[index];
+    }
+
+    void write(size_t index, const T& value) {
+        edit(index) = value;
+    }
+
+    void publish(uint64_t tick, Clock::time_point time = Clock::now()) {
+        uint64_t version = ++m_version;
+
+        for (auto index: m_dirtyIndices) {
+            m_entryVersions[index] = version;
+            m_dirtyFlags[index] = 0;
+        }
+
+        // recycle the oldest journal entry, keeping its capacity
+        auto& record = m_journal[version % JOURNAL_LENGTH];
+        record.version = version;
+        std::swap(record.indices, m_dirtyIndices);
+        m_dirtyIndices.clear();
+
+        syncSlot(*m_writeSlot, version);
+        m_writeSlot->version = version;
+        m_writeSlot->tick = tick;
+        m_writeSlot->time = time;
+
+        // stamp first, so latest() is never behind an acquirable snapshot
+        m_latest.store(Stamp{version, tick, time});
+
+        uint32_t previous = m_pendingSlot.exchange(
+                m_writeSlot->index | NEW_DATA_BIT,
+                std::memory_order_acq_rel);
+        m_writeSlot = &m_slots[previous & SLOT_MASK];
+    }
+
+    // consumer
+
+    // swap in the newest snapshot, returns false if nothing new was published
+    bool acquire() {
+        if (!(m_pendingSlot.load(std::memory_order_relaxed) & NEW_DATA_BIT)) {
+            return false;
+        }
+
+        uint32_t previous = m_pendingSlot.exchange(m_readSlot->index, std::memory_order_acq_rel);
+        m_readSlot = &m_slots[previous & SLOT_MASK];
+        return true;
+    }
+
+    View view() const {
+        return View{
+                .entries = Span<const T>(m_readSlot->entries),
+                .entryVersions = Span<const uint64_t>(m_readSlot->entryVersions),
+                .version = m_readSlot->version,
+                .tick = m_readSlot->tick,
+                .time = m_readSlot->time,
+        };
+    }
+
+    // any thread
+
+    Stamp latest() const { return m_latest.load(); }
+
+private:
+    static constexpr uint32_t NEW_DATA_BIT = 0x80000000u;
+    static constexpr uint32_t SLOT_MASK = ~NEW_DATA_BIT;
+
+    struct Slot {
+        Vector<T> entries;
+        Vector<uint64_t> entryVersions;
+        uint64_t version{0};
+        uint64_t tick{0};
+        Clock::time_point time{};
+        uint32_t index{0};
+    };
+
+    struct JournalRecord {
+        uint64_t version{0};
+        Vector<uint32_t> indices;
+    };
+
+    // producer exclusive
+    Vector<T> m_entries;
+    Vector<uint64_t> m_entryVersions;
+    Vector<uint8_t> m_dirtyFlags;
+    Vector<uint32_t> m_dirtyIndices;
+    Array<JournalRecord, JOURNAL_LENGTH> m_journal;
+    uint64_t m_version{0};
+    Slot* m_writeSlot{nullptr};
+
+    // consumer exclusive
+    Slot* m_readSlot{nullptr};
+
+    Slot m_slots[SLOT_COUNT];
+    std::atomic<uint32_t> m_pendingSlot{0};
+
+    SeqLock<Stamp> m_latest;
+
+    void markDirty(size_t index) {
+        if (!m_dirtyFlags[index]) {
+            m_dirtyFlags[index] = 1;
+            m_dirtyIndices.push_back(static_cast<uint32_t>(index));
+        }
+    }
+
+    // bring a recycled slot up to the given version
+    void syncSlot(Slot& slot, uint64_t version) {
+        bool journalCovers = slot.version + JOURNAL_LENGTH >= version;
+        if (!journalCovers || slot.entries.size() != m_entries.size()) {
+            slot.entries = m_entries;
+            slot.entryVersions = m_entryVersions;
+            return;
+        }
+
+        for (uint64_t v = slot.version + 1; v <= version; ++v) {
+            const auto& record = m_journal[v % JOURNAL_LENGTH];
+            for (auto index: record.indices) {
+                // entries may have been dropped by a shrinking resize
+                if (index >= m_entries.size()) {
+                    continue;
+                }
+                slot.entries[index] = m_entries[index];
+                slot.entryVersions[index] = m_entryVersions[index];
+            }
+        }
+    }
+};
+
+MOE_END_NAMESPACE
\ No newline at end of file
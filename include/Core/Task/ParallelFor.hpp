@@ -0,0 +1,23 @@
+#pragma once
+
+#include "Core/Common.hpp"
+#include "Core/Task/Scheduler.hpp"
+
+MOE_BEGIN_NAMESPACE
+
+// runs fn(slot, chunk) once for every chunk in [0, chunks), on the scheduler's workers and the calling thread,
+// and returns once every chunk has run
+// at most maxSlots threads take part, each under its own slot in [0, maxSlots), the calling thread under slot 0
+// a slot is held by one thread for the whole call, so what is kept per slot, e.g. a command pool, needs no lock
+void parallelFor(
+        ThreadPoolScheduler& scheduler,
+        uint32_t maxSlots,
+        uint32_t chunks,
+        const Function<void(uint32_t, uint32_t)>& fn);
+
+// every worker may help
+inline void parallelFor(ThreadPoolScheduler& scheduler, uint32_t chunks, const Function<void(uint32_t, uint32_t)>& fn) {
+    parallelFor(scheduler, static_cast<uint32_t>(scheduler.workerCount() + 1), chunks, fn);
+}
+
+MOE_END_NAMESPACE
\ No newline at end of file
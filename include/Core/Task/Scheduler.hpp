@@ -10,6 +10,13 @@
 
 MOE_BEGIN_NAMESPACE
 
+enum class TaskPriority : uint8_t {
+    // short tasks another thread is blocked on, e.g. physics jobs
+    High,
+    // everything else, including background loading
+    Normal,
+};
+
 struct ThreadPoolScheduler {
 public:
     static ThreadPoolScheduler& getInstance();
@@ -18,17 +25,19 @@ public:
 
     static void shutdown();
 
-    void schedule(Function<void()> task);
+    // high priority tasks are picked before any queued normal task, a running task is never preempted
+    void schedule(Function<void()> task, TaskPriority priority = TaskPriority::Normal);
 
     size_t workerCount() const { return m_workers.size(); }
 
     template<typename F>
-    void schedule(F&& task) {
-        schedule(Function<void()>(std::forward<F>(task)));
+    void schedule(F&& task, TaskPriority priority = TaskPriority::Normal) {
+        schedule(Function<void()>(std::forward<F>(task)), priority);
     }
 
 private:
     Vector<std::thread> m_workers;
+    Queue<Function<void()>> m_highPriorityTasks;
     Queue<Function<void()>> m_tasks;
     std::mutex m_mutex;
     std::condition_variable m_cv;
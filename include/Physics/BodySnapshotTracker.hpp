@@ -0,0 +1,123 @@
+#pragma once
+
+#include "Physics/JoltIncludes.hpp"
+#include "Physics/ObjectSnapshot.hpp"
+
+#include "Core/SnapshotChannel.hpp"
+
+#include <atomic>
+#include <mutex>
+
+MOE_BEGIN_PHYSICS_NAMESPACE
+
+// read side of the body snapshots, one entry per body slot
+// stays valid until the owning tracker acquires again
+struct SnapshotView {
+public:
+    using Channel = SnapshotChannel<ObjectSnapshot>;
+
+    SnapshotView() = default;
+
+    explicit SnapshotView(Channel::View view)
+        : m_view(view) {}
+
+    // empty until the body has been synced once, and again after it is removed
+    Optional<ObjectSnapshot> getSnapshot(JPH::BodyID id) const {
+        if (auto* snapshot = find(id)) {
+            return *snapshot;
+        }
+        return {};
+    }
+
+    // publish version the body's snapshot last changed at, 0 if the body is unknown
+    uint64_t getSnapshotVersion(JPH::BodyID id) const {
+        return find(id) ? m_view.entryVersions[id.GetIndex()] : 0;
+    }
+
+    // whether the body moved after the given publish version, unknown bodies never changed
+    bool changedSince(JPH::BodyID id, uint64_t sinceVersion) const {
+        return getSnapshotVersion(id) > sinceVersion;
+    }
+
+    // version and physics tick of the publish this view belongs to
+    uint64_t getVersion() const { return m_view.version; }
+
+    uint64_t getTick() const { return m_view.tick; }
+
+    // the time the published tick stands for, consumers interpolate between publishes with it
+    Channel::Clock::time_point getTime() const { return m_view.time; }
+
+    // every slot, empty slots hold an invalid body id
+    const Channel::View& getEntries() const { return m_view; }
+
+private:
+    Channel::View m_view;
+
+    const ObjectSnapshot* find(JPH::BodyID id) const {
+        if (id.IsInvalid() || id.GetIndex() >= m_view.size()) {
+            return nullptr;
+        }
+
+        // a reused slot holds a different sequence number
+        auto& snapshot = m_view[id.GetIndex()];
+        return snapshot.bodyID == id ? &snapshot : nullptr;
+    }
+};
+
+// keeps a dense snapshot of every body transform, indexed by body slot, and publishes it once per tick
+// a sync only reads back bodies that can have moved: the active list, bodies that fell asleep since the last sync
+// (their last step still moved them) and bodies flagged through markMoved; entries that did not change are not
+// written, so a world of sleeping bodies costs next to nothing
+// creating or destroying bodies changes the body count, which rescans every body once; adding or removing
+// an existing body does not, so those must go through markMoved
+struct BodySnapshotTracker final : public JPH::BodyActivationListener {
+public:
+    // physics thread
+
+    // returns the number of entries that changed
+    size_t sync(JPH::PhysicsSystem& system, uint64_t tick, SnapshotView::Channel::Clock::time_point time = SnapshotView::Channel::Clock::now());
+
+    // any thread
+
+    // moving a sleeping body without activating it is invisible to the active list
+    void markMoved(JPH::BodyID id);
+
+    // rescans every body on the next sync, for structural changes that keep the body count
+    void requestFullRescan() { m_fullRescanRequested.store(true, std::memory_order_relaxed); }
+
+    SnapshotView::Channel::Stamp latest() const { return m_channel.latest(); }
+
+    // consumer thread
+
+    // swaps in the newest publish, returns false if nothing new was published
+    bool acquire() { return m_channel.acquire(); }
+
+    SnapshotView view() const { return SnapshotView(m_channel.view()); }
+
+    // called by jolt, possibly from its job threads
+
+    void OnBodyActivated(const JPH::BodyID& inBodyID, JPH::uint64 inBodyUserData) override {}
+
+    void OnBodyDeactivated(const JPH::BodyID& inBodyID, JPH::uint64 inBodyUserData) override {
+        markMoved(inBodyID);
+    }
+
+private:
+    SnapshotView::Channel m_channel;
+
+    // physics thread exclusive
+    JPH::BodyIDVector m_bodyIdCache;
+    Vector<JPH::BodyID> m_pendingScratch;
+    Vector<uint8_t> m_seenFlags;
+    JPH::uint m_lastBodyCount{0};
+
+    std::atomic_bool m_fullRescanRequested{true};
+
+    std::mutex m_pendingMutex;
+    Vector<JPH::BodyID> m_pendingBodies;
+
+    size_t rescanAll(JPH::PhysicsSystem& system, const JPH::BodyLockInterface& lockInterface);
+    bool syncBody(const JPH::BodyLockInterface& lockInterface, JPH::BodyID id);
+};
+
+MOE_END_PHYSICS_NAMESPACE
\ No newline at end of file
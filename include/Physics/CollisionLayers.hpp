@@ -0,0 +1,122 @@
+#pragma once
+
+#include "Physics/JoltIncludes.hpp"
+
+#include "Core/Common.hpp"
+
+MOE_BEGIN_PHYSICS_NAMESPACE
+
+namespace Details {
+    // object layers of the default collision config
+    namespace Layers {
+        static constexpr JPH::ObjectLayer STATIC = JPH::ObjectLayer(0);
+        static constexpr JPH::ObjectLayer DYNAMIC = JPH::ObjectLayer(1);
+        static constexpr JPH::ObjectLayer CHARACTER = JPH::ObjectLayer(2);
+        static constexpr JPH::ObjectLayer PROJECTILE = JPH::ObjectLayer(3);
+        static constexpr JPH::ObjectLayer TRIGGER = JPH::ObjectLayer(4);
+        static constexpr JPH::ObjectLayer DEBRIS = JPH::ObjectLayer(5);
+        static constexpr JPH::ObjectLayer NUM_LAYERS = JPH::ObjectLayer(6);
+
+        // the two layers everything lived on before the matrix
+        static constexpr JPH::ObjectLayer NON_MOVING = STATIC;
+        static constexpr JPH::ObjectLayer MOVING = DYNAMIC;
+    }// namespace Layers
+
+    namespace BroadPhaseLayers {
+        static constexpr JPH::BroadPhaseLayer NON_MOVING(0);
+        static constexpr JPH::BroadPhaseLayer MOVING(1);
+        static constexpr JPH::BroadPhaseLayer TRIGGER(2);
+        static constexpr JPH::BroadPhaseLayer DEBRIS(3);
+        static constexpr JPH::uint NUM_LAYERS(4);
+    }// namespace BroadPhaseLayers
+}// namespace Details
+
+// the object layers, the broad phase layer each one is sorted into and which pairs of object layers collide
+// the jolt filters are built from this, so changing the matrix is a data change
+struct CollisionLayerConfig {
+public:
+    // the collision masks are 64 bit
+    static constexpr size_t MAX_LAYERS = 64;
+
+    struct ObjectLayer {
+        String name;
+        JPH::BroadPhaseLayer::Type broadPhaseLayer{0};
+        // bit n set collides with object layer n, kept symmetric by setCollides
+        uint64_t collidesWith{0};
+    };
+
+    Vector<String> broadPhaseLayers;
+    Vector<ObjectLayer> objectLayers;
+
+    // static, dynamic, character, projectile, trigger and debris, see Details::Layers
+    static CollisionLayerConfig createDefault();
+
+    Optional<JPH::ObjectLayer> findObjectLayer(StringView name) const;
+    Optional<JPH::BroadPhaseLayer::Type> findBroadPhaseLayer(StringView name) const;
+
+    // sets both directions
+    void setCollides(JPH::ObjectLayer a, JPH::ObjectLayer b, bool collides);
+
+    bool collides(JPH::ObjectLayer a, JPH::ObjectLayer b) const {
+        return (objectLayers[a].collidesWith >> b) & 1;
+    }
+
+    // logs and returns false for configs jolt cannot use
+    bool validate() const;
+};
+
+namespace Details {
+    class BPLayerInterfaceImpl final : public JPH::BroadPhaseLayerInterface {
+    public:
+        explicit BPLayerInterfaceImpl(const CollisionLayerConfig& config);
+
+        virtual JPH::uint GetNumBroadPhaseLayers() const override {
+            return static_cast<JPH::uint>(m_broadPhaseLayerNames.size());
+        }
+
+        virtual JPH::BroadPhaseLayer GetBroadPhaseLayer(JPH::ObjectLayer inLayer) const override {
+            JPH_ASSERT(inLayer < m_objectToBroadPhase.size());
+            return m_objectToBroadPhase[inLayer];
+        }
+
+#if defined(JPH_EXTERNAL_PROFILE) || defined(JPH_PROFILE_ENABLED)
+        virtual const char* GetBroadPhaseLayerName(JPH::BroadPhaseLayer inLayer) const override {
+            auto index = static_cast<size_t>((JPH::BroadPhaseLayer::Type) inLayer);
+            return index < m_broadPhaseLayerNames.size() ? m_broadPhaseLayerNames[index].c_str() : "INVALID";
+        }
+#endif// JPH_EXTERNAL_PROFILE || JPH_PROFILE_ENABLED
+
+    private:
+        Vector<JPH::BroadPhaseLayer> m_objectToBroadPhase;
+        Vector<String> m_broadPhaseLayerNames;
+    };
+
+    class ObjectVsBroadPhaseLayerFilterImpl : public JPH::ObjectVsBroadPhaseLayerFilter {
+    public:
+        explicit ObjectVsBroadPhaseLayerFilterImpl(const CollisionLayerConfig& config);
+
+        virtual bool ShouldCollide(JPH::ObjectLayer inLayer1, JPH::BroadPhaseLayer inLayer2) const override {
+            JPH_ASSERT(inLayer1 < m_broadPhaseMasks.size());
+            return (m_broadPhaseMasks[inLayer1] >> (JPH::BroadPhaseLayer::Type) inLayer2) & 1;
+        }
+
+    private:
+        // per object layer, bit n set when any object layer in broad phase layer n collides with it
+        Vector<uint64_t> m_broadPhaseMasks;
+    };
+
+    class ObjectLayerFilterImpl : public JPH::ObjectLayerPairFilter {
+    public:
+        explicit ObjectLayerFilterImpl(const CollisionLayerConfig& config);
+
+        virtual bool ShouldCollide(JPH::ObjectLayer inObject1, JPH::ObjectLayer inObject2) const override {
+            JPH_ASSERT(inObject1 < m_masks.size());
+            return (m_masks[inObject1] >> inObject2) & 1;
+        }
+
+    private:
+        Vector<uint64_t> m_masks;
+    };
+}// namespace Details
+
+MOE_END_PHYSICS_NAMESPACE
\ No newline at end of file
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "Physics/JoltIncludes.hpp"
+
+#include "Core/Common.hpp"
+
+MOE_BEGIN_PHYSICS_NAMESPACE
+
+// a fully built shape stored with jolt's binary shape state, restoring skips building mesh bvhs
+// compound children and materials are saved along with it
+struct CookedShape {
+public:
+    JPH::ShapeRefC shape;
+
+    Vector<uint8_t> serialize() const;
+
+    // fails on data from another jolt build or a truncated file
+    static Optional<CookedShape> deserialize(Span<const uint8_t> data);
+};
+
+MOE_END_PHYSICS_NAMESPACE
\ No newline at end of file
@@ -2,13 +2,47 @@
 
 #include "Core/Common.hpp"
 
+#include "Physics/CookedShape.hpp"
 #include "Physics/JoltIncludes.hpp"
 #include <Jolt/Physics/Collision/Shape/StaticCompoundShape.h>
 
 MOE_BEGIN_PHYSICS_NAMESPACE
 
+// everything besides the file that changes the built shape, part of the cooked collider key
+struct GltfColliderSettings {
+    uint32_t maxTrianglesPerLeaf{8};
+    // cos of the angle below which mesh edges are treated as smooth, jolt's default is 5 degrees
+    float activeEdgeCosThresholdAngle{0.996195f};
+
+    uint64_t hashCode() const;
+};
+
+// generator for Cached, keyed by the hash of the gltf file contents and the settings
+// so an edited model or changed settings cook again instead of loading a stale shape
+struct GltfColliderCooker {
+public:
+    using value_type = CookedShape;
+
+    GltfColliderCooker(StringView filePath, const GltfColliderSettings& settings);
+
+    Optional<value_type> generate();
+
+    uint64_t hashCode() const;
+
+    String paramString() const;
+
+private:
+    String m_filePath;
+    GltfColliderSettings m_settings;
+    Optional<Vector<uint8_t>> m_fileData;
+    uint64_t m_fileHash{0};
+};
+
 struct GltfColliderFactory {
-    static JPH::Ref<JPH::StaticCompoundShapeSettings> shapeFromGltf(StringView filePath);
+    static JPH::Ref<JPH::StaticCompoundShapeSettings> shapeFromGltf(StringView filePath, const GltfColliderSettings& settings = {});
+
+    // builds the shape on the first run and restores it from the cache on later ones
+    static JPH::ShapeRefC cookedShapeFromGltf(StringView filePath, const GltfColliderSettings& settings = {});
 };
 
 MOE_END_PHYSICS_NAMESPACE
\ No newline at end of file
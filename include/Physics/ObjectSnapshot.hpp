@@ -7,10 +7,11 @@
 MOE_BEGIN_PHYSICS_NAMESPACE
 
 struct ObjectSnapshot {
+    // invalid for empty body slots
     JPH::BodyID bodyID;
 
-    JPH::Vec3 position;
-    JPH::Quat rotation;
+    JPH::Vec3 position{JPH::Vec3::sZero()};
+    JPH::Quat rotation{JPH::Quat::sIdentity()};
 };
 
 MOE_END_PHYSICS_NAMESPACE
\ No newline at end of file
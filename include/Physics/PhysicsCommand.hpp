@@ -0,0 +1,49 @@
+#pragma once
+
+#include "Physics/JoltIncludes.hpp"
+
+#include "Core/Common.hpp"
+
+MOE_BEGIN_NAMESPACE
+
+struct PhysicsEngine;
+
+MOE_END_NAMESPACE
+
+MOE_BEGIN_PHYSICS_NAMESPACE
+
+// typed commands for the common body operations, they fit a queue cell and never allocate
+// bodies can be created on any thread through the locking body interface, adding them is a command
+
+struct AddBodyCommand {
+    JPH::BodyID bodyID;
+    JPH::EActivation activation{JPH::EActivation::Activate};
+};
+
+struct RemoveBodyCommand {
+    JPH::BodyID bodyID;
+    // also destroys the body, the id is invalid afterwards
+    bool destroy{true};
+};
+
+struct SetVelocityCommand {
+    JPH::BodyID bodyID;
+    JPH::Vec3 linearVelocity{JPH::Vec3::sZero()};
+    JPH::Vec3 angularVelocity{JPH::Vec3::sZero()};
+};
+
+struct ActivateBodyCommand {
+    JPH::BodyID bodyID;
+};
+
+// anything else, may allocate for large captures
+using CallbackCommand = Function<void(PhysicsEngine&)>;
+
+using PhysicsCommand = Variant<
+        AddBodyCommand,
+        RemoveBodyCommand,
+        SetVelocityCommand,
+        ActivateBodyCommand,
+        CallbackCommand>;
+
+MOE_END_PHYSICS_NAMESPACE
\ No newline at end of file
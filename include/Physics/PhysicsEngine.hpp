@@ -1,10 +1,20 @@
 #pragma once
 
+#include "Physics/BodySnapshotTracker.hpp"
+#include "Physics/CollisionLayers.hpp"
+#include "Physics/PhysicsCommand.hpp"
+#include "Physics/PhysicsProfiler.hpp"
+#include "Physics/RollbackBuffer.hpp"
 #include "Physics/JoltIncludes.hpp"
-#include "Physics/ObjectSnapshot.hpp"
+#include "Physics/SceneQuery.hpp"
+#include "Physics/SchedulerJobSystem.hpp"
+#include "Physics/SnapshotInterpolator.hpp"
 
+#include "Core/FixedStepClock.hpp"
+#include "Core/Memory.hpp"
+#include "Core/MpscQueue.hpp"
 #include "Core/Meta/Feature.hpp"
-#include "Core/TBuffer.hpp"
+#include "Core/SeqLock.hpp"
 
 
 #include <stdarg.h>
@@ -22,6 +32,25 @@ namespace Physics::Details {
         Logger::info("JoltPhysics trace: {}", buffer);
     }
 
+    // jolt allocations are charged to the physics tag whichever thread makes them
+    static void* AllocateImpl(size_t inSize) {
+        return Memory::allocate(inSize, alignof(std::max_align_t), MemoryTag::Physics);
+    }
+
+    static void* AlignedAllocateImpl(size_t inSize, size_t inAlignment) {
+        return Memory::allocate(inSize, inAlignment, MemoryTag::Physics);
+    }
+
+    static void FreeImpl(void* inBlock) {
+        Memory::deallocate(inBlock);
+    }
+
+#if JPH_VERSION_MAJOR >= 5
+    static void* ReallocateImpl(void* inBlock, size_t inOldSize, size_t inNewSize) {
+        return Memory::reallocate(inBlock, inNewSize);
+    }
+#endif
+
 #ifdef JPH_ENABLE_ASSERTS
 
     static bool AssertFailedImpl(const char* inExpression, const char* inMessage, const char* inFile, JPH::uint inLine) {
@@ -31,84 +60,34 @@ namespace Physics::Details {
     };
 
 #endif// JPH_ENABLE_ASSERTS
+}// namespace Physics::Details
 
-    namespace Layers {
-        static constexpr JPH::ObjectLayer NON_MOVING = JPH::ObjectLayer(0);
-        static constexpr JPH::ObjectLayer MOVING = JPH::ObjectLayer(1);
-        static constexpr JPH::ObjectLayer NUM_LAYERS = JPH::ObjectLayer(2);
-    }// namespace Layers
-
-    class ObjectLayerFilterImpl : public JPH::ObjectLayerPairFilter {
-    public:
-        virtual bool ShouldCollide(JPH::ObjectLayer inObject1, JPH::ObjectLayer inObject2) const override {
-            switch (inObject1) {
-                case Layers::NON_MOVING:
-                    return inObject2 == Layers::MOVING;
-                case Layers::MOVING:
-                    return true;
-                default:
-                    JPH_ASSERT(false);
-                    return false;
-            }
-        }
-    };
+struct PhysicsEngineInitializers {
+    // the last part of the wait between ticks is spun for precision, longer windows trade cpu for lower jitter
+    std::chrono::microseconds spinWindow{1000};
+    // ticks run back to back after a stall before the rest are dropped
+    uint32_t maxCatchUpSubsteps{4};
 
-    namespace BroadPhaseLayers {
-        static constexpr JPH::BroadPhaseLayer NON_MOVING(0);
-        static constexpr JPH::BroadPhaseLayer MOVING(1);
-        static constexpr JPH::uint NUM_LAYERS(2);
-    }// namespace BroadPhaseLayers
-
-    class BPLayerInterfaceImpl final : public JPH::BroadPhaseLayerInterface {
-    public:
-        BPLayerInterfaceImpl() {
-            // Create a mapping table from object to broad phase layer
-            m_objectToBroadPhase[Layers::NON_MOVING] = BroadPhaseLayers::NON_MOVING;
-            m_objectToBroadPhase[Layers::MOVING] = BroadPhaseLayers::MOVING;
-        }
-
-        virtual JPH::uint GetNumBroadPhaseLayers() const override {
-            return BroadPhaseLayers::NUM_LAYERS;
-        }
-
-        virtual JPH::BroadPhaseLayer GetBroadPhaseLayer(JPH::ObjectLayer inLayer) const override {
-            JPH_ASSERT(inLayer < Layers::NUM_LAYERS);
-            return m_objectToBroadPhase[inLayer];
-        }
-
-#if defined(JPH_EXTERNAL_PROFILE) || defined(JPH_PROFILE_ENABLED)
-        virtual const char* GetBroadPhaseLayerName(JPH::BroadPhaseLayer inLayer) const override {
-            switch ((JPH::BroadPhaseLayer::Type) inLayer) {
-                case (JPH::BroadPhaseLayer::Type) BroadPhaseLayers::NON_MOVING:
-                    return "NON_MOVING";
-                case (JPH::BroadPhaseLayer::Type) BroadPhaseLayers::MOVING:
-                    return "MOVING";
-                default:
-                    JPH_ASSERT(false);
-                    return "INVALID";
-            }
-        }
-#endif// JPH_EXTERNAL_PROFILE || JPH_PROFILE_ENABLED
-
-    private:
-        JPH::BroadPhaseLayer m_objectToBroadPhase[Layers::NUM_LAYERS];
-    };
+    // jolt preallocates for these, going over fails body creation or drops contacts
+    uint32_t maxBodies{1024};
+    // 0 picks jolt's default
+    uint32_t numBodyMutexes{0};
+    uint32_t maxBodyPairs{1024};
+    uint32_t maxContactConstraints{1024};
+    size_t tempAllocatorBytes{1024 * 1024};
 
-    class ObjectVsBroadPhaseLayerFilterImpl : public JPH::ObjectVsBroadPhaseLayerFilter {
-    public:
-        virtual bool ShouldCollide(JPH::ObjectLayer inLayer1, JPH::BroadPhaseLayer inLayer2) const override {
-            switch (inLayer1) {
-                case Layers::NON_MOVING:
-                    return inLayer2 == BroadPhaseLayers::MOVING;
-                case Layers::MOVING:
-                    return true;
-                default:
-                    JPH_ASSERT(false);
-                    return false;
-            }
-        }
-    };
-}// namespace Physics::Details
+    Physics::CollisionLayerConfig collisionLayers{Physics::CollisionLayerConfig::createDefault()};
+
+    // run jolt jobs on the ThreadPoolScheduler, which must be initialized first,
+    // instead of a dedicated JPH::JobSystemThreadPool
+    bool useEngineScheduler{true};
+
+    // ticks of world state kept for rollbackAndResimulate, 0 skips saving every tick
+    uint32_t rollbackFrames{0};
+
+    // time jolt's jobs per phase for the tick stats, costs an extra std::function per job
+    bool profileJobPhases{true};
+};
 
 struct PhysicsEngine : Meta::Singleton<PhysicsEngine> {
 public:
@@ -117,37 +96,64 @@ public:
     using Duration = std::chrono::duration<float, std::chrono::seconds::period>;
     using RoundTripTimeMs = uint64_t;
 
-    static constexpr JPH::uint MAX_BODIES = 1024;
-    static constexpr JPH::uint NUM_BODY_MUTEXES = 0;
-    static constexpr JPH::uint MAX_BODY_PAIRS = 1024;
-    static constexpr JPH::uint MAX_CONTACT_CONSTRAINTS = 1024;
+    // share of the body capacity that triggers a warning
+    static constexpr float BODY_CAPACITY_WARNING_RATIO = 0.9f;
 
     static constexpr Duration PHYSICS_TIMESTEP = Duration(1.0f / 60.0f);
 
-    struct SwapBuffer {
-        UnorderedMap<JPH::BodyID, Physics::ObjectSnapshot> objectSnapshots;
-
-        Optional<Physics::ObjectSnapshot> getSnapshot(JPH::BodyID id) const {
-            if (auto it = objectSnapshots.find(id); it != objectSnapshots.end()) {
-                return it->second;
-            }
-            return {};
-        }
-    };
-
     struct Stats {
-        float physicsFrameTime;
-        float physicsTicksPerSecond;
+        float physicsFrameTime{0.0f};
+        float physicsTicksPerSecond{0.0f};
+
+        // fixed step clock, percentiles over the last ticks
+        float timingErrorP99Ms{0.0f};
+        float jitterP50Ms{0.0f};
+        float jitterP99Ms{0.0f};
+        float jitterMaxMs{0.0f};
+        float workP50Ms{0.0f};
+        float workP99Ms{0.0f};
+        // share of one core used by ticks and the spin wait
+        float busyPercent{0.0f};
+        float spinPercent{0.0f};
+        uint64_t catchUpTicks{0};
+        uint64_t droppedTicks{0};
+
+        uint32_t numBodies{0};
+        uint32_t numActiveBodies{0};
+        uint32_t maxBodies{0};
+        // ticks where jolt ran out of pair or contact capacity since init
+        uint64_t capacityOverflowTicks{0};
+
+        // ticks whose work took longer than the timestep since init
+        uint64_t tickOverruns{0};
+        uint32_t numConstraints{0};
+        // highest temp allocator high-water mark of the interval against its size
+        uint32_t tempAllocatorPeakBytes{0};
+        uint32_t tempAllocatorBytes{0};
+
+        // rollback cost of the last save, restore and resimulation, zero while disabled
+        float rollbackSaveUs{0.0f};
+        float rollbackRestoreUs{0.0f};
+        float rollbackResimulateUsPerTick{0.0f};
+        uint32_t rollbackFrameBytes{0};
     };
 
-    void init();
+    void init(const PhysicsEngineInitializers& initializers = {});
     void destroy();
 
-    Stats getStats() const { return m_stats; }
+    Stats getStats() const { return m_stats.load(); }
 
+    // cost breakdown of the newest tick, for per tick graphs; any thread
+    Physics::TickStats getLastTickStats() const { return m_lastTickStats.load(); }
+
+    // commands in flight before producers have to wait for the physics thread to drain them
+    static constexpr size_t COMMAND_QUEUE_CAPACITY = 4096;
+
+    // runs every tick on the physics thread, before the dispatched commands, from the next tick on
     void persistOnPhysicsThread(Function<void(PhysicsEngine&)>&& fn) {
-        std::lock_guard<std::mutex> lk(m_dispatchMutex);
-        m_persistOnPhysicsThreadFn.push_back(std::move(fn));
+        std::lock_guard<std::mutex> lk(m_persistMutex);
+        m_pendingPersistFn.push_back(std::move(fn));
+        m_hasPendingPersistFn.store(true, std::memory_order_release);
     }
 
     template<typename F>
@@ -155,24 +161,64 @@ public:
         persistOnPhysicsThread(Function<void(PhysicsEngine&)>(std::forward<F>(fn)));
     }
 
+    // lock-free from any thread, commands run once after the next physics update in the order they were pushed
+    // per producer; the typed commands never allocate, prefer them for plain body operations
+    void dispatchOnPhysicsThread(Physics::PhysicsCommand&& command);
+
     void dispatchOnPhysicsThread(Function<void(PhysicsEngine&)>&& fn) {
-        std::lock_guard<std::mutex> lk(m_dispatchMutex);
-        m_dispatchedOnPhysicsThreadFn.push_back(std::move(fn));
+        dispatchOnPhysicsThread(Physics::PhysicsCommand(std::move(fn)));
     }
 
-    template<typename F>
+    template<typename F, typename = std::enable_if_t<std::is_invocable_v<F&, PhysicsEngine&>>>
     void dispatchOnPhysicsThread(F&& fn) {
         dispatchOnPhysicsThread(Function<void(PhysicsEngine&)>(std::forward<F>(fn)));
     }
 
+    // batched scene queries from any thread, run in parallel after the next physics update
+    // prefer these over dispatching one-off queries, results keep the order of the queries
+    Physics::QueryFuture<Physics::RayHit> castRays(Vector<Physics::RayQuery> queries) {
+        return m_sceneQueries.castRays(std::move(queries));
+    }
+
+    Physics::QueryFuture<Physics::ShapeCastHit> castShapes(Vector<Physics::ShapeCastQuery> queries) {
+        return m_sceneQueries.castShapes(std::move(queries));
+    }
+
+    // the callback runs on the main thread
+    void castRays(Vector<Physics::RayQuery> queries, Function<void(const Vector<Physics::RayHit>&)> callback) {
+        m_sceneQueries.castRays(std::move(queries), std::move(callback));
+    }
+
+    void castShapes(Vector<Physics::ShapeCastQuery> queries, Function<void(const Vector<Physics::ShapeCastHit>&)> callback) {
+        m_sceneQueries.castShapes(std::move(queries), std::move(callback));
+    }
+
     JPH::PhysicsSystem& getPhysicsSystem() { return *m_physicsSystem; }
 
-    JPH::TempAllocator* getTempAllocator() { return m_tempAllocator.get(); }
+    JPH::TempAllocator* getTempAllocator() { return &m_profiler->getTempAllocator(); }
 
-    const SwapBuffer& getCurrentRead() const { return m_swapBuffer.getReadBuffer(); }
+    // body transforms as of the last updateReadBuffer, main thread only
+    Physics::SnapshotView getCurrentRead() const { return m_snapshots.view(); }
 
     // invoke this every frame to update the read buffer
-    void updateReadBuffer() { m_swapBuffer.updateReadBuffer(); }
+    void updateReadBuffer();
+
+    // body transform blended between the two newest ticks for the frame of the last updateReadBuffer,
+    // what rendering should use; main thread only
+    Optional<Physics::ObjectSnapshot> getRenderTransform(JPH::BodyID id) const {
+        return m_interpolator.getTransform(id, m_renderAlpha);
+    }
+
+    float getRenderAlpha() const { return m_renderAlpha; }
+
+    // teleporting a sleeping body without activating it must be reported to show up in the snapshots
+    void markBodyMoved(JPH::BodyID id) { m_snapshots.markMoved(id); }
+
+    // physics thread only, e.g. from a dispatched function after a server correction
+    // restores the world as it was at the start of fromTick and steps it back to the present,
+    // applyInputs replays a tick's recorded inputs after it is stepped, as the dispatched commands are;
+    // false if fromTick is no longer saved or resimulating failed
+    bool rollbackAndResimulate(size_t fromTick, const Function<void(size_t)>& applyInputs = {});
 
     // synchronize tick index from remote
     // atomic operation
@@ -185,36 +231,62 @@ private:
     ~PhysicsEngine() = default;
 
     bool m_initialized{false};
-
-    TBuffer<SwapBuffer> m_swapBuffer;
+    // init registered jolt's factory, types and allocator, so destroy tears them down
+    bool m_ownsJoltGlobals{false};
+
+    Physics::BodySnapshotTracker m_snapshots;
+    // rendering lags one tick behind, the newest tick is what it blends towards
+    Physics::SnapshotInterpolator m_interpolator{Physics::SnapshotInterpolator::Config{
+            .delay = std::chrono::duration_cast<Physics::SnapshotInterpolator::Clock::duration>(PHYSICS_TIMESTEP),
+    }};
+    float m_renderAlpha{1.0f};
+    Physics::SceneQueryBatcher m_sceneQueries;
+    UniquePtr<Physics::RollbackBuffer> m_rollback;
 
     std::atomic_bool m_running{false};
     std::thread m_physicsThread;
 
-    std::mutex m_dispatchMutex;
+    MpscQueue<Physics::PhysicsCommand> m_commands{COMMAND_QUEUE_CAPACITY};
+
+    // registrations are rare, the physics thread only takes the lock when one is pending
+    std::mutex m_persistMutex;
+    std::atomic_bool m_hasPendingPersistFn{false};
+    Vector<Function<void(PhysicsEngine&)>> m_pendingPersistFn;
+    // physics thread exclusive
     Vector<Function<void(PhysicsEngine&)>> m_persistOnPhysicsThreadFn;
-    Vector<Function<void(PhysicsEngine&)>> m_dispatchedOnPhysicsThreadFn;
 
     UniquePtr<Physics::Details::BPLayerInterfaceImpl> m_broadPhaseLayerInterface;
     UniquePtr<Physics::Details::ObjectVsBroadPhaseLayerFilterImpl> m_objectVsBroadPhaseLayerFilter;
     UniquePtr<Physics::Details::ObjectLayerFilterImpl> m_objectLayerFilter;
 
-    UniquePtr<JPH::TempAllocatorImpl> m_tempAllocator;
-    UniquePtr<JPH::JobSystemThreadPool> m_jobSystem;
+    UniquePtr<JPH::JobSystem> m_jobSystem;
+    // owns the temp allocator, wraps the job system
+    UniquePtr<Physics::StepProfiler> m_profiler;
 
     UniquePtr<JPH::PhysicsSystem> m_physicsSystem;
 
-    JPH::BodyIDVector m_bodyIdCache;
+    // physics thread only
+    bool m_bodyCapacityWarned{false};
+    uint64_t m_capacityOverflowTicks{0};
+    uint64_t m_tickOverruns{0};
+    size_t m_nextOverflowWarningTick{0};
 
     std::atomic_size_t m_currentTickIndex{0};
 
-    Stats m_stats;
+    PhysicsEngineInitializers m_initializers;
+
+    // written by the physics thread, read by anyone
+    SeqLock<Stats> m_stats;
+    SeqLock<Physics::TickStats> m_lastTickStats;
 
     void launchPhysicsThread();
 
     void mainLoop();
-    void syncPhysicsToSwapBuffer();
+    void syncPhysicsToSwapBuffer(FixedStepClock::Clock::time_point tickTime);
     void executeDispatchedFunctions();
+    void executeCommand(Physics::PhysicsCommand& command);
+    void executeSceneQueries();
+    void checkCapacity(JPH::EPhysicsUpdateError errors);
 };
 
 MOE_END_NAMESPACE
\ No newline at end of file
@@ -0,0 +1,144 @@
+#pragma once
+
+#include "Physics/JoltIncludes.hpp"
+
+#include <Jolt/Physics/Collision/ContactListener.h>
+
+#include <atomic>
+
+MOE_BEGIN_PHYSICS_NAMESPACE
+
+// jolt only reports per phase timings through its own profiler build, the step's jobs carry their phase in their name
+enum class PhysicsPhase : uint8_t {
+    BroadPhase,
+    NarrowPhase,
+    Solver,
+    Integrate,
+    Other,
+    Count,
+};
+
+// buckets a jolt job name, unknown jobs count as Other
+PhysicsPhase classifyPhysicsJob(const char* jobName);
+
+// what one physics step cost, collected on the physics thread
+struct TickStats {
+    uint64_t tick{0};
+
+    // wall time of PhysicsSystem::Update
+    float stepMs{0.0f};
+    // cpu time of the step's jobs per phase, summed over every thread that ran them
+    float broadPhaseMs{0.0f};
+    float narrowPhaseMs{0.0f};
+    float solverMs{0.0f};
+    float integrateMs{0.0f};
+    float otherJobsMs{0.0f};
+
+    uint32_t numActiveBodies{0};
+    // contact manifolds added or persisted during the step
+    uint32_t numContacts{0};
+    // temp allocator high-water mark of the step
+    uint32_t tempAllocatorPeakBytes{0};
+
+    // the whole tick, not only the step, took longer than the physics timestep
+    bool overrun{false};
+};
+
+// decorates a job system, jobs are timed and the time is charged to the phase their name belongs to
+// handles and barriers are the wrapped system's, this only intercepts job creation
+class ProfilingJobSystem final : public JPH::JobSystem {
+public:
+    explicit ProfilingJobSystem(JPH::JobSystem& jobSystem)
+        : m_jobSystem(jobSystem) {}
+
+    int GetMaxConcurrency() const override { return m_jobSystem.GetMaxConcurrency(); }
+
+    JobHandle CreateJob(const char* inName, JPH::ColorArg inColor, const JobFunction& inJobFunction, JPH::uint32 inNumDependencies = 0) override;
+
+    Barrier* CreateBarrier() override { return m_jobSystem.CreateBarrier(); }
+
+    void DestroyBarrier(Barrier* inBarrier) override { m_jobSystem.DestroyBarrier(inBarrier); }
+
+    void WaitForJobs(Barrier* inBarrier) override { m_jobSystem.WaitForJobs(inBarrier); }
+
+    // job time per phase in nanoseconds since the last call, resets the counters
+    Array<uint64_t, static_cast<size_t>(PhysicsPhase::Count)> consumePhaseNs();
+
+protected:
+    // jobs belong to the wrapped system, which queues and frees them itself
+    void QueueJob(Job* inJob) override { JPH_ASSERT(false); }
+
+    void QueueJobs(Job** inJobs, JPH::uint inNumJobs) override { JPH_ASSERT(false); }
+
+    void FreeJob(Job* inJob) override { JPH_ASSERT(false); }
+
+private:
+    JPH::JobSystem& m_jobSystem;
+    std::atomic<uint64_t> m_phaseNs[static_cast<size_t>(PhysicsPhase::Count)]{};
+};
+
+// stack allocator that remembers how deep it got
+// jolt orders temp allocations through job dependencies, they never race but may come from any thread
+class TrackingTempAllocator final : public JPH::TempAllocator {
+public:
+    explicit TrackingTempAllocator(JPH::uint size)
+        : m_allocator(size), m_capacity(size) {}
+
+    void* Allocate(JPH::uint inSize) override;
+
+    void Free(void* inAddress, JPH::uint inSize) override;
+
+    JPH::uint capacity() const { return m_capacity; }
+
+    // peak usage since the last call, starts the next window at the current usage
+    JPH::uint consumePeakBytes();
+
+private:
+    JPH::TempAllocatorImpl m_allocator;
+    JPH::uint m_capacity;
+    std::atomic<JPH::uint> m_usage{0};
+    std::atomic<JPH::uint> m_peak{0};
+};
+
+// called from jolt's job threads during the step
+class ContactCounter final : public JPH::ContactListener {
+public:
+    void OnContactAdded(const JPH::Body& inBody1, const JPH::Body& inBody2, const JPH::ContactManifold& inManifold, JPH::ContactSettings& ioSettings) override {
+        m_contacts.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void OnContactPersisted(const JPH::Body& inBody1, const JPH::Body& inBody2, const JPH::ContactManifold& inManifold, JPH::ContactSettings& ioSettings) override {
+        m_contacts.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    uint32_t consumeContacts() { return m_contacts.exchange(0, std::memory_order_relaxed); }
+
+private:
+    std::atomic<uint32_t> m_contacts{0};
+};
+
+// steps a physics system and reports what the step cost
+// the profiler's temp allocator and contact listener are the ones the system must use
+struct StepProfiler {
+public:
+    // profilePhases wraps every job in a timer, costing an extra std::function per job
+    StepProfiler(JPH::JobSystem& jobSystem, JPH::uint tempAllocatorBytes, bool profilePhases);
+
+    JPH::TempAllocator& getTempAllocator() { return m_tempAllocator; }
+
+    JPH::uint getTempAllocatorCapacity() const { return m_tempAllocator.capacity(); }
+
+    JPH::ContactListener& getContactListener() { return m_contacts; }
+
+    // one collision step, outStats gets everything except the tick and the overrun flag
+    JPH::EPhysicsUpdateError step(JPH::PhysicsSystem& system, float deltaTime, TickStats& outStats);
+
+private:
+    JPH::JobSystem& m_jobSystem;
+    ProfilingJobSystem m_profilingJobSystem;
+    bool m_profilePhases;
+    TrackingTempAllocator m_tempAllocator;
+    ContactCounter m_contacts;
+};
+
+MOE_END_PHYSICS_NAMESPACE
\ No newline at end of file
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "Physics/JoltIncludes.hpp"
+
+#include <Jolt/Physics/StateRecorder.h>
+
+MOE_BEGIN_PHYSICS_NAMESPACE
+
+// fixed ring of world states, one per tick, for rolling back and resimulating on reconciliation
+// states go through jolt's SaveState so contacts and sleep state come back too, which keeps a resimulation
+// bit identical to the original run; static bodies never change and are left out
+// physics thread only, the system must not be updating while saving or restoring
+class RollbackBuffer {
+public:
+    // timings of the last operation, resimulation is per resimulated tick
+    struct Stats {
+        float saveUs{0.0f};
+        float restoreUs{0.0f};
+        float resimulateUsPerTick{0.0f};
+        size_t frameBytes{0};
+    };
+
+    explicit RollbackBuffer(size_t capacity);
+
+    // records the state at the start of the tick, before it is stepped; the inputs of the previous tick are already in it
+    void save(const JPH::PhysicsSystem& system, size_t tick);
+
+    // false if the tick fell out of the ring or was never saved
+    bool restore(JPH::PhysicsSystem& system, size_t tick);
+
+    // restores fromTick and steps again up to the start of toTick, saving every tick on the way
+    // applyInputs replays the inputs recorded for a tick right after it is stepped, where the physics loop drains them;
+    // false if a tick is no longer saved or an update failed
+    bool resimulate(
+            JPH::PhysicsSystem& system,
+            size_t fromTick, size_t toTick,
+            float deltaTime,
+            JPH::TempAllocator& tempAllocator,
+            JPH::JobSystem& jobSystem,
+            const Function<void(size_t)>& applyInputs = {});
+
+    bool has(size_t tick) const;
+
+    size_t capacity() const { return m_frames.size(); }
+
+    Stats getStats() const { return m_stats; }
+
+private:
+    struct Frame {
+        size_t tick{0};
+        bool valid{false};
+        // reused between ticks, grows to the largest state once
+        Vector<uint8_t> data;
+    };
+
+    Vector<Frame> m_frames;
+    Stats m_stats;
+
+    Frame& frameFor(size_t tick) { return m_frames[tick % m_frames.size()]; }
+
+    const Frame& frameFor(size_t tick) const { return m_frames[tick % m_frames.size()]; }
+};
+
+MOE_END_PHYSICS_NAMESPACE
\ No newline at end of file
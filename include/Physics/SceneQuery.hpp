@@ -0,0 +1,93 @@
+#pragma once
+
+#include "Physics/JoltIncludes.hpp"
+
+#include "Core/Task/Future.hpp"
+#include "Core/Task/Scheduler.hpp"
+
+#include <mutex>
+
+MOE_BEGIN_PHYSICS_NAMESPACE
+
+// per query filter, the default hits everything
+struct QueryFilter {
+    // one bit per object layer, see CollisionLayerConfig
+    uint64_t layerMask{~uint64_t{0}};
+    // e.g. the shooter's own body, invalid ignores nothing
+    JPH::BodyID ignoreBody{};
+};
+
+struct RayQuery {
+    JPH::RVec3 origin{JPH::RVec3::sZero()};
+    // the length is the max distance
+    JPH::Vec3 direction{JPH::Vec3::sZero()};
+    QueryFilter filter{};
+};
+
+// the closest hit along the ray, the body is invalid on a miss
+struct RayHit {
+    JPH::BodyID body{};
+    JPH::SubShapeID subShape{};
+    float fraction{1.0f};
+    JPH::RVec3 position{JPH::RVec3::sZero()};
+
+    bool hasHit() const { return !body.IsInvalid(); }
+};
+
+struct ShapeCastQuery {
+    JPH::ShapeRefC shape;
+    // world transform of the shape at the start of the cast
+    JPH::RMat44 start{JPH::RMat44::sIdentity()};
+    // the length is the max distance
+    JPH::Vec3 direction{JPH::Vec3::sZero()};
+    QueryFilter filter{};
+};
+
+// the first contact along the cast, the body is invalid on a miss
+struct ShapeCastHit {
+    JPH::BodyID body{};
+    JPH::SubShapeID subShape{};
+    float fraction{1.0f};
+    JPH::RVec3 contactPoint{JPH::RVec3::sZero()};
+    // points from the hit body towards the cast shape
+    JPH::Vec3 normal{JPH::Vec3::sZero()};
+
+    bool hasHit() const { return !body.IsInvalid(); }
+};
+
+template<typename HitT>
+using QueryFuture = Future<Vector<HitT>, ThreadPoolScheduler>;
+
+// collects query batches from any thread and runs them between physics updates,
+// which is the only time jolt allows queries; a batch is split across the scheduler's workers
+// results keep the order of the queries and arrive at most one tick after submission
+class SceneQueryBatcher {
+public:
+    // queries per scheduler task, smaller batches run on the calling thread
+    static constexpr size_t QUERIES_PER_TASK = 64;
+
+    QueryFuture<RayHit> castRays(Vector<RayQuery> queries);
+    QueryFuture<ShapeCastHit> castShapes(Vector<ShapeCastQuery> queries);
+
+    // the callback runs on the main thread the frame after the batch completes
+    void castRays(Vector<RayQuery> queries, Function<void(const Vector<RayHit>&)> callback);
+    void castShapes(Vector<ShapeCastQuery> queries, Function<void(const Vector<ShapeCastHit>&)> callback);
+
+    // physics thread only, never while PhysicsSystem::Update runs
+    void execute(const JPH::PhysicsSystem& system, ThreadPoolScheduler& scheduler);
+
+    size_t pendingBatches();
+
+private:
+    template<typename QueryT, typename HitT>
+    struct PendingBatch {
+        Vector<QueryT> queries;
+        Function<void(Vector<HitT>&&)> complete;
+    };
+
+    std::mutex m_mutex;
+    Vector<PendingBatch<RayQuery, RayHit>> m_rayBatches;
+    Vector<PendingBatch<ShapeCastQuery, ShapeCastHit>> m_shapeCastBatches;
+};
+
+MOE_END_PHYSICS_NAMESPACE
\ No newline at end of file
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Physics/JoltIncludes.hpp"
+
+#include "Core/Task/Scheduler.hpp"
+
+#include <Jolt/Core/FixedSizeFreeList.h>
+#include <Jolt/Core/JobSystemWithBarrier.h>
+
+#include <atomic>
+
+MOE_BEGIN_PHYSICS_NAMESPACE
+
+// runs jolt jobs as high priority tasks on the engine's ThreadPoolScheduler instead of a second pool of threads
+// physics then shares the cores with asset loading but is picked ahead of it; the thread waiting on a barrier
+// executes queued jobs itself, so a busy scheduler slows a step down but never stalls it
+class SchedulerJobSystem final : public JPH::JobSystemWithBarrier {
+public:
+    SchedulerJobSystem(ThreadPoolScheduler& scheduler, JPH::uint maxJobs, JPH::uint maxBarriers);
+
+    // waits for scheduled tasks still holding jobs, the scheduler must outlive this
+    ~SchedulerJobSystem() override;
+
+    SchedulerJobSystem(const SchedulerJobSystem&) = delete;
+    SchedulerJobSystem& operator=(const SchedulerJobSystem&) = delete;
+
+    int GetMaxConcurrency() const override;
+
+    JobHandle CreateJob(const char* inName, JPH::ColorArg inColor, const JobFunction& inJobFunction, JPH::uint32 inNumDependencies = 0) override;
+
+protected:
+    void QueueJob(Job* inJob) override;
+    void QueueJobs(Job** inJobs, JPH::uint inNumJobs) override;
+    void FreeJob(Job* inJob) override;
+
+private:
+    using AvailableJobs = JPH::FixedSizeFreeList<Job>;
+
+    ThreadPoolScheduler& m_scheduler;
+    AvailableJobs m_jobs;
+
+    // tasks queued on the scheduler that still reference a job
+    std::atomic<uint32_t> m_scheduledTasks{0};
+};
+
+MOE_END_PHYSICS_NAMESPACE
\ No newline at end of file
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "Physics/BodySnapshotTracker.hpp"
+
+MOE_BEGIN_PHYSICS_NAMESPACE
+
+// keeps the two newest body snapshots and blends between them, so rendering at a higher rate than
+// the physics tick does not show the tick rate as stutter
+// rendering runs one tick behind the newest publish: at render alpha 0 a body is where it was one
+// publish ago, at 1 where the newest publish put it, above 1 it is extrapolated along its last motion
+// consumer thread only, the buffers are sized once per body capacity and reused after that
+struct SnapshotInterpolator {
+public:
+    using Clock = SnapshotView::Channel::Clock;
+
+    struct Config {
+        // how far rendering lags behind the newest publish, one physics step hides a whole tick
+        Clock::duration delay{std::chrono::microseconds(16667)};
+        // how far past the newest publish a late tick may be extrapolated before bodies freeze
+        Clock::duration maxExtrapolation{std::chrono::milliseconds(8)};
+    };
+
+    SnapshotInterpolator();
+    explicit SnapshotInterpolator(const Config& config);
+
+    // takes in the view if it is newer than the last one, returns whether it was
+    // only entries changed since the previous publish are touched besides bodies that just stopped
+    bool update(const SnapshotView& view);
+
+    // blend factor between the previous and the newest snapshot for a frame rendered at the given time,
+    // clamped to [0, 1 + maxExtrapolation / tick span]
+    float computeAlpha(Clock::time_point now) const;
+
+    // empty until the body has been published once, and again after it is removed
+    Optional<ObjectSnapshot> getTransform(JPH::BodyID id, float alpha) const;
+
+    // ticks of the two snapshots in use, equal until a second publish arrived
+    uint64_t getPreviousTick() const { return m_previousTick; }
+
+    uint64_t getCurrentTick() const { return m_currentTick; }
+
+private:
+    Config m_config;
+
+    Vector<ObjectSnapshot> m_previous;
+    Vector<ObjectSnapshot> m_current;
+    // entries whose previous and current snapshot differ, they need a copy once they stop changing
+    Vector<uint8_t> m_moving;
+
+    uint64_t m_version{0};
+    uint64_t m_previousTick{0};
+    uint64_t m_currentTick{0};
+    Clock::time_point m_previousTime{};
+    Clock::time_point m_currentTime{};
+};
+
+MOE_END_PHYSICS_NAMESPACE
\ No newline at end of file
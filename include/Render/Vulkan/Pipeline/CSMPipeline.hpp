@@ -1,6 +1,10 @@
 #pragma once
 
+#include "Render/Vulkan/VulkanCulling.hpp"
 #include "Render/Vulkan/VulkanIdTypes.hpp"
+#include "Render/Vulkan/VulkanInstanceBuffer.hpp"
+#include "Render/Vulkan/VulkanInstancing.hpp"
+#include "Render/Vulkan/VulkanSortKey.hpp"
 #include "Render/Vulkan/VulkanTypes.hpp"
 
 
@@ -24,15 +28,31 @@ namespace moe {
 
             void init(VulkanEngine& engine, Array<float, SHADOW_CASCADE_COUNT> cascadeSplitRatios = {0.1f, 0.3f, 0.65f, 1.0f});
 
+            // each cascade draws only the packets inside its light frustum, cullingBatch holds drawCommands' bounds
+            // an empty batch skips culling and draws everything into every cascade
+            // consecutive packets of one mesh become a single instanced draw, whatever their material
             void draw(
                     VkCommandBuffer cmdBuffer,
                     VulkanMeshCache& meshCache,
                     Span<VulkanRenderPacket> drawCommands,
+                    const VulkanCullingBatch& cullingBatch,
                     const VulkanCamera& camera,
-                    glm::vec3 lightDir);
+                    glm::vec3 lightDir,
+                    size_t frameIndex);
+
+            // gpu driven path, draws what CullingPipeline left in each cascade's view
+            // the cascades must have been updated this frame, their light transforms are what the views were culled with
+            void drawIndirect(
+                    VkCommandBuffer cmdBuffer,
+                    VulkanMeshCache& meshCache,
+                    const Array<VulkanIndirectView, SHADOW_CASCADE_COUNT>& cascadeViews);
+
+            // fits each cascade's light transform around its slice of the camera frustum, draw does this itself
+            void updateCascades(const VulkanCamera& camera, glm::vec3 lightDir);
 
             void destroy();
 
+            // every cascade is a layer of it, the caller moves it to depth attachment layout before drawing
             ImageId getShadowMapImageId() const { return m_shadowMapImageId; }
 
             glm::vec3 getShadowMapCameraScale() const { return m_shadowMapCameraScale; }
@@ -41,12 +61,28 @@ namespace moe {
             // however if the scene is too large, a larger x and y may still be needed
             void setShadowMapCameraScale(glm::vec3 scale) { m_shadowMapCameraScale = scale; }
 
+            // packets drawn into the cascade in the last draw
+            uint32_t getCascadeDrawCount(uint32_t cascade) const { return static_cast<uint32_t>(m_cascadeVisibleIndices[cascade].size()); }
+
+            // all cascades of the last draw
+            const VulkanPassStats& getLastStats() const { return m_lastStats; }
+
+            // orders each cascade's draws by the depth only key policy, off keeps gather order
+            void setDrawSortingEnabled(bool enabled) { m_sortDraws = enabled; }
+
+            // off draws every packet on its own, still through the instance buffer
+            void setInstancingEnabled(bool enabled) { m_instancing = enabled; }
+
+            // records each cascade into a secondary of the engine's command recorder, the indirect path stays inline
+            void setParallelRecordingEnabled(bool enabled) { m_parallelRecording = enabled; }
+
             glm::mat4 m_cascadeLightTransforms[SHADOW_CASCADE_COUNT];
             float m_cascadeFarPlaneZs[SHADOW_CASCADE_COUNT];
 
         private:
             struct PushConstants {
-                glm::mat4 mvp;
+                glm::mat4 lightViewProjection;
+                VkDeviceAddress instanceBufferAddr;
                 VkDeviceAddress vertexBufferAddr;
             };
 
@@ -63,6 +99,27 @@ namespace moe {
             Array<float, SHADOW_CASCADE_COUNT> m_cascadeSplitRatios;
 
             glm::vec3 m_shadowMapCameraScale{2.0f, 2.0f, 2.0f};
+
+            Array<Vector<uint32_t>, SHADOW_CASCADE_COUNT> m_cascadeVisibleIndices;
+            Vector<uint64_t> m_sortKeys;
+            VulkanDrawSorter m_drawSorter;
+            bool m_sortDraws{true};
+
+            // every cascade's instances share one list and one buffer, each cascade has its own draws
+            VulkanInstanceBatcher m_instanceBatcher{false};
+            Array<Vector<VulkanInstancedDraw>, SHADOW_CASCADE_COUNT> m_cascadeInstancedDraws;
+            VulkanInstanceBuffer m_instanceBuffer;
+            bool m_instancing{true};
+            bool m_parallelRecording{false};
+
+            VulkanPassStats m_lastStats{};
+
+            void beginCascade(VkCommandBuffer cmdBuffer, uint32_t cascade, VkRenderingFlags flags);
+
+            // the pipeline and what every draw shares, a secondary inherits none of it
+            void bindState(VkCommandBuffer cmdBuffer);
+
+            VkCommandBufferInheritanceRenderingInfo getInheritanceInfo() const;
         };
     }// namespace Pipeline
 }// namespace moe
\ No newline at end of file
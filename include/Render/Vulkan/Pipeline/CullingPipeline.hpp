@@ -0,0 +1,105 @@
+#pragma once
+
+#include "Render/Common.hpp"
+#include "Render/Vulkan/Pipeline/CSMPipeline.hpp"
+#include "Render/Vulkan/VulkanInstancing.hpp"
+#include "Render/Vulkan/VulkanRenderable.hpp"
+#include "Render/Vulkan/VulkanTypes.hpp"
+
+
+namespace moe {
+    class VulkanEngine;
+    class VulkanMeshCache;
+}// namespace moe
+
+namespace moe {
+    namespace Pipeline {
+        // gpu driven path: one compute dispatch culls every packet against the camera and each shadow cascade,
+        // then writes the indirect draws GBufferPipeline::drawIndirect and CSMPipeline::drawIndirect consume
+        struct CullingPipeline {
+        public:
+            // the camera first, then every shadow cascade
+            static constexpr uint32_t VIEW_COUNT = 1 + CSMPipeline::SHADOW_CASCADE_COUNT;
+            static constexpr uint32_t PLANES_PER_VIEW = 6;
+
+            CullingPipeline() = default;
+            ~CullingPipeline() = default;
+
+            void init(VulkanEngine& engine);
+
+            void destroy();
+
+            // groups the packets, then writes the objects and empty indirect draws into the frame's buffers
+            // skinned packets must already hold their skinned vertex addresses
+            void prepare(VulkanMeshCache& meshCache, Span<VulkanRenderPacket> drawCommands, size_t frameIndex);
+
+            // records the culling dispatch, must be recorded outside of any rendering, after prepare
+            // the draws consuming the output wait on it through the frame graph
+            void cull(VkCommandBuffer cmdBuffer, const Array<glm::mat4, VIEW_COUNT>& viewProjections, size_t frameIndex);
+
+            // what cull writes for the frame last prepared
+            struct OutputBuffers {
+                // read as indirect arguments
+                VkBuffer commands;
+                VkBuffer counts;
+                // read by the vertex shaders
+                VkBuffer instances;
+            };
+
+            OutputBuffers getOutputBuffers() const;
+
+            // view 0 is the g-buffer, view 1 + i is shadow cascade i, valid for the frame last prepared
+            VulkanIndirectView getView(uint32_t view) const;
+
+            // every packet is grouped and uploaded, only the groups are recorded later
+            uint32_t getObjectCount() const { return static_cast<uint32_t>(m_builder.getObjects().size()); }
+
+        private:
+            static constexpr uint32_t WORKGROUP_SIZE = 64;
+            static constexpr size_t MIN_BUFFER_SIZE = 4096;
+            static constexpr size_t BUFFER_GROWTH_FACTOR = 2;
+
+            struct PushConstants {
+                VkDeviceAddress objectBufferAddr;
+                VkDeviceAddress frustumPlaneBufferAddr;
+                VkDeviceAddress commandBufferAddr;
+                VkDeviceAddress countBufferAddr;
+                VkDeviceAddress instanceBufferAddr;
+                uint32_t objectCount;
+                uint32_t gBufferGroupCount;
+                uint32_t shadowGroupCount;
+            };
+
+            struct FrameBuffer {
+                VulkanAllocatedBuffer buffer{};
+                size_t capacity{0};
+            };
+
+            struct SwapData {
+                FrameBuffer objects;
+                FrameBuffer frustumPlanes;
+                FrameBuffer commands;
+                FrameBuffer counts;
+                // written by the gpu only
+                FrameBuffer instances;
+            };
+
+            VulkanEngine* m_engine{nullptr};
+            bool m_initialized{false};
+
+            VkPipelineLayout m_pipelineLayout;
+            VkPipeline m_pipeline;
+
+            Array<SwapData, Constants::FRAMES_IN_FLIGHT> m_swapData;
+            size_t m_frameIndex{0};
+
+            VulkanIndirectDrawBuilder m_builder;
+            Vector<VkDrawIndexedIndirectCommand> m_commands;
+
+            void reserve(FrameBuffer& frameBuffer, size_t size, VkBufferUsageFlags usage, VmaMemoryUsage memoryUsage);
+
+            // index of the first draw of a view in the command and count buffers
+            uint32_t getFirstCommand(uint32_t view) const;
+        };
+    }// namespace Pipeline
+}// namespace moe
\ No newline at end of file
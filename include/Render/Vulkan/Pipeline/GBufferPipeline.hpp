@@ -1,6 +1,8 @@
 #pragma once
 
 #include "Render/Vulkan/VulkanIdTypes.hpp"
+#include "Render/Vulkan/VulkanInstanceBuffer.hpp"
+#include "Render/Vulkan/VulkanInstancing.hpp"
 #include "Render/Vulkan/VulkanRenderable.hpp"
 #include "Render/Vulkan/VulkanTypes.hpp"
 
@@ -22,13 +24,32 @@ namespace moe {
 
             void destroy();
 
+            // consecutive draw commands of one mesh and material become a single instanced draw
             void draw(
                     VkCommandBuffer cmdBuffer,
                     VulkanMeshCache& meshCache,
                     VulkanMaterialCache& materialCache,
                     Span<VulkanRenderPacket> drawCommands,
+                    VulkanAllocatedBuffer& sceneDataBuffer,
+                    size_t frameIndex);
+
+            // gpu driven path, draws what CullingPipeline left in its g-buffer view
+            // instances in the stats are unknown on the cpu and left at 0
+            void drawIndirect(
+                    VkCommandBuffer cmdBuffer,
+                    VulkanMeshCache& meshCache,
+                    const VulkanIndirectView& view,
                     VulkanAllocatedBuffer& sceneDataBuffer);
 
+            const VulkanPassStats& getLastStats() const { return m_lastStats; }
+
+            // off draws every command on its own, still through the instance buffer
+            void setInstancingEnabled(bool enabled) { m_instancing = enabled; }
+
+            // splits the draws into chunks recorded into secondaries of the engine's command recorder,
+            // a pass too small for more than one chunk and the indirect path stay inline
+            void setParallelRecordingEnabled(bool enabled) { m_parallelRecording = enabled; }
+
             //VulkanAllocatedImage gPosition;
             VulkanAllocatedImage gDepth;
             VulkanAllocatedImage gNormal;
@@ -44,8 +65,7 @@ namespace moe {
 
         private:
             struct PushConstants {
-                glm::mat4 transform;
-                glm::mat3 clampedInverseTransform;
+                VkDeviceAddress instanceBufferAddr;
                 VkDeviceAddress vertexBufferAddr;
                 VkDeviceAddress sceneDataAddress;
                 MaterialId materialId;
@@ -57,11 +77,29 @@ namespace moe {
             VkPipelineLayout m_pipelineLayout;
             VkPipeline m_pipeline;
 
+            VulkanInstanceBatcher m_instanceBatcher;
+            Vector<VulkanInstancedDraw> m_instancedDraws;
+            VulkanInstanceBuffer m_instanceBuffer;
+            bool m_instancing{true};
+            bool m_parallelRecording{false};
+
+            VulkanPassStats m_lastStats{};
+            // one per chunk of the last parallel draw, each recorded on its own thread
+            Vector<VulkanPassStats> m_chunkStats;
+
+            Array<VkFormat, 4> m_colorAttachmentFormats{};
+
             void allocateImages();
 
-            void transitionImagesForRendering(VkCommandBuffer cmdBuffer);
+            // the targets must already be in attachment layouts, the frame graph moves them
+            void beginRendering(VkCommandBuffer cmdBuffer, VkRenderingFlags flags);
+
+            // the pipeline and what every draw shares, a secondary inherits none of it
+            void bindState(VkCommandBuffer cmdBuffer);
+
+            VkCommandBufferInheritanceRenderingInfo getInheritanceInfo() const;
 
-            void transitionImagesForSampling(VkCommandBuffer cmdBuffer);
+            void endRendering(VkCommandBuffer cmdBuffer);
         };
     }// namespace Pipeline
 }// namespace moe
\ No newline at end of file
@@ -23,16 +23,18 @@ namespace moe {
 
             size_t appendJointMatrices(Span<glm::mat4> jointMatrices, size_t frameIndex);
 
-            void compute(
-                    VkCommandBuffer cmdBuffer,
-                    VulkanMeshCache& meshCache,
-                    Span<VulkanRenderPacket> drawCommands,
-                    size_t frameIndex);
+            // gives every skinned packet its range of the frame's output buffer and grows the buffer to fit,
+            // on the cpu only, so the passes reading the skinned addresses can be declared before any is recorded
+            // the joint matrices must be appended first
+            void prepare(VulkanMeshCache& meshCache, Span<VulkanRenderPacket> drawCommands, size_t frameIndex);
 
-            void destroy();
+            // records the dispatches the frame was prepared with
+            void compute(VkCommandBuffer cmdBuffer, size_t frameIndex);
+
+            // the buffer compute writes the frame's skinned vertices into
+            VkBuffer getOutputBuffer(size_t frameIndex) const { return m_swapData[frameIndex].dynamicVertexBuffer.buffer.buffer; }
 
-            // this should be called by VulkanEngine before using the pipeline each frame
-            void resetDynamicVertexBuffer(size_t frameIndex);
+            void destroy();
 
         private:
             static constexpr uint32_t MAX_JOINT_MATRIX_COUNT = 10240;       // max 10k joint matrices
@@ -57,6 +59,11 @@ namespace moe {
                 VkDeviceAddress bufferAddr{};
             };
 
+            struct Dispatch {
+                PushConstants pushConstants;
+                uint32_t groupCount;
+            };
+
             void ensureDynamicVertexBufferSize(size_t requiredVertexCount, size_t frameIndex);
 
             struct SwapData {
@@ -64,6 +71,8 @@ namespace moe {
                 size_t jointMatrixBufferSize;
 
                 DynamicVertexBuffer dynamicVertexBuffer;
+
+                Vector<Dispatch> dispatches;
             };
 
             Array<SwapData, Constants::FRAMES_IN_FLIGHT> m_swapData;
@@ -31,6 +31,9 @@ namespace moe {
 
             void destroy();
 
+            // splits the sprites into chunks recorded into secondaries of the engine's command recorder
+            void setParallelRecordingEnabled(bool enabled) { m_parallelRecording = enabled; }
+
         private:
             struct PushConstants {
                 glm::mat4 transform;
@@ -49,6 +52,8 @@ namespace moe {
 
             VkPipelineLayout m_pipelineLayout;
             VkPipeline m_pipeline;
+
+            bool m_parallelRecording{false};
         };
     }// namespace Pipeline
 }// namespace moe
\ No newline at end of file
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "Render/Common.hpp"
+#include "Render/Vulkan/VulkanParallelRecording.hpp"
+#include "Render/Vulkan/VulkanTypes.hpp"
+
+#include <algorithm>
+
+
+namespace moe {
+    class VulkanEngine;
+}// namespace moe
+
+namespace moe {
+    // records chunks of a pass into secondary command buffers on ThreadPoolScheduler's workers
+    // every frame in flight has a command pool per slot, a slot being one of the threads recording at once
+    // a pool is only ever touched by the thread holding its slot, and is reset as a whole once its frame's fence signaled
+    struct VulkanCommandRecorder {
+    public:
+        // a chunk smaller than this costs more to hand out than to record inline
+        static constexpr size_t MIN_DRAWS_PER_CHUNK = 64;
+
+        struct Stats {
+            uint32_t passes{0};
+            uint32_t secondaryBuffers{0};
+            // wall time of every record call, the calling thread waits that long
+            float recordUs{0.0f};
+        };
+
+        VulkanCommandRecorder() = default;
+        ~VulkanCommandRecorder() = default;
+
+        // slotCount is the most threads recording at once, the calling thread included
+        void init(VulkanEngine& engine, uint32_t queueFamilyIndex, uint32_t slotCount);
+
+        void destroy();
+
+        // resets the frame's pools, every buffer recorded from them FRAMES_IN_FLIGHT frames ago is back to initial
+        // the frame's fence must have signaled
+        void beginFrame(size_t frameIndex);
+
+        // records fn(cmdBuffer, chunk) for every chunk, each into its own secondary begun inside a rendering with these attachments
+        // fn may only write to cmdBuffer and to what its chunk owns, it runs on worker threads
+        // returns the buffers in chunk order, valid until the next record, to be executed in a rendering begun with
+        // VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT
+        Span<const VkCommandBuffer> record(
+                const VkCommandBufferInheritanceRenderingInfo& renderingInfo,
+                uint32_t chunks,
+                const Function<void(VkCommandBuffer, uint32_t)>& fn);
+
+        // 1 records every chunk on the calling thread, still into secondaries
+        void setSlotLimit(uint32_t limit) { m_slotLimit = std::clamp<uint32_t>(limit, 1, getSlotCount()); }
+
+        uint32_t getSlotLimit() const { return m_slotLimit; }
+
+        uint32_t getSlotCount() const { return static_cast<uint32_t>(m_frames[0].size()); }
+
+        // everything recorded since the last beginFrame
+        const Stats& getStats() const { return m_stats; }
+
+    private:
+        struct SlotPool {
+            VkCommandPool pool{VK_NULL_HANDLE};
+            // allocated once and handed out again after every reset
+            Vector<VkCommandBuffer> buffers;
+            uint32_t used{0};
+        };
+
+        VulkanEngine* m_engine{nullptr};
+        bool m_initialized{false};
+
+        Array<Vector<SlotPool>, Constants::FRAMES_IN_FLIGHT> m_frames;
+        size_t m_frameIndex{0};
+        uint32_t m_slotLimit{1};
+
+        Vector<VkCommandBuffer> m_recorded;
+
+        Stats m_stats;
+
+        VkCommandBuffer acquire(SlotPool& slot);
+    };
+}// namespace moe
\ No newline at end of file
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "Core/Common.hpp"
+
+#include "Math/Common.hpp"
+
+
+namespace moe {
+    // axis aligned box as center and half extent
+    struct VulkanBounds {
+        // large enough to pass every plane test, small enough to never overflow to inf in one
+        static constexpr float UNBOUNDED_EXTENT = 1e30f;
+
+        glm::vec3 center{0.0f};
+        glm::vec3 extent{0.0f};
+
+        static VulkanBounds fromMinMax(const glm::vec3& min, const glm::vec3& max) {
+            return {(min + max) * 0.5f, (max - min) * 0.5f};
+        }
+
+        // for anything whose shape is not known on the cpu, e.g. skinned meshes, never culled
+        static VulkanBounds unbounded() {
+            return {glm::vec3(0.0f), glm::vec3(UNBOUNDED_EXTENT)};
+        }
+
+        bool isUnbounded() const { return extent.x >= UNBOUNDED_EXTENT; }
+
+        // box around the transformed box
+        VulkanBounds transformed(const glm::mat4& transform) const {
+            if (isUnbounded()) {
+                return *this;
+            }
+
+            glm::vec3 worldCenter = glm::vec3(transform * glm::vec4(center, 1.0f));
+            glm::vec3 worldExtent =
+                    glm::abs(glm::vec3(transform[0])) * extent.x
+                    + glm::abs(glm::vec3(transform[1])) * extent.y
+                    + glm::abs(glm::vec3(transform[2])) * extent.z;
+            return {worldCenter, worldExtent};
+        }
+    };
+
+    struct VulkanFrustum {
+        // xyz is the inward unit normal, a point p is inside when dot(xyz, p) + w >= 0
+        Array<glm::vec4, 6> planes;
+
+        // expects 0..1 clip depth, works for both perspective and orthographic projections
+        static VulkanFrustum fromViewProjection(const glm::mat4& viewProjection);
+
+        bool intersects(const VulkanBounds& bounds) const;
+    };
+
+    // world space bounds of a frame's render packets, stored as structure of arrays so
+    // one frustum test covers LANES packets at a time. indices match the order of push
+    struct VulkanCullingBatch {
+    public:
+        static constexpr size_t LANES = 4;
+
+        void clear();
+
+        void reserve(size_t count);
+
+        void push(const VulkanBounds& bounds);
+
+        size_t size() const { return m_size; }
+
+        // appends the index of every box that intersects the frustum, in ascending order
+        void cull(const VulkanFrustum& frustum, Vector<uint32_t>& outVisible) const;
+
+    private:
+        // padded to a multiple of LANES with boxes that never pass, so the loop has no tail
+        Vector<float> m_centerX;
+        Vector<float> m_centerY;
+        Vector<float> m_centerZ;
+        Vector<float> m_extentX;
+        Vector<float> m_extentY;
+        Vector<float> m_extentZ;
+        size_t m_size{0};
+    };
+}// namespace moe
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Render/Vulkan/Pipeline/CSMPipeline.hpp"
+#include "Render/Vulkan/Pipeline/CullingPipeline.hpp"
 #include "Render/Vulkan/Pipeline/DeferredLightingPipeline.hpp"
 #include "Render/Vulkan/Pipeline/GBufferPipeline.hpp"
 //#include "Render/Vulkan/Pipeline/MeshPipeline.hpp"
@@ -13,6 +14,7 @@
 #include "Render/Vulkan/VulkanAnimationCache.hpp"
 #include "Render/Vulkan/VulkanBindlessSet.hpp"
 #include "Render/Vulkan/VulkanCamera.hpp"
+#include "Render/Vulkan/VulkanCommandRecorder.hpp"
 #include "Render/Vulkan/VulkanDescriptors.hpp"
 #include "Render/Vulkan/VulkanEngineDrivers.hpp"
 #include "Render/Vulkan/VulkanFont.hpp"
@@ -21,11 +23,14 @@
 #include "Render/Vulkan/VulkanMaterialCache.hpp"
 #include "Render/Vulkan/VulkanMeshCache.hpp"
 #include "Render/Vulkan/VulkanObjectCache.hpp"
+#include "Render/Vulkan/VulkanPipelineCache.hpp"
 #include "Render/Vulkan/VulkanPostFXGraph.hpp"
+#include "Render/Vulkan/VulkanRenderGraph.hpp"
 #include "Render/Vulkan/VulkanRenderTarget.hpp"
 #include "Render/Vulkan/VulkanScene.hpp"
 #include "Render/Vulkan/VulkanSwapBuffer.hpp"
 #include "Render/Vulkan/VulkanTypes.hpp"
+#include "Render/Vulkan/VulkanUploadService.hpp"
 
 
 #include "Core/Input.hpp"
@@ -71,6 +76,9 @@ namespace moe {
         glm::vec3 csmCameraScale{3.0f, 3.0f, 3.0f};
 
         moe::String imGuiFontPath{""};
+
+        // run uploads on a dedicated transfer queue family when the device has one
+        bool useTransferQueue{true};
     };
 
     class VulkanEngine {
@@ -82,6 +90,7 @@ namespace moe {
         bool m_isInitialized{false};
         int32_t m_frameNumber{0};
         bool m_stopRendering{false};
+        bool m_skipRenderThisFrame{false};
         bool m_resizeRequested{false};
         VkExtent2D m_windowExtent;
 
@@ -91,6 +100,35 @@ namespace moe {
 
         glm::vec3 m_shadowMapCameraScale{3.0f, 3.0f, 3.0f};
 
+        // packets outside the camera or a cascade's light frustum are skipped by that pass
+        bool m_enableFrustumCulling{true};
+        // passes draw in VkSortKey order instead of gather order
+        bool m_enableDrawSorting{true};
+        // consecutive packets that share a mesh, and a material where the pass reads it, draw as one instanced draw
+        bool m_enableInstancing{true};
+        // a compute pass culls every packet and the g-buffer and shadow passes draw indirectly,
+        // the cpu neither culls, sorts nor records per draw, at the cost of depth ordering
+        bool m_enableGpuDriven{false};
+        // the device has drawIndirectFirstInstance and drawIndirectCount, known once the device is created
+        bool m_supportsGpuDriven{false};
+        // the shadow cascades, g-buffer chunks and sprites are recorded into secondaries on the thread pool
+        bool m_enableParallelRecording{true};
+
+        struct DrawStats {
+            uint32_t packets{0};
+            uint32_t cameraDraws{0};
+            Array<uint32_t, Pipeline::CSMPipeline::SHADOW_CASCADE_COUNT> cascadeDraws{};
+
+            VulkanPassStats gBuffer{};
+            // every cascade together
+            VulkanPassStats shadow{};
+
+            // culled on the gpu, camera and cascade draws are unknown on the cpu and left at 0
+            bool gpuDriven{false};
+        };
+
+        DrawStats m_drawStats{};
+
         GLFWwindow* m_window{nullptr};
         std::pair<float, float> m_lastMousePos{0.0f, 0.0f};
         bool m_firstMouse{true};
@@ -114,6 +152,22 @@ namespace moe {
         VkQueue m_graphicsQueue;
         uint32_t m_graphicsQueueFamilyIndex;
 
+        // the graphics queue again when there is no dedicated transfer family, or it is turned off
+        bool m_useTransferQueue{true};
+        VkQueue m_transferQueue;
+        uint32_t m_transferQueueFamilyIndex;
+
+        VulkanUploadService m_uploadService;
+
+        // shared by every pipeline, imgui's included, and kept on disk between runs
+        VulkanPipelineCache m_pipelineCache;
+
+        // rebuilt every frame from what each pass reads and writes, derives the barriers between them
+        VulkanRenderGraph m_frameGraph;
+
+        // per frame and per thread command pools for the passes recorded in parallel
+        VulkanCommandRecorder m_commandRecorder;
+
         VkExtent2D m_drawExtent;
         VkFormat m_drawImageFormat{VK_FORMAT_R16G16B16A16_SFLOAT};
         VkFormat m_depthImageFormat{VK_FORMAT_D32_SFLOAT};
@@ -158,6 +212,7 @@ namespace moe {
 
         struct {
             Pipeline::SkinningPipeline skinningPipeline;
+            Pipeline::CullingPipeline cullingPipeline;
             //Pipeline::VulkanMeshPipeline meshPipeline;
             //Pipeline::SkyBoxPipeline skyBoxPipeline;
             //Pipeline::ShadowMapPipeline shadowMapPipeline;
@@ -188,19 +243,22 @@ namespace moe {
 
         void run();
 
-        void beginFrame();
+        // render = false runs the frame for input and state only, draw commands submitted during it are dropped
+        void beginFrame(bool render = true);
 
         void endFrame();
 
+        bool isRenderingFrame() const { return !m_stopRendering && !m_skipRenderThisFrame; }
+
         void addImGuiDrawCommand(Function<void()>&& fn) {
-            if (m_stopRendering) {
+            if (!isRenderingFrame()) {
                 return;
             }
             m_imguiDrawQueue.push(std::move(fn));
         }
 
         void addIm3dDrawCommand(Function<void()>&& fn) {
-            if (m_stopRendering) {
+            if (!isRenderingFrame()) {
                 return;
             }
             m_im3dDrawQueue.push(std::move(fn));
@@ -215,6 +273,51 @@ namespace moe {
 
         void setFxaaEnabled(bool enabled) { m_enableFxaa = enabled; }
 
+        bool isFrustumCullingEnabled() const { return m_enableFrustumCulling; }
+
+        void setFrustumCullingEnabled(bool enabled) { m_enableFrustumCulling = enabled; }
+
+        bool isDrawSortingEnabled() const { return m_enableDrawSorting; }
+
+        void setDrawSortingEnabled(bool enabled) { m_enableDrawSorting = enabled; }
+
+        bool isInstancingEnabled() const { return m_enableInstancing; }
+
+        void setInstancingEnabled(bool enabled) { m_enableInstancing = enabled; }
+
+        bool isGpuDrivenEnabled() const { return m_enableGpuDriven; }
+
+        bool isGpuDrivenSupported() const { return m_supportsGpuDriven; }
+
+        void setGpuDrivenEnabled(bool enabled) { m_enableGpuDriven = enabled && m_supportsGpuDriven; }
+
+        bool isParallelRecordingEnabled() const { return m_enableParallelRecording; }
+
+        void setParallelRecordingEnabled(bool enabled) { m_enableParallelRecording = enabled; }
+
+        // threads recording at once, the render thread included, clamped to what the thread pool has
+        uint32_t getRecordingThreads() const { return m_commandRecorder.getSlotLimit(); }
+
+        uint32_t getMaxRecordingThreads() const { return m_commandRecorder.getSlotCount(); }
+
+        void setRecordingThreads(uint32_t threads) { m_commandRecorder.setSlotLimit(threads); }
+
+        const VulkanCommandRecorder::Stats& getRecordingStats() const { return m_commandRecorder.getStats(); }
+
+        // draws of the last frame, before and after culling, and the binds they needed
+        const DrawStats& getDrawStats() const { return m_drawStats; }
+
+        const VulkanMeshArena& getMeshArena() const { return m_caches.meshCache.getArena(); }
+
+        const VulkanUploadService& getUploadService() const { return m_uploadService; }
+
+        const VulkanPipelineCache& getPipelineCache() const { return m_pipelineCache; }
+
+        const VulkanPostFXGraph::Stats& getPostFXStats() const { return m_pipelines.postFxGraph.getStats(); }
+
+        // passes, culled passes and barriers of the last frame
+        const VulkanRenderGraph::Stats& getFrameGraphStats() const { return m_frameGraph.getStats(); }
+
         void immediateSubmit(Function<void(VkCommandBuffer)>&& fn, Function<void()>&& postFn = nullptr);
 
         VulkanAllocatedBuffer allocateBuffer(size_t size, VkBufferUsageFlags usage, VmaMemoryUsage memoryUsage);
@@ -237,8 +340,6 @@ namespace moe {
 
         void destroyBuffer(VulkanAllocatedBuffer& buffer);
 
-        VulkanGPUMeshBuffer uploadMesh(Span<uint32_t> indices, Span<Vertex> vertices, Span<SkinningData> skinningData = {});
-
         FrameData& getCurrentFrame() { return m_frames[m_frameNumber % FRAMES_IN_FLIGHT]; }
 
         size_t getCurrentFrameIndex() const { return m_frameNumber % FRAMES_IN_FLIGHT; }
@@ -295,10 +396,16 @@ namespace moe {
 
         void initSyncPrimitives();
 
+        void initUploadService();
+
         void initDescriptors();
 
         void initCaches();
 
+        void initPipelineCache();
+
+        void initFrameGraph();
+
         void initBindlessSet();
 
         void initPipelines();
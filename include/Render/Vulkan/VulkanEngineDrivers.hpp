@@ -72,12 +72,15 @@ namespace moe {
 
         VulkanCPULight getSunlight() const { return sunLight; }
 
+        // a sun without light is not uploaded, nothing then samples the shadow map and the shadow pass is culled
+        bool hasSunlight() const { return sunLight.intensity > 0.0f && sunLight.color != glm::vec3(0.0f); }
+
         glm::vec4 getAmbientColorStrength() const { return ambientColorStrength; }
 
         void uploadToGPU(VkCommandBuffer cmdBuffer, uint32_t frameIndex);
 
         // includes the sun light + static lights + dynamic lights
-        size_t getNumLights() const { return staticLights.size() + dynamicLights.size() + 1; }
+        size_t getNumLights() const { return staticLights.size() + dynamicLights.size() + (hasSunlight() ? 1 : 0); }
 
         void resetDynamicState() { dynamicLights.clear(); }
 
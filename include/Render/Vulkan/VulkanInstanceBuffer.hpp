@@ -0,0 +1,43 @@
+#pragma once
+
+#include "Render/Common.hpp"
+#include "Render/Vulkan/VulkanInstancing.hpp"
+#include "Render/Vulkan/VulkanTypes.hpp"
+
+
+namespace moe {
+    class VulkanEngine;
+}// namespace moe
+
+namespace moe {
+    // host visible instance buffer per frame in flight, written once per frame and read through its device address
+    struct VulkanInstanceBuffer {
+    public:
+        static constexpr size_t DEFAULT_INITIAL_CAPACITY = 1024;
+        static constexpr size_t GROWTH_FACTOR = 2;
+
+        VulkanInstanceBuffer() = default;
+        ~VulkanInstanceBuffer() = default;
+
+        void init(VulkanEngine& engine, size_t initialCapacity = DEFAULT_INITIAL_CAPACITY);
+
+        void destroy();
+
+        // copies the instances into the frame's buffer, growing it first when they don't fit
+        // the frame's buffer was last read FRAMES_IN_FLIGHT frames ago, whose fence has been waited on
+        VkDeviceAddress upload(const Vector<VulkanInstanceData>& instances, size_t frameIndex);
+
+    private:
+        struct SwapData {
+            VulkanAllocatedBuffer buffer{};
+            size_t capacity{0};
+        };
+
+        VulkanEngine* m_engine{nullptr};
+        bool m_initialized{false};
+
+        Array<SwapData, Constants::FRAMES_IN_FLIGHT> m_swapData;
+
+        void allocate(size_t capacity, size_t frameIndex);
+    };
+}// namespace moe
\ No newline at end of file
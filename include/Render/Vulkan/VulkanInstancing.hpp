@@ -0,0 +1,121 @@
+#pragma once
+
+#include "Render/Vulkan/VulkanIdTypes.hpp"
+#include "Render/Vulkan/VulkanRenderable.hpp"
+#include "Render/Vulkan/VulkanTypes.hpp"
+
+
+namespace moe {
+    // one entry of the per frame instance buffer, see InstanceData in shaders/slang/moe/instance.slang
+    struct VulkanInstanceData {
+        glm::mat4 transform;
+        glm::mat3 clampedInverseTransform;
+        // keeps the stride a multiple of 16 whether or not glm aligns its types
+        glm::vec3 padding;
+
+        // the normal matrix only needs the linear part, a 3x3 inverse is far cheaper than a 4x4 one
+        static VulkanInstanceData fromTransform(const glm::mat4& transform, bool normalMatrix = true) {
+            return {
+                    .transform = transform,
+                    .clampedInverseTransform = normalMatrix ? glm::inverse(glm::mat3(transform)) : glm::mat3(1.0f),
+                    .padding = glm::vec3(0.0f),
+            };
+        }
+    };
+
+    static_assert(sizeof(VulkanInstanceData) == 112, "VulkanInstanceData must match the scalar layout of InstanceData");
+
+    // one vkCmdDrawIndexed, its instances are [firstInstance, firstInstance + instanceCount) of the instance list
+    struct VulkanInstancedDraw {
+        MeshId meshId;
+        MaterialId materialId;
+        uint32_t firstInstance;
+        uint32_t instanceCount;
+
+        // skinned packets read their own vertex buffer, so they always draw alone
+        bool skinned{false};
+        VkDeviceAddress skinnedVertexBufferAddr{0};
+    };
+
+    // turns a run of packets into instanced draws, only consecutive packets ever share a draw
+    // so the order the caller pushes in, usually VkSortKey order, decides how well they group
+    struct VulkanInstanceBatcher {
+    public:
+        enum class Grouping : uint8_t {
+            // every packet draws alone, for comparing against the grouped passes
+            None,
+            // depth only passes never read the material
+            Mesh,
+            MeshAndMaterial,
+        };
+
+        // depth only passes can skip the per instance normal matrix
+        explicit VulkanInstanceBatcher(bool normalMatrices = true) : m_normalMatrices(normalMatrices) {}
+
+        void clear() { m_instances.clear(); }
+
+        void reserve(size_t count) { m_instances.reserve(count); }
+
+        // appends the packet as an instance, growing the last draw when the packet can join it
+        // draws of several passes may share one instance list, as long as each pass pushes into its own draws
+        void push(const VulkanRenderPacket& packet, Grouping grouping, Vector<VulkanInstancedDraw>& draws);
+
+        const Vector<VulkanInstanceData>& getInstances() const { return m_instances; }
+
+    private:
+        bool m_normalMatrices{true};
+        Vector<VulkanInstanceData> m_instances;
+    };
+
+    // one packet as the gpu culling pass sees it, see CullingObject in shaders/slang/gpu_culling.slang
+    struct VulkanCullingObject {
+        VulkanInstanceData instance;
+        // xyz of the world space bounds, w unused
+        glm::vec4 center;
+        glm::vec4 extent;
+        // the draw group the packet joins in the g-buffer view and in the shadow views
+        uint32_t gBufferGroup;
+        uint32_t shadowGroup;
+        uint32_t padding[2];
+    };
+
+    static_assert(sizeof(VulkanCullingObject) == 160, "VulkanCullingObject must match the scalar layout of CullingObject");
+
+    // the indirect draws of one view of the gpu driven path, group g's draw and count sit g entries past the offsets
+    // the count is 0 or 1, so groups with nothing visible cost no draw at all
+    struct VulkanIndirectView {
+        Span<const VulkanInstancedDraw> groups;
+
+        VkBuffer commandBuffer{VK_NULL_HANDLE};
+        VkDeviceSize commandOffset{0};
+        VkBuffer countBuffer{VK_NULL_HANDLE};
+        VkDeviceSize countOffset{0};
+
+        VkDeviceAddress instanceBufferAddr{0};
+    };
+
+    // groups a frame's packets for the gpu driven path, where a compute pass culls every packet and
+    // appends the survivors to their group's indirect draw. each group is one indirect draw per view,
+    // its instanceCount is the group's capacity and firstInstance is relative to the view's instance range
+    // unlike VulkanInstanceBatcher, packets of a group need not be consecutive, so no sorting is needed
+    struct VulkanIndirectDrawBuilder {
+    public:
+        void build(Span<const VulkanRenderPacket> packets);
+
+        const Vector<VulkanCullingObject>& getObjects() const { return m_objects; }
+
+        // grouped by mesh and material
+        const Vector<VulkanInstancedDraw>& getGBufferGroups() const { return m_gBufferGroups; }
+
+        // grouped by mesh only, depth never reads the material
+        const Vector<VulkanInstancedDraw>& getShadowGroups() const { return m_shadowGroups; }
+
+    private:
+        Vector<VulkanCullingObject> m_objects;
+        Vector<VulkanInstancedDraw> m_gBufferGroups;
+        Vector<VulkanInstancedDraw> m_shadowGroups;
+
+        UnorderedMap<uint64_t, uint32_t> m_gBufferLookup;
+        UnorderedMap<uint64_t, uint32_t> m_shadowLookup;
+    };
+}// namespace moe
\ No newline at end of file
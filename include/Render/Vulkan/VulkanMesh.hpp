@@ -10,17 +10,24 @@ namespace moe {
         uint32_t indexCount;
     };
 
+    // a mesh's ranges of the mesh arena's shared buffers, the buffers themselves belong to the arena
     struct VulkanGPUMeshBuffer {
         VulkanAllocatedBuffer vertexBuffer;
         VulkanAllocatedBuffer indexBuffer;
         VulkanAllocatedBuffer skinningDataBuffer;
 
+        // addresses of the mesh's first vertex and skinning entry, indices are relative to the first vertex
         VkDeviceAddress vertexBufferAddr;
         VkDeviceAddress skinningDataBufferAddr;
 
         uint32_t indexCount;
         uint32_t vertexCount;
 
+        // in elements of the shared buffers, draws pass firstIndex to vkCmdDrawIndexed
+        uint32_t vertexOffset{0};
+        uint32_t firstIndex{0};
+        uint32_t skinningDataOffset{0};
+
         bool hasSkinningData;
     };
 
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "Render/Vulkan/VulkanMesh.hpp"
+#include "Render/Vulkan/VulkanRangeAllocator.hpp"
+#include "Render/Vulkan/VulkanTypes.hpp"
+
+
+// fwd decl
+namespace moe {
+    class VulkanEngine;
+}
+
+namespace moe {
+    // every mesh's vertices, indices and skinning data live in three shared gpu buffers
+    // a mesh is a range of each, so draws of different meshes bind the same index buffer
+    struct VulkanMeshArena {
+    public:
+        static constexpr uint32_t INITIAL_VERTEX_CAPACITY = 1u << 18;
+        static constexpr uint32_t INITIAL_INDEX_CAPACITY = 1u << 20;
+        static constexpr uint32_t INITIAL_SKINNING_DATA_CAPACITY = 1u << 16;
+
+        struct Stats {
+            uint32_t uploads{0};
+            uint32_t growths{0};
+            uint32_t compactions{0};
+            // cpu time spent in upload, staging included, the gpu copies run later
+            float uploadMs{0.0f};
+        };
+
+        // every range that compaction moved, remap mesh offsets through them
+        struct Compaction {
+            Vector<VulkanRangeAllocator::Move> vertices;
+            Vector<VulkanRangeAllocator::Move> indices;
+            Vector<VulkanRangeAllocator::Move> skinningData;
+        };
+
+        VulkanMeshArena() = default;
+        ~VulkanMeshArena() = default;
+
+        void init(VulkanEngine& engine);
+
+        void destroy();
+
+        // copies a mesh into the shared buffers, growing them when it does not fit
+        // growing replaces the buffers, meshes uploaded earlier must be resolved again, see getGeneration
+        VulkanGPUMeshBuffer upload(Span<uint32_t> indices, Span<Vertex> vertices, Span<SkinningData> skinningData);
+
+        void free(const VulkanGPUMeshBuffer& mesh);
+
+        // packs live meshes to the front of each buffer, waits for the device to go idle first
+        Compaction compact();
+
+        // fills a mesh's buffers and addresses in from its offsets
+        void resolve(VulkanGPUMeshBuffer& mesh) const;
+
+        // bumps whenever growth or compaction replaced the shared buffers
+        uint32_t getGeneration() const { return m_generation; }
+
+        const Stats& getStats() const { return m_stats; }
+
+        const VulkanRangeAllocator& getVertexAllocator() const { return m_vertices.allocator; }
+
+        const VulkanRangeAllocator& getIndexAllocator() const { return m_indices.allocator; }
+
+        const VulkanRangeAllocator& getSkinningDataAllocator() const { return m_skinningData.allocator; }
+
+    private:
+        struct Pool {
+            VulkanAllocatedBuffer buffer;
+            VulkanRangeAllocator allocator;
+            VkBufferUsageFlags usage{0};
+            uint32_t stride{0};
+        };
+
+        bool m_initialized{false};
+        VulkanEngine* m_engine{nullptr};
+
+        Pool m_vertices;
+        Pool m_indices;
+        Pool m_skinningData;
+
+        uint32_t m_generation{0};
+        Stats m_stats;
+
+        void initPool(Pool& pool, uint32_t capacity, uint32_t stride, VkBufferUsageFlags usage);
+
+        uint32_t allocate(Pool& pool, uint32_t count);
+
+        // moves the pool into a new buffer of newCapacity, copying regions from the old one
+        void replaceBuffer(Pool& pool, uint32_t newCapacity, Span<const VkBufferCopy> regions);
+    };
+}// namespace moe
\ No newline at end of file
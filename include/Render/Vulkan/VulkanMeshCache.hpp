@@ -3,6 +3,7 @@
 #include "Render/Vulkan/VulkanCacheUtils.hpp"
 #include "Render/Vulkan/VulkanIdTypes.hpp"
 #include "Render/Vulkan/VulkanMesh.hpp"
+#include "Render/Vulkan/VulkanMeshArena.hpp"
 #include "Render/Vulkan/VulkanTypes.hpp"
 
 
@@ -24,6 +25,14 @@ namespace moe {
 
         Optional<VulkanGPUMesh> getMesh(MeshId id) const;
 
+        // frees the mesh's ranges of the arena, no frame in flight may still draw it
+        void unloadMesh(MeshId id);
+
+        // packs the arena after meshes were unloaded, stalls until the device is idle
+        void compactArena();
+
+        const VulkanMeshArena& getArena() const { return m_arena; }
+
         void destroy();
 
         struct {
@@ -36,5 +45,11 @@ namespace moe {
 
         UnorderedMap<MeshId, VulkanGPUMesh> m_meshes;
         VulkanCacheIdAllocator<MeshId> m_idAllocator;
+
+        VulkanMeshArena m_arena;
+        // the arena generation the meshes' buffers and addresses were resolved against
+        uint32_t m_arenaGeneration{0};
+
+        void resolveMeshes();
     };
 }// namespace moe
\ No newline at end of file
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "Core/Common.hpp"
+
+namespace moe {
+    namespace VkParallel {
+        // a chunk's items, end exclusive
+        struct ChunkRange {
+            size_t begin;
+            size_t end;
+        };
+
+        // how many chunks count items are split into, none smaller than minPerChunk unless count is, at most maxChunks
+        uint32_t chunkCount(size_t count, size_t minPerChunk, uint32_t maxChunks);
+
+        // chunk's items when count items are split into chunks near equal, contiguous chunks in order
+        ChunkRange chunkRange(size_t count, uint32_t chunks, uint32_t chunk);
+    }// namespace VkParallel
+}// namespace moe
\ No newline at end of file
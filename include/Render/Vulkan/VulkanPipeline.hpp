@@ -1,7 +1,10 @@
 #pragma once
 
+#include "Render/Vulkan/VulkanPipelineCache.hpp"
 #include "Render/Vulkan/VulkanTypes.hpp"
 
+#include <chrono>
+
 namespace moe {
     class VulkanPipelineBuilder {
     public:
@@ -24,7 +27,8 @@ namespace moe {
 
         void clear();
 
-        VkPipeline build(VkDevice device);
+        // creates through the cache when given one, and records the creation time in it
+        VkPipeline build(VkDevice device, VulkanPipelineCache* cache = nullptr);
 
         void addShader(VkShaderModule vert, VkShaderModule frag);
 
@@ -83,14 +87,18 @@ namespace moe {
             shaderStage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
         }
 
-        VkPipeline build(VkDevice device) {
+        VkPipeline build(VkDevice device, VulkanPipelineCache* cache = nullptr) {
             VkComputePipelineCreateInfo pipelineInfo{};
             pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
             pipelineInfo.layout = pipelineLayout;
             pipelineInfo.stage = shaderStage;
 
             VkPipeline pipeline;
-            VkResult result = vkCreateComputePipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &pipeline);
+            auto start = std::chrono::high_resolution_clock::now();
+            VkResult result = vkCreateComputePipelines(device, cache ? cache->get() : VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &pipeline);
+            if (cache) {
+                cache->recordCreation(std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count());
+            }
             if (result != VK_SUCCESS) {
                 Logger::error("Failed to create compute pipeline");
                 return VK_NULL_HANDLE;
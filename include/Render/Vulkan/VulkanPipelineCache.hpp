@@ -0,0 +1,70 @@
+#pragma once
+
+#include "Render/Vulkan/VulkanTypes.hpp"
+
+
+namespace moe {
+    // the device and driver a saved cache was built with, a cache from anything else is thrown away
+    struct VulkanPipelineCacheIdentity {
+        uint32_t vendorID{0};
+        uint32_t deviceID{0};
+        uint32_t driverVersion{0};
+        Array<uint8_t, VK_UUID_SIZE> pipelineCacheUUID{};
+
+        static VulkanPipelineCacheIdentity fromProperties(const VkPhysicalDeviceProperties& properties);
+    };
+
+    // on disk layout: our own header, then the driver's blob, which starts with a VkPipelineCacheHeaderVersionOne
+    // our header carries what the driver's does not, the driver version and a hash of the blob
+    namespace VkPipelineCacheFile {
+        Vector<uint8_t> serialize(const VulkanPipelineCacheIdentity& identity, Span<const uint8_t> blob);
+
+        // the driver's blob when the file is intact and both headers match the identity, nullopt otherwise
+        Optional<Span<const uint8_t>> validate(Span<const uint8_t> file, const VulkanPipelineCacheIdentity& identity);
+    }// namespace VkPipelineCacheFile
+
+    // one VkPipelineCache for every pipeline the engine creates, loaded from disk at init and saved back at destroy
+    struct VulkanPipelineCache {
+    public:
+        static constexpr const char* DEFAULT_PATH = "./cache/pipeline.bin";
+
+        struct Stats {
+            // whether init found a usable cache on disk
+            bool warm{false};
+            size_t loadedBytes{0};
+            uint32_t pipelines{0};
+            // cpu time spent inside vkCreate*Pipelines
+            float createMs{0.0f};
+        };
+
+        VulkanPipelineCache() = default;
+        ~VulkanPipelineCache() = default;
+
+        void init(VkDevice device, VkPhysicalDevice physicalDevice, StringView path = DEFAULT_PATH);
+
+        void destroy();
+
+        VkPipelineCache get() const { return m_cache; }
+
+        // called by the pipeline builders around every creation
+        void recordCreation(float ms) {
+            ++m_stats.pipelines;
+            m_stats.createMs += ms;
+        }
+
+        const Stats& getStats() const { return m_stats; }
+
+    private:
+        bool m_initialized{false};
+
+        VkDevice m_device{VK_NULL_HANDLE};
+        VkPipelineCache m_cache{VK_NULL_HANDLE};
+        VulkanPipelineCacheIdentity m_identity;
+        String m_path;
+
+        Stats m_stats;
+
+        // writes next to the target and renames over it, so a crash mid write never leaves a torn cache
+        void save() const;
+    };
+}// namespace moe
\ No newline at end of file
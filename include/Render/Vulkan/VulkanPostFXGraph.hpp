@@ -24,7 +24,11 @@ struct VulkanCompiledPostFXStage {
 
     Vector<uint32_t> inputIndices;
     Vector<uint32_t> outputIndices;
+    // inputs this stage is the first to read, their attachment -> sampled barriers are batched with this stage's
+    Vector<uint32_t> firstReadIndices;
 
+    // the transient image this stage writes, shared with stages whose lifetimes do not overlap
+    uint32_t physicalIndex;
     VulkanAllocatedImage outputImage;
     ImageId outputImageId;
 
@@ -37,6 +41,17 @@ struct VulkanCompiledPostFXStage {
 };
 
 struct VulkanPostFXGraph {
+    struct Stats {
+        uint32_t logicalImages{0};
+        uint32_t physicalImages{0};
+        size_t transientBytes{0};
+        // what the images would take if every stage kept its own
+        size_t unaliasedBytes{0};
+        // of the last exec
+        uint32_t barrierBatches{0};
+        uint32_t imageBarriers{0};
+    };
+
     void init(VulkanEngine& eng) {
         MOE_ASSERT(!initialized, "VulkanPostFXGraph already initialized");
         engine = &eng;
@@ -89,6 +104,10 @@ struct VulkanPostFXGraph {
         return compilationLog;
     }
 
+    const Stats& getStats() const {
+        return stats;
+    }
+
 private:
     Vector<VulkanPostFXStage> stages;
     Vector<uint32_t> compiledStagesOrder;
@@ -105,6 +124,17 @@ private:
     UnorderedMap<uint32_t, VulkanCompiledPostFXStage> compiledStages;
     UnorderedMap<String, uint32_t> nameToImageIndex;
 
+    struct TransientImage {
+        VulkanAllocatedImage image;
+        ImageId imageId;
+    };
+
+    // the physical images stages are assigned to, allocated once per compile
+    Vector<TransientImage> transientImages;
+    Vector<VkImageMemoryBarrier2> barrierScratch;
+
+    Stats stats;
+
     VulkanEngine* engine{nullptr};
     bool initialized{false};
 
@@ -115,6 +145,12 @@ private:
 
     void resolveDependencies();
 
+    void allocateTransientImages();
+
+    void planBarriers();
+
+    void recordBarriers(VkCommandBuffer cmdBuffer);
+
     void logCompilationResult();
 };
 
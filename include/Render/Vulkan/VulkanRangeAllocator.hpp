@@ -0,0 +1,60 @@
+#pragma once
+
+#include "Core/Common.hpp"
+
+
+namespace moe {
+    // hands out ranges of elements in [0, capacity), it never touches memory itself
+    // free ranges are kept sorted by offset and merged with their neighbours, allocation takes the first that fits
+    struct VulkanRangeAllocator {
+    public:
+        // a live range that compaction moved, both offsets are in elements
+        struct Move {
+            uint32_t srcOffset;
+            uint32_t dstOffset;
+            uint32_t count;
+        };
+
+        explicit VulkanRangeAllocator(uint32_t capacity = 0);
+
+        // the offset of count free elements, nullopt when no free range is large enough
+        Optional<uint32_t> allocate(uint32_t count);
+
+        // offset must come from allocate and not have been freed since
+        void free(uint32_t offset);
+
+        // new elements are appended, live ranges keep their offsets
+        void grow(uint32_t newCapacity);
+
+        // packs the live ranges to the front in offset order, leaving a single free range at the end
+        // returns every range that moved, sorted by its old offset
+        Vector<Move> compact();
+
+        // where an offset ended up after compact() returned moves, unmoved offsets map to themselves
+        static uint32_t remap(const Vector<Move>& moves, uint32_t offset);
+
+        uint32_t getCapacity() const { return m_capacity; }
+
+        uint32_t getUsed() const { return m_used; }
+
+        size_t getAllocationCount() const { return m_allocations.size(); }
+
+        // more than one free range means some free space sits between live ranges
+        size_t getFreeRangeCount() const { return m_freeRanges.size(); }
+
+        uint32_t getLargestFreeRange() const;
+
+    private:
+        struct Range {
+            uint32_t offset;
+            uint32_t count;
+        };
+
+        uint32_t m_capacity{0};
+        uint32_t m_used{0};
+
+        Vector<Range> m_freeRanges;
+        // offset to count of every live range
+        UnorderedMap<uint32_t, uint32_t> m_allocations;
+    };
+}// namespace moe
\ No newline at end of file
@@ -0,0 +1,211 @@
+#pragma once
+
+#include "Render/Vulkan/VulkanTransientImages.hpp"
+#include "Render/Vulkan/VulkanTypes.hpp"
+
+
+namespace moe {
+    // how a pass uses a resource, each fixes the stages, the memory accesses and, for images, the layout of the use
+    enum class VulkanRGAccess : uint8_t {
+        ColorAttachment,
+        // depth and stencil attachment optimal, the depth formats in use have no separate stencil layout
+        DepthAttachment,
+        SampledFragment,
+        StorageReadCompute,
+        StorageWriteCompute,
+        // buffers vertex shaders read through device addresses
+        StorageReadVertex,
+        IndirectRead,
+        TransferSrc,
+        TransferDst,
+        // the last use of a swapchain image before vkQueuePresentKHR
+        Present,
+    };
+
+    using VulkanRGResourceId = uint32_t;
+
+    // the frame's passes in submission order, each declaring what it reads and writes
+    // compile culls the passes nothing depends on and plans the barriers between the uses of every resource,
+    // execute records each live pass after one batched barrier holding exactly what its uses need
+    // resources are tracked by handle across frames, so a frame's first barrier on a resource waits on the last frame's uses
+    class VulkanRenderGraph {
+    public:
+        struct Stats {
+            uint32_t passes{0};
+            uint32_t culledPasses{0};
+            // passes that needed a barrier, each records one vkCmdPipelineBarrier2
+            uint32_t barrierBatches{0};
+            uint32_t imageBarriers{0};
+            uint32_t bufferBarriers{0};
+            uint32_t transientImages{0};
+            uint32_t physicalImages{0};
+        };
+
+        // the barriers recorded before a live pass, as ranges of getImageBarriers and getBufferBarriers
+        struct CompiledPass {
+            uint32_t pass;
+            uint32_t firstImageBarrier;
+            uint32_t imageBarrierCount;
+            uint32_t firstBufferBarrier;
+            uint32_t bufferBarrierCount;
+        };
+
+        using ImageAllocator = Function<VulkanAllocatedImage(const VulkanTransientImageDesc&)>;
+        // called once the graph stops using an image, the image may still be in use by frames in flight
+        using ImageReleaser = Function<void(const VulkanAllocatedImage&)>;
+
+        struct PassBuilder {
+        public:
+            PassBuilder& read(VulkanRGResourceId resource, VulkanRGAccess access);
+
+            PassBuilder& write(VulkanRGResourceId resource, VulkanRGAccess access);
+
+            // keeps the pass even if nothing reads what it writes, e.g. presenting
+            PassBuilder& sideEffect();
+
+        private:
+            friend class VulkanRenderGraph;
+
+            PassBuilder(VulkanRenderGraph& graph, uint32_t pass)
+                : m_graph(&graph), m_pass(pass) {}
+
+            VulkanRenderGraph* m_graph;
+            uint32_t m_pass;
+        };
+
+        VulkanRenderGraph() = default;
+        ~VulkanRenderGraph() = default;
+
+        void init(ImageAllocator allocator, ImageReleaser releaser);
+
+        void destroy();
+
+        // drops the last frame's passes and resources, what is known about every handle is kept
+        void beginFrame();
+
+        // a resource the graph does not own, it must be written in the graph before it is first read
+        // null handles are accepted and never get barriers, e.g. a buffer not allocated yet
+        VulkanRGResourceId importImage(StringView name, VkImage image, VkImageAspectFlags aspect = VK_IMAGE_ASPECT_COLOR_BIT);
+
+        // an image made available by a semaphore wait at waitStage, e.g. an acquired swapchain image
+        VulkanRGResourceId importAcquiredImage(StringView name, VkImage image, VkPipelineStageFlags2 waitStage);
+
+        VulkanRGResourceId importBuffer(StringView name, VkBuffer buffer);
+
+        // owned by the graph, shares its memory with transient images whose passes do not overlap
+        VulkanRGResourceId createImage(StringView name, VkFormat format, VkExtent3D extent, VkImageUsageFlags usage, VkImageAspectFlags aspect = VK_IMAGE_ASPECT_COLOR_BIT);
+
+        // passes are recorded in the order they are added, record must not record barriers for declared resources
+        PassBuilder addPass(StringView name, Function<void(VkCommandBuffer)>&& record);
+
+        void compile();
+
+        void execute(VkCommandBuffer cmdBuffer);
+
+        // a transient image's allocation, valid from compile until the next beginFrame
+        const VulkanAllocatedImage& getImage(VulkanRGResourceId resource) const;
+
+        bool isCulled(uint32_t pass) const { return m_passes[pass].culled; }
+
+        StringView getPassName(uint32_t pass) const { return m_passes[pass].name; }
+
+        Span<const CompiledPass> getCompiledPasses() const { return m_compiledPasses; }
+
+        Span<const VkImageMemoryBarrier2> getImageBarriers() const { return m_imageBarriers; }
+
+        Span<const VkBufferMemoryBarrier2> getBufferBarriers() const { return m_bufferBarriers; }
+
+        const Stats& getStats() const { return m_stats; }
+
+    private:
+        // a handle unused for this many frames is forgotten, every frame in flight has long retired its uses
+        static constexpr uint64_t STATE_RETENTION_FRAMES = 16;
+
+        enum class ResourceType : uint8_t {
+            Image,
+            Buffer,
+        };
+
+        struct Resource {
+            String name;
+            ResourceType type;
+            VkImage image{VK_NULL_HANDLE};
+            VkBuffer buffer{VK_NULL_HANDLE};
+            VkImageAspectFlags aspect{0};
+
+            bool transient{false};
+            VulkanTransientImageDesc transientDesc{};
+            // the pool entry the image took this frame
+            uint32_t poolIndex{0};
+        };
+
+        // one per resource a pass touches, a resource used twice merges both uses
+        struct Use {
+            VulkanRGResourceId resource;
+            VkPipelineStageFlags2 stages;
+            VkAccessFlags2 access;
+            VkImageLayout layout;
+            bool write;
+        };
+
+        struct Pass {
+            String name;
+            Function<void(VkCommandBuffer)> record;
+            Vector<Use> uses;
+            bool sideEffect{false};
+            bool culled{false};
+        };
+
+        // what the graph knows about a handle between uses
+        struct HandleState {
+            VkImageLayout layout{VK_IMAGE_LAYOUT_UNDEFINED};
+            // the last write, or layout transition, not every later use has waited on yet
+            VkPipelineStageFlags2 writeStages{VK_PIPELINE_STAGE_2_NONE};
+            VkAccessFlags2 writeAccess{VK_ACCESS_2_NONE};
+            // the reads since, the next write waits on them and later reads they cover need no barrier
+            VkPipelineStageFlags2 readStages{VK_PIPELINE_STAGE_2_NONE};
+            VkAccessFlags2 readAccess{VK_ACCESS_2_NONE};
+            uint64_t lastFrame{0};
+        };
+
+        struct PooledImage {
+            VulkanAllocatedImage image;
+            VkFormat format;
+            VkExtent3D extent;
+            VkImageUsageFlags usage;
+            bool used{false};
+        };
+
+        bool m_initialized{false};
+
+        ImageAllocator m_allocateImage;
+        ImageReleaser m_releaseImage;
+
+        Vector<Resource> m_resources;
+        Vector<Pass> m_passes;
+
+        UnorderedMap<uint64_t, HandleState> m_states;
+        uint64_t m_frame{0};
+
+        // the physical transient images, kept across frames and reused while a frame still wants them
+        Vector<PooledImage> m_imagePool;
+
+        Vector<CompiledPass> m_compiledPasses;
+        Vector<VkImageMemoryBarrier2> m_imageBarriers;
+        Vector<VkBufferMemoryBarrier2> m_bufferBarriers;
+
+        Stats m_stats;
+
+        VulkanRGResourceId addResource(Resource&& resource);
+
+        void addUse(uint32_t pass, VulkanRGResourceId resource, VulkanRGAccess access, bool write);
+
+        void cullPasses();
+
+        void allocateTransientImages();
+
+        void planBarriers();
+
+        void releaseStaleState();
+    };
+}// namespace moe
\ No newline at end of file
@@ -15,8 +15,20 @@ namespace moe {
     struct VulkanRenderTarget {
         Vector<VulkanRenderPacket> renderPackets;
 
+        // renderPackets' bounds, and what survived the camera frustum in draw order
+        VulkanCullingBatch cullingBatch;
+        Vector<uint32_t> visibleIndices;
+        Vector<VulkanRenderPacket> visiblePackets;
+
+        Vector<uint64_t> sortKeys;
+        VulkanDrawSorter drawSorter;
+
         void resetDynamicState() {
             renderPackets.clear();
+            cullingBatch.clear();
+            visibleIndices.clear();
+            visiblePackets.clear();
+            sortKeys.clear();
         }
     };
 
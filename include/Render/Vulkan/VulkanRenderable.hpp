@@ -1,6 +1,8 @@
 #pragma once
 
+#include "Render/Vulkan/VulkanCulling.hpp"
 #include "Render/Vulkan/VulkanIdTypes.hpp"
+#include "Render/Vulkan/VulkanSortKey.hpp"
 #include "Render/Vulkan/VulkanTypes.hpp"
 
 
@@ -10,17 +12,25 @@ namespace moe {
     constexpr size_t INVALID_JOINT_MATRIX_START_INDEX = std::numeric_limits<size_t>::max();
 
     struct VulkanRenderPacket {
-        static constexpr uint32_t INVALID_SORT_KEY = std::numeric_limits<uint32_t>::max();
+        static constexpr uint64_t INVALID_SORT_KEY = std::numeric_limits<uint64_t>::max();
 
         MeshId meshId;
         MaterialId materialId;
         glm::mat4 transform;
-        uint32_t sortKey{INVALID_SORT_KEY};// todo: add sorting key
+        // world space, packets that leave it unbounded are never culled
+        VulkanBounds bounds{VulkanBounds::unbounded()};
+        // pipeline, material and mesh as laid out by VkSortKey, each pass adds its own pass and depth fields
+        uint64_t sortKey{INVALID_SORT_KEY};
 
         bool skinned{false};
         size_t jointMatrixStartIndex{INVALID_JOINT_MATRIX_START_INDEX};// for skinned meshes
 
         VkDeviceAddress skinnedVertexBufferAddr{0};// for skinned meshes
+
+        // where the packet sorts by depth, the bounds' center or the origin of its transform
+        glm::vec3 getSortPosition() const {
+            return bounds.isUnbounded() ? glm::vec3(transform[3]) : bounds.center;
+        }
     };
 
     struct VulkanDrawContext {
@@ -23,7 +23,7 @@ namespace moe {
 
     struct VulkanSceneNode : public VulkanRenderNode {
         SceneResourceInternalId resourceInternalId{NULL_SCENE_RESOURCE_INTERNAL_ID};// -> VulkanScene::meshes
-        uint32_t sortKey{VulkanRenderPacket::INVALID_SORT_KEY};
+        uint64_t sortKey{VulkanRenderPacket::INVALID_SORT_KEY};
 
         void gatherRenderPackets(Vector<VulkanRenderPacket>& packets, const VulkanDrawContext& drawContext) override;
     };
@@ -31,6 +31,8 @@ namespace moe {
     struct VulkanSceneMesh {
         Vector<MeshId> primitives;
         Vector<MaterialId> primitiveMaterials;
+        // local space bounds per primitive, from the position accessor's min and max
+        Vector<VulkanBounds> primitiveBounds;
     };
 
     struct VulkanSkeletalAnimation {
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "Core/Common.hpp"
+
+#include "Math/Common.hpp"
+
+
+namespace moe {
+    // 64 bit draw order key, packets are drawn in ascending key order
+    // | pass 4 | pipeline 4 | material 20 | mesh 20 | depth 16 |
+    // ids wider than their field wrap, which only costs grouping, never correctness
+    namespace VkSortKey {
+        enum class Pass : uint8_t {
+            Opaque = 0,
+            ShadowDepth = 1,
+        };
+
+        // vertex source of the draw, static meshes and skinned meshes read different buffers
+        enum class Pipeline : uint8_t {
+            Static = 0,
+            Skinned = 1,
+        };
+
+        constexpr uint32_t DEPTH_BITS = 16;
+        constexpr uint32_t MESH_BITS = 20;
+        constexpr uint32_t MATERIAL_BITS = 20;
+        constexpr uint32_t PIPELINE_BITS = 4;
+        constexpr uint32_t PASS_BITS = 4;
+
+        constexpr uint32_t DEPTH_SHIFT = 0;
+        constexpr uint32_t MESH_SHIFT = DEPTH_SHIFT + DEPTH_BITS;
+        constexpr uint32_t MATERIAL_SHIFT = MESH_SHIFT + MESH_BITS;
+        constexpr uint32_t PIPELINE_SHIFT = MATERIAL_SHIFT + MATERIAL_BITS;
+        constexpr uint32_t PASS_SHIFT = PIPELINE_SHIFT + PIPELINE_BITS;
+        static_assert(PASS_SHIFT + PASS_BITS == 64, "sort key fields must fill 64 bits");
+
+        constexpr uint64_t fieldMask(uint32_t bits, uint32_t shift) { return ((uint64_t{1} << bits) - 1) << shift; }
+
+        constexpr uint64_t DEPTH_MASK = fieldMask(DEPTH_BITS, DEPTH_SHIFT);
+        constexpr uint64_t MESH_MASK = fieldMask(MESH_BITS, MESH_SHIFT);
+        constexpr uint64_t MATERIAL_MASK = fieldMask(MATERIAL_BITS, MATERIAL_SHIFT);
+        constexpr uint64_t PIPELINE_MASK = fieldMask(PIPELINE_BITS, PIPELINE_SHIFT);
+        constexpr uint64_t PASS_MASK = fieldMask(PASS_BITS, PASS_SHIFT);
+
+        constexpr uint64_t make(Pass pass, Pipeline pipeline, uint32_t material, uint32_t mesh, uint32_t depth) {
+            return ((static_cast<uint64_t>(pass) << PASS_SHIFT) & PASS_MASK)
+                   | ((static_cast<uint64_t>(pipeline) << PIPELINE_SHIFT) & PIPELINE_MASK)
+                   | ((static_cast<uint64_t>(material) << MATERIAL_SHIFT) & MATERIAL_MASK)
+                   | ((static_cast<uint64_t>(mesh) << MESH_SHIFT) & MESH_MASK)
+                   | ((static_cast<uint64_t>(depth) << DEPTH_SHIFT) & DEPTH_MASK);
+        }
+
+        constexpr Pass getPass(uint64_t key) { return static_cast<Pass>((key & PASS_MASK) >> PASS_SHIFT); }
+
+        constexpr Pipeline getPipeline(uint64_t key) { return static_cast<Pipeline>((key & PIPELINE_MASK) >> PIPELINE_SHIFT); }
+
+        constexpr uint32_t getMaterial(uint64_t key) { return static_cast<uint32_t>((key & MATERIAL_MASK) >> MATERIAL_SHIFT); }
+
+        constexpr uint32_t getMesh(uint64_t key) { return static_cast<uint32_t>((key & MESH_MASK) >> MESH_SHIFT); }
+
+        constexpr uint32_t getDepth(uint64_t key) { return static_cast<uint32_t>((key & DEPTH_MASK) >> DEPTH_SHIFT); }
+
+        // clip space depth of a world position, quantized to the depth field, 0 is nearest
+        uint32_t quantizeDepth(const glm::mat4& viewProjection, const glm::vec3& position);
+
+        // opaque g-buffer policy: state first, then front to back inside a state so early depth rejects more
+        inline uint64_t opaque(uint64_t gatherKey, uint32_t depth) {
+            return (gatherKey & ~(PASS_MASK | DEPTH_MASK)) | make(Pass::Opaque, Pipeline::Static, 0, 0, depth);
+        }
+
+        // depth only shadow policy: the material is never read, so meshes group across materials
+        inline uint64_t shadowDepth(uint64_t gatherKey, uint32_t depth) {
+            return (gatherKey & (PIPELINE_MASK | MESH_MASK)) | make(Pass::ShadowDepth, Pipeline::Static, 0, 0, depth);
+        }
+    }// namespace VkSortKey
+
+    // sorts draw indices by their keys, least significant digit first with 8 bit digits
+    // digits every key shares are skipped, so keys that differ only in a few fields cost a few passes
+    struct VulkanDrawSorter {
+    public:
+        // reorders keys and indices together by ascending key, equal keys keep their order
+        void sort(Vector<uint64_t>& keys, Vector<uint32_t>& indices);
+
+    private:
+        Vector<uint64_t> m_keysScratch;
+        Vector<uint32_t> m_indicesScratch;
+    };
+
+    // what a pass submitted, binds count vkCmdBind* calls left after redundant ones were skipped
+    struct VulkanPassStats {
+        // vkCmdDrawIndexed calls, each drawing one or more instances
+        uint32_t draws{0};
+        uint32_t instances{0};
+        uint32_t indexBufferBinds{0};
+        uint32_t materialChanges{0};
+        // cpu time of building the pass's keys and sorting them
+        float sortUs{0.0f};
+        // cpu time of grouping the pass's instances, uploading them and recording its draws
+        float submitUs{0.0f};
+
+        // adds the counts of a chunk recorded on its own, the times stay the pass's
+        void addCounts(const VulkanPassStats& chunk) {
+            draws += chunk.draws;
+            instances += chunk.instances;
+            indexBufferBinds += chunk.indexBufferBinds;
+            materialChanges += chunk.materialChanges;
+        }
+    };
+}// namespace moe
\ No newline at end of file
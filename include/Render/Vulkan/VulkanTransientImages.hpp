@@ -0,0 +1,29 @@
+#pragma once
+
+#include "Render/Vulkan/VulkanTypes.hpp"
+
+
+namespace moe {
+    // a transient image and the steps of an execution order it is live in, both ends inclusive
+    // written at firstUse, read for the last time at lastUse
+    struct VulkanTransientImageDesc {
+        VkFormat format;
+        VkExtent3D extent;
+        VkImageUsageFlags usage;
+        uint32_t firstUse;
+        uint32_t lastUse;
+    };
+
+    namespace VkTransient {
+        struct Assignment {
+            // one per desc, the physical image it was given
+            Vector<uint32_t> physicalIndices;
+            // one per physical image, the desc that first took it
+            Vector<uint32_t> physicalDescs;
+        };
+
+        // descs whose lifetimes do not overlap and that agree on format, extent and usage share a physical image
+        // greedy in order of first use, which needs the fewest images per compatible group
+        Assignment assign(Span<const VulkanTransientImageDesc> descs);
+    }// namespace VkTransient
+}// namespace moe
\ No newline at end of file
@@ -0,0 +1,134 @@
+#pragma once
+
+#include "Render/Vulkan/VulkanTypes.hpp"
+
+
+// fwd decl
+namespace moe {
+    class VulkanEngine;
+}
+
+namespace moe {
+    // completes once the gpu finished the batch the upload was recorded into
+    struct VulkanUploadTicket {
+        uint64_t value{0};
+    };
+
+    // stages uploads in a persistently mapped ring and records their copies into one open batch
+    // the batch is submitted once a frame, or earlier when it runs out of room, and callers never wait on it
+    // frames wait for submitted batches on the gpu through a timeline semaphore instead, see getWaitInfo
+    // on a dedicated transfer queue, batches release what they wrote and the next frame acquires it, see recordAcquires
+    struct VulkanUploadService {
+    public:
+        static constexpr VkDeviceSize STAGING_RING_SIZE = 64ull << 20;
+        static constexpr VkDeviceSize STAGING_ALIGNMENT = 16;
+        static constexpr uint32_t BATCH_COUNT = 4;
+
+        struct Stats {
+            uint32_t submissions{0};
+            uint32_t copies{0};
+            uint64_t bytes{0};
+            // uploads too large for the ring, staged in a buffer of their own
+            uint32_t oversized{0};
+            // times the cpu waited for the gpu, for ring space, a free batch or an explicit wait
+            uint32_t stalls{0};
+            float stallMs{0.0f};
+        };
+
+        VulkanUploadService() = default;
+        ~VulkanUploadService() = default;
+
+        // queueFamilyIndex other than the graphics family makes every upload an ownership transfer
+        void init(VulkanEngine& engine, VkQueue queue, uint32_t queueFamilyIndex);
+
+        void destroy();
+
+        // data is copied into the ring before this returns
+        VulkanUploadTicket uploadBuffer(VkBuffer dst, VkDeviceSize dstOffset, const void* data, VkDeviceSize size);
+
+        // one pointer of layerSize bytes per array layer, the image ends up shader read only
+        VulkanUploadTicket uploadImage(const VulkanAllocatedImage& image, Span<void* const> layers, VkDeviceSize layerSize, bool mipmap);
+
+        // submits the open batch if it recorded anything
+        void flush();
+
+        bool isComplete(VulkanUploadTicket ticket) const;
+
+        // blocks until the ticket completes, submitting its batch first if needed
+        void wait(VulkanUploadTicket ticket);
+
+        // submits and waits for everything, then acquires it on the graphics queue right away
+        // for when a buffer the uploads wrote is about to be copied or replaced outside a frame
+        void finish();
+
+        // the graphics queue half of the ownership transfers submitted batches released, record before any reads
+        void recordAcquires(VkCommandBuffer cmdBuffer);
+
+        // a graphics submission that waits on this sees every submitted upload
+        VkSemaphoreSubmitInfo getWaitInfo() const;
+
+        bool isDedicatedQueue() const { return m_queueFamilyIndex != m_graphicsQueueFamilyIndex; }
+
+        const Stats& getStats() const { return m_stats; }
+
+    private:
+        static constexpr uint32_t NO_BATCH = ~0u;
+
+        struct Batch {
+            VkCommandBuffer cmdBuffer{VK_NULL_HANDLE};
+            uint64_t value{0};
+            uint32_t copies{0};
+            // ring bytes the batch holds on to until it completes, alignment and wrap padding included
+            VkDeviceSize stagingBytes{0};
+            Vector<VulkanAllocatedBuffer> oversizedStaging;
+
+            Vector<VkBufferMemoryBarrier2> bufferReleases;
+            Vector<VkImageMemoryBarrier2> imageReleases;
+            // images whose mips the graphics queue generates after acquiring them
+            Vector<Pair<VkImage, VkExtent2D>> mipmapAfterAcquire;
+        };
+
+        struct Staging {
+            VkBuffer buffer;
+            VkDeviceSize offset;
+            uint8_t* data;
+        };
+
+        bool m_initialized{false};
+        VulkanEngine* m_engine{nullptr};
+
+        VkQueue m_queue{VK_NULL_HANDLE};
+        uint32_t m_queueFamilyIndex{0};
+        uint32_t m_graphicsQueueFamilyIndex{0};
+
+        VkCommandPool m_commandPool{VK_NULL_HANDLE};
+        VkSemaphore m_timeline{VK_NULL_HANDLE};
+        uint64_t m_submittedValue{0};
+
+        Array<Batch, BATCH_COUNT> m_batches;
+        uint32_t m_openBatch{NO_BATCH};
+        // submitted batches, oldest first
+        Deque<uint32_t> m_inFlight;
+
+        VulkanAllocatedBuffer m_ring;
+        VkDeviceSize m_ringHead{0};
+        VkDeviceSize m_ringUsed{0};
+
+        Vector<VkBufferMemoryBarrier2> m_pendingBufferAcquires;
+        Vector<VkImageMemoryBarrier2> m_pendingImageAcquires;
+        Vector<Pair<VkImage, VkExtent2D>> m_pendingMipmaps;
+
+        Stats m_stats;
+
+        Batch& openBatch();
+
+        Staging stage(VkDeviceSize size);
+
+        uint64_t getCompletedValue() const;
+
+        void waitFor(uint64_t value);
+
+        // returns ring space and staging buffers of every completed batch
+        void reclaim();
+    };
+}// namespace moe
\ No newline at end of file
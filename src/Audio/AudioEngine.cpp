@@ -2,6 +2,8 @@
 #include "Audio/AudioBuffer.hpp"
 #include "Audio/AudioSource.hpp"
 
+#include "Core/Profiler.hpp"
+
 MOE_BEGIN_NAMESPACE
 
 static const char* OPENAL_SOFT_DEVICE_NAME = "OpenAL Soft";
@@ -25,13 +27,17 @@ void AudioEngine::mainAudioLoop() {
     auto lastTime = std::chrono::steady_clock::now();
     constexpr auto frameDuration = std::chrono::milliseconds(5);
     while (m_running.load()) {
-        // process audio commands
-        handleCommands();
-        m_bufferPool.handleDeletes();
+        {
+            MOE_PROFILE_SCOPE("AudioEngine::update");
+
+            // process audio commands
+            handleCommands();
+            m_bufferPool.handleDeletes();
 
-        // update audio sources
-        for (auto& source: m_sources) {
-            source->update();
+            // update audio sources
+            for (auto& source: m_sources) {
+                source->update();
+            }
         }
 
         auto currentTime = std::chrono::steady_clock::now();
@@ -52,6 +58,8 @@ void AudioEngine::initAndLaunchMainAudioLoop() {
     m_running.store(true);
     m_audioThread = std::thread([this]() {
         Logger::setThreadName("Audio");
+        MOE_PROFILE_THREAD("Audio");
+        Memory::setThreadTag(MemoryTag::Audio);
         s_audioThreadId = std::this_thread::get_id();
         Logger::info("Audio engine main loop started");
 
@@ -0,0 +1,106 @@
+#include "Core/FixedStepClock.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+MOE_BEGIN_NAMESPACE
+
+namespace {
+    float toMs(FixedStepClock::Clock::duration duration) {
+        return std::chrono::duration<float, std::milli>(duration).count();
+    }
+}// namespace
+
+FixedStepClock::FixedStepClock()
+    : FixedStepClock(Config{}) {
+}
+
+FixedStepClock::FixedStepClock(const Config& config, TimeSource timeSource)
+    : m_config(config),
+      m_time(Timing::withDefaults(std::move(timeSource))),
+      m_timingErrorStats(config.statsWindow),
+      m_jitterStats(config.statsWindow),
+      m_workStats(config.statsWindow) {
+    MOE_ASSERT(m_config.step > Clock::duration::zero(), "FixedStepClock step must be positive");
+    m_config.maxSubsteps = std::max<uint32_t>(m_config.maxSubsteps, 1);
+
+    // a tick that takes longer than its step always misses
+    m_workStats.setTargetMs(toMs(m_config.step));
+}
+
+void FixedStepClock::start() {
+    start(m_time.now());
+}
+
+void FixedStepClock::start(Clock::time_point now) {
+    m_nextDeadline = now;
+    m_intervalStart = now;
+    m_lastWake.reset();
+    m_started = true;
+}
+
+uint32_t FixedStepClock::waitForNextTick() {
+    if (!m_started) {
+        start();
+    }
+
+    auto spin = Clock::duration::zero();
+    auto lateness = m_time.sleepUntil(m_nextDeadline, m_config.spinWindow, &spin);
+    auto now = m_nextDeadline + lateness;
+
+    m_timingErrorStats.push(toMs(lateness));
+    if (m_lastWake.has_value()) {
+        auto interval = now - *m_lastWake;
+        m_jitterStats.push(std::abs(toMs(interval - m_config.step)));
+    }
+    m_lastWake = now;
+
+    // every full step of lateness is a tick that should already have run
+    auto dueTicks = static_cast<uint64_t>(lateness / m_config.step) + 1;
+    uint32_t ticks = static_cast<uint32_t>(std::min<uint64_t>(dueTicks, m_config.maxSubsteps));
+
+    if (dueTicks > m_config.maxSubsteps) {
+        m_droppedTicks += dueTicks - m_config.maxSubsteps;
+        m_nextDeadline = now + m_config.step;
+    } else {
+        m_nextDeadline += m_config.step * ticks;
+    }
+
+    m_ticks += ticks;
+    m_catchUpTicks += ticks - 1;
+    m_lastSpin = spin;
+    m_tickStart = now;
+    return ticks;
+}
+
+void FixedStepClock::endTick() {
+    auto work = m_time.now() - m_tickStart;
+    m_workStats.push(toMs(work));
+    m_intervalBusy += work + m_lastSpin;
+    m_intervalSpin += m_lastSpin;
+}
+
+FixedStepClock::Stats FixedStepClock::collectStats() {
+    Stats stats;
+    stats.timingError = m_timingErrorStats.summarize();
+    stats.jitter = m_jitterStats.summarize();
+    stats.work = m_workStats.summarize();
+    stats.ticks = m_ticks;
+    stats.catchUpTicks = m_catchUpTicks;
+    stats.droppedTicks = m_droppedTicks;
+
+    auto now = m_time.now();
+    float wallMs = toMs(now - m_intervalStart);
+    if (wallMs > 0.0f) {
+        stats.busyPercent = toMs(m_intervalBusy) / wallMs * 100.0f;
+        stats.spinPercent = toMs(m_intervalSpin) / wallMs * 100.0f;
+    }
+
+    m_intervalStart = now;
+    m_intervalBusy = Clock::duration::zero();
+    m_intervalSpin = Clock::duration::zero();
+    return stats;
+}
+
+MOE_END_NAMESPACE
\ No newline at end of file
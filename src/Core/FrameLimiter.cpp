@@ -0,0 +1,228 @@
+#include "Core/FrameLimiter.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#include <timeapi.h>
+#endif
+
+MOE_BEGIN_NAMESPACE
+
+namespace Timing {
+#ifdef _WIN32
+    HighResolutionTimerScope::HighResolutionTimerScope() {
+        timeBeginPeriod(1);
+    }
+
+    HighResolutionTimerScope::~HighResolutionTimerScope() {
+        timeEndPeriod(1);
+    }
+#else
+    HighResolutionTimerScope::HighResolutionTimerScope() = default;
+
+    HighResolutionTimerScope::~HighResolutionTimerScope() = default;
+#endif
+
+    Clock::duration sleepUntil(Clock::time_point deadline, Clock::duration spinWindow, Clock::duration* outSpinTime) {
+        auto now = Clock::now();
+        if (deadline - now > spinWindow) {
+            std::this_thread::sleep_until(deadline - spinWindow);
+        }
+
+        // spin out the remainder, yielding keeps a waiting core from starving other threads
+        auto spinStart = Clock::now();
+        now = spinStart;
+        while (now < deadline) {
+            std::this_thread::yield();
+            now = Clock::now();
+        }
+
+        if (outSpinTime) {
+            *outSpinTime = now - spinStart;
+        }
+        return now - deadline;
+    }
+
+    TimeSource withDefaults(TimeSource source) {
+        if (!source.now) {
+            source.now = [] { return Clock::now(); };
+        }
+        if (!source.sleepUntil) {
+            source.sleepUntil = Timing::sleepUntil;
+        }
+        return source;
+    }
+}// namespace Timing
+
+void FrameLimiter::setTargetRate(double hz) {
+    auto period = Timing::rateToPeriod(hz);
+    if (period == m_period) {
+        return;
+    }
+
+    m_targetRate = hz > 0.0 ? hz : 0.0;
+    m_period = period;
+    m_hasDeadline = false;
+}
+
+FrameLimiter::Clock::time_point FrameLimiter::advance(Clock::time_point now) {
+    if (!m_hasDeadline) {
+        m_nextDeadline = now;
+        m_hasDeadline = true;
+    }
+
+    auto due = m_nextDeadline;
+    m_nextDeadline += m_period;
+
+    // more than a full period behind, skip the missed slots rather than running them back to back
+    if (now - m_nextDeadline > m_period) {
+        m_nextDeadline = now + m_period;
+    }
+    return due;
+}
+
+void FrameLimiter::wait() {
+    if (!isLimited()) {
+        return;
+    }
+
+    auto due = advance(m_time.now());
+    m_time.sleepUntil(due, m_spinWindow, nullptr);
+}
+
+bool FrameLimiter::poll(Clock::time_point now) {
+    if (!isLimited()) {
+        return true;
+    }
+
+    if (m_hasDeadline && now < m_nextDeadline) {
+        return false;
+    }
+
+    advance(now);
+    return true;
+}
+
+FrameTimeStats::FrameTimeStats(size_t windowSize)
+    : m_samples(std::max<size_t>(windowSize, 1), 0.0f),
+      m_missed(std::max<size_t>(windowSize, 1), false) {}
+
+void FrameTimeStats::push(float frameTimeMs) {
+    bool missed = isMiss(frameTimeMs);
+
+    if (m_count == m_samples.size()) {
+        // overwrite the oldest sample
+        if (m_missed[m_head]) {
+            --m_missedInWindow;
+        }
+    } else {
+        ++m_count;
+    }
+
+    m_samples[m_head] = frameTimeMs;
+    m_missed[m_head] = missed;
+    m_head = (m_head + 1) % m_samples.size();
+
+    ++m_totalFrames;
+    if (missed) {
+        ++m_missedInWindow;
+        ++m_totalMissedFrames;
+    }
+}
+
+void FrameTimeStats::reset() {
+    m_head = 0;
+    m_count = 0;
+    m_missedInWindow = 0;
+    m_totalFrames = 0;
+    m_totalMissedFrames = 0;
+}
+
+float FrameTimeStats::getSample(size_t index) const {
+    MOE_ASSERT(index < m_count, "FrameTimeStats sample index out of range");
+    size_t oldest = (m_head + m_samples.size() - m_count) % m_samples.size();
+    return m_samples[(oldest + index) % m_samples.size()];
+}
+
+FrameTimeStats::Summary FrameTimeStats::summarize() const {
+    Summary summary;
+    summary.samples = m_count;
+    summary.targetMs = m_targetMs;
+    summary.missedFrames = m_missedInWindow;
+    summary.totalFrames = m_totalFrames;
+    summary.totalMissedFrames = m_totalMissedFrames;
+
+    if (m_count == 0) {
+        return summary;
+    }
+
+    Vector<float> sorted;
+    sorted.reserve(m_count);
+    for (size_t i = 0; i < m_count; ++i) {
+        sorted.push_back(getSample(i));
+    }
+    std::sort(sorted.begin(), sorted.end());
+
+    // nearest rank, so p99 of a small window is an actual sample rather than an interpolation
+    auto percentile = [&](float p) {
+        auto rank = static_cast<size_t>(std::ceil(p * static_cast<float>(sorted.size())));
+        return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+    };
+
+    double sum = 0.0;
+    for (auto value: sorted) {
+        sum += value;
+    }
+
+    summary.meanMs = static_cast<float>(sum / static_cast<double>(sorted.size()));
+    summary.p50Ms = percentile(0.50f);
+    summary.p95Ms = percentile(0.95f);
+    summary.p99Ms = percentile(0.99f);
+    summary.maxMs = sorted.back();
+    return summary;
+}
+
+void FrameTimeStats::buildHistogram(Span<float> buckets, float maxMs) const {
+    std::fill(buckets.begin(), buckets.end(), 0.0f);
+    if (buckets.empty() || maxMs <= 0.0f) {
+        return;
+    }
+
+    float bucketWidth = maxMs / static_cast<float>(buckets.size());
+    for (size_t i = 0; i < m_count; ++i) {
+        auto bucket = static_cast<size_t>(getSample(i) / bucketWidth);
+        buckets[std::min(bucket, buckets.size() - 1)] += 1.0f;
+    }
+}
+
+String FrameTimeStats::toJson(StringView name) const {
+    auto summary = summarize();
+
+    String json = fmt::format(
+            "{{\"name\":\"{}\",\"samples\":{},\"target_ms\":{:.4f},\"mean_ms\":{:.4f},"
+            "\"p50_ms\":{:.4f},\"p95_ms\":{:.4f},\"p99_ms\":{:.4f},\"max_ms\":{:.4f},"
+            "\"missed_frames\":{},\"total_frames\":{},\"total_missed_frames\":{},\"frame_times_ms\":[",
+            name, summary.samples, summary.targetMs, summary.meanMs,
+            summary.p50Ms, summary.p95Ms, summary.p99Ms, summary.maxMs,
+            summary.missedFrames, summary.totalFrames, summary.totalMissedFrames);
+
+    for (size_t i = 0; i < m_count; ++i) {
+        if (i > 0) {
+            json += ',';
+        }
+        json += fmt::format("{:.4f}", getSample(i));
+    }
+    json += "]}";
+    return json;
+}
+
+MOE_END_NAMESPACE
\ No newline at end of file
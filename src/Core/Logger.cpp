@@ -11,7 +11,9 @@ namespace moe {
 
     void Logger::initialize() {
         constexpr std::size_t queue_size = 8192;
-        spdlog::init_thread_pool(queue_size, 1);
+        spdlog::init_thread_pool(queue_size, 1, []() {
+            Memory::setThreadTag(MemoryTag::Logging);
+        });
 
         auto console_sink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
         console_sink->set_pattern("[%T] [%^%l%$] %v");
@@ -0,0 +1,333 @@
+#include "Core/Memory.hpp"
+
+#include "Core/Common.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+
+#ifdef MOE_USE_MIMALLOC
+#include <mimalloc.h>
+#endif
+
+namespace moe {
+    namespace {
+        // 16 bytes in front of every block, keeps the default alignment of the block behind it
+        struct BlockHeader {
+            uint64_t size;
+            // distance from the start of the raw allocation to the user pointer
+            uint32_t offset;
+            MemoryTag tag;
+            // log2 of the alignment the block was allocated with, frees and reallocations must match the allocation
+            uint8_t alignmentShift;
+            uint8_t padding[2];
+        };
+
+        constexpr size_t HEADER_SIZE = sizeof(BlockHeader);
+        constexpr size_t DEFAULT_ALIGNMENT = alignof(std::max_align_t);
+
+        static_assert(HEADER_SIZE == 16, "BlockHeader must stay 16 bytes");
+        static_assert(HEADER_SIZE % DEFAULT_ALIGNMENT == 0, "BlockHeader must preserve the default alignment");
+
+        // current and peak bytes must be exact across threads, one shared atomic per tag, each on its own cache line
+        struct alignas(64) TagCounters {
+            std::atomic<int64_t> currentBytes{0};
+            std::atomic<int64_t> peakBytes{0};
+        };
+
+        // the monotonic counters are per thread, the owning thread is the only writer so a bump is a plain load and store,
+        // readers sum all slots; threads beyond the slot count share the last slot and fall back to atomic adds
+        struct alignas(64) ThreadCounters {
+            std::atomic<uint64_t> allocations[Memory::TAG_COUNT]{};
+            std::atomic<uint64_t> deallocations[Memory::TAG_COUNT]{};
+            std::atomic<uint64_t> allocatedBytes[Memory::TAG_COUNT]{};
+        };
+
+        constexpr size_t MAX_THREAD_SLOTS = 128;
+
+        // constant initialized, usable by operator new before any dynamic initialization has run
+        TagCounters g_counters[Memory::TAG_COUNT];
+        ThreadCounters g_threadCounters[MAX_THREAD_SLOTS];
+        std::atomic<size_t> g_nextThreadSlot{0};
+        std::atomic_bool g_globalTrackingEnabled{false};
+
+        thread_local ThreadCounters* t_threadCounters{nullptr};
+        thread_local bool t_sharedThreadCounters{false};
+
+        ThreadCounters& getThreadCounters() {
+            if (!t_threadCounters) {
+                size_t slot = g_nextThreadSlot.fetch_add(1, std::memory_order_relaxed);
+                t_sharedThreadCounters = slot >= MAX_THREAD_SLOTS - 1;
+                t_threadCounters = &g_threadCounters[std::min(slot, MAX_THREAD_SLOTS - 1)];
+            }
+            return *t_threadCounters;
+        }
+
+        void bump(std::atomic<uint64_t>& counter, uint64_t value) {
+            if (t_sharedThreadCounters) {
+                counter.fetch_add(value, std::memory_order_relaxed);
+            } else {
+                counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+            }
+        }
+
+        using ThreadCounterArray = std::atomic<uint64_t>[Memory::TAG_COUNT];
+
+        uint64_t sumThreadCounters(ThreadCounterArray ThreadCounters::*counters, size_t tag) {
+            size_t slots = std::min(g_nextThreadSlot.load(std::memory_order_relaxed), MAX_THREAD_SLOTS);
+            uint64_t sum = 0;
+            for (size_t i = 0; i < slots; ++i) {
+                sum += (g_threadCounters[i].*counters)[tag].load(std::memory_order_relaxed);
+            }
+            return sum;
+        }
+
+        struct RateSampler {
+            std::mutex mutex;
+            bool hasSample{false};
+            std::chrono::steady_clock::time_point lastTime;
+            uint64_t lastTotalBytes[Memory::TAG_COUNT]{};
+            uint64_t lastTotalAllocations[Memory::TAG_COUNT]{};
+            double bytesPerSecond[Memory::TAG_COUNT]{};
+            double allocationsPerSecond[Memory::TAG_COUNT]{};
+        };
+
+        RateSampler& getRateSampler() {
+            static RateSampler sampler;
+            return sampler;
+        }
+
+        // the one test for which allocator a block goes through, allocation and free must agree on it
+        bool isOverAligned(size_t alignment) {
+            return alignment > DEFAULT_ALIGNMENT;
+        }
+
+        size_t getAlignment(const BlockHeader& header) {
+            return size_t(1) << header.alignmentShift;
+        }
+
+        uint8_t toShift(size_t alignment) {
+            uint8_t shift = 0;
+            while ((size_t(1) << shift) < alignment) {
+                ++shift;
+            }
+            return shift;
+        }
+
+        void* rawAllocate(size_t size, size_t alignment) {
+#ifdef MOE_USE_MIMALLOC
+            return isOverAligned(alignment) ? mi_malloc_aligned(size, alignment) : mi_malloc(size);
+#elif defined(_WIN32)
+            return isOverAligned(alignment) ? _aligned_malloc(size, alignment) : std::malloc(size);
+#else
+            if (isOverAligned(alignment)) {
+                // aligned_alloc wants the size to be a multiple of the alignment
+                return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+            }
+            return std::malloc(size);
+#endif
+        }
+
+        void rawFree(void* ptr, bool aligned) {
+#ifdef MOE_USE_MIMALLOC
+            (void) aligned;
+            mi_free(ptr);
+#elif defined(_WIN32)
+            aligned ? _aligned_free(ptr) : std::free(ptr);
+#else
+            (void) aligned;
+            std::free(ptr);
+#endif
+        }
+
+        BlockHeader* getHeader(void* ptr) {
+            return reinterpret_cast<BlockHeader*>(static_cast<uint8_t*>(ptr) - HEADER_SIZE);
+        }
+
+        void recordAllocation(MemoryTag tag, size_t size) {
+            auto index = static_cast<size_t>(tag);
+            auto& threadCounters = getThreadCounters();
+            bump(threadCounters.allocations[index], 1);
+            bump(threadCounters.allocatedBytes[index], size);
+
+            auto& counters = g_counters[index];
+            auto current = counters.currentBytes.fetch_add(static_cast<int64_t>(size), std::memory_order_relaxed) + static_cast<int64_t>(size);
+
+            // the peak only moves while a tag grows, the plain load keeps the common case free of a cas
+            auto peak = counters.peakBytes.load(std::memory_order_relaxed);
+            while (current > peak && !counters.peakBytes.compare_exchange_weak(peak, current, std::memory_order_relaxed)) {
+            }
+        }
+
+        void recordDeallocation(MemoryTag tag, size_t size) {
+            auto index = static_cast<size_t>(tag);
+            bump(getThreadCounters().deallocations[index], 1);
+            g_counters[index].currentBytes.fetch_sub(static_cast<int64_t>(size), std::memory_order_relaxed);
+        }
+
+        String formatBytes(double bytes) {
+            if (bytes >= 1024.0 * 1024.0) {
+                return fmt::format("{:.2f} MiB", bytes / (1024.0 * 1024.0));
+            }
+            if (bytes >= 1024.0) {
+                return fmt::format("{:.2f} KiB", bytes / 1024.0);
+            }
+            return fmt::format("{:.0f} B", bytes);
+        }
+    }// namespace
+
+    namespace Memory {
+        const char* getTagName(MemoryTag tag) {
+            switch (tag) {
+                case MemoryTag::General:
+                    return "General";
+                case MemoryTag::Render:
+                    return "Render";
+                case MemoryTag::Physics:
+                    return "Physics";
+                case MemoryTag::Audio:
+                    return "Audio";
+                case MemoryTag::Network:
+                    return "Network";
+                case MemoryTag::Font:
+                    return "Font";
+                case MemoryTag::Logging:
+                    return "Logging";
+                case MemoryTag::Game:
+                    return "Game";
+                default:
+                    return "Unknown";
+            }
+        }
+
+        void* allocate(size_t size, size_t alignment, MemoryTag tag) {
+            MOE_ASSERT((alignment & (alignment - 1)) == 0, "Alignment must be a power of two");
+            alignment = std::max(alignment, DEFAULT_ALIGNMENT);
+            // over-aligned blocks pad the header up to the alignment so the user pointer stays aligned
+            size_t offset = std::max(alignment, HEADER_SIZE);
+
+            auto* raw = static_cast<uint8_t*>(rawAllocate(size + offset, alignment));
+            if (!raw) {
+                return nullptr;
+            }
+
+            auto* ptr = raw + offset;
+            auto* header = getHeader(ptr);
+            header->size = size;
+            header->offset = static_cast<uint32_t>(offset);
+            header->tag = tag;
+            header->alignmentShift = toShift(alignment);
+
+            recordAllocation(tag, size);
+            return ptr;
+        }
+
+        void deallocate(void* ptr) {
+            if (!ptr) {
+                return;
+            }
+
+            auto* header = getHeader(ptr);
+            recordDeallocation(header->tag, header->size);
+
+            rawFree(static_cast<uint8_t*>(ptr) - header->offset, isOverAligned(getAlignment(*header)));
+        }
+
+        void* reallocate(void* ptr, size_t newSize) {
+            if (!ptr) {
+                return allocate(newSize, DEFAULT_ALIGNMENT, getThreadTag());
+            }
+
+            auto* header = getHeader(ptr);
+            auto* newPtr = allocate(newSize, getAlignment(*header), header->tag);
+            if (!newPtr) {
+                return nullptr;
+            }
+
+            std::memcpy(newPtr, ptr, std::min<size_t>(header->size, newSize));
+            deallocate(ptr);
+            return newPtr;
+        }
+
+        bool isGlobalTrackingEnabled() {
+            return g_globalTrackingEnabled.load(std::memory_order_relaxed);
+        }
+
+        void setGlobalTrackingEnabled(bool enabled) {
+            g_globalTrackingEnabled.store(enabled, std::memory_order_relaxed);
+        }
+
+        std::array<TagStats, TAG_COUNT> getStats() {
+            std::array<TagStats, TAG_COUNT> stats;
+
+            auto& sampler = getRateSampler();
+            std::lock_guard lock(sampler.mutex);
+
+            for (size_t i = 0; i < TAG_COUNT; ++i) {
+                auto& counters = g_counters[i];
+                auto& tagStats = stats[i];
+                tagStats.tag = static_cast<MemoryTag>(i);
+                tagStats.currentBytes = counters.currentBytes.load(std::memory_order_relaxed);
+                tagStats.peakBytes = counters.peakBytes.load(std::memory_order_relaxed);
+                tagStats.totalAllocations = sumThreadCounters(&ThreadCounters::allocations, i);
+                tagStats.totalBytes = sumThreadCounters(&ThreadCounters::allocatedBytes, i);
+                // summed without a snapshot, frees racing with the read can briefly show more frees than allocations
+                tagStats.liveAllocations = static_cast<int64_t>(tagStats.totalAllocations - sumThreadCounters(&ThreadCounters::deallocations, i));
+                tagStats.bytesPerSecond = sampler.bytesPerSecond[i];
+                tagStats.allocationsPerSecond = sampler.allocationsPerSecond[i];
+            }
+            return stats;
+        }
+
+        void sampleRates() {
+            auto& sampler = getRateSampler();
+            std::lock_guard lock(sampler.mutex);
+
+            auto now = std::chrono::steady_clock::now();
+            double elapsedSecs = std::chrono::duration<double>(now - sampler.lastTime).count();
+
+            for (size_t i = 0; i < TAG_COUNT; ++i) {
+                auto totalBytes = sumThreadCounters(&ThreadCounters::allocatedBytes, i);
+                auto totalAllocations = sumThreadCounters(&ThreadCounters::allocations, i);
+
+                if (sampler.hasSample && elapsedSecs > 0.0) {
+                    sampler.bytesPerSecond[i] = static_cast<double>(totalBytes - sampler.lastTotalBytes[i]) / elapsedSecs;
+                    sampler.allocationsPerSecond[i] = static_cast<double>(totalAllocations - sampler.lastTotalAllocations[i]) / elapsedSecs;
+                }
+
+                sampler.lastTotalBytes[i] = totalBytes;
+                sampler.lastTotalAllocations[i] = totalAllocations;
+            }
+
+            sampler.lastTime = now;
+            sampler.hasSample = true;
+        }
+
+        void logStats() {
+            auto stats = getStats();
+
+            String table = fmt::format("{:<10} {:>12} {:>12} {:>10} {:>14} {:>12}",
+                                       "tag", "current", "peak", "live", "rate", "allocs/s");
+            for (auto& tagStats: stats) {
+                if (tagStats.totalAllocations == 0) {
+                    continue;
+                }
+
+                table += fmt::format("\n{:<10} {:>12} {:>12} {:>10} {:>12}/s {:>12.0f}",
+                                     getTagName(tagStats.tag),
+                                     formatBytes(static_cast<double>(tagStats.currentBytes)),
+                                     formatBytes(static_cast<double>(tagStats.peakBytes)),
+                                     tagStats.liveAllocations,
+                                     formatBytes(tagStats.bytesPerSecond),
+                                     tagStats.allocationsPerSecond);
+            }
+
+            Logger::info("Memory usage by tag{}:\n{}",
+                         isGlobalTrackingEnabled() ? "" : " (global tracking disabled, explicit allocations only)",
+                         table);
+        }
+    }// namespace Memory
+}// namespace moe
\ No newline at end of file
@@ -0,0 +1,162 @@
+#include "Core/Profiler.hpp"
+#include "Core/FileWriter.hpp"
+
+#include <algorithm>
+
+MOE_BEGIN_NAMESPACE
+
+namespace {
+    thread_local Profiling::ThreadBuffer* t_threadBuffer{nullptr};
+
+    void appendJsonEscaped(String& out, const char* str) {
+        for (const char* c = str; *c != '\0'; ++c) {
+            switch (*c) {
+                case '"':
+                    out += "\\\"";
+                    break;
+                case '\\':
+                    out += "\\\\";
+                    break;
+                default:
+                    if (static_cast<unsigned char>(*c) >= 0x20) {
+                        out += *c;
+                    }
+                    break;
+            }
+        }
+    }
+}// namespace
+
+void Profiler::registerThread(StringView name) {
+    if (t_threadBuffer) {
+        std::lock_guard<std::mutex> lk(m_threadsMutex);
+        t_threadBuffer->threadName = String(name);
+        return;
+    }
+
+    t_threadBuffer = &createThreadBuffer(name);
+}
+
+Profiling::ThreadBuffer& Profiler::getThreadBuffer() {
+    if (!t_threadBuffer) {
+        String name;
+        {
+            std::lock_guard<std::mutex> lk(m_threadsMutex);
+            name = fmt::format("Thread#{}", m_threads.size());
+        }
+        t_threadBuffer = &createThreadBuffer(name);
+    }
+    return *t_threadBuffer;
+}
+
+Profiling::ThreadBuffer& Profiler::createThreadBuffer(StringView name) {
+    std::lock_guard<std::mutex> lk(m_threadsMutex);
+    auto index = static_cast<uint32_t>(m_threads.size());
+    m_threads.push_back(std::make_unique<Profiling::ThreadBuffer>(index, name));
+    return *m_threads.back();
+}
+
+void Profiler::endFrame() {
+    auto now = Profiling::now();
+
+    Profiling::FrameRecord record;
+    if (!m_recycledRecords.empty()) {
+        record = std::move(m_recycledRecords.back());
+        m_recycledRecords.pop_back();
+        record.events.clear();
+    }
+
+    record.frameIndex = m_frameIndex++;
+    record.startNs = m_frameStartNs;
+    record.endNs = now;
+    m_frameStartNs = now;
+
+    {
+        // buffers are never removed, the lock only guards against concurrent registration
+        std::lock_guard<std::mutex> lk(m_threadsMutex);
+        for (auto& buffer: m_threads) {
+            buffer->drain([this, &record](const Profiling::ZoneEvent& event) {
+                record.events.push_back(event);
+                if (m_capturing) {
+                    m_captureEvents.push_back(event);
+                }
+            });
+        }
+    }
+
+    if (m_paused) {
+        m_recycledRecords.push_back(std::move(record));
+        return;
+    }
+
+    m_history.push_back(std::move(record));
+    if (m_history.size() > HISTORY_FRAMES) {
+        m_recycledRecords.push_back(std::move(m_history.front()));
+        m_history.pop_front();
+    }
+}
+
+Vector<Profiling::ThreadInfo> Profiler::getThreadInfos() const {
+    std::lock_guard<std::mutex> lk(m_threadsMutex);
+    Vector<Profiling::ThreadInfo> infos;
+    infos.reserve(m_threads.size());
+    for (auto& buffer: m_threads) {
+        infos.push_back({buffer->threadIndex, buffer->threadName, buffer->droppedCount()});
+    }
+    return infos;
+}
+
+void Profiler::beginCapture() {
+    Logger::info("Profiler: capture started");
+    m_captureEvents.clear();
+    m_capturing = true;
+}
+
+bool Profiler::endCapture(StringView filePath) {
+    if (!m_capturing) {
+        Logger::warn("Profiler::endCapture: no capture in progress");
+        return false;
+    }
+    m_capturing = false;
+
+    std::sort(
+            m_captureEvents.begin(), m_captureEvents.end(),
+            [](const Profiling::ZoneEvent& a, const Profiling::ZoneEvent& b) {
+                return a.startNs < b.startNs;
+            });
+
+    Profiling::TimestampNs origin = m_captureEvents.empty() ? 0 : m_captureEvents.front().startNs;
+
+    String json;
+    json.reserve(m_captureEvents.size() * 96 + 256);
+    json += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    bool first = true;
+    for (auto& info: getThreadInfos()) {
+        json += first ? "\n" : ",\n";
+        first = false;
+        json += fmt::format(R"({{"name":"thread_name","ph":"M","pid":1,"tid":{},"args":{{"name":")", info.threadIndex);
+        appendJsonEscaped(json, info.threadName.c_str());
+        json += "\"}}";
+    }
+
+    for (auto& event: m_captureEvents) {
+        json += first ? "\n" : ",\n";
+        first = false;
+        json += "{\"name\":\"";
+        appendJsonEscaped(json, event.name);
+        json += fmt::format(
+                R"(","cat":"cpu","ph":"X","pid":1,"tid":{},"ts":{:.3f},"dur":{:.3f}}})",
+                event.threadIndex,
+                static_cast<double>(event.startNs - origin) / 1000.0,
+                static_cast<double>(event.endNs - event.startNs) / 1000.0);
+    }
+    json += "\n]}\n";
+
+    Logger::info("Profiler: writing {} captured events to {}", m_captureEvents.size(), filePath);
+    m_captureEvents.clear();
+
+    return FileWriter::writeToFile(filePath, StringView(json));
+}
+
+MOE_END_NAMESPACE
\ No newline at end of file
@@ -0,0 +1,61 @@
+#include "Core/Task/ParallelFor.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+
+MOE_BEGIN_NAMESPACE
+
+void parallelFor(
+        ThreadPoolScheduler& scheduler,
+        uint32_t maxSlots,
+        uint32_t chunks,
+        const Function<void(uint32_t, uint32_t)>& fn) {
+    MOE_ASSERT(maxSlots > 0, "At least the calling thread's slot is needed");
+
+    size_t helpers = std::min<size_t>({scheduler.workerCount(), maxSlots - 1, chunks > 0 ? chunks - 1 : 0});
+    if (helpers == 0) {
+        for (uint32_t chunk = 0; chunk < chunks; ++chunk) {
+            fn(0, chunk);
+        }
+        return;
+    }
+
+    struct State {
+        std::atomic_uint32_t nextSlot{1};
+        std::atomic_uint32_t nextChunk{0};
+        std::atomic_uint32_t doneChunks{0};
+        std::mutex mutex;
+        std::condition_variable cv;
+    };
+    auto state = std::make_shared<State>();
+
+    // helpers that start after all chunks are taken return without touching fn
+    auto run = [state, &fn, chunks](uint32_t slot) {
+        uint32_t chunk;
+        while ((chunk = state->nextChunk.fetch_add(1)) < chunks) {
+            fn(slot, chunk);
+            if (state->doneChunks.fetch_add(1) + 1 == chunks) {
+                std::lock_guard<std::mutex> lk(state->mutex);
+                state->cv.notify_all();
+            }
+        }
+    };
+
+    for (size_t i = 0; i < helpers; ++i) {
+        // a slot is taken when the helper starts, only helpers that actually run hold one
+        scheduler.schedule(
+                [state, run]() {
+                    run(state->nextSlot.fetch_add(1));
+                },
+                TaskPriority::High);
+    }
+    run(0);
+
+    std::unique_lock<std::mutex> lk(state->mutex);
+    state->cv.wait(lk, [&]() { return state->doneChunks.load() == chunks; });
+}
+
+MOE_END_NAMESPACE
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "Core/Task/Scheduler.hpp"
+#include "Core/Profiler.hpp"
 
 MOE_BEGIN_NAMESPACE
 
@@ -25,12 +26,16 @@ void ThreadPoolScheduler::shutdown() {
     });
 }
 
-void ThreadPoolScheduler::schedule(Function<void()> task) {
+void ThreadPoolScheduler::schedule(Function<void()> task, TaskPriority priority) {
     MOE_ASSERT(m_running, "Scheduler not running");
     {
         std::lock_guard<std::mutex> lk(m_mutex);
         if (!m_running) return;
-        m_tasks.emplace(std::move(task));
+        if (priority == TaskPriority::High) {
+            m_highPriorityTasks.emplace(std::move(task));
+        } else {
+            m_tasks.emplace(std::move(task));
+        }
     }
     m_cv.notify_one();
 }
@@ -46,6 +51,7 @@ void ThreadPoolScheduler::start(size_t threadCount) {
     for (size_t i = 0; i < threadCount; ++i) {
         m_workers.emplace_back([this, i]() {
             Logger::setThreadName(fmt::format("Worker#{}", i));
+            MOE_PROFILE_THREAD(fmt::format("Worker#{}", i));
             Logger::info("Scheduler thread Worker#{} started", i);
             workerMain();
         });
@@ -65,9 +71,11 @@ void ThreadPoolScheduler::stop() {
     m_workers.clear();
 
     Queue<Function<void()>> empty;
+    Queue<Function<void()>> emptyHighPriority;
     {
         std::lock_guard<std::mutex> lk(m_mutex);
         std::swap(m_tasks, empty);
+        std::swap(m_highPriorityTasks, emptyHighPriority);
     }
 }
 
@@ -76,13 +84,18 @@ void ThreadPoolScheduler::workerMain() {
         Function<void()> task;
         {
             std::unique_lock<std::mutex> lk(m_mutex);
-            m_cv.wait(lk, [this]() { return !m_running || !m_tasks.empty(); });
-            if (!m_running && m_tasks.empty()) return;
-            task = std::move(m_tasks.front());
-            m_tasks.pop();
+            m_cv.wait(lk, [this]() { return !m_running || !m_highPriorityTasks.empty() || !m_tasks.empty(); });
+            if (!m_running && m_highPriorityTasks.empty() && m_tasks.empty()) return;
+
+            auto& queue = m_highPriorityTasks.empty() ? m_tasks : m_highPriorityTasks;
+            task = std::move(queue.front());
+            queue.pop();
         }
 
-        task();
+        {
+            MOE_PROFILE_SCOPE("Worker task");
+            task();
+        }
     }
 }
 
@@ -0,0 +1,108 @@
+#include "Core/Memory.hpp"
+
+#include <new>
+
+// routes every global new/delete of the executable through the memory tracker, charged to the thread's current tag
+
+namespace {
+    void* trackedNew(size_t size, size_t alignment) {
+        // operator new must return a unique pointer even for empty requests
+        auto* ptr = moe::Memory::allocate(size == 0 ? 1 : size, alignment, moe::Memory::getThreadTag());
+        if (!ptr) {
+            throw std::bad_alloc();
+        }
+        return ptr;
+    }
+
+    void* trackedNewNoThrow(size_t size, size_t alignment) noexcept {
+        return moe::Memory::allocate(size == 0 ? 1 : size, alignment, moe::Memory::getThreadTag());
+    }
+
+    struct GlobalTrackingRegistrar {
+        GlobalTrackingRegistrar() {
+            moe::Memory::setGlobalTrackingEnabled(true);
+        }
+    };
+
+    GlobalTrackingRegistrar g_globalTrackingRegistrar;
+}// namespace
+
+void* operator new(size_t size) {
+    return trackedNew(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void* operator new[](size_t size) {
+    return trackedNew(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    return trackedNewNoThrow(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    return trackedNewNoThrow(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void* operator new(size_t size, std::align_val_t alignment) {
+    return trackedNew(size, static_cast<size_t>(alignment));
+}
+
+void* operator new[](size_t size, std::align_val_t alignment) {
+    return trackedNew(size, static_cast<size_t>(alignment));
+}
+
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return trackedNewNoThrow(size, static_cast<size_t>(alignment));
+}
+
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return trackedNewNoThrow(size, static_cast<size_t>(alignment));
+}
+
+void operator delete(void* ptr) noexcept {
+    moe::Memory::deallocate(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    moe::Memory::deallocate(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    moe::Memory::deallocate(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept {
+    moe::Memory::deallocate(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+    moe::Memory::deallocate(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+    moe::Memory::deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept {
+    moe::Memory::deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t) noexcept {
+    moe::Memory::deallocate(ptr);
+}
+
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept {
+    moe::Memory::deallocate(ptr);
+}
+
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept {
+    moe::Memory::deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept {
+    moe::Memory::deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept {
+    moe::Memory::deallocate(ptr);
+}
\ No newline at end of file
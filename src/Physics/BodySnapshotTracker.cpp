@@ -0,0 +1,113 @@
+#include "Physics/BodySnapshotTracker.hpp"
+
+#include "Core/Profiler.hpp"
+
+#include <algorithm>
+
+MOE_BEGIN_PHYSICS_NAMESPACE
+
+size_t BodySnapshotTracker::sync(JPH::PhysicsSystem& system, uint64_t tick, SnapshotView::Channel::Clock::time_point time) {
+    MOE_PROFILE_FUNCTION();
+
+    // runs on the physics thread between updates, nothing else touches the bodies
+    const auto& lockInterface = system.GetBodyLockInterfaceNoLock();
+
+    if (m_channel.size() != system.GetMaxBodies()) {
+        m_channel.resize(system.GetMaxBodies());
+        m_seenFlags.resize(system.GetMaxBodies());
+        m_fullRescanRequested.store(true, std::memory_order_relaxed);
+    }
+
+    size_t written = 0;
+
+    auto bodyCount = system.GetNumBodies();
+    if (m_fullRescanRequested.exchange(false, std::memory_order_relaxed) || bodyCount != m_lastBodyCount) {
+        m_lastBodyCount = bodyCount;
+        written = rescanAll(system, lockInterface);
+    } else {
+        m_bodyIdCache.clear();
+#if JPH_VERSION_MAJOR >= 5
+        system.GetActiveBodies(JPH::EBodyType::RigidBody, m_bodyIdCache);
+#else
+        system.GetActiveBodies(m_bodyIdCache);
+#endif
+        for (auto id: m_bodyIdCache) {
+            written += syncBody(lockInterface, id);
+        }
+    }
+
+    {
+        std::lock_guard lock(m_pendingMutex);
+        std::swap(m_pendingScratch, m_pendingBodies);
+    }
+    for (auto id: m_pendingScratch) {
+        written += syncBody(lockInterface, id);
+    }
+    m_pendingScratch.clear();
+
+    m_channel.publish(tick, time);
+    return written;
+}
+
+void BodySnapshotTracker::markMoved(JPH::BodyID id) {
+    std::lock_guard lock(m_pendingMutex);
+    m_pendingBodies.push_back(id);
+}
+
+size_t BodySnapshotTracker::rescanAll(JPH::PhysicsSystem& system, const JPH::BodyLockInterface& lockInterface) {
+    MOE_PROFILE_FUNCTION();
+
+    m_bodyIdCache.clear();
+    system.GetBodies(m_bodyIdCache);
+
+    size_t written = 0;
+    std::fill(m_seenFlags.begin(), m_seenFlags.end(), 0);
+    for (auto id: m_bodyIdCache) {
+        m_seenFlags[id.GetIndex()] = 1;
+        written += syncBody(lockInterface, id);
+    }
+
+    // slots whose body is gone
+    for (size_t i = 0; i < m_channel.size(); ++i) {
+        if (!m_seenFlags[i] && !m_channel.peek(i).bodyID.IsInvalid()) {
+            m_channel.write(i, ObjectSnapshot{});
+            ++written;
+        }
+    }
+    return written;
+}
+
+bool BodySnapshotTracker::syncBody(const JPH::BodyLockInterface& lockInterface, JPH::BodyID id) {
+    auto index = id.GetIndex();
+    if (index >= m_channel.size()) {
+        return false;
+    }
+
+    JPH::BodyLockRead lock(lockInterface, id);
+    if (!lock.Succeeded() || !lock.GetBody().IsInBroadPhase()) {
+        // removed or destroyed since it was queued, only clear the slot if it still belongs to this body
+        if (m_channel.peek(index).bodyID != id) {
+            return false;
+        }
+        m_channel.write(index, ObjectSnapshot{});
+        return true;
+    }
+
+    const auto& body = lock.GetBody();
+    auto position = JPH::Vec3(body.GetPosition());
+    auto rotation = body.GetRotation();
+
+    const auto& current = m_channel.peek(index);
+    if (current.bodyID == id && current.position == position && current.rotation == rotation) {
+        return false;
+    }
+
+    m_channel.write(index, ObjectSnapshot{
+                                   .bodyID = id,
+                                   .position = position,
+                                   .rotation = rotation,
+                           });
+    return true;
+}
+
+MOE_END_PHYSICS_NAMESPACE
\ No newline at end of file
@@ -0,0 +1,129 @@
+#include "Physics/CollisionLayers.hpp"
+
+MOE_BEGIN_PHYSICS_NAMESPACE
+
+CollisionLayerConfig CollisionLayerConfig::createDefault() {
+    using namespace Details;
+
+    CollisionLayerConfig config;
+    config.broadPhaseLayers = {"non_moving", "moving", "trigger", "debris"};
+
+    auto addLayer = [&config](JPH::ObjectLayer layer, StringView name, JPH::BroadPhaseLayer broadPhaseLayer) {
+        MOE_ASSERT(layer == config.objectLayers.size(), "Default layers must be added in order");
+        config.objectLayers.push_back(ObjectLayer{
+                .name = String(name),
+                .broadPhaseLayer = (JPH::BroadPhaseLayer::Type) broadPhaseLayer,
+        });
+    };
+
+    addLayer(Layers::STATIC, "static", BroadPhaseLayers::NON_MOVING);
+    addLayer(Layers::DYNAMIC, "dynamic", BroadPhaseLayers::MOVING);
+    addLayer(Layers::CHARACTER, "character", BroadPhaseLayers::MOVING);
+    addLayer(Layers::PROJECTILE, "projectile", BroadPhaseLayers::MOVING);
+    addLayer(Layers::TRIGGER, "trigger", BroadPhaseLayers::TRIGGER);
+    addLayer(Layers::DEBRIS, "debris", BroadPhaseLayers::DEBRIS);
+
+    // static geometry never tests against itself
+    config.setCollides(Layers::STATIC, Layers::DYNAMIC, true);
+    config.setCollides(Layers::STATIC, Layers::CHARACTER, true);
+    config.setCollides(Layers::STATIC, Layers::PROJECTILE, true);
+    config.setCollides(Layers::STATIC, Layers::DEBRIS, true);
+
+    config.setCollides(Layers::DYNAMIC, Layers::DYNAMIC, true);
+    config.setCollides(Layers::DYNAMIC, Layers::CHARACTER, true);
+    config.setCollides(Layers::DYNAMIC, Layers::PROJECTILE, true);
+    config.setCollides(Layers::DYNAMIC, Layers::TRIGGER, true);
+
+    config.setCollides(Layers::CHARACTER, Layers::CHARACTER, true);
+    config.setCollides(Layers::CHARACTER, Layers::PROJECTILE, true);
+    config.setCollides(Layers::CHARACTER, Layers::TRIGGER, true);
+
+    // projectiles pass through each other
+    config.setCollides(Layers::PROJECTILE, Layers::TRIGGER, true);
+
+    // debris only rests on static geometry, so it never disturbs gameplay objects
+
+    return config;
+}
+
+Optional<JPH::ObjectLayer> CollisionLayerConfig::findObjectLayer(StringView name) const {
+    for (size_t i = 0; i < objectLayers.size(); ++i) {
+        if (objectLayers[i].name == name) {
+            return static_cast<JPH::ObjectLayer>(i);
+        }
+    }
+    return {};
+}
+
+Optional<JPH::BroadPhaseLayer::Type> CollisionLayerConfig::findBroadPhaseLayer(StringView name) const {
+    for (size_t i = 0; i < broadPhaseLayers.size(); ++i) {
+        if (broadPhaseLayers[i] == name) {
+            return static_cast<JPH::BroadPhaseLayer::Type>(i);
+        }
+    }
+    return {};
+}
+
+void CollisionLayerConfig::setCollides(JPH::ObjectLayer a, JPH::ObjectLayer b, bool collides) {
+    MOE_ASSERT(a < objectLayers.size() && b < objectLayers.size(), "Object layer out of range");
+
+    if (collides) {
+        objectLayers[a].collidesWith |= uint64_t(1) << b;
+        objectLayers[b].collidesWith |= uint64_t(1) << a;
+    } else {
+        objectLayers[a].collidesWith &= ~(uint64_t(1) << b);
+        objectLayers[b].collidesWith &= ~(uint64_t(1) << a);
+    }
+}
+
+bool CollisionLayerConfig::validate() const {
+    if (objectLayers.empty() || broadPhaseLayers.empty()) {
+        Logger::error("Collision layer config needs at least one object layer and one broad phase layer");
+        return false;
+    }
+
+    if (objectLayers.size() > MAX_LAYERS || broadPhaseLayers.size() > MAX_LAYERS) {
+        Logger::error("Collision layer config has {} object and {} broad phase layers, at most {} of each are supported",
+                      objectLayers.size(), broadPhaseLayers.size(), MAX_LAYERS);
+        return false;
+    }
+
+    for (auto& layer: objectLayers) {
+        if (layer.broadPhaseLayer >= broadPhaseLayers.size()) {
+            Logger::error("Object layer '{}' maps to missing broad phase layer {}", layer.name, layer.broadPhaseLayer);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+namespace Details {
+    BPLayerInterfaceImpl::BPLayerInterfaceImpl(const CollisionLayerConfig& config)
+        : m_broadPhaseLayerNames(config.broadPhaseLayers) {
+        m_objectToBroadPhase.reserve(config.objectLayers.size());
+        for (auto& layer: config.objectLayers) {
+            m_objectToBroadPhase.push_back(JPH::BroadPhaseLayer(layer.broadPhaseLayer));
+        }
+    }
+
+    ObjectVsBroadPhaseLayerFilterImpl::ObjectVsBroadPhaseLayerFilterImpl(const CollisionLayerConfig& config)
+        : m_broadPhaseMasks(config.objectLayers.size(), 0) {
+        for (size_t a = 0; a < config.objectLayers.size(); ++a) {
+            for (size_t b = 0; b < config.objectLayers.size(); ++b) {
+                if ((config.objectLayers[a].collidesWith >> b) & 1) {
+                    m_broadPhaseMasks[a] |= uint64_t(1) << config.objectLayers[b].broadPhaseLayer;
+                }
+            }
+        }
+    }
+
+    ObjectLayerFilterImpl::ObjectLayerFilterImpl(const CollisionLayerConfig& config) {
+        m_masks.reserve(config.objectLayers.size());
+        for (auto& layer: config.objectLayers) {
+            m_masks.push_back(layer.collidesWith);
+        }
+    }
+}// namespace Details
+
+MOE_END_PHYSICS_NAMESPACE
\ No newline at end of file
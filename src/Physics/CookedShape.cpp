@@ -0,0 +1,59 @@
+#include "Physics/CookedShape.hpp"
+
+#include <Jolt/Core/StreamWrapper.h>
+#include <Jolt/Physics/Collision/PhysicsMaterial.h>
+
+#include <sstream>
+
+MOE_BEGIN_PHYSICS_NAMESPACE
+
+namespace {
+    // guards against reading blobs written by an incompatible build
+    constexpr uint32_t COOKED_SHAPE_MAGIC = 0x4B4F4F43;// "COOK"
+    constexpr uint32_t COOKED_SHAPE_VERSION = (JPH_VERSION_MAJOR << 16) | (JPH_VERSION_MINOR << 8) | 1;
+}// namespace
+
+Vector<uint8_t> CookedShape::serialize() const {
+    MOE_ASSERT(shape != nullptr, "Cannot serialize an empty cooked shape");
+
+    std::stringstream stream(std::ios::out | std::ios::binary);
+    JPH::StreamOutWrapper out(stream);
+
+    out.Write(COOKED_SHAPE_MAGIC);
+    out.Write(COOKED_SHAPE_VERSION);
+
+    JPH::Shape::ShapeToIDMap shapeMap;
+    JPH::Shape::MaterialToIDMap materialMap;
+    shape->SaveWithChildren(out, shapeMap, materialMap);
+
+    auto str = stream.str();
+    return Vector<uint8_t>(str.begin(), str.end());
+}
+
+Optional<CookedShape> CookedShape::deserialize(Span<const uint8_t> data) {
+    std::stringstream stream(
+            std::string(reinterpret_cast<const char*>(data.data()), data.size()),
+            std::ios::in | std::ios::binary);
+    JPH::StreamInWrapper in(stream);
+
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    in.Read(magic);
+    in.Read(version);
+    if (in.IsFailed() || magic != COOKED_SHAPE_MAGIC || version != COOKED_SHAPE_VERSION) {
+        Logger::warn("Cooked shape has an unknown format, version {}", version);
+        return std::nullopt;
+    }
+
+    JPH::Shape::IDToShapeMap shapeMap;
+    JPH::Shape::IDToMaterialMap materialMap;
+    auto result = JPH::Shape::sRestoreWithChildren(in, shapeMap, materialMap);
+    if (result.HasError() || in.IsFailed()) {
+        Logger::warn("Failed to restore cooked shape: {}", result.HasError() ? result.GetError().c_str() : "truncated data");
+        return std::nullopt;
+    }
+
+    return CookedShape{result.Get()};
+}
+
+MOE_END_PHYSICS_NAMESPACE
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "Physics/GltfColliderFactory.hpp"
 #include "Core/FileReader.hpp"
+#include "Core/Resource/Cached.hpp"
 #include "Math/Common.hpp"
 
 #include <Jolt/Physics/Collision/Shape/MeshShape.h>
@@ -55,30 +56,33 @@ namespace Details {
         return {T, R, S};
     }
 
-    void loadGltfFile(tinygltf::Model& model, std::filesystem::path path, std::filesystem::path parentDir) {
-        tinygltf::TinyGLTF loader;
-        String err;
-        String warn;
-
+    Optional<Vector<uint8_t>> readGltfFile(StringView filePath) {
         size_t bufSize = 0;
-        auto fileBuf = FileReader::s_instance->readFile(path.string(), bufSize);
+        auto fileBuf = FileReader::s_instance->readFile(filePath, bufSize);
         if (!fileBuf) {
-            Logger::error("Failed to load glTF file: {}", path.string());
+            Logger::error("Failed to load glTF file: {}", filePath);
             MOE_ASSERT(false, "Failed to load glTF file");
         }
+        return fileBuf;
+    }
+
+    void loadGltfFile(tinygltf::Model& model, const Vector<uint8_t>& fileBuf, std::filesystem::path path, std::filesystem::path parentDir) {
+        tinygltf::TinyGLTF loader;
+        String err;
+        String warn;
 
         bool isBinary = path.extension() == ".glb";
         bool success = false;
         if (isBinary) {
             success = loader.LoadBinaryFromMemory(
                     &model, &err, &warn,
-                    reinterpret_cast<const unsigned char*>(fileBuf->data()),
-                    bufSize, parentDir.string());
+                    reinterpret_cast<const unsigned char*>(fileBuf.data()),
+                    fileBuf.size(), parentDir.string());
         } else {
             success = loader.LoadASCIIFromString(
                     &model, &err, &warn,
-                    reinterpret_cast<const char*>(fileBuf->data()),
-                    bufSize, parentDir.string());
+                    reinterpret_cast<const char*>(fileBuf.data()),
+                    fileBuf.size(), parentDir.string());
         }
 
         if (!warn.empty()) {
@@ -91,6 +95,24 @@ namespace Details {
         }
     }
 
+    constexpr uint64_t FNV_OFFSET_BASIS = 14695981039346656037ull;
+    constexpr uint64_t FNV_PRIME = 1099511628211ull;
+
+    // fnv-1a, stable across runs and platforms unlike std::hash
+    uint64_t hashBytes(const uint8_t* data, size_t size, uint64_t seed = FNV_OFFSET_BASIS) {
+        uint64_t hash = seed;
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= data[i];
+            hash *= FNV_PRIME;
+        }
+        return hash;
+    }
+
+    template<typename T>
+    uint64_t hashValue(const T& value, uint64_t seed) {
+        return hashBytes(reinterpret_cast<const uint8_t*>(&value), sizeof(T), seed);
+    }
+
     int findAttributeAccessor(const tinygltf::Primitive& primitive, StringView attributeName) {
         for (const auto& [accessorName, accessorID]: primitive.attributes) {
             if (accessorName == attributeName) {
@@ -203,13 +225,16 @@ namespace Details {
     }
 }// namespace Details
 
-JPH::Ref<JPH::StaticCompoundShapeSettings> GltfColliderFactory::shapeFromGltf(StringView filePath) {
+static JPH::Ref<JPH::StaticCompoundShapeSettings> buildShapeSettings(
+        StringView filePath,
+        const Vector<uint8_t>& fileData,
+        const GltfColliderSettings& settings) {
     tinygltf::Model model;
 
-    std::filesystem::path pathStr{filePath.data()};
+    std::filesystem::path pathStr{String(filePath)};
     std::filesystem::path parentDir = pathStr.parent_path();
 
-    Details::loadGltfFile(model, pathStr, parentDir);
+    Details::loadGltfFile(model, fileData, pathStr, parentDir);
 
     struct PerPrimitiveData {
         JPH::VertexList vertices;
@@ -323,6 +348,8 @@ JPH::Ref<JPH::StaticCompoundShapeSettings> GltfColliderFactory::shapeFromGltf(St
                     new JPH::MeshShapeSettings(
                             primitiveData.vertices,
                             primitiveData.triangles);
+            meshShapeSettings->mMaxTrianglesPerLeaf = settings.maxTrianglesPerLeaf;
+            meshShapeSettings->SetActiveEdgeCosThresholdAngle(settings.activeEdgeCosThresholdAngle);
 
             // mesh primitive itself is not mutable
             // (at least let's assume so here anyway)
@@ -380,5 +407,59 @@ JPH::Ref<JPH::StaticCompoundShapeSettings> GltfColliderFactory::shapeFromGltf(St
     return rootCompoundShapeSettings;
 }
 
+uint64_t GltfColliderSettings::hashCode() const {
+    uint64_t hash = Details::hashValue(maxTrianglesPerLeaf, Details::FNV_OFFSET_BASIS);
+    return Details::hashValue(activeEdgeCosThresholdAngle, hash);
+}
+
+GltfColliderCooker::GltfColliderCooker(StringView filePath, const GltfColliderSettings& settings)
+    : m_filePath(filePath),
+      m_settings(settings),
+      m_fileData(Details::readGltfFile(filePath)) {
+    if (m_fileData) {
+        m_fileHash = Details::hashBytes(m_fileData->data(), m_fileData->size());
+    }
+}
+
+Optional<GltfColliderCooker::value_type> GltfColliderCooker::generate() {
+    if (!m_fileData) {
+        return std::nullopt;
+    }
+
+    auto shapeSettings = buildShapeSettings(m_filePath, *m_fileData, m_settings);
+    auto result = shapeSettings->Create();
+    if (result.HasError()) {
+        Logger::error("Failed to build collider for {}: {}", m_filePath, result.GetError().c_str());
+        return std::nullopt;
+    }
+
+    return CookedShape{result.Get()};
+}
+
+uint64_t GltfColliderCooker::hashCode() const {
+    return Details::hashValue(m_settings.hashCode(), m_fileHash);
+}
+
+String GltfColliderCooker::paramString() const {
+    // only the file name, the cache key must be a valid file name
+    return fmt::format("gltf_collider_{}", std::filesystem::path(m_filePath).stem().string());
+}
+
+JPH::Ref<JPH::StaticCompoundShapeSettings> GltfColliderFactory::shapeFromGltf(StringView filePath, const GltfColliderSettings& settings) {
+    auto fileData = Details::readGltfFile(filePath);
+    if (!fileData) {
+        return new JPH::StaticCompoundShapeSettings();
+    }
+    return buildShapeSettings(filePath, *fileData, settings);
+}
+
+JPH::ShapeRefC GltfColliderFactory::cookedShapeFromGltf(StringView filePath, const GltfColliderSettings& settings) {
+    Cached<GltfColliderCooker> cooked(filePath, settings);
+    if (auto result = cooked.generate()) {
+        return result->shape;
+    }
+    return nullptr;
+}
+
 
 MOE_END_PHYSICS_NAMESPACE
\ No newline at end of file
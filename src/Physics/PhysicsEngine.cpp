@@ -1,42 +1,89 @@
 #include "Physics/PhysicsEngine.hpp"
 
+#include "Core/Profiler.hpp"
+
+#include <algorithm>
+
 MOE_BEGIN_NAMESPACE
 
-void PhysicsEngine::init() {
+void PhysicsEngine::init(const PhysicsEngineInitializers& initializers) {
     Logger::info("Initializing physics engine...");
-
-    JPH::RegisterDefaultAllocator();
+    m_initializers = initializers;
+
+    // a host that registered jolt before, e.g. a test, keeps its globals and allocator
+    m_ownsJoltGlobals = JPH::Factory::sInstance == nullptr;
+    if (m_ownsJoltGlobals) {
+        // route jolt through the memory tracker, the default allocator fills in anything not overridden here
+        JPH::RegisterDefaultAllocator();
+        JPH::Allocate = Physics::Details::AllocateImpl;
+        JPH::Free = Physics::Details::FreeImpl;
+        JPH::AlignedAllocate = Physics::Details::AlignedAllocateImpl;
+        JPH::AlignedFree = Physics::Details::FreeImpl;
+#if JPH_VERSION_MAJOR >= 5
+        JPH::Reallocate = Physics::Details::ReallocateImpl;
+#endif
+
+        JPH::Factory::sInstance = new JPH::Factory();
+        JPH::RegisterTypes();
+    }
 
     JPH::Trace = Physics::Details::TraceImpl;
     JPH_IF_ENABLE_ASSERTS(JPH::AssertFailed = Physics::Details::AssertFailedImpl;)
 
-    JPH::Factory::sInstance = new JPH::Factory();
-    JPH::RegisterTypes();
-
     Logger::info("Jolt Physics version: {}.{}.{}",
                  JPH_VERSION_MAJOR,
                  JPH_VERSION_MINOR,
                  JPH_VERSION_PATCH);
     Logger::info("Initializing physics utilities...");
-    m_broadPhaseLayerInterface = std::make_unique<Physics::Details::BPLayerInterfaceImpl>();
-    m_objectVsBroadPhaseLayerFilter = std::make_unique<Physics::Details::ObjectVsBroadPhaseLayerFilterImpl>();
-    m_objectLayerFilter = std::make_unique<Physics::Details::ObjectLayerFilterImpl>();
-    m_tempAllocator = std::make_unique<JPH::TempAllocatorImpl>(1024 * 1024);
-    m_jobSystem = std::make_unique<JPH::JobSystemThreadPool>(
-            JPH::cMaxPhysicsJobs,
-            JPH::cMaxPhysicsBarriers);
+    if (!m_initializers.collisionLayers.validate()) {
+        Logger::error("Invalid collision layer config, falling back to the default layers");
+        m_initializers.collisionLayers = Physics::CollisionLayerConfig::createDefault();
+    }
+
+    const auto& layers = m_initializers.collisionLayers;
+    m_broadPhaseLayerInterface = std::make_unique<Physics::Details::BPLayerInterfaceImpl>(layers);
+    m_objectVsBroadPhaseLayerFilter = std::make_unique<Physics::Details::ObjectVsBroadPhaseLayerFilterImpl>(layers);
+    m_objectLayerFilter = std::make_unique<Physics::Details::ObjectLayerFilterImpl>(layers);
+    if (m_initializers.useEngineScheduler) {
+        auto& scheduler = ThreadPoolScheduler::getInstance();
+        MOE_ASSERT(scheduler.workerCount() > 0, "ThreadPoolScheduler must be initialized before the physics engine");
+        m_jobSystem = std::make_unique<Physics::SchedulerJobSystem>(
+                scheduler,
+                JPH::cMaxPhysicsJobs,
+                JPH::cMaxPhysicsBarriers);
+        Logger::info("Physics jobs run on the engine scheduler ({} workers)", scheduler.workerCount());
+    } else {
+        m_jobSystem = std::make_unique<JPH::JobSystemThreadPool>(
+                JPH::cMaxPhysicsJobs,
+                JPH::cMaxPhysicsBarriers);
+        Logger::info("Physics jobs run on a dedicated thread pool");
+    }
+    m_profiler = std::make_unique<Physics::StepProfiler>(
+            *m_jobSystem,
+            static_cast<JPH::uint>(m_initializers.tempAllocatorBytes),
+            m_initializers.profileJobPhases);
 
     Logger::info("Initializing physics system...");
     m_physicsSystem = std::make_unique<JPH::PhysicsSystem>();
     m_physicsSystem->Init(
-            MAX_BODIES, NUM_BODY_MUTEXES,
-            MAX_BODY_PAIRS, MAX_CONTACT_CONSTRAINTS,
+            m_initializers.maxBodies, m_initializers.numBodyMutexes,
+            m_initializers.maxBodyPairs, m_initializers.maxContactConstraints,
             *m_broadPhaseLayerInterface,
             *m_objectVsBroadPhaseLayerFilter,
             *m_objectLayerFilter);
+    m_physicsSystem->SetBodyActivationListener(&m_snapshots);
+    m_physicsSystem->SetContactListener(&m_profiler->getContactListener());
 
-    Logger::info("Physics system initialized with {} max bodies, {} max body pairs, {} max contact constraints",
-                 MAX_BODIES, MAX_BODY_PAIRS, MAX_CONTACT_CONSTRAINTS);
+    if (m_initializers.rollbackFrames > 0) {
+        m_rollback = std::make_unique<Physics::RollbackBuffer>(m_initializers.rollbackFrames);
+        Logger::info("Keeping {} ticks of physics state for rollback", m_initializers.rollbackFrames);
+    }
+
+    Logger::info("Physics system initialized with {} max bodies, {} max body pairs, {} max contact constraints, {} KiB temp memory",
+                 m_initializers.maxBodies, m_initializers.maxBodyPairs, m_initializers.maxContactConstraints,
+                 m_initializers.tempAllocatorBytes / 1024);
+    Logger::info("Collision layers: {} object layers in {} broad phase layers",
+                 layers.objectLayers.size(), layers.broadPhaseLayers.size());
     Logger::info("Launching physics thread...");
     m_initialized = true;
     launchPhysicsThread();
@@ -52,12 +99,31 @@ void PhysicsEngine::destroy() {
         m_physicsThread.join();
     }
 
+    // nobody waiting on a query batch is left hanging
+    executeSceneQueries();
+
+    // commands still queued are dropped with their captures, as the thread will not run again
+    Physics::PhysicsCommand command;
+    while (m_commands.tryPop(command)) {
+    }
     m_persistOnPhysicsThreadFn.clear();
-    m_dispatchedOnPhysicsThreadFn.clear();
+    {
+        std::lock_guard<std::mutex> lk(m_persistMutex);
+        m_pendingPersistFn.clear();
+        m_hasPendingPersistFn.store(false, std::memory_order_relaxed);
+    }
+
+    m_physicsSystem->SetContactListener(nullptr);
+    m_profiler.reset();
 
-    JPH::UnregisterTypes();
-    delete JPH::Factory::sInstance;
-    JPH::Factory::sInstance = nullptr;
+    // while the scheduler still runs, the scheduler job system waits for its queued tasks
+    m_jobSystem.reset();
+
+    if (m_ownsJoltGlobals) {
+        JPH::UnregisterTypes();
+        delete JPH::Factory::sInstance;
+        JPH::Factory::sInstance = nullptr;
+    }
 
     Logger::info("Physics engine shut down");
     m_initialized = false;
@@ -70,91 +136,240 @@ void PhysicsEngine::launchPhysicsThread() {
 
 void PhysicsEngine::mainLoop() {
     Logger::setThreadName("Physics");
+    MOE_PROFILE_THREAD("Physics");
+    Memory::setThreadTag(MemoryTag::Physics);
     Logger::info("Physics thread started");
 
-    const auto step = std::chrono::duration_cast<std::chrono::nanoseconds>(PHYSICS_TIMESTEP);
-    auto nextTick = std::chrono::high_resolution_clock::now();
+    Timing::HighResolutionTimerScope timerResolution;
+    FixedStepClock clock({
+            .step = std::chrono::duration_cast<FixedStepClock::Clock::duration>(PHYSICS_TIMESTEP),
+            .spinWindow = m_initializers.spinWindow,
+            .maxSubsteps = m_initializers.maxCatchUpSubsteps,
+    });
+
+    // summarizing sorts the stat windows, twice a second is plenty for a debug readout
+    constexpr uint32_t STATS_INTERVAL_TICKS = 30;
+    uint32_t ticksSinceStats = 0;
+    uint32_t intervalTempPeakBytes = 0;
 
-    auto _lastTime = std::chrono::high_resolution_clock::now();
+    clock.start();
+    auto lastWake = FixedStepClock::Clock::now();
 
     while (m_running.load()) {
-        m_physicsSystem->Update(PHYSICS_TIMESTEP.count(), 1, m_tempAllocator.get(), m_jobSystem.get());
-
-        syncPhysicsToSwapBuffer();
-        executeDispatchedFunctions();
-
-        nextTick += step;
-
-        while (true) {
-            auto now = std::chrono::high_resolution_clock::now();
-            auto remaining = nextTick - now;
-
-            // sleeping is not precise enough for small durations
-            // i have no idea why
-            // so just busy wait
-            // ! fixme: find out the reason and fix it
-            if (remaining > std::chrono::nanoseconds(0)) {
-                // yield to other threads
-                // still busy waiting though φ(゜▽゜*)♪
-                std::this_thread::yield();
-            } else {
-                break;
+        uint32_t ticks = clock.waitForNextTick();
+        auto wake = FixedStepClock::Clock::now();
+        auto step = std::chrono::duration_cast<FixedStepClock::Clock::duration>(PHYSICS_TIMESTEP);
+
+        for (uint32_t i = 0; i < ticks && m_running.load(); ++i) {
+            MOE_PROFILE_SCOPE("PhysicsEngine::mainLoop");
+            auto tickStart = FixedStepClock::Clock::now();
+            if (m_rollback) {
+                m_rollback->save(*m_physicsSystem, m_currentTickIndex.load());
             }
 
-            // extremely large lag compensation
-            if (remaining < -step * 5) {
-                nextTick = now;
-                break;
-            }
-        }
+            Physics::TickStats tickStats;
+            tickStats.tick = m_currentTickIndex.load();
+            checkCapacity(m_profiler->step(*m_physicsSystem, PHYSICS_TIMESTEP.count(), tickStats));
 
-        // advance tick index
-        m_currentTickIndex.fetch_add(1);
+            // catch-up ticks run back to back, stamp them one step apart as if each had run on time
+            syncPhysicsToSwapBuffer(wake - step * (ticks - 1 - i));
+            executeDispatchedFunctions();
+            executeSceneQueries();
 
-        {
-            // stats
-            auto _now = std::chrono::high_resolution_clock::now();
-            auto _dt = _now - _lastTime;
-            _lastTime = _now;
+            tickStats.overrun = FixedStepClock::Clock::now() - tickStart > step;
+            if (tickStats.overrun) {
+                ++m_tickOverruns;
+            }
+            intervalTempPeakBytes = std::max(intervalTempPeakBytes, tickStats.tempAllocatorPeakBytes);
+            m_lastTickStats.store(tickStats);
+
+            // advance tick index
+            m_currentTickIndex.fetch_add(1);
+        }
 
-            m_stats.physicsFrameTime = std::chrono::duration_cast<Duration>(_dt).count() * 1000.0f;
-            m_stats.physicsTicksPerSecond = 1.0f / std::chrono::duration_cast<Duration>(_dt).count();
+        clock.endTick();
+
+        ticksSinceStats += ticks;
+        if (ticksSinceStats >= STATS_INTERVAL_TICKS) {
+            ticksSinceStats = 0;
+
+            auto dt = std::chrono::duration_cast<Duration>(wake - lastWake).count() / static_cast<float>(ticks);
+            auto clockStats = clock.collectStats();
+
+            Stats stats;
+            stats.physicsFrameTime = dt * 1000.0f;
+            stats.physicsTicksPerSecond = dt > 0.0f ? 1.0f / dt : 0.0f;
+            stats.timingErrorP99Ms = clockStats.timingError.p99Ms;
+            stats.jitterP50Ms = clockStats.jitter.p50Ms;
+            stats.jitterP99Ms = clockStats.jitter.p99Ms;
+            stats.jitterMaxMs = clockStats.jitter.maxMs;
+            stats.workP50Ms = clockStats.work.p50Ms;
+            stats.workP99Ms = clockStats.work.p99Ms;
+            stats.busyPercent = clockStats.busyPercent;
+            stats.spinPercent = clockStats.spinPercent;
+            stats.catchUpTicks = clockStats.catchUpTicks;
+            stats.droppedTicks = clockStats.droppedTicks;
+            stats.numBodies = m_physicsSystem->GetNumBodies();
+#if JPH_VERSION_MAJOR >= 5
+            stats.numActiveBodies = m_physicsSystem->GetNumActiveBodies(JPH::EBodyType::RigidBody);
+#else
+            stats.numActiveBodies = m_physicsSystem->GetNumActiveBodies();
+#endif
+            stats.maxBodies = m_physicsSystem->GetMaxBodies();
+            stats.capacityOverflowTicks = m_capacityOverflowTicks;
+            stats.tickOverruns = m_tickOverruns;
+            // copies the constraint list, fine twice a second
+            stats.numConstraints = static_cast<uint32_t>(m_physicsSystem->GetConstraints().size());
+            stats.tempAllocatorPeakBytes = intervalTempPeakBytes;
+            stats.tempAllocatorBytes = m_profiler->getTempAllocatorCapacity();
+            intervalTempPeakBytes = 0;
+            if (m_rollback) {
+                auto rollbackStats = m_rollback->getStats();
+                stats.rollbackSaveUs = rollbackStats.saveUs;
+                stats.rollbackRestoreUs = rollbackStats.restoreUs;
+                stats.rollbackResimulateUsPerTick = rollbackStats.resimulateUsPerTick;
+                stats.rollbackFrameBytes = static_cast<uint32_t>(rollbackStats.frameBytes);
+            }
+            m_stats.store(stats);
         }
+        lastWake = wake;
     }
+
+    Logger::info("Physics thread stopped");
 }
 
-void PhysicsEngine::syncPhysicsToSwapBuffer() {
-    auto& writeBuffer = m_swapBuffer.getWriteBuffer();
-    writeBuffer.objectSnapshots.clear();
+void PhysicsEngine::syncPhysicsToSwapBuffer(FixedStepClock::Clock::time_point tickTime) {
+    MOE_PROFILE_FUNCTION();
+    m_snapshots.sync(*m_physicsSystem, m_currentTickIndex.load(), tickTime);
+}
 
-    m_bodyIdCache.clear();
-    m_physicsSystem->GetBodies(m_bodyIdCache);
+void PhysicsEngine::updateReadBuffer() {
+    m_snapshots.acquire();
+    m_interpolator.update(m_snapshots.view());
+    m_renderAlpha = m_interpolator.computeAlpha(Physics::SnapshotInterpolator::Clock::now());
+}
 
-    const auto& bodyInterface = m_physicsSystem->GetBodyInterface();
-    for (const auto& bodyID: m_bodyIdCache) {
-        Physics::ObjectSnapshot snapshot{};
-        snapshot.bodyID = bodyID;
-        bodyInterface.GetPositionAndRotation(
-                bodyID,
-                snapshot.position,
-                snapshot.rotation);
-        writeBuffer.objectSnapshots.emplace(bodyID, snapshot);
+void PhysicsEngine::dispatchOnPhysicsThread(Physics::PhysicsCommand&& command) {
+    if (m_commands.tryPush(std::move(command))) {
+        return;
     }
 
-    // swap buffers
-    m_swapBuffer.publish();
+    // the physics thread is the only consumer, it would wait for itself
+    MOE_ASSERT(std::this_thread::get_id() != m_physicsThread.get_id(), "Physics command queue overflowed from the physics thread");
+
+    // full: a backlog this deep means the physics thread is stalled, wait for the next drain instead of dropping
+    Logger::warn("Physics command queue full ({} commands), waiting for the physics thread", m_commands.capacity());
+    while (!m_commands.tryPush(std::move(command))) {
+        std::this_thread::yield();
+    }
 }
 
 void PhysicsEngine::executeDispatchedFunctions() {
-    std::lock_guard<std::mutex> lk(m_dispatchMutex);
+    MOE_PROFILE_FUNCTION();
+    if (m_hasPendingPersistFn.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> lk(m_persistMutex);
+        for (auto& fn: m_pendingPersistFn) {
+            m_persistOnPhysicsThreadFn.push_back(std::move(fn));
+        }
+        m_pendingPersistFn.clear();
+        m_hasPendingPersistFn.store(false, std::memory_order_relaxed);
+    }
+
+    // no lock is held while callbacks run, they may dispatch or register more
     for (auto& fn: m_persistOnPhysicsThreadFn) {
         fn(*this);
     }
 
-    for (auto& fn: m_dispatchedOnPhysicsThreadFn) {
-        fn(*this);
+    // commands dispatched from inside a command run next tick, so a self-dispatching callback cannot spin forever
+    m_commands.drain([this](Physics::PhysicsCommand& command) { executeCommand(command); }, m_commands.sizeApprox());
+}
+
+void PhysicsEngine::executeCommand(Physics::PhysicsCommand& command) {
+    auto& bodyInterface = m_physicsSystem->GetBodyInterface();
+    if (auto* fn = std::get_if<Physics::CallbackCommand>(&command)) {
+        if (*fn) {
+            (*fn)(*this);
+        }
+    } else if (auto* add = std::get_if<Physics::AddBodyCommand>(&command)) {
+        bodyInterface.AddBody(add->bodyID, add->activation);
+        // adding keeps the body count, a body added asleep would never reach the snapshots otherwise
+        m_snapshots.markMoved(add->bodyID);
+    } else if (auto* remove = std::get_if<Physics::RemoveBodyCommand>(&command)) {
+        bodyInterface.RemoveBody(remove->bodyID);
+        if (remove->destroy) {
+            bodyInterface.DestroyBody(remove->bodyID);
+        }
+        // clears its slot, a removed sleeping body would keep its stale snapshot
+        m_snapshots.markMoved(remove->bodyID);
+    } else if (auto* velocity = std::get_if<Physics::SetVelocityCommand>(&command)) {
+        bodyInterface.SetLinearAndAngularVelocity(velocity->bodyID, velocity->linearVelocity, velocity->angularVelocity);
+    } else if (auto* activate = std::get_if<Physics::ActivateBodyCommand>(&command)) {
+        bodyInterface.ActivateBody(activate->bodyID);
+    }
+}
+
+void PhysicsEngine::executeSceneQueries() {
+    m_sceneQueries.execute(*m_physicsSystem, ThreadPoolScheduler::getInstance());
+}
+
+bool PhysicsEngine::rollbackAndResimulate(size_t fromTick, const Function<void(size_t)>& applyInputs) {
+    MOE_ASSERT(std::this_thread::get_id() == m_physicsThread.get_id(), "rollbackAndResimulate must run on the physics thread");
+    if (!m_rollback) {
+        Logger::warn("Physics rollback requested but rollbackFrames is 0");
+        return false;
+    }
+
+    // the tick being run has already been stepped, the world is at the start of the next one
+    auto toTick = m_currentTickIndex.load() + 1;
+    if (fromTick >= toTick) {
+        return true;
+    }
+
+    if (toTick - fromTick >= m_rollback->capacity() || !m_rollback->has(fromTick)) {
+        Logger::warn("Cannot roll physics back to tick {}, only the last {} ticks are kept", fromTick, m_rollback->capacity());
+        return false;
+    }
+    if (!m_rollback->resimulate(*m_physicsSystem, fromTick, toTick, PHYSICS_TIMESTEP.count(), m_profiler->getTempAllocator(), *m_jobSystem, applyInputs)) {
+        // the world is somewhere between fromTick and the present, rescan it all the same
+        m_snapshots.requestFullRescan();
+        return false;
+    }
+
+    // everything may have moved
+    m_snapshots.requestFullRescan();
+    return true;
+}
+
+void PhysicsEngine::checkCapacity(JPH::EPhysicsUpdateError errors) {
+    // bodies only change between updates, a cheap check every tick
+    auto numBodies = m_physicsSystem->GetNumBodies();
+    auto maxBodies = m_physicsSystem->GetMaxBodies();
+    bool nearBodyLimit = static_cast<float>(numBodies) >= static_cast<float>(maxBodies) * BODY_CAPACITY_WARNING_RATIO;
+    if (nearBodyLimit && !m_bodyCapacityWarned) {
+        Logger::warn("Physics body count {} is close to the limit of {}, raise maxBodies", numBodies, maxBodies);
+    }
+    m_bodyCapacityWarned = nearBodyLimit;
+
+    if (errors == JPH::EPhysicsUpdateError::None) {
+        return;
+    }
+
+    ++m_capacityOverflowTicks;
+
+    // an overflowing scene overflows every tick, once every few seconds is enough
+    auto tick = m_currentTickIndex.load();
+    if (tick < m_nextOverflowWarningTick) {
+        return;
     }
-    m_dispatchedOnPhysicsThreadFn.clear();
+    m_nextOverflowWarningTick = tick + static_cast<size_t>(5.0f / PHYSICS_TIMESTEP.count());
+
+    auto has = [errors](JPH::EPhysicsUpdateError error) {
+        return (errors & error) != JPH::EPhysicsUpdateError::None;
+    };
+    Logger::warn("Physics update ran out of capacity, contacts were dropped:{}{}{}",
+                 has(JPH::EPhysicsUpdateError::ManifoldCacheFull) ? " manifold cache full (raise maxContactConstraints)" : "",
+                 has(JPH::EPhysicsUpdateError::BodyPairCacheFull) ? " body pair cache full (raise maxBodyPairs)" : "",
+                 has(JPH::EPhysicsUpdateError::ContactConstraintsFull) ? " contact constraints full (raise maxContactConstraints)" : "");
 }
 
 void PhysicsEngine::syncTickIndex(size_t remoteTickIndex, RoundTripTimeMs roundTripTimeMs) {
@@ -0,0 +1,129 @@
+#include "Physics/PhysicsProfiler.hpp"
+
+#include "Core/Profiler.hpp"
+
+#include <cctype>
+#include <chrono>
+
+MOE_BEGIN_PHYSICS_NAMESPACE
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    // jolt spells the same word differently across jobs and versions, e.g. "Broad Phase" and "Broadphase"
+    bool containsIgnoreCase(const char* text, const char* word) {
+        for (; *text; ++text) {
+            const char* a = text;
+            const char* b = word;
+            while (*a && *b && std::tolower(static_cast<unsigned char>(*a)) == std::tolower(static_cast<unsigned char>(*b))) {
+                ++a;
+                ++b;
+            }
+            if (!*b) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    float toMs(uint64_t ns) {
+        return static_cast<float>(ns) / 1'000'000.0f;
+    }
+}// namespace
+
+PhysicsPhase classifyPhysicsJob(const char* jobName) {
+    if (jobName == nullptr) {
+        return PhysicsPhase::Other;
+    }
+
+    if (containsIgnoreCase(jobName, "broad")) {
+        return PhysicsPhase::BroadPhase;
+    }
+    // "Find Collisions" runs the pair queries and the narrow phase, ccd is narrow phase work on fast bodies
+    if (containsIgnoreCase(jobName, "collision") || containsIgnoreCase(jobName, "ccd")) {
+        return PhysicsPhase::NarrowPhase;
+    }
+    if (containsIgnoreCase(jobName, "constraint") || containsIgnoreCase(jobName, "island")) {
+        return PhysicsPhase::Solver;
+    }
+    if (containsIgnoreCase(jobName, "integrate") || containsIgnoreCase(jobName, "gravity")) {
+        return PhysicsPhase::Integrate;
+    }
+    return PhysicsPhase::Other;
+}
+
+ProfilingJobSystem::JobHandle ProfilingJobSystem::CreateJob(const char* inName, JPH::ColorArg inColor, const JobFunction& inJobFunction, JPH::uint32 inNumDependencies) {
+    auto* counter = &m_phaseNs[static_cast<size_t>(classifyPhysicsJob(inName))];
+    return m_jobSystem.CreateJob(
+            inName, inColor,
+            [counter, fn = inJobFunction]() {
+                auto start = Clock::now();
+                fn();
+                auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+                counter->fetch_add(static_cast<uint64_t>(ns), std::memory_order_relaxed);
+            },
+            inNumDependencies);
+}
+
+Array<uint64_t, static_cast<size_t>(PhysicsPhase::Count)> ProfilingJobSystem::consumePhaseNs() {
+    Array<uint64_t, static_cast<size_t>(PhysicsPhase::Count)> result{};
+    for (size_t i = 0; i < result.size(); ++i) {
+        result[i] = m_phaseNs[i].exchange(0, std::memory_order_relaxed);
+    }
+    return result;
+}
+
+void* TrackingTempAllocator::Allocate(JPH::uint inSize) {
+    void* address = m_allocator.Allocate(inSize);
+
+    JPH::uint usage = m_usage.fetch_add(inSize, std::memory_order_relaxed) + inSize;
+    JPH::uint peak = m_peak.load(std::memory_order_relaxed);
+    while (usage > peak && !m_peak.compare_exchange_weak(peak, usage, std::memory_order_relaxed)) {
+    }
+    return address;
+}
+
+void TrackingTempAllocator::Free(void* inAddress, JPH::uint inSize) {
+    m_allocator.Free(inAddress, inSize);
+    m_usage.fetch_sub(inSize, std::memory_order_relaxed);
+}
+
+JPH::uint TrackingTempAllocator::consumePeakBytes() {
+    return m_peak.exchange(m_usage.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+StepProfiler::StepProfiler(JPH::JobSystem& jobSystem, JPH::uint tempAllocatorBytes, bool profilePhases)
+    : m_jobSystem(jobSystem),
+      m_profilingJobSystem(jobSystem),
+      m_profilePhases(profilePhases),
+      m_tempAllocator(tempAllocatorBytes) {}
+
+JPH::EPhysicsUpdateError StepProfiler::step(JPH::PhysicsSystem& system, float deltaTime, TickStats& outStats) {
+    auto* jobSystem = m_profilePhases ? static_cast<JPH::JobSystem*>(&m_profilingJobSystem) : &m_jobSystem;
+
+    auto start = Clock::now();
+    JPH::EPhysicsUpdateError errors;
+    {
+        MOE_PROFILE_SCOPE("PhysicsSystem::Update");
+        errors = system.Update(deltaTime, 1, &m_tempAllocator, jobSystem);
+    }
+    outStats.stepMs = std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+
+    auto phaseNs = m_profilingJobSystem.consumePhaseNs();
+    outStats.broadPhaseMs = toMs(phaseNs[static_cast<size_t>(PhysicsPhase::BroadPhase)]);
+    outStats.narrowPhaseMs = toMs(phaseNs[static_cast<size_t>(PhysicsPhase::NarrowPhase)]);
+    outStats.solverMs = toMs(phaseNs[static_cast<size_t>(PhysicsPhase::Solver)]);
+    outStats.integrateMs = toMs(phaseNs[static_cast<size_t>(PhysicsPhase::Integrate)]);
+    outStats.otherJobsMs = toMs(phaseNs[static_cast<size_t>(PhysicsPhase::Other)]);
+
+#if JPH_VERSION_MAJOR >= 5
+    outStats.numActiveBodies = system.GetNumActiveBodies(JPH::EBodyType::RigidBody);
+#else
+    outStats.numActiveBodies = system.GetNumActiveBodies();
+#endif
+    outStats.numContacts = m_contacts.consumeContacts();
+    outStats.tempAllocatorPeakBytes = m_tempAllocator.consumePeakBytes();
+    return errors;
+}
+
+MOE_END_PHYSICS_NAMESPACE
\ No newline at end of file
@@ -0,0 +1,138 @@
+#include "Physics/RollbackBuffer.hpp"
+
+#include "Core/Profiler.hpp"
+
+#include <chrono>
+#include <cstring>
+
+MOE_BEGIN_PHYSICS_NAMESPACE
+
+namespace {
+    // jolt's StateRecorderImpl goes through a stringstream, this writes into a reused buffer instead
+    class BufferStateRecorder final : public JPH::StateRecorder {
+    public:
+        explicit BufferStateRecorder(Vector<uint8_t>& buffer)
+            : m_buffer(buffer) {}
+
+        void WriteBytes(const void* inData, size_t inNumBytes) override {
+            auto* bytes = static_cast<const uint8_t*>(inData);
+            m_buffer.insert(m_buffer.end(), bytes, bytes + inNumBytes);
+        }
+
+        void ReadBytes(void* outData, size_t inNumBytes) override {
+            if (m_readOffset + inNumBytes > m_buffer.size()) {
+                m_failed = true;
+                std::memset(outData, 0, inNumBytes);
+                return;
+            }
+            std::memcpy(outData, m_buffer.data() + m_readOffset, inNumBytes);
+            m_readOffset += inNumBytes;
+        }
+
+        bool IsEOF() const override { return m_readOffset >= m_buffer.size(); }
+
+        bool IsFailed() const override { return m_failed; }
+
+    private:
+        Vector<uint8_t>& m_buffer;
+        size_t m_readOffset{0};
+        bool m_failed{false};
+    };
+
+#if JPH_VERSION_MAJOR >= 5
+    class SkipStaticBodiesFilter final : public JPH::StateRecorderFilter {
+    public:
+        bool ShouldSaveBody(const JPH::Body& inBody) const override {
+            return !inBody.IsStatic();
+        }
+    };
+#endif
+
+    float elapsedUs(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - start).count();
+    }
+}// namespace
+
+RollbackBuffer::RollbackBuffer(size_t capacity)
+    : m_frames(capacity) {
+    MOE_ASSERT(capacity > 0, "RollbackBuffer needs at least one frame");
+}
+
+void RollbackBuffer::save(const JPH::PhysicsSystem& system, size_t tick) {
+    MOE_PROFILE_FUNCTION();
+    auto start = std::chrono::steady_clock::now();
+
+    auto& frame = frameFor(tick);
+    frame.data.clear();
+    BufferStateRecorder recorder(frame.data);
+#if JPH_VERSION_MAJOR >= 5
+    SkipStaticBodiesFilter filter;
+    system.SaveState(recorder, JPH::EStateRecorderState::All, &filter);
+#else
+    system.SaveState(recorder);
+#endif
+    frame.tick = tick;
+    frame.valid = true;
+
+    m_stats.saveUs = elapsedUs(start);
+    m_stats.frameBytes = frame.data.size();
+}
+
+bool RollbackBuffer::restore(JPH::PhysicsSystem& system, size_t tick) {
+    MOE_PROFILE_FUNCTION();
+    if (!has(tick)) {
+        return false;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    BufferStateRecorder recorder(frameFor(tick).data);
+    if (!system.RestoreState(recorder)) {
+        Logger::error("Failed to restore physics state of tick {}", tick);
+        return false;
+    }
+
+    m_stats.restoreUs = elapsedUs(start);
+    return true;
+}
+
+bool RollbackBuffer::resimulate(
+        JPH::PhysicsSystem& system,
+        size_t fromTick, size_t toTick,
+        float deltaTime,
+        JPH::TempAllocator& tempAllocator,
+        JPH::JobSystem& jobSystem,
+        const Function<void(size_t)>& applyInputs) {
+    MOE_PROFILE_FUNCTION();
+    MOE_ASSERT(fromTick <= toTick, "Cannot resimulate backwards");
+    if (toTick - fromTick >= m_frames.size() || !restore(system, fromTick)) {
+        return false;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t tick = fromTick; tick < toTick; ++tick) {
+        // same order as the physics loop: step, then the inputs drained during the tick, then the next save
+        auto errors = system.Update(deltaTime, 1, &tempAllocator, &jobSystem);
+        if (errors != JPH::EPhysicsUpdateError::None) {
+            Logger::error("Physics update failed while resimulating tick {}: {:#x}", tick, static_cast<uint32_t>(errors));
+            return false;
+        }
+        if (applyInputs) {
+            applyInputs(tick);
+        }
+
+        // the states recorded after the rolled back tick were wrong
+        save(system, tick + 1);
+    }
+
+    if (toTick > fromTick) {
+        m_stats.resimulateUsPerTick = elapsedUs(start) / static_cast<float>(toTick - fromTick);
+    }
+    return true;
+}
+
+bool RollbackBuffer::has(size_t tick) const {
+    const auto& frame = frameFor(tick);
+    return frame.valid && frame.tick == tick;
+}
+
+MOE_END_PHYSICS_NAMESPACE
\ No newline at end of file
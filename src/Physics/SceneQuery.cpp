@@ -0,0 +1,161 @@
+#include "Physics/SceneQuery.hpp"
+
+#include "Core/Profiler.hpp"
+#include "Core/Task/ParallelFor.hpp"
+
+#include <Jolt/Physics/Body/BodyFilter.h>
+#include <Jolt/Physics/Collision/CastResult.h>
+#include <Jolt/Physics/Collision/CollisionCollectorImpl.h>
+#include <Jolt/Physics/Collision/NarrowPhaseQuery.h>
+#include <Jolt/Physics/Collision/RayCast.h>
+#include <Jolt/Physics/Collision/ShapeCast.h>
+
+MOE_BEGIN_PHYSICS_NAMESPACE
+
+namespace {
+    class LayerMaskFilter final : public JPH::ObjectLayerFilter {
+    public:
+        explicit LayerMaskFilter(uint64_t mask)
+            : m_mask(mask) {}
+
+        bool ShouldCollide(JPH::ObjectLayer inLayer) const override {
+            return inLayer < 64 && ((m_mask >> inLayer) & 1) != 0;
+        }
+
+    private:
+        uint64_t m_mask;
+    };
+
+    RayHit castRay(const JPH::NarrowPhaseQuery& query, const RayQuery& ray) {
+        JPH::RRayCast cast{ray.origin, ray.direction};
+        JPH::RayCastResult result;
+        LayerMaskFilter layerFilter(ray.filter.layerMask);
+        JPH::IgnoreSingleBodyFilter bodyFilter(ray.filter.ignoreBody);
+
+        RayHit hit;
+        if (query.CastRay(cast, result, {}, layerFilter, bodyFilter)) {
+            hit.body = result.mBodyID;
+            hit.subShape = result.mSubShapeID2;
+            hit.fraction = result.mFraction;
+            hit.position = cast.GetPointOnRay(result.mFraction);
+        }
+        return hit;
+    }
+
+    ShapeCastHit castShape(const JPH::NarrowPhaseQuery& query, const ShapeCastQuery& shapeCast) {
+        ShapeCastHit hit;
+        if (shapeCast.shape == nullptr) {
+            return hit;
+        }
+
+        auto cast = JPH::RShapeCast::sFromWorldTransform(
+                shapeCast.shape, JPH::Vec3::sReplicate(1.0f), shapeCast.start, shapeCast.direction);
+        // contact points come back relative to this, keeps precision far from the origin
+        auto baseOffset = shapeCast.start.GetTranslation();
+
+        JPH::ShapeCastSettings settings;
+        JPH::ClosestHitCollisionCollector<JPH::CastShapeCollector> collector;
+        LayerMaskFilter layerFilter(shapeCast.filter.layerMask);
+        JPH::IgnoreSingleBodyFilter bodyFilter(shapeCast.filter.ignoreBody);
+        query.CastShape(cast, settings, baseOffset, collector, {}, layerFilter, bodyFilter);
+
+        if (collector.HadHit()) {
+            const auto& result = collector.mHit;
+            hit.body = result.mBodyID2;
+            hit.subShape = result.mSubShapeID2;
+            hit.fraction = result.mFraction;
+            hit.contactPoint = baseOffset + result.mContactPointOn2;
+            hit.normal = -result.mPenetrationAxis.NormalizedOr(JPH::Vec3::sZero());
+        }
+        return hit;
+    }
+
+    template<typename QueryT, typename HitT, typename CastFn>
+    void runBatches(
+            Vector<QueryT>& queries,
+            Function<void(Vector<HitT>&&)>& complete,
+            const JPH::NarrowPhaseQuery& query,
+            ThreadPoolScheduler& scheduler,
+            CastFn castFn) {
+        constexpr size_t GRAIN = SceneQueryBatcher::QUERIES_PER_TASK;
+        Vector<HitT> hits(queries.size());
+        auto chunks = static_cast<uint32_t>((queries.size() + GRAIN - 1) / GRAIN);
+        parallelFor(scheduler, chunks, [&](uint32_t, uint32_t chunk) {
+            size_t end = std::min(queries.size(), (chunk + 1) * GRAIN);
+            for (size_t i = chunk * GRAIN; i < end; ++i) {
+                hits[i] = castFn(query, queries[i]);
+            }
+        });
+        complete(std::move(hits));
+    }
+
+    template<typename HitT>
+    Function<void(Vector<HitT>&&)> completeOnMainThread(Function<void(const Vector<HitT>&)> callback) {
+        return [callback = std::move(callback)](Vector<HitT>&& hits) {
+            MainScheduler::getInstance().schedule([callback, hits = std::move(hits)]() {
+                callback(hits);
+            });
+        };
+    }
+
+    template<typename HitT>
+    std::pair<Function<void(Vector<HitT>&&)>, QueryFuture<HitT>> completeWithFuture() {
+        auto promise = std::make_shared<Promise<Vector<HitT>, ThreadPoolScheduler>>();
+        auto future = promise->getFuture();
+        return {
+                [promise](Vector<HitT>&& hits) { promise->setValue(std::move(hits)); },
+                std::move(future),
+        };
+    }
+}// namespace
+
+QueryFuture<RayHit> SceneQueryBatcher::castRays(Vector<RayQuery> queries) {
+    auto [complete, future] = completeWithFuture<RayHit>();
+    std::lock_guard<std::mutex> lk(m_mutex);
+    m_rayBatches.push_back({std::move(queries), std::move(complete)});
+    return future;
+}
+
+QueryFuture<ShapeCastHit> SceneQueryBatcher::castShapes(Vector<ShapeCastQuery> queries) {
+    auto [complete, future] = completeWithFuture<ShapeCastHit>();
+    std::lock_guard<std::mutex> lk(m_mutex);
+    m_shapeCastBatches.push_back({std::move(queries), std::move(complete)});
+    return future;
+}
+
+void SceneQueryBatcher::castRays(Vector<RayQuery> queries, Function<void(const Vector<RayHit>&)> callback) {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    m_rayBatches.push_back({std::move(queries), completeOnMainThread<RayHit>(std::move(callback))});
+}
+
+void SceneQueryBatcher::castShapes(Vector<ShapeCastQuery> queries, Function<void(const Vector<ShapeCastHit>&)> callback) {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    m_shapeCastBatches.push_back({std::move(queries), completeOnMainThread<ShapeCastHit>(std::move(callback))});
+}
+
+void SceneQueryBatcher::execute(const JPH::PhysicsSystem& system, ThreadPoolScheduler& scheduler) {
+    MOE_PROFILE_FUNCTION();
+
+    Vector<PendingBatch<RayQuery, RayHit>> rayBatches;
+    Vector<PendingBatch<ShapeCastQuery, ShapeCastHit>> shapeCastBatches;
+    {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        rayBatches.swap(m_rayBatches);
+        shapeCastBatches.swap(m_shapeCastBatches);
+    }
+
+    const auto& query = system.GetNarrowPhaseQuery();
+    for (auto& batch: rayBatches) {
+        runBatches(batch.queries, batch.complete, query, scheduler, castRay);
+    }
+    for (auto& batch: shapeCastBatches) {
+        runBatches(batch.queries, batch.complete, query, scheduler, castShape);
+    }
+}
+
+size_t SceneQueryBatcher::pendingBatches() {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    return m_rayBatches.size() + m_shapeCastBatches.size();
+}
+
+MOE_END_PHYSICS_NAMESPACE
\ No newline at end of file
@@ -0,0 +1,76 @@
+#include "Physics/SchedulerJobSystem.hpp"
+
+#include "Core/Profiler.hpp"
+
+#include <thread>
+
+MOE_BEGIN_PHYSICS_NAMESPACE
+
+SchedulerJobSystem::SchedulerJobSystem(ThreadPoolScheduler& scheduler, JPH::uint maxJobs, JPH::uint maxBarriers)
+    : JPH::JobSystemWithBarrier(maxBarriers),
+      m_scheduler(scheduler) {
+    m_jobs.Init(maxJobs, maxJobs);
+}
+
+SchedulerJobSystem::~SchedulerJobSystem() {
+    // a job the barrier thread already ran is still referenced by its queued task
+    while (m_scheduledTasks.load(std::memory_order_acquire) != 0) {
+        std::this_thread::yield();
+    }
+}
+
+int SchedulerJobSystem::GetMaxConcurrency() const {
+    // the workers plus the thread waiting on the barrier
+    return static_cast<int>(m_scheduler.workerCount()) + 1;
+}
+
+SchedulerJobSystem::JobHandle SchedulerJobSystem::CreateJob(const char* inName, JPH::ColorArg inColor, const JobFunction& inJobFunction, JPH::uint32 inNumDependencies) {
+    JPH::uint32 index;
+    while (true) {
+        index = m_jobs.ConstructObject(inName, inColor, this, inJobFunction, inNumDependencies);
+        if (index != AvailableJobs::cInvalidObjectIndex) {
+            break;
+        }
+
+        // jobs are recycled as soon as they finish, running out means maxJobs is too small
+        JPH_ASSERT(false, "No jobs available!");
+        std::this_thread::yield();
+    }
+
+    auto* job = &m_jobs.Get(index);
+
+    // the handle keeps the job alive, it may complete as soon as it is queued
+    JobHandle handle(job);
+    if (inNumDependencies == 0) {
+        QueueJob(job);
+    }
+    return handle;
+}
+
+void SchedulerJobSystem::QueueJob(Job* inJob) {
+    // the queued task owns a reference until it has run
+    inJob->AddRef();
+    m_scheduledTasks.fetch_add(1, std::memory_order_relaxed);
+
+    m_scheduler.schedule(
+            [this, inJob]() {
+                MOE_PROFILE_SCOPE("Physics job");
+                // no-op if the barrier thread got to it first
+                inJob->Execute();
+                inJob->Release();
+                m_scheduledTasks.fetch_sub(1, std::memory_order_release);
+            },
+            TaskPriority::High);
+}
+
+void SchedulerJobSystem::QueueJobs(Job** inJobs, JPH::uint inNumJobs) {
+    for (JPH::uint i = 0; i < inNumJobs; ++i) {
+        QueueJob(inJobs[i]);
+    }
+}
+
+void SchedulerJobSystem::FreeJob(Job* inJob) {
+    m_jobs.DestructObject(inJob);
+}
+
+MOE_END_PHYSICS_NAMESPACE
\ No newline at end of file
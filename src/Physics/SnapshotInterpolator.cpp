@@ -0,0 +1,103 @@
+#include "Physics/SnapshotInterpolator.hpp"
+
+#include "Core/Profiler.hpp"
+
+#include <algorithm>
+
+MOE_BEGIN_PHYSICS_NAMESPACE
+
+namespace {
+    // normalized lerp takes the short way round, close enough to slerp for the rotation of a single tick
+    // and also fine with alpha above 1
+    JPH::Quat blendRotation(JPH::QuatArg from, JPH::QuatArg to, float alpha) {
+        JPH::Quat target = from.Dot(to) < 0.0f ? -to : to;
+        JPH::Quat blended = from * (1.0f - alpha) + target * alpha;
+        return blended.Normalized();
+    }
+}// namespace
+
+SnapshotInterpolator::SnapshotInterpolator()
+    : SnapshotInterpolator(Config{}) {}
+
+SnapshotInterpolator::SnapshotInterpolator(const Config& config)
+    : m_config(config) {}
+
+bool SnapshotInterpolator::update(const SnapshotView& view) {
+    const auto& entries = view.getEntries();
+    if (entries.version == 0 || entries.version <= m_version) {
+        return false;
+    }
+
+    MOE_PROFILE_FUNCTION();
+
+    // the first publish, or the body capacity changed: nothing to blend from
+    if (m_version == 0 || entries.size() != m_current.size()) {
+        m_current.assign(entries.entries.begin(), entries.entries.end());
+        m_previous = m_current;
+        m_moving.assign(entries.size(), 0);
+
+        m_version = entries.version;
+        m_previousTick = m_currentTick = entries.tick;
+        m_previousTime = m_currentTime = entries.time;
+        return true;
+    }
+
+    for (size_t i = 0; i < entries.size(); ++i) {
+        if (entries.changedSince(i, m_version)) {
+            auto& current = m_current[i];
+            // a reused slot belongs to a new body, it must not fly in from where the old one was
+            m_previous[i] = current.bodyID == entries[i].bodyID ? current : entries[i];
+            current = entries[i];
+            m_moving[i] = 1;
+        } else if (m_moving[i]) {
+            // came to rest during the last publish, hold it still from now on
+            m_previous[i] = m_current[i];
+            m_moving[i] = 0;
+        }
+    }
+
+    m_version = entries.version;
+    m_previousTick = m_currentTick;
+    m_currentTick = entries.tick;
+    m_previousTime = m_currentTime;
+    m_currentTime = entries.time;
+    return true;
+}
+
+float SnapshotInterpolator::computeAlpha(Clock::time_point now) const {
+    using Seconds = std::chrono::duration<float>;
+
+    float span = std::chrono::duration_cast<Seconds>(m_currentTime - m_previousTime).count();
+    if (span <= 0.0f) {
+        return 1.0f;
+    }
+
+    auto renderTime = now - m_config.delay;
+    float alpha = std::chrono::duration_cast<Seconds>(renderTime - m_previousTime).count() / span;
+    float maxAlpha = 1.0f + std::chrono::duration_cast<Seconds>(m_config.maxExtrapolation).count() / span;
+    return std::clamp(alpha, 0.0f, maxAlpha);
+}
+
+Optional<ObjectSnapshot> SnapshotInterpolator::getTransform(JPH::BodyID id, float alpha) const {
+    if (id.IsInvalid() || id.GetIndex() >= m_current.size()) {
+        return {};
+    }
+
+    const auto& current = m_current[id.GetIndex()];
+    if (current.bodyID != id) {
+        return {};
+    }
+
+    const auto& previous = m_previous[id.GetIndex()];
+    if (!m_moving[id.GetIndex()]) {
+        return current;
+    }
+
+    return ObjectSnapshot{
+            .bodyID = id,
+            .position = previous.position + (current.position - previous.position) * alpha,
+            .rotation = blendRotation(previous.rotation, current.rotation, alpha),
+    };
+}
+
+MOE_END_PHYSICS_NAMESPACE
\ No newline at end of file
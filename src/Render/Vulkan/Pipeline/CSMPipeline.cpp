@@ -1,5 +1,6 @@
 #include "Render/Vulkan/Pipeline/CSMPipeline.hpp"
 #include "Render/Vulkan/VulkanCamera.hpp"
+#include "Render/Vulkan/VulkanCommandRecorder.hpp"
 #include "Render/Vulkan/VulkanEngine.hpp"
 #include "Render/Vulkan/VulkanInitializers.hpp"
 #include "Render/Vulkan/VulkanMaterialCache.hpp"
@@ -8,6 +9,9 @@
 #include "Render/Vulkan/VulkanRenderable.hpp"
 #include "Render/Vulkan/VulkanUtils.hpp"
 
+#include <chrono>
+#include <numeric>
+
 
 namespace moe {
     namespace Pipeline {
@@ -59,7 +63,7 @@ namespace moe {
             builder.enableDepthTesting(true, VK_COMPARE_OP_LESS);
             builder.setDepthFormat(VK_FORMAT_D32_SFLOAT);
 
-            m_pipeline = builder.build(engine.m_device);
+            m_pipeline = builder.build(engine.m_device, &engine.m_pipelineCache);
 
             auto csmImageInfo =
                     VkInit::imageCreateInfo(
@@ -96,6 +100,8 @@ namespace moe {
                 m_shadowMapImageViews[i] = imageView;
             }
 
+            m_instanceBuffer.init(engine);
+
             vkDestroyShaderModule(engine.m_device, vert, nullptr);
             vkDestroyShaderModule(engine.m_device, frag, nullptr);
         }
@@ -104,28 +110,170 @@ namespace moe {
                 VkCommandBuffer cmdBuffer,
                 VulkanMeshCache& meshCache,
                 Span<VulkanRenderPacket> drawCommands,
+                const VulkanCullingBatch& cullingBatch,
                 const VulkanCamera& camera,
-                glm::vec3 lightDir) {
+                glm::vec3 lightDir,
+                size_t frameIndex) {
             MOE_ASSERT(m_initialized, "CSMPipeline is not initialized");
 
-            vkCmdBindPipeline(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipeline);
-            auto bindlessDescriptorSet = m_engine->getBindlessSet().getDescriptorSet();
-            vkCmdBindDescriptorSets(
-                    cmdBuffer,
-                    VK_PIPELINE_BIND_POINT_GRAPHICS,
-                    m_pipelineLayout,
-                    0, 1, &bindlessDescriptorSet,
-                    0, nullptr);
-
-            auto csmShadowMapResult = m_engine->m_caches.imageCache.getImage(m_shadowMapImageId);
-            MOE_ASSERT(csmShadowMapResult.has_value(), "Invalid CSM shadow map image id");
-            auto csmShadowMap = csmShadowMapResult.value();
-
-            VkUtils::transitionImage(
-                    cmdBuffer,
-                    csmShadowMap.image,
-                    VK_IMAGE_LAYOUT_UNDEFINED,
-                    VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL);
+            updateCascades(camera, lightDir);
+
+            m_lastStats = {};
+
+            auto grouping = m_instancing
+                                    ? VulkanInstanceBatcher::Grouping::Mesh
+                                    : VulkanInstanceBatcher::Grouping::None;
+            m_instanceBatcher.clear();
+
+            // every cascade is culled, sorted and grouped before any is recorded,
+            // the instance buffer is written once and must not grow while its address is in use
+            for (int i = 0; i < SHADOW_CASCADE_COUNT; ++i) {
+                // casters outside the light's clip volume would be clipped by the rasterizer anyway
+                auto& visibleIndices = m_cascadeVisibleIndices[i];
+                visibleIndices.clear();
+                if (cullingBatch.size() == drawCommands.size()) {
+                    cullingBatch.cull(VulkanFrustum::fromViewProjection(m_cascadeLightTransforms[i]), visibleIndices);
+                } else {
+                    MOE_ASSERT(cullingBatch.size() == 0, "Culling batch does not match the draw commands");
+                    visibleIndices.resize(drawCommands.size());
+                    std::iota(visibleIndices.begin(), visibleIndices.end(), 0u);
+                }
+
+                if (m_sortDraws) {
+                    auto sortStart = std::chrono::steady_clock::now();
+                    m_sortKeys.clear();
+                    for (auto index: visibleIndices) {
+                        auto& packet = drawCommands[index];
+                        auto depth = VkSortKey::quantizeDepth(m_cascadeLightTransforms[i], packet.getSortPosition());
+                        m_sortKeys.push_back(VkSortKey::shadowDepth(packet.sortKey, depth));
+                    }
+                    m_drawSorter.sort(m_sortKeys, visibleIndices);
+                    m_lastStats.sortUs += std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - sortStart).count();
+                }
+
+                auto submitStart = std::chrono::steady_clock::now();
+                auto& instancedDraws = m_cascadeInstancedDraws[i];
+                instancedDraws.clear();
+                for (auto index: visibleIndices) {
+                    m_instanceBatcher.push(drawCommands[index], grouping, instancedDraws);
+                }
+                m_lastStats.submitUs += std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - submitStart).count();
+            }
+
+            auto submitStart = std::chrono::steady_clock::now();
+            auto instanceBufferAddr = m_instanceBuffer.upload(m_instanceBatcher.getInstances(), frameIndex);
+
+            // only reads what was built above, so cascades can be recorded on any thread
+            auto recordCascade = [&](VkCommandBuffer cmd, uint32_t cascade, VulkanPassStats& stats) {
+                bindState(cmd);
+
+                // every mesh's indices live in the mesh arena, so the index buffer is bound once
+                VkBuffer boundIndexBuffer = VK_NULL_HANDLE;
+                for (auto& draw: m_cascadeInstancedDraws[cascade]) {
+                    auto mesh = meshCache.getMesh(draw.meshId).value();
+                    if (mesh.gpuBuffer.indexBuffer.buffer != boundIndexBuffer) {
+                        boundIndexBuffer = mesh.gpuBuffer.indexBuffer.buffer;
+                        vkCmdBindIndexBuffer(cmd, boundIndexBuffer, 0, VK_INDEX_TYPE_UINT32);
+                        ++stats.indexBufferBinds;
+                    }
+
+                    auto pushConstants = PushConstants{
+                            .lightViewProjection = m_cascadeLightTransforms[cascade],
+                            .instanceBufferAddr = instanceBufferAddr,
+                            .vertexBufferAddr =
+                                    draw.skinned
+                                            ? draw.skinnedVertexBufferAddr
+                                            : mesh.gpuBuffer.vertexBufferAddr,
+                    };
+
+                    vkCmdPushConstants(cmd, m_pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(PushConstants), &pushConstants);
+                    vkCmdDrawIndexed(cmd, mesh.gpuBuffer.indexCount, draw.instanceCount, mesh.gpuBuffer.firstIndex, 0, draw.firstInstance);
+                    ++stats.draws;
+                    stats.instances += draw.instanceCount;
+                }
+            };
+
+            if (m_parallelRecording) {
+                // one secondary per cascade, recorded at once and then executed in each cascade's rendering
+                Array<VulkanPassStats, SHADOW_CASCADE_COUNT> cascadeStats{};
+                auto buffers = m_engine->m_commandRecorder.record(
+                        getInheritanceInfo(), SHADOW_CASCADE_COUNT,
+                        [&](VkCommandBuffer cmd, uint32_t cascade) {
+                            recordCascade(cmd, cascade, cascadeStats[cascade]);
+                        });
+
+                for (uint32_t i = 0; i < SHADOW_CASCADE_COUNT; ++i) {
+                    beginCascade(cmdBuffer, i, VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT);
+                    vkCmdExecuteCommands(cmdBuffer, 1, &buffers[i]);
+                    vkCmdEndRendering(cmdBuffer);
+                    m_lastStats.addCounts(cascadeStats[i]);
+                }
+            } else {
+                for (uint32_t i = 0; i < SHADOW_CASCADE_COUNT; ++i) {
+                    beginCascade(cmdBuffer, i, 0);
+                    recordCascade(cmdBuffer, i, m_lastStats);
+                    vkCmdEndRendering(cmdBuffer);
+                }
+            }
+
+            m_lastStats.submitUs += std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - submitStart).count();
+        }
+
+        void CSMPipeline::drawIndirect(
+                VkCommandBuffer cmdBuffer,
+                VulkanMeshCache& meshCache,
+                const Array<VulkanIndirectView, SHADOW_CASCADE_COUNT>& cascadeViews) {
+            MOE_ASSERT(m_initialized, "CSMPipeline is not initialized");
+
+            m_lastStats = {};
+            auto submitStart = std::chrono::steady_clock::now();
+
+            for (int i = 0; i < SHADOW_CASCADE_COUNT; ++i) {
+                auto& view = cascadeViews[i];
+
+                beginCascade(cmdBuffer, i, 0);
+                bindState(cmdBuffer);
+
+                VkBuffer boundIndexBuffer = VK_NULL_HANDLE;
+                for (size_t g = 0; g < view.groups.size(); ++g) {
+                    auto& group = view.groups[g];
+                    auto mesh = meshCache.getMesh(group.meshId);
+                    if (!mesh.has_value()) {
+                        continue;
+                    }
+
+                    if (mesh->gpuBuffer.indexBuffer.buffer != boundIndexBuffer) {
+                        boundIndexBuffer = mesh->gpuBuffer.indexBuffer.buffer;
+                        vkCmdBindIndexBuffer(cmdBuffer, boundIndexBuffer, 0, VK_INDEX_TYPE_UINT32);
+                        ++m_lastStats.indexBufferBinds;
+                    }
+
+                    auto pushConstants = PushConstants{
+                            .lightViewProjection = m_cascadeLightTransforms[i],
+                            .instanceBufferAddr = view.instanceBufferAddr,
+                            .vertexBufferAddr =
+                                    group.skinned
+                                            ? group.skinnedVertexBufferAddr
+                                            : mesh->gpuBuffer.vertexBufferAddr,
+                    };
+
+                    vkCmdPushConstants(cmdBuffer, m_pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(PushConstants), &pushConstants);
+                    vkCmdDrawIndexedIndirectCount(
+                            cmdBuffer,
+                            view.commandBuffer, view.commandOffset + g * sizeof(VkDrawIndexedIndirectCommand),
+                            view.countBuffer, view.countOffset + g * sizeof(uint32_t),
+                            1, sizeof(VkDrawIndexedIndirectCommand));
+                    ++m_lastStats.draws;
+                }
+
+                vkCmdEndRendering(cmdBuffer);
+            }
+
+            m_lastStats.submitUs = std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - submitStart).count();
+        }
+
+        void CSMPipeline::updateCascades(const VulkanCamera& camera, glm::vec3 lightDir) {
+            MOE_ASSERT(m_initialized, "CSMPipeline is not initialized");
 
             float nearZ = camera.getNearZ();
             float farZ = camera.getFarZ();
@@ -147,70 +295,60 @@ namespace moe {
                 float aspect = (float) m_engine->m_drawExtent.width / (float) m_engine->m_drawExtent.height;
                 auto corners = subFrustumCamera.getFrustumCornersWorldSpace(aspect);
                 m_cascadeLightTransforms[i] = VulkanCamera::getCSMCamera(corners, lightDir, m_csmShadowMapSize, m_shadowMapCameraScale).viewProj;
+            }
+        }
 
-                auto depthClearValue = VkClearValue{.depthStencil = {1.0f, 0}};
-                auto depthAttachment = VkInit::renderingAttachmentInfo(
-                        m_shadowMapImageViews[i],
-                        &depthClearValue,
-                        VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL);
-                auto renderingInfo = VkInit::renderingInfo(
-                        VkExtent2D{m_csmShadowMapSize, m_csmShadowMapSize},
-                        nullptr,
-                        &depthAttachment);
-
-                vkCmdBeginRendering(cmdBuffer, &renderingInfo);
-
-                vkCmdBindPipeline(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipeline);
-
-                auto bindlessSet = m_engine->getBindlessSet().getDescriptorSet();
-                vkCmdBindDescriptorSets(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipelineLayout, 0, 1, &bindlessSet, 0, nullptr);
-
-                const auto viewport = VkViewport{
-                        .x = 0,
-                        .y = 0,
-                        .width = (float) m_csmShadowMapSize,
-                        .height = (float) m_csmShadowMapSize,
-                        .minDepth = 0.f,
-                        .maxDepth = 1.f,
-                };
-                vkCmdSetViewport(cmdBuffer, 0, 1, &viewport);
-
-                const auto scissor = VkRect2D{
-                        .offset = {},
-                        .extent = {m_csmShadowMapSize, m_csmShadowMapSize},
-                };
-                vkCmdSetScissor(cmdBuffer, 0, 1, &scissor);
+        void CSMPipeline::beginCascade(VkCommandBuffer cmdBuffer, uint32_t cascade, VkRenderingFlags flags) {
+            auto depthClearValue = VkClearValue{.depthStencil = {1.0f, 0}};
+            auto depthAttachment = VkInit::renderingAttachmentInfo(
+                    m_shadowMapImageViews[cascade],
+                    &depthClearValue,
+                    VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL);
+            auto renderingInfo = VkInit::renderingInfo(
+                    VkExtent2D{m_csmShadowMapSize, m_csmShadowMapSize},
+                    nullptr,
+                    &depthAttachment);
+            renderingInfo.flags = flags;
 
-                for (auto& drawCommand: drawCommands) {
-                    auto mesh = m_engine->m_caches.meshCache.getMesh(drawCommand.meshId).value();
-                    vkCmdBindIndexBuffer(cmdBuffer, mesh.gpuBuffer.indexBuffer.buffer, 0, VK_INDEX_TYPE_UINT32);
+            vkCmdBeginRendering(cmdBuffer, &renderingInfo);
+        }
 
-                    auto pushConstants = PushConstants{
-                            .mvp = m_cascadeLightTransforms[i] * drawCommand.transform,
-                            .vertexBufferAddr =
-                                    drawCommand.skinned
-                                            ? drawCommand.skinnedVertexBufferAddr
-                                            : mesh.gpuBuffer.vertexBufferAddr,
-                    };
+        void CSMPipeline::bindState(VkCommandBuffer cmdBuffer) {
+            vkCmdBindPipeline(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipeline);
 
-                    vkCmdPushConstants(cmdBuffer, m_pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(PushConstants), &pushConstants);
-                    vkCmdDrawIndexed(cmdBuffer, mesh.gpuBuffer.indexCount, 1, 0, 0, 0);
-                }
+            auto bindlessSet = m_engine->getBindlessSet().getDescriptorSet();
+            vkCmdBindDescriptorSets(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipelineLayout, 0, 1, &bindlessSet, 0, nullptr);
 
+            const auto viewport = VkViewport{
+                    .x = 0,
+                    .y = 0,
+                    .width = (float) m_csmShadowMapSize,
+                    .height = (float) m_csmShadowMapSize,
+                    .minDepth = 0.f,
+                    .maxDepth = 1.f,
+            };
+            vkCmdSetViewport(cmdBuffer, 0, 1, &viewport);
 
-                vkCmdEndRendering(cmdBuffer);
-            }
+            const auto scissor = VkRect2D{
+                    .offset = {},
+                    .extent = {m_csmShadowMapSize, m_csmShadowMapSize},
+            };
+            vkCmdSetScissor(cmdBuffer, 0, 1, &scissor);
+        }
 
-            VkUtils::transitionImage(
-                    cmdBuffer,
-                    csmShadowMap.image,
-                    VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
-                    VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+        VkCommandBufferInheritanceRenderingInfo CSMPipeline::getInheritanceInfo() const {
+            return VkCommandBufferInheritanceRenderingInfo{
+                    .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO,
+                    .depthAttachmentFormat = VK_FORMAT_D32_SFLOAT,
+                    .rasterizationSamples = VK_SAMPLE_COUNT_1_BIT,
+            };
         }
 
         void CSMPipeline::destroy() {
             MOE_ASSERT(m_initialized, "CSMPipeline is not initialized");
 
+            m_instanceBuffer.destroy();
+
             for (auto imageView: m_shadowMapImageViews) {
                 vkDestroyImageView(m_engine->m_device, imageView, nullptr);
             }
@@ -0,0 +1,205 @@
+#include "Render/Vulkan/Pipeline/CullingPipeline.hpp"
+#include "Render/Vulkan/VulkanCulling.hpp"
+#include "Render/Vulkan/VulkanEngine.hpp"
+#include "Render/Vulkan/VulkanInitializers.hpp"
+#include "Render/Vulkan/VulkanMeshCache.hpp"
+#include "Render/Vulkan/VulkanPipeline.hpp"
+#include "Render/Vulkan/VulkanUtils.hpp"
+
+#include <algorithm>
+
+namespace moe {
+    namespace Pipeline {
+        void CullingPipeline::init(VulkanEngine& engine) {
+            MOE_ASSERT(!m_initialized, "CullingPipeline already initialized");
+
+            m_engine = &engine;
+            auto shader = VkUtils::createShaderModuleFromFile(m_engine->m_device, "shaders/gpu_culling.comp.spv");
+
+            auto pushRange = VkPushConstantRange{
+                    .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
+                    .offset = 0,
+                    .size = sizeof(PushConstants),
+            };
+
+            auto pushRanges = Array<VkPushConstantRange, 1>{pushRange};
+
+            auto pipelineLayoutInfo = VkInit::pipelineLayoutCreateInfo({}, pushRanges);
+            MOE_VK_CHECK(vkCreatePipelineLayout(engine.m_device, &pipelineLayoutInfo, nullptr, &m_pipelineLayout));
+
+            auto builder = VulkanComputePipelineBuilder{m_pipelineLayout};
+            builder.setShader(shader);
+            m_pipeline = builder.build(m_engine->m_device, &m_engine->m_pipelineCache);
+
+            vkDestroyShaderModule(engine.m_device, shader, nullptr);
+
+            m_initialized = true;
+        }
+
+        void CullingPipeline::destroy() {
+            MOE_ASSERT(m_initialized, "CullingPipeline not initialized");
+
+            for (auto& swapData: m_swapData) {
+                for (auto* frameBuffer: {&swapData.objects, &swapData.frustumPlanes, &swapData.commands, &swapData.counts, &swapData.instances}) {
+                    if (frameBuffer->capacity > 0) {
+                        m_engine->destroyBuffer(frameBuffer->buffer);
+                        frameBuffer->capacity = 0;
+                    }
+                }
+            }
+
+            vkDestroyPipeline(m_engine->m_device, m_pipeline, nullptr);
+            vkDestroyPipelineLayout(m_engine->m_device, m_pipelineLayout, nullptr);
+
+            m_engine = nullptr;
+            m_initialized = false;
+        }
+
+        void CullingPipeline::prepare(VulkanMeshCache& meshCache, Span<VulkanRenderPacket> drawCommands, size_t frameIndex) {
+            MOE_ASSERT(m_initialized, "CullingPipeline not initialized");
+            MOE_ASSERT(frameIndex < Constants::FRAMES_IN_FLIGHT, "Invalid frame index");
+
+            m_frameIndex = frameIndex;
+            m_builder.build(drawCommands);
+
+            auto& objects = m_builder.getObjects();
+            auto& gBufferGroups = m_builder.getGBufferGroups();
+            auto& shadowGroups = m_builder.getShadowGroups();
+            auto objectCount = static_cast<uint32_t>(objects.size());
+
+            // every view owns objectCount instance slots, its groups split them up
+            m_commands.clear();
+            auto appendCommands = [&](const Vector<VulkanInstancedDraw>& groups, uint32_t view) {
+                for (auto& group: groups) {
+                    auto mesh = meshCache.getMesh(group.meshId);
+                    m_commands.push_back(VkDrawIndexedIndirectCommand{
+                            // a missing mesh draws nothing
+                            .indexCount = mesh.has_value() ? mesh->gpuBuffer.indexCount : 0,
+                            .instanceCount = 0,
+                            .firstIndex = mesh.has_value() ? mesh->gpuBuffer.firstIndex : 0,
+                            .vertexOffset = 0,
+                            .firstInstance = view * objectCount + group.firstInstance,
+                    });
+                }
+            };
+            appendCommands(gBufferGroups, 0);
+            for (uint32_t i = 0; i < CSMPipeline::SHADOW_CASCADE_COUNT; ++i) {
+                appendCommands(shadowGroups, 1 + i);
+            }
+
+            auto& swapData = m_swapData[frameIndex];
+            reserve(swapData.objects, objects.size() * sizeof(VulkanCullingObject),
+                    VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+                    VMA_MEMORY_USAGE_AUTO);
+            reserve(swapData.frustumPlanes, VIEW_COUNT * PLANES_PER_VIEW * sizeof(glm::vec4),
+                    VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+                    VMA_MEMORY_USAGE_AUTO);
+            reserve(swapData.commands, m_commands.size() * sizeof(VkDrawIndexedIndirectCommand),
+                    VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+                    VMA_MEMORY_USAGE_AUTO);
+            reserve(swapData.counts, m_commands.size() * sizeof(uint32_t),
+                    VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+                    VMA_MEMORY_USAGE_AUTO);
+            reserve(swapData.instances, VIEW_COUNT * objects.size() * sizeof(VulkanInstanceData),
+                    VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+                    VMA_MEMORY_USAGE_GPU_ONLY);
+
+            // host writes are visible to the gpu once the frame is submitted
+            std::memcpy(
+                    swapData.objects.buffer.vmaAllocationInfo.pMappedData,
+                    objects.data(),
+                    objects.size() * sizeof(VulkanCullingObject));
+            std::memcpy(
+                    swapData.commands.buffer.vmaAllocationInfo.pMappedData,
+                    m_commands.data(),
+                    m_commands.size() * sizeof(VkDrawIndexedIndirectCommand));
+            std::memset(
+                    swapData.counts.buffer.vmaAllocationInfo.pMappedData,
+                    0,
+                    m_commands.size() * sizeof(uint32_t));
+        }
+
+        void CullingPipeline::cull(VkCommandBuffer cmdBuffer, const Array<glm::mat4, VIEW_COUNT>& viewProjections, size_t frameIndex) {
+            MOE_ASSERT(m_initialized, "CullingPipeline not initialized");
+            MOE_ASSERT(frameIndex == m_frameIndex, "CullingPipeline::cull must follow prepare for the same frame");
+
+            auto& swapData = m_swapData[frameIndex];
+            auto objectCount = getObjectCount();
+            if (objectCount == 0) {
+                return;
+            }
+
+            auto* planes = static_cast<glm::vec4*>(swapData.frustumPlanes.buffer.vmaAllocationInfo.pMappedData);
+            for (uint32_t view = 0; view < VIEW_COUNT; ++view) {
+                auto frustum = VulkanFrustum::fromViewProjection(viewProjections[view]);
+                std::copy(frustum.planes.begin(), frustum.planes.end(), planes + view * PLANES_PER_VIEW);
+            }
+
+            vkCmdBindPipeline(cmdBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipeline);
+
+            auto pushConstants = PushConstants{
+                    .objectBufferAddr = swapData.objects.buffer.address,
+                    .frustumPlaneBufferAddr = swapData.frustumPlanes.buffer.address,
+                    .commandBufferAddr = swapData.commands.buffer.address,
+                    .countBufferAddr = swapData.counts.buffer.address,
+                    .instanceBufferAddr = swapData.instances.buffer.address,
+                    .objectCount = objectCount,
+                    .gBufferGroupCount = static_cast<uint32_t>(m_builder.getGBufferGroups().size()),
+                    .shadowGroupCount = static_cast<uint32_t>(m_builder.getShadowGroups().size()),
+            };
+            vkCmdPushConstants(cmdBuffer, m_pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(PushConstants), &pushConstants);
+
+            vkCmdDispatch(cmdBuffer, (objectCount + WORKGROUP_SIZE - 1) / WORKGROUP_SIZE, VIEW_COUNT, 1);
+        }
+
+        CullingPipeline::OutputBuffers CullingPipeline::getOutputBuffers() const {
+            auto& swapData = m_swapData[m_frameIndex];
+            return OutputBuffers{
+                    .commands = swapData.commands.buffer.buffer,
+                    .counts = swapData.counts.buffer.buffer,
+                    .instances = swapData.instances.buffer.buffer,
+            };
+        }
+
+        VulkanIndirectView CullingPipeline::getView(uint32_t view) const {
+            MOE_ASSERT(view < VIEW_COUNT, "Invalid culling view");
+
+            auto& swapData = m_swapData[m_frameIndex];
+            auto firstCommand = getFirstCommand(view);
+            return VulkanIndirectView{
+                    .groups = view == 0 ? Span<const VulkanInstancedDraw>(m_builder.getGBufferGroups())
+                                        : Span<const VulkanInstancedDraw>(m_builder.getShadowGroups()),
+                    .commandBuffer = swapData.commands.buffer.buffer,
+                    .commandOffset = firstCommand * sizeof(VkDrawIndexedIndirectCommand),
+                    .countBuffer = swapData.counts.buffer.buffer,
+                    .countOffset = firstCommand * sizeof(uint32_t),
+                    .instanceBufferAddr = swapData.instances.buffer.address,
+            };
+        }
+
+        uint32_t CullingPipeline::getFirstCommand(uint32_t view) const {
+            auto gBufferGroupCount = static_cast<uint32_t>(m_builder.getGBufferGroups().size());
+            auto shadowGroupCount = static_cast<uint32_t>(m_builder.getShadowGroups().size());
+            return view == 0 ? 0 : gBufferGroupCount + (view - 1) * shadowGroupCount;
+        }
+
+        void CullingPipeline::reserve(FrameBuffer& frameBuffer, size_t size, VkBufferUsageFlags usage, VmaMemoryUsage memoryUsage) {
+            if (size <= frameBuffer.capacity) {
+                return;
+            }
+
+            // the frame's buffers were last read FRAMES_IN_FLIGHT frames ago, whose fence has been waited on
+            if (frameBuffer.capacity > 0) {
+                m_engine->destroyBuffer(frameBuffer.buffer);
+            }
+
+            size_t capacity = std::max(frameBuffer.capacity, MIN_BUFFER_SIZE);
+            while (capacity < size) {
+                capacity *= BUFFER_GROWTH_FACTOR;
+            }
+
+            frameBuffer.buffer = m_engine->allocateBuffer(capacity, usage, memoryUsage);
+            frameBuffer.capacity = capacity;
+        }
+    }// namespace Pipeline
+}// namespace moe
\ No newline at end of file
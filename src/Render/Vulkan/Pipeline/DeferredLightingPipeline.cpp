@@ -54,7 +54,7 @@ namespace moe {
                 builder.disableMultisampling();
             }
 
-            m_pipeline = builder.build(engine.m_device);
+            m_pipeline = builder.build(engine.m_device, &engine.m_pipelineCache);
 
             vkDestroyShaderModule(engine.m_device, vert, nullptr);
             vkDestroyShaderModule(engine.m_device, frag, nullptr);
@@ -1,4 +1,5 @@
 #include "Render/Vulkan/Pipeline/GBufferPipeline.hpp"
+#include "Render/Vulkan/VulkanCommandRecorder.hpp"
 #include "Render/Vulkan/VulkanEngine.hpp"
 #include "Render/Vulkan/VulkanInitializers.hpp"
 #include "Render/Vulkan/VulkanMaterialCache.hpp"
@@ -6,6 +7,8 @@
 #include "Render/Vulkan/VulkanPipeline.hpp"
 #include "Render/Vulkan/VulkanUtils.hpp"
 
+#include <chrono>
+
 namespace moe {
     namespace Pipeline {
         void GBufferPipeline::init(VulkanEngine& engine) {
@@ -16,6 +19,8 @@ namespace moe {
 
             allocateImages();
 
+            m_instanceBuffer.init(engine);
+
             auto vert =
                     VkUtils::createShaderModuleFromFile(engine.m_device, "shaders/gbuffer.vert.spv");
             auto frag =
@@ -61,7 +66,7 @@ namespace moe {
                 builder.disableMultisampling();
             }
 
-            m_pipeline = builder.build(engine.m_device);
+            m_pipeline = builder.build(engine.m_device, &engine.m_pipelineCache);
 
             vkDestroyShaderModule(engine.m_device, vert, nullptr);
             vkDestroyShaderModule(engine.m_device, frag, nullptr);
@@ -72,11 +77,192 @@ namespace moe {
                 VulkanMeshCache& meshCache,
                 VulkanMaterialCache& materialCache,
                 Span<VulkanRenderPacket> drawCommands,
+                VulkanAllocatedBuffer& sceneDataBuffer,
+                size_t frameIndex) {
+            MOE_ASSERT(m_initialized, "GBufferPipeline not initialized");
+
+            m_lastStats = {};
+            auto submitStart = std::chrono::steady_clock::now();
+
+            // draw commands come sorted by material and mesh, so runs of one mesh and material are consecutive
+            auto grouping = m_instancing
+                                    ? VulkanInstanceBatcher::Grouping::MeshAndMaterial
+                                    : VulkanInstanceBatcher::Grouping::None;
+            m_instanceBatcher.clear();
+            m_instanceBatcher.reserve(drawCommands.size());
+            m_instancedDraws.clear();
+            for (auto& cmd: drawCommands) {
+                m_instanceBatcher.push(cmd, grouping, m_instancedDraws);
+            }
+            // host writes are visible to the gpu once the frame is submitted
+            auto instanceBufferAddr = m_instanceBuffer.upload(m_instanceBatcher.getInstances(), frameIndex);
+
+            MOE_ASSERT(sceneDataBuffer.address != 0, "Invalid scene data buffer");
+
+            // only reads what was built above, so chunks can be recorded on any thread
+            auto recordDraws = [&](VkCommandBuffer cmd, VkParallel::ChunkRange range, VulkanPassStats& stats) {
+                bindState(cmd);
+
+                // every mesh's indices live in the mesh arena, so the index buffer is bound once
+                VkBuffer boundIndexBuffer = VK_NULL_HANDLE;
+                MaterialId lastMaterialId = NULL_MATERIAL_ID;
+
+                for (size_t i = range.begin; i < range.end; ++i) {
+                    auto& draw = m_instancedDraws[i];
+                    auto mesh = meshCache.getMesh(draw.meshId);
+                    if (!mesh.has_value()) {
+                        Logger::warn("Invalid mesh id {}, skipping draw command", draw.meshId);
+                        continue;
+                    }
+
+                    auto& meshAsset = mesh.value();
+
+                    if (meshAsset.gpuBuffer.indexBuffer.buffer != boundIndexBuffer) {
+                        boundIndexBuffer = meshAsset.gpuBuffer.indexBuffer.buffer;
+                        vkCmdBindIndexBuffer(cmd, boundIndexBuffer, 0, VK_INDEX_TYPE_UINT32);
+                        ++stats.indexBufferBinds;
+                    }
+                    if (draw.materialId != lastMaterialId) {
+                        lastMaterialId = draw.materialId;
+                        ++stats.materialChanges;
+                    }
+
+                    auto vertexBufferAddr =
+                            draw.skinned
+                                    ? draw.skinnedVertexBufferAddr
+                                    : meshAsset.gpuBuffer.vertexBufferAddr;
+
+                    const auto pushConstants = PushConstants{
+                            .instanceBufferAddr = instanceBufferAddr,
+                            .vertexBufferAddr = vertexBufferAddr,
+                            .sceneDataAddress = sceneDataBuffer.address,
+                            .materialId = draw.materialId,
+                    };
+
+                    vkCmdPushConstants(
+                            cmd,
+                            m_pipelineLayout,
+                            VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
+                            0,
+                            sizeof(PushConstants),
+                            &pushConstants);
+
+                    // the shader indexes the instance buffer with gl_InstanceIndex, which starts at firstInstance
+                    vkCmdDrawIndexed(cmd, meshAsset.gpuBuffer.indexCount, draw.instanceCount, meshAsset.gpuBuffer.firstIndex, 0, draw.firstInstance);
+                    ++stats.draws;
+                    stats.instances += draw.instanceCount;
+                }
+            };
+
+            auto& recorder = m_engine->m_commandRecorder;
+            auto chunks = VkParallel::chunkCount(m_instancedDraws.size(), VulkanCommandRecorder::MIN_DRAWS_PER_CHUNK, recorder.getSlotLimit());
+            if (m_parallelRecording && chunks > 1) {
+                // contiguous chunks executed in order draw exactly what one buffer would
+                m_chunkStats.assign(chunks, {});
+                auto buffers = recorder.record(
+                        getInheritanceInfo(), chunks,
+                        [&](VkCommandBuffer cmd, uint32_t chunk) {
+                            recordDraws(cmd, VkParallel::chunkRange(m_instancedDraws.size(), chunks, chunk), m_chunkStats[chunk]);
+                        });
+
+                beginRendering(cmdBuffer, VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT);
+                vkCmdExecuteCommands(cmdBuffer, static_cast<uint32_t>(buffers.size()), buffers.data());
+                endRendering(cmdBuffer);
+
+                for (auto& chunkStats: m_chunkStats) {
+                    m_lastStats.addCounts(chunkStats);
+                }
+            } else {
+                beginRendering(cmdBuffer, 0);
+                recordDraws(cmdBuffer, {0, m_instancedDraws.size()}, m_lastStats);
+                endRendering(cmdBuffer);
+            }
+
+            m_lastStats.submitUs = std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - submitStart).count();
+        }
+
+        void GBufferPipeline::drawIndirect(
+                VkCommandBuffer cmdBuffer,
+                VulkanMeshCache& meshCache,
+                const VulkanIndirectView& view,
                 VulkanAllocatedBuffer& sceneDataBuffer) {
             MOE_ASSERT(m_initialized, "GBufferPipeline not initialized");
+            MOE_ASSERT(sceneDataBuffer.address != 0, "Invalid scene data buffer");
+
+            m_lastStats = {};
+            auto submitStart = std::chrono::steady_clock::now();
 
-            transitionImagesForRendering(cmdBuffer);
+            beginRendering(cmdBuffer, 0);
+            bindState(cmdBuffer);
 
+            // one draw per group, however many of its instances survived culling
+            VkBuffer boundIndexBuffer = VK_NULL_HANDLE;
+            MaterialId lastMaterialId = NULL_MATERIAL_ID;
+
+            for (size_t i = 0; i < view.groups.size(); ++i) {
+                auto& group = view.groups[i];
+                auto mesh = meshCache.getMesh(group.meshId);
+                if (!mesh.has_value()) {
+                    continue;
+                }
+
+                auto& meshAsset = mesh.value();
+
+                if (meshAsset.gpuBuffer.indexBuffer.buffer != boundIndexBuffer) {
+                    boundIndexBuffer = meshAsset.gpuBuffer.indexBuffer.buffer;
+                    vkCmdBindIndexBuffer(cmdBuffer, boundIndexBuffer, 0, VK_INDEX_TYPE_UINT32);
+                    ++m_lastStats.indexBufferBinds;
+                }
+                if (group.materialId != lastMaterialId) {
+                    lastMaterialId = group.materialId;
+                    ++m_lastStats.materialChanges;
+                }
+
+                const auto pushConstants = PushConstants{
+                        .instanceBufferAddr = view.instanceBufferAddr,
+                        .vertexBufferAddr =
+                                group.skinned
+                                        ? group.skinnedVertexBufferAddr
+                                        : meshAsset.gpuBuffer.vertexBufferAddr,
+                        .sceneDataAddress = sceneDataBuffer.address,
+                        .materialId = group.materialId,
+                };
+
+                vkCmdPushConstants(
+                        cmdBuffer,
+                        m_pipelineLayout,
+                        VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
+                        0,
+                        sizeof(PushConstants),
+                        &pushConstants);
+
+                // the count is 1 only when the culling pass kept an instance of the group
+                vkCmdDrawIndexedIndirectCount(
+                        cmdBuffer,
+                        view.commandBuffer, view.commandOffset + i * sizeof(VkDrawIndexedIndirectCommand),
+                        view.countBuffer, view.countOffset + i * sizeof(uint32_t),
+                        1, sizeof(VkDrawIndexedIndirectCommand));
+                ++m_lastStats.draws;
+            }
+
+            endRendering(cmdBuffer);
+
+            m_lastStats.submitUs = std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - submitStart).count();
+        }
+
+        void GBufferPipeline::destroy() {
+            MOE_ASSERT(m_initialized, "GBufferPipeline not initialized");
+
+            m_instanceBuffer.destroy();
+
+            vkDestroyPipeline(m_engine->m_device, m_pipeline, nullptr);
+            vkDestroyPipelineLayout(m_engine->m_device, m_pipelineLayout, nullptr);
+
+            m_initialized = false;
+            m_engine = nullptr;
+        }
+
+        void GBufferPipeline::beginRendering(VkCommandBuffer cmdBuffer, VkRenderingFlags flags) {
             VkClearValue colorClearValue = {.color = {0.0f, 0.0f, 0.0f, 1.0f}};
             VkClearValue depthClearValue = {.depthStencil = {1.0f, 0}};
 
@@ -115,9 +301,12 @@ namespace moe {
             auto renderingInfo = VkInit::renderingInfo(m_engine->m_drawExtent, nullptr, &depthAttachment);
             renderingInfo.colorAttachmentCount = colorAttachments.size();
             renderingInfo.pColorAttachments = colorAttachments.data();
+            renderingInfo.flags = flags;
 
             vkCmdBeginRendering(cmdBuffer, &renderingInfo);
+        }
 
+        void GBufferPipeline::bindState(VkCommandBuffer cmdBuffer) {
             vkCmdBindPipeline(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipeline);
 
             auto bindlessDescriptorSet = m_engine->getBindlessSet().getDescriptorSet();
@@ -128,69 +317,32 @@ namespace moe {
                     0, 1, &bindlessDescriptorSet,
                     0, nullptr);
 
-            for (auto& cmd: drawCommands) {
-                auto mesh = meshCache.getMesh(cmd.meshId);
-                if (!mesh.has_value()) {
-                    Logger::warn("Invalid mesh id {}, skipping draw command", cmd.meshId);
-                    continue;
-                }
-
-                auto& meshAsset = mesh.value();
-                MOE_ASSERT(sceneDataBuffer.address != 0, "Invalid scene data buffer");
-
-                const auto viewport = VkViewport{
-                        .x = 0,
-                        .y = 0,
-                        .width = (float) m_engine->m_drawExtent.width,
-                        .height = (float) m_engine->m_drawExtent.height,
-                        .minDepth = 0.f,
-                        .maxDepth = 1.f,
-                };
-                vkCmdSetViewport(cmdBuffer, 0, 1, &viewport);
-
-                VkRect2D scissor = {.offset = {0, 0}, .extent = m_engine->m_drawExtent};
-                vkCmdSetScissor(cmdBuffer, 0, 1, &scissor);
-
-                vkCmdBindIndexBuffer(cmdBuffer, meshAsset.gpuBuffer.indexBuffer.buffer, 0, VK_INDEX_TYPE_UINT32);
-
-                auto vertexBufferAddr =
-                        cmd.skinned
-                                ? cmd.skinnedVertexBufferAddr
-                                : meshAsset.gpuBuffer.vertexBufferAddr;
-
-                const auto pushConstants = PushConstants{
-                        .transform = cmd.transform,
-                        .clampedInverseTransform =
-                                glm::mat3(glm::inverse(cmd.transform)),
-                        .vertexBufferAddr = vertexBufferAddr,
-                        .sceneDataAddress = sceneDataBuffer.address,
-                        .materialId = cmd.materialId,
-                };
-
-                vkCmdPushConstants(
-                        cmdBuffer,
-                        m_pipelineLayout,
-                        VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
-                        0,
-                        sizeof(PushConstants),
-                        &pushConstants);
+            const auto viewport = VkViewport{
+                    .x = 0,
+                    .y = 0,
+                    .width = (float) m_engine->m_drawExtent.width,
+                    .height = (float) m_engine->m_drawExtent.height,
+                    .minDepth = 0.f,
+                    .maxDepth = 1.f,
+            };
+            vkCmdSetViewport(cmdBuffer, 0, 1, &viewport);
 
-                vkCmdDrawIndexed(cmdBuffer, meshAsset.gpuBuffer.indexCount, 1, 0, 0, 0);
-            }
+            VkRect2D scissor = {.offset = {0, 0}, .extent = m_engine->m_drawExtent};
+            vkCmdSetScissor(cmdBuffer, 0, 1, &scissor);
+        }
 
+        void GBufferPipeline::endRendering(VkCommandBuffer cmdBuffer) {
             vkCmdEndRendering(cmdBuffer);
-
-            transitionImagesForSampling(cmdBuffer);
         }
 
-        void GBufferPipeline::destroy() {
-            MOE_ASSERT(m_initialized, "GBufferPipeline not initialized");
-
-            vkDestroyPipeline(m_engine->m_device, m_pipeline, nullptr);
-            vkDestroyPipelineLayout(m_engine->m_device, m_pipelineLayout, nullptr);
-
-            m_initialized = false;
-            m_engine = nullptr;
+        VkCommandBufferInheritanceRenderingInfo GBufferPipeline::getInheritanceInfo() const {
+            return VkCommandBufferInheritanceRenderingInfo{
+                    .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO,
+                    .colorAttachmentCount = static_cast<uint32_t>(m_colorAttachmentFormats.size()),
+                    .pColorAttachmentFormats = m_colorAttachmentFormats.data(),
+                    .depthAttachmentFormat = gDepth.imageFormat,
+                    .rasterizationSamples = VK_SAMPLE_COUNT_1_BIT,
+            };
         }
 
         void GBufferPipeline::allocateImages() {
@@ -243,70 +395,14 @@ namespace moe {
             gAlbedo = imageCache.getImage(gAlbedoId).value();
             gORMA = imageCache.getImage(gORMAId).value();
             gEmissive = imageCache.getImage(gEmissiveId).value();
-        }
 
-        void GBufferPipeline::transitionImagesForRendering(VkCommandBuffer cmdBuffer) {
-            VkUtils::transitionImage(
-                    cmdBuffer,
-                    gDepth.image,
-                    VK_IMAGE_LAYOUT_UNDEFINED,
-                    VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL);
-
-            VkUtils::transitionImage(
-                    cmdBuffer,
-                    gAlbedo.image,
-                    VK_IMAGE_LAYOUT_UNDEFINED,
-                    VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
-
-            VkUtils::transitionImage(
-                    cmdBuffer,
-                    gNormal.image,
-                    VK_IMAGE_LAYOUT_UNDEFINED,
-                    VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
-
-            VkUtils::transitionImage(
-                    cmdBuffer,
-                    gORMA.image,
-                    VK_IMAGE_LAYOUT_UNDEFINED,
-                    VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
-
-            VkUtils::transitionImage(
-                    cmdBuffer,
-                    gEmissive.image,
-                    VK_IMAGE_LAYOUT_UNDEFINED,
-                    VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
-        }
-
-        void GBufferPipeline::transitionImagesForSampling(VkCommandBuffer cmdBuffer) {
-            VkUtils::transitionImage(
-                    cmdBuffer,
-                    gDepth.image,
-                    VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
-                    VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-
-            VkUtils::transitionImage(
-                    cmdBuffer,
-                    gAlbedo.image,
-                    VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
-                    VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-
-            VkUtils::transitionImage(
-                    cmdBuffer,
-                    gNormal.image,
-                    VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
-                    VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-
-            VkUtils::transitionImage(
-                    cmdBuffer,
-                    gORMA.image,
-                    VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
-                    VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-
-            VkUtils::transitionImage(
-                    cmdBuffer,
-                    gEmissive.image,
-                    VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
-                    VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+            // in beginRendering's attachment order
+            m_colorAttachmentFormats = {
+                    gAlbedo.imageFormat,
+                    gNormal.imageFormat,
+                    gORMA.imageFormat,
+                    gEmissive.imageFormat,
+            };
         }
     }// namespace Pipeline
 }// namespace moe
\ No newline at end of file
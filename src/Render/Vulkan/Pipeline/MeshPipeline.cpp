@@ -57,7 +57,7 @@ namespace moe {
                 builder.disableMultisampling();
             }
 
-            m_pipeline = builder.build(engine.m_device);
+            m_pipeline = builder.build(engine.m_device, &engine.m_pipelineCache);
 
             vkDestroyShaderModule(engine.m_device, vert, nullptr);
             vkDestroyShaderModule(engine.m_device, frag, nullptr);
@@ -123,7 +123,7 @@ namespace moe {
                         sizeof(PushConstants),
                         &pushConstants);
 
-                vkCmdDrawIndexed(cmdBuffer, meshAsset.gpuBuffer.indexCount, 1, 0, 0, 0);
+                vkCmdDrawIndexed(cmdBuffer, meshAsset.gpuBuffer.indexCount, 1, meshAsset.gpuBuffer.firstIndex, 0, 0);
             }
         }
 
@@ -55,7 +55,7 @@ namespace moe {
                 builder.disableMultisampling();
             }
 
-            m_pipeline = builder.build(engine.m_device);
+            m_pipeline = builder.build(engine.m_device, &engine.m_pipelineCache);
 
             vkDestroyShaderModule(engine.m_device, vert, nullptr);
             vkDestroyShaderModule(engine.m_device, frag, nullptr);
@@ -151,7 +151,7 @@ namespace moe {
             builder.setColorAttachmentFormat(engine.m_swapchainImageFormat);
             builder.disableMultisampling();
 
-            m_pipeline = builder.build(engine.m_device);
+            m_pipeline = builder.build(engine.m_device, &engine.m_pipelineCache);
 
             vkDestroyShaderModule(engine.m_device, vert, nullptr);
             vkDestroyShaderModule(engine.m_device, frag, nullptr);
@@ -246,7 +246,7 @@ namespace moe {
             builder.setColorAttachmentFormat(engine.m_drawImageFormat);
             builder.disableMultisampling();
 
-            m_pipeline = builder.build(engine.m_device);
+            m_pipeline = builder.build(engine.m_device, &engine.m_pipelineCache);
 
             vkDestroyShaderModule(engine.m_device, vert, nullptr);
             vkDestroyShaderModule(engine.m_device, frag, nullptr);
@@ -348,7 +348,7 @@ namespace moe {
             builder.setColorAttachmentFormat(engine.m_drawImageFormat);
             builder.disableMultisampling();
 
-            m_pipeline = builder.build(engine.m_device);
+            m_pipeline = builder.build(engine.m_device, &engine.m_pipelineCache);
 
             vkDestroyShaderModule(engine.m_device, vert, nullptr);
             vkDestroyShaderModule(engine.m_device, frag, nullptr);
@@ -49,9 +49,9 @@ namespace moe {
             builder.disableBlending();
             builder.enableDepthTesting(true, VK_COMPARE_OP_LESS);
             builder.setDepthFormat(VK_FORMAT_D32_SFLOAT);
-            builder.build(engine.m_device);
+            builder.build(engine.m_device, &engine.m_pipelineCache);
 
-            m_pipeline = builder.build(engine.m_device);
+            m_pipeline = builder.build(engine.m_device, &engine.m_pipelineCache);
 
             auto shadowMapImageInfo =
                     VkInit::imageCreateInfo(
@@ -148,7 +148,7 @@ namespace moe {
                 };
 
                 vkCmdPushConstants(cmdBuffer, m_pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(PushConstants), &pushConstants);
-                vkCmdDrawIndexed(cmdBuffer, mesh.gpuBuffer.indexCount, 1, 0, 0, 0);
+                vkCmdDrawIndexed(cmdBuffer, mesh.gpuBuffer.indexCount, 1, mesh.gpuBuffer.firstIndex, 0, 0);
             }
 
 
@@ -30,7 +30,7 @@ namespace moe {
 
             auto builder = VulkanComputePipelineBuilder{m_pipelineLayout};
             builder.setShader(shader);
-            m_pipeline = builder.build(m_engine->m_device);
+            m_pipeline = builder.build(m_engine->m_device, &m_engine->m_pipelineCache);
 
             vkDestroyShaderModule(engine.m_device, shader, nullptr);
 
@@ -96,15 +96,13 @@ namespace moe {
             return before;
         }
 
-        void SkinningPipeline::compute(
-                VkCommandBuffer cmdBuffer,
-                VulkanMeshCache& meshCache,
-                Span<VulkanRenderPacket> drawCommands,
-                size_t frameIndex) {
+        void SkinningPipeline::prepare(VulkanMeshCache& meshCache, Span<VulkanRenderPacket> drawCommands, size_t frameIndex) {
             MOE_ASSERT(m_initialized, "SkinningPipeline is not initialized");
+            MOE_ASSERT(frameIndex < FRAMES_IN_FLIGHT, "Invalid frame index");
 
             auto& swapData = m_swapData[frameIndex];
-            vkCmdBindPipeline(cmdBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipeline);
+            swapData.dynamicVertexBuffer.size = 0;
+            swapData.dispatches.clear();
 
             VkDeviceSize requiredDynamicVertexBufferSize = 0;
             // required size
@@ -153,11 +151,24 @@ namespace moe {
                         .vertexCount = mesh.gpuBuffer.vertexCount,
                 };
 
-                vkCmdPushConstants(cmdBuffer, m_pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(PushConstants), &pushConstants);
-
                 constexpr uint32_t workGroupSize = 128;
                 const auto groupCount = (uint32_t) std::ceil(mesh.gpuBuffer.vertexCount / (float) workGroupSize);
-                vkCmdDispatch(cmdBuffer, groupCount, 1, 1);
+                swapData.dispatches.push_back(Dispatch{pushConstants, groupCount});
+            }
+        }
+
+        void SkinningPipeline::compute(VkCommandBuffer cmdBuffer, size_t frameIndex) {
+            MOE_ASSERT(m_initialized, "SkinningPipeline is not initialized");
+
+            auto& swapData = m_swapData[frameIndex];
+            if (swapData.dispatches.empty()) {
+                return;
+            }
+
+            vkCmdBindPipeline(cmdBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipeline);
+            for (auto& dispatch: swapData.dispatches) {
+                vkCmdPushConstants(cmdBuffer, m_pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(PushConstants), &dispatch.pushConstants);
+                vkCmdDispatch(cmdBuffer, dispatch.groupCount, 1, 1);
             }
         }
 
@@ -193,12 +204,5 @@ namespace moe {
 
             moe::Logger::info("Resized skinning dynamic vertex buffer to {} vertices, frame index {}", newCapacity, frameIndex);
         }
-
-        void SkinningPipeline::resetDynamicVertexBuffer(size_t frameIndex) {
-            MOE_ASSERT(m_initialized, "SkinningPipeline not initialized");
-
-            auto& swapData = m_swapData[frameIndex];
-            swapData.dynamicVertexBuffer.size = 0;
-        }
     }// namespace Pipeline
 }// namespace moe
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "Render/Vulkan/Pipeline/SpritePipeline.hpp"
+#include "Render/Vulkan/VulkanCommandRecorder.hpp"
 #include "Render/Vulkan/VulkanEngine.hpp"
 #include "Render/Vulkan/VulkanInitializers.hpp"
 #include "Render/Vulkan/VulkanPipeline.hpp"
@@ -51,7 +52,7 @@ namespace moe {
             builder.disableMultisampling();
             builder.disableDepthTesting();
 
-            m_pipeline = builder.build(engine.m_device);
+            m_pipeline = builder.build(engine.m_device, &engine.m_pipelineCache);
 
             vkDestroyShaderModule(engine.m_device, vert, nullptr);
             vkDestroyShaderModule(engine.m_device, frag, nullptr);
@@ -80,70 +81,97 @@ namespace moe {
             };
             auto renderInfo = VkInit::renderingInfo(extent, &colorAttachment, nullptr);
 
-            vkCmdBeginRendering(cmdBuffer, &renderInfo);
-            vkCmdBindPipeline(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipeline);
-
-            auto bindlessDescriptorSet = m_engine->getBindlessSet().getDescriptorSet();
-            vkCmdBindDescriptorSets(
-                    cmdBuffer,
-                    VK_PIPELINE_BIND_POINT_GRAPHICS,
-                    m_pipelineLayout,
-                    0, 1, &bindlessDescriptorSet,
-                    0, nullptr);
-
-            const auto viewport = VkViewport{
-                    .x = 0,
-                    .y = 0,
-                    .width = (float) extent.width,
-                    .height = (float) extent.height,
-                    .minDepth = 0.f,
-                    .maxDepth = 1.f,
-            };
-            vkCmdSetViewport(cmdBuffer, 0, 1, &viewport);
-
-            const auto scissor = VkRect2D{
-                    .offset = {},
-                    .extent = extent,
-            };
-            vkCmdSetScissor(cmdBuffer, 0, 1, &scissor);
-
-            for (auto& sprite: sprites) {
-                auto mesh = *meshCache.getMesh(meshCache.defaults.rectMeshId);
+            // only reads the sprites and the caches, so chunks can be recorded on any thread
+            auto recordSprites = [&](VkCommandBuffer cmd, VkParallel::ChunkRange range) {
+                vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipeline);
 
-                glm::vec2 texSize{1, 1};
-                if (sprite.textureId != NULL_IMAGE_ID) {
-                    auto tex = m_engine->m_caches.imageCache.getImage(sprite.textureId);
-                    MOE_ASSERT(tex.has_value(), "Invalid texture id");
+                auto bindlessDescriptorSet = m_engine->getBindlessSet().getDescriptorSet();
+                vkCmdBindDescriptorSets(
+                        cmd,
+                        VK_PIPELINE_BIND_POINT_GRAPHICS,
+                        m_pipelineLayout,
+                        0, 1, &bindlessDescriptorSet,
+                        0, nullptr);
+
+                const auto viewport = VkViewport{
+                        .x = 0,
+                        .y = 0,
+                        .width = (float) extent.width,
+                        .height = (float) extent.height,
+                        .minDepth = 0.f,
+                        .maxDepth = 1.f,
+                };
+                vkCmdSetViewport(cmd, 0, 1, &viewport);
 
-                    texSize.x = tex->imageExtent.width;
-                    texSize.y = tex->imageExtent.height;
+                const auto scissor = VkRect2D{
+                        .offset = {},
+                        .extent = extent,
+                };
+                vkCmdSetScissor(cmd, 0, 1, &scissor);
+
+                for (size_t i = range.begin; i < range.end; ++i) {
+                    auto& sprite = sprites[i];
+                    auto mesh = *meshCache.getMesh(meshCache.defaults.rectMeshId);
+
+                    glm::vec2 texSize{1, 1};
+                    if (sprite.textureId != NULL_IMAGE_ID) {
+                        auto tex = m_engine->m_caches.imageCache.getImage(sprite.textureId);
+                        MOE_ASSERT(tex.has_value(), "Invalid texture id");
+
+                        texSize.x = tex->imageExtent.width;
+                        texSize.y = tex->imageExtent.height;
+                    }
+
+                    PushConstants pushConstantsTransform{
+                            .transform = viewProj * sprite.transform.getMatrix(),
+
+                            .color = sprite.color.toVec4(),
+                            .spriteSize = sprite.size,
+                            .texRegionOffset = sprite.texOffset,
+                            .texRegionSize = sprite.texSize,
+                            .textureSize = texSize,
+                            .textureId = sprite.textureId,
+                            .isTextSprite = sprite.isTextSprite,
+                    };
+
+                    vkCmdPushConstants(
+                            cmd,
+                            m_pipelineLayout,
+                            VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
+                            0,
+                            sizeof(PushConstants),
+                            &pushConstantsTransform);
+
+                    vkCmdBindIndexBuffer(cmd, mesh.gpuBuffer.indexBuffer.buffer, 0, VK_INDEX_TYPE_UINT32);
+                    vkCmdDrawIndexed(cmd, mesh.gpuBuffer.indexCount, 1, mesh.gpuBuffer.firstIndex, 0, 0);
                 }
+            };
 
-                PushConstants pushConstantsTransform{
-                        .transform = viewProj * sprite.transform.getMatrix(),
-
-                        .color = sprite.color.toVec4(),
-                        .spriteSize = sprite.size,
-                        .texRegionOffset = sprite.texOffset,
-                        .texRegionSize = sprite.texSize,
-                        .textureSize = texSize,
-                        .textureId = sprite.textureId,
-                        .isTextSprite = sprite.isTextSprite,
+            auto& recorder = m_engine->m_commandRecorder;
+            auto chunks = VkParallel::chunkCount(sprites.size(), VulkanCommandRecorder::MIN_DRAWS_PER_CHUNK, recorder.getSlotLimit());
+            if (m_parallelRecording && chunks > 1) {
+                const auto inheritanceInfo = VkCommandBufferInheritanceRenderingInfo{
+                        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO,
+                        .colorAttachmentCount = 1,
+                        .pColorAttachmentFormats = &renderTarget.imageFormat,
+                        .rasterizationSamples = VK_SAMPLE_COUNT_1_BIT,
                 };
-
-                vkCmdPushConstants(
-                        cmdBuffer,
-                        m_pipelineLayout,
-                        VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
-                        0,
-                        sizeof(PushConstants),
-                        &pushConstantsTransform);
-
-                vkCmdBindIndexBuffer(cmdBuffer, mesh.gpuBuffer.indexBuffer.buffer, 0, VK_INDEX_TYPE_UINT32);
-                vkCmdDrawIndexed(cmdBuffer, mesh.gpuBuffer.indexCount, 1, 0, 0, 0);
+                // sprites blend in submission order, contiguous chunks executed in order keep it
+                auto buffers = recorder.record(
+                        inheritanceInfo, chunks,
+                        [&](VkCommandBuffer cmd, uint32_t chunk) {
+                            recordSprites(cmd, VkParallel::chunkRange(sprites.size(), chunks, chunk));
+                        });
+
+                renderInfo.flags = VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT;
+                vkCmdBeginRendering(cmdBuffer, &renderInfo);
+                vkCmdExecuteCommands(cmdBuffer, static_cast<uint32_t>(buffers.size()), buffers.data());
+                vkCmdEndRendering(cmdBuffer);
+            } else {
+                vkCmdBeginRendering(cmdBuffer, &renderInfo);
+                recordSprites(cmdBuffer, {0, sprites.size()});
+                vkCmdEndRendering(cmdBuffer);
             }
-
-            vkCmdEndRendering(cmdBuffer);
         }
 
         void SpritePipeline::destroy() {
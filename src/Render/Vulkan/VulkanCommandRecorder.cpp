@@ -0,0 +1,112 @@
+#include "Render/Vulkan/VulkanCommandRecorder.hpp"
+#include "Core/Task/ParallelFor.hpp"
+#include "Render/Vulkan/VulkanEngine.hpp"
+#include "Render/Vulkan/VulkanInitializers.hpp"
+
+#include <chrono>
+
+namespace moe {
+    void VulkanCommandRecorder::init(VulkanEngine& engine, uint32_t queueFamilyIndex, uint32_t slotCount) {
+        MOE_ASSERT(!m_initialized, "VulkanCommandRecorder already initialized");
+        MOE_ASSERT(slotCount > 0, "At least the calling thread's slot is needed");
+
+        m_engine = &engine;
+
+        // transient, buffers are recorded once and the pools are only reset whole, never buffer by buffer
+        auto createInfo = VkInit::commandPoolCreateInfo(queueFamilyIndex, VK_COMMAND_POOL_CREATE_TRANSIENT_BIT);
+        for (auto& slots: m_frames) {
+            slots.resize(slotCount);
+            for (auto& slot: slots) {
+                MOE_VK_CHECK_MSG(
+                        vkCreateCommandPool(engine.m_device, &createInfo, nullptr, &slot.pool),
+                        "Failed to create command pool");
+            }
+        }
+        m_slotLimit = slotCount;
+
+        m_initialized = true;
+    }
+
+    void VulkanCommandRecorder::destroy() {
+        MOE_ASSERT(m_initialized, "VulkanCommandRecorder not initialized");
+
+        // destroying a pool frees its buffers
+        for (auto& slots: m_frames) {
+            for (auto& slot: slots) {
+                vkDestroyCommandPool(m_engine->m_device, slot.pool, nullptr);
+            }
+            slots.clear();
+        }
+        m_recorded.clear();
+
+        m_engine = nullptr;
+        m_initialized = false;
+    }
+
+    void VulkanCommandRecorder::beginFrame(size_t frameIndex) {
+        MOE_ASSERT(m_initialized, "VulkanCommandRecorder not initialized");
+        MOE_ASSERT(frameIndex < Constants::FRAMES_IN_FLIGHT, "Invalid frame index");
+
+        m_frameIndex = frameIndex;
+        for (auto& slot: m_frames[frameIndex]) {
+            if (slot.used > 0) {
+                MOE_VK_CHECK(vkResetCommandPool(m_engine->m_device, slot.pool, 0));
+                slot.used = 0;
+            }
+        }
+        m_stats = {};
+    }
+
+    Span<const VkCommandBuffer> VulkanCommandRecorder::record(
+            const VkCommandBufferInheritanceRenderingInfo& renderingInfo,
+            uint32_t chunks,
+            const Function<void(VkCommandBuffer, uint32_t)>& fn) {
+        MOE_ASSERT(m_initialized, "VulkanCommandRecorder not initialized");
+
+        auto recordStart = std::chrono::steady_clock::now();
+
+        auto& slots = m_frames[m_frameIndex];
+        m_recorded.resize(chunks);
+
+        // every chunk writes its own entry of m_recorded, slots are never shared between threads
+        parallelFor(
+                ThreadPoolScheduler::getInstance(), m_slotLimit, chunks,
+                [&](uint32_t slot, uint32_t chunk) {
+                    auto cmdBuffer = acquire(slots[slot]);
+
+                    const auto inheritanceInfo = VkCommandBufferInheritanceInfo{
+                            .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO,
+                            .pNext = &renderingInfo,
+                    };
+                    auto beginInfo = VkInit::commandBufferBeginInfo(
+                            VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT);
+                    beginInfo.pInheritanceInfo = &inheritanceInfo;
+                    MOE_VK_CHECK(vkBeginCommandBuffer(cmdBuffer, &beginInfo));
+
+                    fn(cmdBuffer, chunk);
+
+                    MOE_VK_CHECK(vkEndCommandBuffer(cmdBuffer));
+                    m_recorded[chunk] = cmdBuffer;
+                });
+
+        ++m_stats.passes;
+        m_stats.secondaryBuffers += chunks;
+        m_stats.recordUs += std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - recordStart).count();
+
+        return m_recorded;
+    }
+
+    VkCommandBuffer VulkanCommandRecorder::acquire(SlotPool& slot) {
+        if (slot.used == slot.buffers.size()) {
+            auto allocInfo = VkInit::commandBufferAllocateInfo(slot.pool);
+            allocInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+
+            VkCommandBuffer cmdBuffer;
+            MOE_VK_CHECK_MSG(
+                    vkAllocateCommandBuffers(m_engine->m_device, &allocInfo, &cmdBuffer),
+                    "Failed to allocate secondary command buffer");
+            slot.buffers.push_back(cmdBuffer);
+        }
+        return slot.buffers[slot.used++];
+    }
+}// namespace moe
\ No newline at end of file
@@ -0,0 +1,165 @@
+#include "Render/Vulkan/VulkanCulling.hpp"
+
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MOE_CULLING_USE_SSE
+#include <emmintrin.h>
+#endif
+
+namespace moe {
+    namespace {
+        // padding boxes are pushed past every plane, -UNBOUNDED_EXTENT * (|nx| + |ny| + |nz|) is at most -UNBOUNDED_EXTENT
+        constexpr float PADDING_EXTENT = -VulkanBounds::UNBOUNDED_EXTENT;
+
+        glm::vec4 normalizePlane(const glm::vec4& plane) {
+            float length = glm::length(glm::vec3(plane));
+            return length > 0.0f ? plane / length : plane;
+        }
+
+        // planes with their normals' absolute values next to them, the form the box test wants
+        struct CullPlanes {
+            float nx[6], ny[6], nz[6], w[6];
+            float ax[6], ay[6], az[6];
+
+            explicit CullPlanes(const VulkanFrustum& frustum) {
+                for (size_t i = 0; i < 6; ++i) {
+                    const auto& plane = frustum.planes[i];
+                    nx[i] = plane.x;
+                    ny[i] = plane.y;
+                    nz[i] = plane.z;
+                    w[i] = plane.w;
+                    ax[i] = std::abs(plane.x);
+                    ay[i] = std::abs(plane.y);
+                    az[i] = std::abs(plane.z);
+                }
+            }
+        };
+    }// namespace
+
+    VulkanFrustum VulkanFrustum::fromViewProjection(const glm::mat4& viewProjection) {
+        // glm is column major, row i is (m[0][i], m[1][i], m[2][i], m[3][i])
+        auto row = [&](int i) {
+            return glm::vec4(viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i]);
+        };
+        auto r0 = row(0);
+        auto r1 = row(1);
+        auto r2 = row(2);
+        auto r3 = row(3);
+
+        VulkanFrustum frustum;
+        frustum.planes[0] = normalizePlane(r3 + r0);// left
+        frustum.planes[1] = normalizePlane(r3 - r0);// right
+        frustum.planes[2] = normalizePlane(r3 + r1);// bottom, or top with a flipped y
+        frustum.planes[3] = normalizePlane(r3 - r1);
+        frustum.planes[4] = normalizePlane(r2);     // near, depth is 0..1
+        frustum.planes[5] = normalizePlane(r3 - r2);// far
+        return frustum;
+    }
+
+    bool VulkanFrustum::intersects(const VulkanBounds& bounds) const {
+        for (const auto& plane: planes) {
+            glm::vec3 normal{plane};
+            float distance = glm::dot(normal, bounds.center) + plane.w;
+            float radius = glm::dot(glm::abs(normal), bounds.extent);
+            if (distance + radius < 0.0f) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void VulkanCullingBatch::clear() {
+        m_centerX.clear();
+        m_centerY.clear();
+        m_centerZ.clear();
+        m_extentX.clear();
+        m_extentY.clear();
+        m_extentZ.clear();
+        m_size = 0;
+    }
+
+    void VulkanCullingBatch::reserve(size_t count) {
+        auto padded = (count + LANES - 1) / LANES * LANES;
+        m_centerX.reserve(padded);
+        m_centerY.reserve(padded);
+        m_centerZ.reserve(padded);
+        m_extentX.reserve(padded);
+        m_extentY.reserve(padded);
+        m_extentZ.reserve(padded);
+    }
+
+    void VulkanCullingBatch::push(const VulkanBounds& bounds) {
+        if (m_size == m_centerX.size()) {
+            auto padded = m_size + LANES;
+            m_centerX.resize(padded, 0.0f);
+            m_centerY.resize(padded, 0.0f);
+            m_centerZ.resize(padded, 0.0f);
+            m_extentX.resize(padded, PADDING_EXTENT);
+            m_extentY.resize(padded, PADDING_EXTENT);
+            m_extentZ.resize(padded, PADDING_EXTENT);
+        }
+
+        m_centerX[m_size] = bounds.center.x;
+        m_centerY[m_size] = bounds.center.y;
+        m_centerZ[m_size] = bounds.center.z;
+        m_extentX[m_size] = bounds.extent.x;
+        m_extentY[m_size] = bounds.extent.y;
+        m_extentZ[m_size] = bounds.extent.z;
+        ++m_size;
+    }
+
+    void VulkanCullingBatch::cull(const VulkanFrustum& frustum, Vector<uint32_t>& outVisible) const {
+        const CullPlanes planes{frustum};
+        const size_t count = m_centerX.size();
+
+#ifdef MOE_CULLING_USE_SSE
+        const __m128 zero = _mm_setzero_ps();
+        for (size_t i = 0; i < count; i += LANES) {
+            const __m128 cx = _mm_loadu_ps(&m_centerX[i]);
+            const __m128 cy = _mm_loadu_ps(&m_centerY[i]);
+            const __m128 cz = _mm_loadu_ps(&m_centerZ[i]);
+            const __m128 ex = _mm_loadu_ps(&m_extentX[i]);
+            const __m128 ey = _mm_loadu_ps(&m_extentY[i]);
+            const __m128 ez = _mm_loadu_ps(&m_extentZ[i]);
+
+            int mask = 0xF;
+            for (size_t p = 0; p < 6 && mask != 0; ++p) {
+                // signed distance of the center plus the box's projected radius onto the normal
+                __m128 d = _mm_add_ps(
+                        _mm_add_ps(_mm_mul_ps(cx, _mm_set1_ps(planes.nx[p])), _mm_mul_ps(cy, _mm_set1_ps(planes.ny[p]))),
+                        _mm_add_ps(_mm_mul_ps(cz, _mm_set1_ps(planes.nz[p])), _mm_set1_ps(planes.w[p])));
+                __m128 r = _mm_add_ps(
+                        _mm_add_ps(_mm_mul_ps(ex, _mm_set1_ps(planes.ax[p])), _mm_mul_ps(ey, _mm_set1_ps(planes.ay[p]))),
+                        _mm_mul_ps(ez, _mm_set1_ps(planes.az[p])));
+                mask &= _mm_movemask_ps(_mm_cmpge_ps(_mm_add_ps(d, r), zero));
+            }
+
+            for (size_t lane = 0; mask != 0; ++lane, mask >>= 1) {
+                if (mask & 1) {
+                    outVisible.push_back(static_cast<uint32_t>(i + lane));
+                }
+            }
+        }
+#else
+        for (size_t i = 0; i < count; i += LANES) {
+            bool visible[LANES] = {true, true, true, true};
+            for (size_t p = 0; p < 6; ++p) {
+                for (size_t lane = 0; lane < LANES; ++lane) {
+                    float d = m_centerX[i + lane] * planes.nx[p] + m_centerY[i + lane] * planes.ny[p]
+                              + m_centerZ[i + lane] * planes.nz[p] + planes.w[p];
+                    float r = m_extentX[i + lane] * planes.ax[p] + m_extentY[i + lane] * planes.ay[p]
+                              + m_extentZ[i + lane] * planes.az[p];
+                    visible[lane] = visible[lane] && d + r >= 0.0f;
+                }
+            }
+
+            for (size_t lane = 0; lane < LANES; ++lane) {
+                if (visible[lane]) {
+                    outVisible.push_back(static_cast<uint32_t>(i + lane));
+                }
+            }
+        }
+#endif
+    }
+}// namespace moe
\ No newline at end of file
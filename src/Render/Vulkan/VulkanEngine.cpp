@@ -12,8 +12,11 @@
 #include "Render/Vulkan/VolkImpl.hpp"
 
 #include "Core/FileReader.hpp"
+#include "Core/Profiler.hpp"
+#include "Core/Task/Scheduler.hpp"
 
 #include <chrono>
+#include <numeric>
 #include <thread>
 
 #include "imgui.h"
@@ -54,6 +57,8 @@ namespace moe {
                 static_cast<uint32_t>(initializers.viewportHeight),
         };
 
+        m_useTransferQueue = initializers.useTransferQueue;
+
         m_defaultSpriteCamera = makePinned<Vulkan2DCamera>(
                 glm::vec2(0.0f, 0.0f),
                 initializers.viewportWidth,
@@ -73,6 +78,7 @@ namespace moe {
 
     void VulkanEngine::init(const VulkanEngineInitializers& initializers) {
         MOE_ASSERT(g_engineInstance == nullptr, "engine instance already initialized");
+        MOE_MEMORY_TAG(Render);
 
         g_engineInstance = this;
 
@@ -84,16 +90,24 @@ namespace moe {
         initSwapchain();
         initCommands();
         initSyncPrimitives();
+        initUploadService();
         initDescriptors();
 
         initBindlessSet();
         initCaches();
 
+        initPipelineCache();
+        initFrameGraph();
         initPipelines();
 
         initImGUI();
         initIm3d();
 
+        auto& pipelineCacheStats = m_pipelineCache.getStats();
+        Logger::info("Created {} pipelines in {:.1f} ms, pipeline cache {} ({} KB loaded)",
+                     pipelineCacheStats.pipelines, pipelineCacheStats.createMs,
+                     pipelineCacheStats.warm ? "warm" : "cold", pipelineCacheStats.loadedBytes / 1024);
+
         m_isInitialized = true;
     }
 
@@ -152,7 +166,9 @@ namespace moe {
         }
     }
 
-    void VulkanEngine::beginFrame() {
+    void VulkanEngine::beginFrame(bool render) {
+        m_skipRenderThisFrame = !render;
+
         glfwPollEvents();
 
         std::pair<uint32_t, uint32_t> newMetric;
@@ -191,7 +207,7 @@ namespace moe {
     }
 
     void VulkanEngine::endFrame() {
-        if (m_stopRendering) {
+        if (!isRenderingFrame()) {
             return;
         }
 
@@ -340,47 +356,15 @@ namespace moe {
 
     VulkanAllocatedImage VulkanEngine::allocateImage(void* data, VkExtent3D extent, VkFormat format, VkImageUsageFlags usage, bool mipmap) {
         size_t imageSize = extent.width * extent.height * extent.depth * VkUtils::getChannelsFromFormat(format);
-        VulkanAllocatedBuffer stagingBuffer = allocateBuffer(imageSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_MEMORY_USAGE_CPU_TO_GPU);
-        std::memcpy(stagingBuffer.vmaAllocationInfo.pMappedData, data, imageSize);
 
         VulkanAllocatedImage image = allocateImage(
                 extent, format,
                 usage | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
                 mipmap);
-        immediateSubmit([&](VkCommandBuffer cmd) {
-            VkUtils::transitionImage(
-                    cmd, image.image,
-                    VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
-
-            VkBufferImageCopy copyRegion{};
-            copyRegion.bufferOffset = 0;
-            copyRegion.bufferRowLength = 0;
-            copyRegion.bufferImageHeight = 0;
-
-            copyRegion.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-            copyRegion.imageSubresource.mipLevel = 0;
-            copyRegion.imageSubresource.baseArrayLayer = 0;
-            copyRegion.imageSubresource.layerCount = 1;
-            copyRegion.imageExtent = extent;
-
-            vkCmdCopyBufferToImage(
-                    cmd,
-                    stagingBuffer.buffer,
-                    image.image,
-                    VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                    1,
-                    &copyRegion);
-            if (mipmap) {
-                VkUtils::generateMipmaps(cmd, image.image, VkExtent2D{extent.width, extent.height});
-            } else {
-                VkUtils::transitionImage(
-                        cmd, image.image,
-                        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                        VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-            }
-        });
 
-        destroyBuffer(stagingBuffer);
+        // frames wait for the copy on the gpu, the image can be bound right away
+        Array<void*, 1> layers{data};
+        m_uploadService.uploadImage(image, layers, imageSize, mipmap);
 
         return image;
     }
@@ -424,52 +408,13 @@ namespace moe {
 
     VulkanAllocatedImage VulkanEngine::allocateCubeMapImage(Array<void*, 6> data, VkExtent3D extent, VkFormat format, VkImageUsageFlags usage, bool mipmap) {
         size_t imageSize = extent.width * extent.height * extent.depth * VkUtils::getChannelsFromFormat(format);
-        VulkanAllocatedBuffer stagingBuffer = allocateBuffer(imageSize * 6, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_MEMORY_USAGE_CPU_TO_GPU);
-        MOE_ASSERT(stagingBuffer.vmaAllocationInfo.pMappedData != nullptr, "Failed to map staging buffer");
-        for (size_t i = 0; i < 6; ++i) {
-            std::memcpy(static_cast<uint8_t*>(stagingBuffer.vmaAllocationInfo.pMappedData) + imageSize * i, data[i], imageSize);
-        }
 
         VulkanAllocatedImage image = allocateCubeMapImage(
                 extent, format,
                 usage | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
                 mipmap);
-        immediateSubmit([&](VkCommandBuffer cmd) {
-            VkUtils::transitionImage(
-                    cmd, image.image,
-                    VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
-
-            Array<VkBufferImageCopy, 6> copyRegions{};
-            for (uint32_t i = 0; i < 6; ++i) {
-                copyRegions[i].bufferOffset = imageSize * i;
-                copyRegions[i].bufferRowLength = 0;
-                copyRegions[i].bufferImageHeight = 0;
-
-                copyRegions[i].imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-                copyRegions[i].imageSubresource.mipLevel = 0;
-                copyRegions[i].imageSubresource.baseArrayLayer = i;
-                copyRegions[i].imageSubresource.layerCount = 1;
-                copyRegions[i].imageExtent = extent;
-            }
-
-            vkCmdCopyBufferToImage(
-                    cmd,
-                    stagingBuffer.buffer,
-                    image.image,
-                    VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                    static_cast<uint32_t>(copyRegions.size()),
-                    copyRegions.data());
-            if (mipmap) {
-                VkUtils::generateMipmaps(cmd, image.image, VkExtent2D{extent.width, extent.height});
-            } else {
-                VkUtils::transitionImage(
-                        cmd, image.image,
-                        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                        VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-            }
-        });
 
-        destroyBuffer(stagingBuffer);
+        m_uploadService.uploadImage(image, data, imageSize, mipmap);
 
         return image;
     }
@@ -528,134 +473,31 @@ namespace moe {
         vmaDestroyBuffer(m_allocator, buffer.buffer, buffer.vmaAllocation);
     }
 
-    VulkanGPUMeshBuffer VulkanEngine::uploadMesh(Span<uint32_t> indices, Span<Vertex> vertices, Span<SkinningData> skinningData) {
-        const size_t vertBufferSize = vertices.size() * sizeof(Vertex);
-        const size_t indexBufferSize = indices.size() * sizeof(uint32_t);
-        const size_t skinningDataBufferSize = skinningData.size() * sizeof(SkinningData);
-
-        VulkanGPUMeshBuffer surface;
-        surface.indexCount = static_cast<uint32_t>(indices.size());
-        surface.vertexCount = static_cast<uint32_t>(vertices.size());
-
-        surface.vertexBuffer = allocateBuffer(
-                vertBufferSize,
-                VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
-                        VK_BUFFER_USAGE_TRANSFER_DST_BIT |
-                        VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
-                VMA_MEMORY_USAGE_GPU_ONLY);
-
-        {
-            VkBufferDeviceAddressInfo deviceAddrInfo{};
-            deviceAddrInfo.sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO;
-            deviceAddrInfo.buffer = surface.vertexBuffer.buffer;
-
-            surface.vertexBufferAddr = vkGetBufferDeviceAddress(m_device, &deviceAddrInfo);
-        }
-
-        surface.indexBuffer = allocateBuffer(
-                indexBufferSize,
-                VK_BUFFER_USAGE_INDEX_BUFFER_BIT |
-                        VK_BUFFER_USAGE_TRANSFER_DST_BIT,
-                VMA_MEMORY_USAGE_GPU_ONLY);
-
-        bool hasSkinningData = !skinningData.empty();
-        surface.hasSkinningData = hasSkinningData;
-
-        size_t stagingBufferSize = 0;
-
-        if (hasSkinningData) {
-            Logger::info("Mesh has skinning data, size {} bytes", skinningDataBufferSize);
-
-            // no need to initialize skinned vertex buffer here, will be done in skinning pipeline
-            stagingBufferSize = indexBufferSize + vertBufferSize + skinningDataBufferSize;
-
-            surface.skinningDataBuffer = allocateBuffer(
-                    skinningDataBufferSize,
-                    VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
-                            VK_BUFFER_USAGE_TRANSFER_DST_BIT |
-                            VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
-                    VMA_MEMORY_USAGE_GPU_ONLY);
-            {
-                VkBufferDeviceAddressInfo deviceAddrInfo{};
-                deviceAddrInfo.sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO;
-                deviceAddrInfo.buffer = surface.skinningDataBuffer.buffer;
-                surface.skinningDataBufferAddr = vkGetBufferDeviceAddress(m_device, &deviceAddrInfo);
-            }
-        } else {
-            stagingBufferSize = indexBufferSize + vertBufferSize;
-
-            surface.skinningDataBuffer = {};
-            surface.skinningDataBufferAddr = 0;
-        }
-
-        VulkanAllocatedBuffer stagingBuffer = allocateBuffer(
-                stagingBufferSize,
-                VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                VMA_MEMORY_USAGE_CPU_ONLY);
-
-        void* data = stagingBuffer.vmaAllocationInfo.pMappedData;
-
-        std::memcpy(data, vertices.data(), vertBufferSize);
-        std::memcpy(static_cast<uint8_t*>(data) + vertBufferSize,
-                    indices.data(), indexBufferSize);
-
-        if (hasSkinningData) {
-            std::memcpy(static_cast<uint8_t*>(data) + vertBufferSize + indexBufferSize,
-                        skinningData.data(), skinningDataBufferSize);
-        }
-
-        immediateSubmit([&, hasSkinningData](VkCommandBuffer cmdBuffer) {
-            VkBufferCopy vertCopy{};
-            vertCopy.srcOffset = 0;
-            vertCopy.dstOffset = 0;
-            vertCopy.size = vertBufferSize;
-
-            vkCmdCopyBuffer(cmdBuffer,
-                            stagingBuffer.buffer, surface.vertexBuffer.buffer,
-                            1, &vertCopy);
-
-            VkBufferCopy indexCopy{};
-            indexCopy.srcOffset = vertBufferSize;
-            indexCopy.dstOffset = 0;
-            indexCopy.size = indexBufferSize;
-
-            vkCmdCopyBuffer(cmdBuffer,
-                            stagingBuffer.buffer, surface.indexBuffer.buffer,
-                            1, &indexCopy);
-
-            if (hasSkinningData) {
-                VkBufferCopy skinningCopy{};
-                skinningCopy.srcOffset = vertBufferSize + indexBufferSize;
-                skinningCopy.dstOffset = 0;
-                skinningCopy.size = skinningDataBufferSize;
-
-                vkCmdCopyBuffer(cmdBuffer,
-                                stagingBuffer.buffer, surface.skinningDataBuffer.buffer,
-                                1, &skinningCopy);
-            }
-        });
-
-        destroyBuffer(stagingBuffer);
-
-        return surface;
-    }
-
     void VulkanEngine::draw() {
+        MOE_PROFILE_FUNCTION();
+        MOE_MEMORY_TAG(Render);
+
         auto& currentFrame = getCurrentFrame();
         auto currentFrameIndex = getCurrentFrameIndex();
 
-        MOE_VK_CHECK_MSG(
-                vkWaitForFences(
-                        m_device,
-                        1, &currentFrame.inFlightFence,
-                        VK_TRUE,
-                        VkUtils::secsToNanoSecs(1.0f)),
-                "Failed to wait for fence");
+        {
+            MOE_PROFILE_SCOPE("Wait for in-flight fence");
+            MOE_VK_CHECK_MSG(
+                    vkWaitForFences(
+                            m_device,
+                            1, &currentFrame.inFlightFence,
+                            VK_TRUE,
+                            VkUtils::secsToNanoSecs(1.0f)),
+                    "Failed to wait for fence");
+        }
 
         currentFrame.deletionQueue.flush();
 
         currentFrame.descriptorAllocator.clearPools(m_device);
 
+        // the frame's secondaries were last executed by the submission its fence tracks
+        m_commandRecorder.beginFrame(currentFrameIndex);
+
         MOE_VK_CHECK_MSG(
                 vkResetFences(m_device, 1, &currentFrame.inFlightFence),
                 "Failed to reset fence");
@@ -687,6 +529,10 @@ namespace moe {
 
         MOE_VK_CHECK(vkBeginCommandBuffer(commandBuffer, &beginInfo));
 
+        // everything uploaded since the last frame goes out in one submission, the frame waits for it on the gpu
+        m_uploadService.flush();
+        m_uploadService.recordAcquires(commandBuffer);
+
         // ! begin skinning. as we need to upload joint matrices from cpu to gpu, we do it first.
         m_pipelines.skinningPipeline.beginFrame(currentFrameIndex);
 
@@ -694,39 +540,42 @@ namespace moe {
         ComputeSkinHandleId handleIdCounter = 0;
         ComputeSkinHandleId maxHandleId = m_renderBus.getNumComputeSkinCommands();
 
-        for (auto& command: computeSkinCommands) {
-            MOE_ASSERT(handleIdCounter < maxHandleId, "Compute skin command handle id out of range");
-            auto handleId = handleIdCounter++;
-
-            // initialize with invalid index
-            m_renderBus.setComputeSkinMatrix(handleId, INVALID_JOINT_MATRIX_START_INDEX);
-
-            auto renderable = m_caches.objectCache.get(command.renderableId);
-            if (!renderable.has_value()) {
-                Logger::warn("Renderable with id {} not found in cache", command.renderableId);
-                continue;
-            }
+        {
+            MOE_PROFILE_SCOPE("Joint matrices");
+            for (auto& command: computeSkinCommands) {
+                MOE_ASSERT(handleIdCounter < maxHandleId, "Compute skin command handle id out of range");
+                auto handleId = handleIdCounter++;
+
+                // initialize with invalid index
+                m_renderBus.setComputeSkinMatrix(handleId, INVALID_JOINT_MATRIX_START_INDEX);
+
+                auto renderable = m_caches.objectCache.get(command.renderableId);
+                if (!renderable.has_value()) {
+                    Logger::warn("Renderable with id {} not found in cache", command.renderableId);
+                    continue;
+                }
 
-            auto animation = m_caches.animationCache.get(command.animationId);
-            if (!animation.has_value()) {
-                Logger::warn("Animation with id {} not found in cache", command.animationId);
-                continue;
-            }
+                auto animation = m_caches.animationCache.get(command.animationId);
+                if (!animation.has_value()) {
+                    Logger::warn("Animation with id {} not found in cache", command.animationId);
+                    continue;
+                }
 
-            if (!renderable->get()->hasFeature<VulkanRenderableFeature::HasSkeletalAnimation>()) {
-                Logger::warn("Renderable with id {} does not have skeletal animation feature", command.renderableId);
-                continue;
-            }
+                if (!renderable->get()->hasFeature<VulkanRenderableFeature::HasSkeletalAnimation>()) {
+                    Logger::warn("Renderable with id {} does not have skeletal animation feature", command.renderableId);
+                    continue;
+                }
 
-            auto* skeletal = renderable->get()->as<VulkanSkeletalAnimation>();
-            // ! fixme: only support one skeleton for now
-            auto& skeleton = skeletal->getSkeletons()[0];
+                auto* skeletal = renderable->get()->as<VulkanSkeletalAnimation>();
+                // ! fixme: only support one skeleton for now
+                auto& skeleton = skeletal->getSkeletons()[0];
 
-            Vector<glm::mat4> jointMatrices;
-            calculateJointMatrices(jointMatrices, skeleton, *animation.value(), command.time);
-            auto offset = m_pipelines.skinningPipeline.appendJointMatrices(jointMatrices, currentFrameIndex);
+                Vector<glm::mat4> jointMatrices;
+                calculateJointMatrices(jointMatrices, skeleton, *animation.value(), command.time);
+                auto offset = m_pipelines.skinningPipeline.appendJointMatrices(jointMatrices, currentFrameIndex);
 
-            m_renderBus.setComputeSkinMatrix(handleId, offset);
+                m_renderBus.setComputeSkinMatrix(handleId, offset);
+            }
         }
 
         // ! load scene render packets
@@ -739,13 +588,11 @@ namespace moe {
         auto& renderView2d = *m_caches.renderViewCache.get(m_defaultSpriteRenderViewId).value();
 
         auto drawImageId = renderView.drawImageId;
-        auto depthImageId = renderView.depthImageId;
         auto resolveImageId = renderView.msaaResolveImageId;
 
         auto drawImage2dId = renderView2d.drawImageId;
 
         auto drawImage = *m_caches.imageCache.getImage(drawImageId);
-        auto depthImage = *m_caches.imageCache.getImage(depthImageId);
         VulkanAllocatedImage resolveImage;
         if (resolveImageId != NULL_IMAGE_ID) {
             resolveImage = *m_caches.imageCache.getImage(resolveImageId);
@@ -763,86 +610,117 @@ namespace moe {
                          packets.size(), MAX_EXPECTED_RENDER_PACKETS);
         }
 
-        for (auto& renderCommands: m_renderBus.getRenderCommands()) {
-            auto id = renderCommands.renderableId;
-            if (auto renderable = m_caches.objectCache.get(id)) {
-                // todo: upload skeleton matrices if present, and set the values in render packets
-                size_t offset = INVALID_JOINT_MATRIX_START_INDEX;
-                if (renderCommands.computeHandle != NULL_COMPUTE_SKIN_HANDLE_ID) {
-                    offset = m_renderBus.getComputeSkinMatrix(renderCommands.computeHandle);
+        {
+            MOE_PROFILE_SCOPE("Gather render packets");
+            for (auto& renderCommands: m_renderBus.getRenderCommands()) {
+                auto id = renderCommands.renderableId;
+                if (auto renderable = m_caches.objectCache.get(id)) {
+                    // todo: upload skeleton matrices if present, and set the values in render packets
+                    size_t offset = INVALID_JOINT_MATRIX_START_INDEX;
+                    if (renderCommands.computeHandle != NULL_COMPUTE_SKIN_HANDLE_ID) {
+                        offset = m_renderBus.getComputeSkinMatrix(renderCommands.computeHandle);
+                    }
+                    VulkanDrawContext ctx = NULL_DRAW_CONTEXT;
+                    ctx.jointMatrixStartIndex = offset;
+                    renderable->get()->updateTransform(renderCommands.transform.getMatrix());
+                    renderable->get()->gatherRenderPackets(packets, ctx);
+                } else {
+                    Logger::warn("Renderable with id {} not found in cache", id);
+                    continue;
                 }
-                VulkanDrawContext ctx = NULL_DRAW_CONTEXT;
-                ctx.jointMatrixStartIndex = offset;
-                renderable->get()->updateTransform(renderCommands.transform.getMatrix());
-                renderable->get()->gatherRenderPackets(packets, ctx);
-            } else {
-                Logger::warn("Renderable with id {} not found in cache", id);
-                continue;
             }
         }
 
-        // ! compute
+        // ! skinning
+        // output ranges are assigned on the cpu first, every pass reading the skinned addresses is declared before any is recorded
+        m_pipelines.skinningPipeline.prepare(m_caches.meshCache, packets, currentFrameIndex);
 
-        {
-            // barrier previous read - compute
-            const auto barrier = VkMemoryBarrier2{
-                    .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
-                    .srcStageMask = VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT,
-                    .srcAccessMask = VK_ACCESS_2_SHADER_READ_BIT,
-                    .dstStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
-                    .dstAccessMask = VK_ACCESS_2_MEMORY_WRITE_BIT,
-            };
-            const auto dependencyInfo = VkDependencyInfo{
-                    .sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
-                    .memoryBarrierCount = 1,
-                    .pMemoryBarriers = &barrier,
-            };
-            vkCmdPipelineBarrier2(commandBuffer, &dependencyInfo);
-        }
+        auto& defaultCamera = getDefaultCamera();
 
-        // reset dynamic vertex buffer for skinning pipeline
-        m_pipelines.skinningPipeline.resetDynamicVertexBuffer(currentFrameIndex);
+        auto cameraView = defaultCamera.viewMatrix();
+        auto cameraProjection = defaultCamera.projectionMatrix((float) m_drawExtent.width / (float) m_drawExtent.height);
+        //cameraProjection[1][1] *= -1;
+        auto cameraViewProjection = cameraProjection * cameraView;
 
-        // record compute commands
-        m_pipelines.skinningPipeline.compute(commandBuffer, m_caches.meshCache, packets, currentFrameIndex);
+        auto& visibleIndices = renderTarget.visibleIndices;
+        auto& visiblePackets = renderTarget.visiblePackets;
+        float cameraSortUs = 0.0f;
+        if (!m_enableGpuDriven) {
+            // ! frustum culling
+            // after skinning, which fills in the packets' skinned vertex addresses
+            {
+                MOE_PROFILE_SCOPE("Frustum culling");
+                if (m_enableFrustumCulling) {
+                    auto& cullingBatch = renderTarget.cullingBatch;
+                    cullingBatch.reserve(packets.size());
+                    for (auto& packet: packets) {
+                        cullingBatch.push(packet.bounds);
+                    }
 
-        {
-            // barrier compute - csm shadow
-            const auto barrier = VkMemoryBarrier2{
-                    .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
-                    .srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
-                    .srcAccessMask = VK_ACCESS_2_SHADER_WRITE_BIT,
-                    .dstStageMask = VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT,
-                    .dstAccessMask = VK_ACCESS_2_MEMORY_READ_BIT,
-            };
-            const auto dependencyInfo = VkDependencyInfo{
-                    .sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
-                    .memoryBarrierCount = 1,
-                    .pMemoryBarriers = &barrier,
-            };
-            vkCmdPipelineBarrier2(commandBuffer, &dependencyInfo);
-        }
+                    cullingBatch.cull(VulkanFrustum::fromViewProjection(cameraViewProjection), visibleIndices);
+                } else {
+                    visibleIndices.resize(packets.size());
+                    std::iota(visibleIndices.begin(), visibleIndices.end(), 0u);
+                }
+            }
 
-        auto& defaultCamera = getDefaultCamera();
+            // ! sort
+            if (m_enableDrawSorting) {
+                MOE_PROFILE_SCOPE("Sort render packets");
+                auto sortStart = std::chrono::steady_clock::now();
+
+                auto& sortKeys = renderTarget.sortKeys;
+                for (auto index: visibleIndices) {
+                    auto& packet = packets[index];
+                    auto depth = VkSortKey::quantizeDepth(cameraViewProjection, packet.getSortPosition());
+                    sortKeys.push_back(VkSortKey::opaque(packet.sortKey, depth));
+                }
+                renderTarget.drawSorter.sort(sortKeys, visibleIndices);
+
+                cameraSortUs = std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - sortStart).count();
+            }
+
+            visiblePackets.reserve(visibleIndices.size());
+            for (auto index: visibleIndices) {
+                visiblePackets.push_back(packets[index]);
+            }
+        }
 
         // ! illumination information upload
         m_illuminationBus.uploadToGPU(commandBuffer, currentFrameIndex);
 
-        // ! shadow
+        // ! shadow cascades
+        // fitted up front, the scene data and the gpu culling both need the light transforms before any pass is recorded
         m_pipelines.csmPipeline.setShadowMapCameraScale(m_shadowMapCameraScale);
-        m_pipelines.csmPipeline.draw(
-                commandBuffer,
-                m_caches.meshCache,
-                packets,
-                defaultCamera,
-                m_illuminationBus.getSunlight().direction);
+        m_pipelines.csmPipeline.setDrawSortingEnabled(m_enableDrawSorting);
+        m_pipelines.csmPipeline.setInstancingEnabled(m_enableInstancing);
+        m_pipelines.csmPipeline.setParallelRecordingEnabled(m_enableParallelRecording);
+        m_pipelines.gBufferPipeline.setParallelRecordingEnabled(m_enableParallelRecording);
+        m_pipelines.spritePipeline.setParallelRecordingEnabled(m_enableParallelRecording);
+        m_pipelines.csmPipeline.updateCascades(defaultCamera, m_illuminationBus.getSunlight().direction);
+
+        m_drawStats = {};
+        m_drawStats.packets = static_cast<uint32_t>(packets.size());
+        m_drawStats.gpuDriven = m_enableGpuDriven;
+
+        auto& cullingPipeline = m_pipelines.cullingPipeline;
+        Array<glm::mat4, Pipeline::CullingPipeline::VIEW_COUNT> viewProjections;
+        Array<VulkanIndirectView, Pipeline::CSMPipeline::SHADOW_CASCADE_COUNT> cascadeViews;
+        if (m_enableGpuDriven) {
+            {
+                MOE_PROFILE_SCOPE("Prepare gpu culling");
+                cullingPipeline.prepare(m_caches.meshCache, packets, currentFrameIndex);
+            }
+
+            viewProjections[0] = cameraViewProjection;
+            for (uint32_t i = 0; i < Pipeline::CSMPipeline::SHADOW_CASCADE_COUNT; ++i) {
+                viewProjections[1 + i] = m_pipelines.csmPipeline.m_cascadeLightTransforms[i];
+                cascadeViews[i] = cullingPipeline.getView(1 + i);
+            }
+        }
 
         // ! initialize scene data
 
-        auto cameraView = defaultCamera.viewMatrix();
-        auto cameraProjection = defaultCamera.projectionMatrix((float) m_drawExtent.width / (float) m_drawExtent.height);
-        //cameraProjection[1][1] *= -1;
-        auto cameraViewProjection = cameraProjection * cameraView;
         auto cameraPosition = glm::vec4(defaultCamera.getPosition(), 1.0f);
         VulkanGPUSceneData sceneData{
                 .view = cameraView,
@@ -874,86 +752,8 @@ namespace moe {
 
         m_pipelines.sceneDataBuffer.upload(commandBuffer, &sceneData, currentFrameIndex, sizeof(VulkanGPUSceneData));
 
-        // ! begin of main render pass
-
-        //! fixme: general image layout is not an optimal choice.
-        VkUtils::transitionImage(
-                commandBuffer, drawImage.image,
-                VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL);
-
-        VkUtils::transitionImage(
-                commandBuffer, depthImage.image,
-                VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_DEPTH_ATTACHMENT_OPTIMAL);
-
-        if (isMultisamplingEnabled()) {
-            VkUtils::transitionImage(
-                    commandBuffer, resolveImage.image,
-                    VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL);
-        }
-
-        // todo: sync with last read
-        m_pipelines.gBufferPipeline.draw(
-                commandBuffer,
-                m_caches.meshCache, m_caches.materialCache,
-                packets, m_pipelines.sceneDataBuffer.getBuffer());
-
-        auto clearColor = renderView.clearColor;
-        VkClearValue clearValue = {
-                .color = {
-                        clearColor.r,
-                        clearColor.g,
-                        clearColor.b,
-                        clearColor.a,
-                },
-        };
-        //VkClearValue depthClearValue = {.depthStencil = {1.0f, 0}};
-        auto colorAttachment = VkInit::renderingAttachmentInfo(drawImage.imageView, &clearValue, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
-        if (isMultisamplingEnabled()) {
-            colorAttachment.resolveImageView = resolveImage.imageView;
-            colorAttachment.resolveMode = VK_RESOLVE_MODE_AVERAGE_BIT;
-            colorAttachment.resolveImageLayout = VK_IMAGE_LAYOUT_GENERAL;// ! msaa x4
-            // resolve msaa x4 image -> 1 sample resolved image
-        }
-
-        //auto depthAttachment = VkInit::renderingAttachmentInfo(m_depthImage.imageView, &depthClearValue, VK_IMAGE_LAYOUT_DEPTH_ATTACHMENT_OPTIMAL);
-        auto renderInfo = VkInit::renderingInfo(m_drawExtent, &colorAttachment, nullptr);
-        vkCmdBeginRendering(commandBuffer, &renderInfo);
-
-        /*m_pipelines.meshPipeline.draw(
-                commandBuffer,
-                m_caches.meshCache,
-                m_caches.materialCache,
-                packets,
-                m_pipelines.sceneDataBuffer);
-
-        m_pipelines.skyBoxPipeline.draw(commandBuffer, getDefaultCamera());*/
-
-        m_pipelines.deferredLightingPipeline.draw(
-                commandBuffer,
-                m_pipelines.sceneDataBuffer.getBuffer(),
-                m_pipelines.gBufferPipeline.gDepthId,
-                m_pipelines.gBufferPipeline.gAlbedoId,
-                m_pipelines.gBufferPipeline.gNormalId,
-                m_pipelines.gBufferPipeline.gORMAId,
-                m_pipelines.gBufferPipeline.gEmissiveId);
-
-
-        vkCmdEndRendering(commandBuffer);
-
         // ! im3d
-        // im3d pipeline requires the draw image to be in color attachment optimal layout
-        VkUtils::transitionImage(
-                commandBuffer,
-                drawImage.image,
-                VK_IMAGE_LAYOUT_GENERAL,
-                VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
-
-        // barrier previous write
-        VkUtils::transitionImage(
-                commandBuffer,
-                m_pipelines.gBufferPipeline.gDepth.image,
-                VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-                VK_IMAGE_LAYOUT_DEPTH_ATTACHMENT_OPTIMAL);
+        // the draw queue is consumed every frame, whether or not the pass is recorded
 
         // acquire input state
         VulkanIm3dDriver::MouseState mouseState{};
@@ -980,81 +780,225 @@ namespace moe {
 
         m_im3dDriver.endFrame();
 
-        m_im3dDriver.render(
-                commandBuffer,
-                &defaultCamera,
-                drawImage.imageView,
-                m_pipelines.gBufferPipeline.gDepth.imageView,// requires depth info
-                m_drawExtent);
-
-        // ! sprites
-
-        // ! fixme: the sprite layer should not use fxaa
-
-        // barrier prev write
-        VkUtils::transitionImage(
-                commandBuffer,
-                drawImage.image,
-                VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
-                VK_IMAGE_LAYOUT_GENERAL);
-
-        VkUtils::transitionImage(
-                commandBuffer,
-                drawImage2d.image,
-                VK_IMAGE_LAYOUT_UNDEFINED,
-                VK_IMAGE_LAYOUT_GENERAL);
-
-        auto& sprites = m_renderBus.getSpriteRenderCommands();
-        m_pipelines.spritePipeline.draw(
-                commandBuffer,
-                m_caches.meshCache,
-                sprites,
-                m_defaultSpriteCamera->getViewProjectionMatrix(),
-                drawImage2d);
-
-        // ! post fx
+        // ! frame graph
+        // every pass declares what it reads and writes, the graph culls what nothing uses and places the barriers
+
+        auto& gBufferPipeline = m_pipelines.gBufferPipeline;
+        auto shadowMapImage = *m_caches.imageCache.getImage(m_pipelines.csmPipeline.getShadowMapImageId());
+        auto swapchainImage = VulkanAllocatedImage{
+                .image = m_swapchainImages[swapchainImageIndex],
+                .imageView = m_swapchainImageViews[swapchainImageIndex],
+                .vmaAllocation = VK_NULL_HANDLE,
+                .imageExtent = {m_swapchainExtent.width, m_swapchainExtent.height, 1},
+                .imageFormat = m_swapchainImageFormat,
+        };
 
-        m_pipelines.postFxGraph.copyToInput(commandBuffer, "#input", drawImage, VK_IMAGE_LAYOUT_GENERAL);
-        m_pipelines.postFxGraph.copyToInput(commandBuffer, "#input_2d", drawImage2d, VK_IMAGE_LAYOUT_GENERAL);
-        m_pipelines.postFxGraph.exec(commandBuffer);
-        m_pipelines.postFxGraph.copyFromOutput(commandBuffer, drawImage, VK_IMAGE_LAYOUT_GENERAL);
+        auto& graph = m_frameGraph;
+        graph.beginFrame();
+
+        auto skinnedVertices = graph.importBuffer("skinned_vertices", m_pipelines.skinningPipeline.getOutputBuffer(currentFrameIndex));
+        auto shadowMap = graph.importImage("shadow_map", shadowMapImage.image, VK_IMAGE_ASPECT_DEPTH_BIT);
+        auto gDepth = graph.importImage("g_depth", gBufferPipeline.gDepth.image, VK_IMAGE_ASPECT_DEPTH_BIT);
+        auto gAlbedo = graph.importImage("g_albedo", gBufferPipeline.gAlbedo.image);
+        auto gNormal = graph.importImage("g_normal", gBufferPipeline.gNormal.image);
+        auto gORMA = graph.importImage("g_orma", gBufferPipeline.gORMA.image);
+        auto gEmissive = graph.importImage("g_emissive", gBufferPipeline.gEmissive.image);
+        auto color = graph.importImage("draw", drawImage.image);
+        auto color2d = graph.importImage("draw_2d", drawImage2d.image);
+        // the submission waits on the acquire semaphore at color attachment output
+        auto swapchain = graph.importAcquiredImage("swapchain", swapchainImage.image, VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT);
+
+        graph.addPass("skinning", [&](VkCommandBuffer cmd) {
+                 m_pipelines.skinningPipeline.compute(cmd, currentFrameIndex);
+             })
+                .write(skinnedVertices, VulkanRGAccess::StorageWriteCompute);
+
+        auto cullOutput = cullingPipeline.getOutputBuffers();
+        auto indirectCommands = graph.importBuffer("indirect_commands", cullOutput.commands);
+        auto indirectCounts = graph.importBuffer("indirect_counts", cullOutput.counts);
+        auto instances = graph.importBuffer("instances", cullOutput.instances);
+        // the indirect draws read what the culling dispatch wrote
+        auto readIndirect = [&](VulkanRenderGraph::PassBuilder& pass) {
+            if (m_enableGpuDriven) {
+                pass.read(indirectCommands, VulkanRGAccess::IndirectRead)
+                        .read(indirectCounts, VulkanRGAccess::IndirectRead)
+                        .read(instances, VulkanRGAccess::StorageReadVertex);
+            }
+        };
 
-        VkUtils::transitionImage(
-                commandBuffer, drawImage.image,
-                VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+        if (m_enableGpuDriven) {
+            graph.addPass("gpu_culling", [&](VkCommandBuffer cmd) {
+                     cullingPipeline.cull(cmd, viewProjections, currentFrameIndex);
+                 })
+                    .write(indirectCommands, VulkanRGAccess::StorageWriteCompute)
+                    .write(indirectCounts, VulkanRGAccess::StorageWriteCompute)
+                    .write(instances, VulkanRGAccess::StorageWriteCompute);
+        }
 
-        VkUtils::transitionImage(
-                commandBuffer, m_swapchainImages[swapchainImageIndex],
-                VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+        auto shadowPass = graph.addPass("shadows", [&](VkCommandBuffer cmd) {
+            if (m_enableGpuDriven) {
+                m_pipelines.csmPipeline.drawIndirect(cmd, m_caches.meshCache, cascadeViews);
+            } else {
+                m_pipelines.csmPipeline.draw(
+                        cmd,
+                        m_caches.meshCache,
+                        packets,
+                        renderTarget.cullingBatch,
+                        defaultCamera,
+                        m_illuminationBus.getSunlight().direction,
+                        currentFrameIndex);
+            }
+        });
+        shadowPass.read(skinnedVertices, VulkanRGAccess::StorageReadVertex)
+                .write(shadowMap, VulkanRGAccess::DepthAttachment);
+        readIndirect(shadowPass);
+
+        auto gBufferPass = graph.addPass("gbuffer", [&](VkCommandBuffer cmd) {
+            if (m_enableGpuDriven) {
+                gBufferPipeline.drawIndirect(
+                        cmd,
+                        m_caches.meshCache,
+                        cullingPipeline.getView(0),
+                        m_pipelines.sceneDataBuffer.getBuffer());
+            } else {
+                gBufferPipeline.setInstancingEnabled(m_enableInstancing);
+                gBufferPipeline.draw(
+                        cmd,
+                        m_caches.meshCache, m_caches.materialCache,
+                        visiblePackets, m_pipelines.sceneDataBuffer.getBuffer(),
+                        currentFrameIndex);
+            }
+        });
+        gBufferPass.read(skinnedVertices, VulkanRGAccess::StorageReadVertex)
+                .write(gDepth, VulkanRGAccess::DepthAttachment)
+                .write(gAlbedo, VulkanRGAccess::ColorAttachment)
+                .write(gNormal, VulkanRGAccess::ColorAttachment)
+                .write(gORMA, VulkanRGAccess::ColorAttachment)
+                .write(gEmissive, VulkanRGAccess::ColorAttachment);
+        readIndirect(gBufferPass);
+
+        auto lightingPass = graph.addPass("lighting", [&](VkCommandBuffer cmd) {
+            auto clearColor = renderView.clearColor;
+            VkClearValue clearValue = {
+                    .color = {
+                            clearColor.r,
+                            clearColor.g,
+                            clearColor.b,
+                            clearColor.a,
+                    },
+            };
+            auto colorAttachment = VkInit::renderingAttachmentInfo(drawImage.imageView, &clearValue, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+            if (isMultisamplingEnabled()) {
+                colorAttachment.resolveImageView = resolveImage.imageView;
+                colorAttachment.resolveMode = VK_RESOLVE_MODE_AVERAGE_BIT;
+                colorAttachment.resolveImageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;// ! msaa x4
+                // resolve msaa x4 image -> 1 sample resolved image
+            }
 
-        VkUtils::copyImage(
-                commandBuffer, drawImage.image, m_swapchainImages[swapchainImageIndex],
-                VkExtent2D{drawImage.imageExtent.width, drawImage.imageExtent.height},
-                VkExtent2D{m_swapchainExtent.width, m_swapchainExtent.height});
+            auto renderInfo = VkInit::renderingInfo(m_drawExtent, &colorAttachment, nullptr);
+            vkCmdBeginRendering(cmd, &renderInfo);
 
-        VkUtils::transitionImage(
-                commandBuffer, m_swapchainImages[swapchainImageIndex],
-                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+            m_pipelines.deferredLightingPipeline.draw(
+                    cmd,
+                    m_pipelines.sceneDataBuffer.getBuffer(),
+                    gBufferPipeline.gDepthId,
+                    gBufferPipeline.gAlbedoId,
+                    gBufferPipeline.gNormalId,
+                    gBufferPipeline.gORMAId,
+                    gBufferPipeline.gEmissiveId);
+
+            vkCmdEndRendering(cmd);
+        });
+        lightingPass.read(gDepth, VulkanRGAccess::SampledFragment)
+                .read(gAlbedo, VulkanRGAccess::SampledFragment)
+                .read(gNormal, VulkanRGAccess::SampledFragment)
+                .read(gORMA, VulkanRGAccess::SampledFragment)
+                .read(gEmissive, VulkanRGAccess::SampledFragment)
+                .write(color, VulkanRGAccess::ColorAttachment);
+        if (isMultisamplingEnabled()) {
+            lightingPass.write(graph.importImage("draw_resolve", resolveImage.image), VulkanRGAccess::ColorAttachment);
+        }
+        // only the sun casts shadows, without it nothing samples the shadow map and the shadow pass is culled
+        if (m_illuminationBus.hasSunlight()) {
+            lightingPass.read(shadowMap, VulkanRGAccess::SampledFragment);
+        }
 
-        drawImGUI(commandBuffer, m_swapchainImageViews[swapchainImageIndex]);
+        graph.addPass("im3d", [&](VkCommandBuffer cmd) {
+                 m_im3dDriver.render(
+                         cmd,
+                         &defaultCamera,
+                         drawImage.imageView,
+                         gBufferPipeline.gDepth.imageView,// requires depth info
+                         m_drawExtent);
+             })
+                .write(color, VulkanRGAccess::ColorAttachment)
+                .write(gDepth, VulkanRGAccess::DepthAttachment);
 
-        VkUtils::transitionImage(
-                commandBuffer, m_swapchainImages[swapchainImageIndex],
-                VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR);
+        // ! fixme: the sprite layer should not use fxaa
+        auto& sprites = m_renderBus.getSpriteRenderCommands();
+        graph.addPass("sprites", [&](VkCommandBuffer cmd) {
+                 m_pipelines.spritePipeline.draw(
+                         cmd,
+                         m_caches.meshCache,
+                         sprites,
+                         m_defaultSpriteCamera->getViewProjectionMatrix(),
+                         drawImage2d);
+             })
+                .write(color2d, VulkanRGAccess::ColorAttachment);
+
+        // the post fx output is blitted straight into the swapchain image
+        graph.addPass("post_fx", [&](VkCommandBuffer cmd) {
+                 m_pipelines.postFxGraph.copyToInput(cmd, "#input", drawImage, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+                 m_pipelines.postFxGraph.copyToInput(cmd, "#input_2d", drawImage2d, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+                 m_pipelines.postFxGraph.exec(cmd);
+                 m_pipelines.postFxGraph.copyFromOutput(cmd, swapchainImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+             })
+                .read(color, VulkanRGAccess::TransferSrc)
+                .read(color2d, VulkanRGAccess::TransferSrc)
+                .write(swapchain, VulkanRGAccess::TransferDst);
+
+        graph.addPass("imgui", [&](VkCommandBuffer cmd) {
+                 drawImGUI(cmd, swapchainImage.imageView);
+             })
+                .write(swapchain, VulkanRGAccess::ColorAttachment);
+
+        graph.addPass("present", nullptr)
+                .read(swapchain, VulkanRGAccess::Present)
+                .sideEffect();
+
+        graph.compile();
+        graph.execute(commandBuffer);
+
+        if (!m_enableGpuDriven) {
+            m_drawStats.cameraDraws = static_cast<uint32_t>(visiblePackets.size());
+            for (uint32_t i = 0; i < Pipeline::CSMPipeline::SHADOW_CASCADE_COUNT; ++i) {
+                m_drawStats.cascadeDraws[i] = m_pipelines.csmPipeline.getCascadeDrawCount(i);
+            }
+        }
+        // a culled shadow pass leaves the last recorded frame's stats behind
+        if (m_illuminationBus.hasSunlight()) {
+            m_drawStats.shadow = m_pipelines.csmPipeline.getLastStats();
+        }
+        m_drawStats.gBuffer = gBufferPipeline.getLastStats();
+        m_drawStats.gBuffer.sortUs = cameraSortUs;
 
         MOE_VK_CHECK(vkEndCommandBuffer(commandBuffer));
 
+        MOE_PROFILE_SCOPE("Submit and present");
         VkCommandBufferSubmitInfo submitInfo = VkInit::commandBufferSubmitInfo(commandBuffer);
-        VkSemaphoreSubmitInfo waitInfo =
+        Array<VkSemaphoreSubmitInfo, 2> waitInfos = {
                 VkInit::semaphoreSubmitInfo(
                         currentFrame.imageAvailableSemaphore,
-                        VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT_KHR);
+                        VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT_KHR),
+                m_uploadService.getWaitInfo(),
+        };
         VkSemaphoreSubmitInfo signalInfo =
                 VkInit::semaphoreSubmitInfo(
                         m_perSwapchainImageData[swapchainImageIndex].renderFinishedSemaphore,
                         VK_PIPELINE_STAGE_2_ALL_GRAPHICS_BIT);
 
-        VkSubmitInfo2 submitInfo2 = VkInit::submitInfo(&submitInfo, &waitInfo, &signalInfo);
+        VkSubmitInfo2 submitInfo2 = VkInit::submitInfo(&submitInfo, waitInfos.data(), &signalInfo);
+        submitInfo2.waitSemaphoreInfoCount = static_cast<uint32_t>(waitInfos.size());
         MOE_VK_CHECK(vkQueueSubmit2(m_graphicsQueue, 1, &submitInfo2, currentFrame.inFlightFence));
 
         VkPresentInfoKHR presentInfo{};
@@ -1304,26 +1248,59 @@ namespace moe {
                 .descriptorBindingVariableDescriptorCount = VK_TRUE,
                 .runtimeDescriptorArray = VK_TRUE,
                 .scalarBlockLayout = VK_TRUE,
+                // upload batches signal a timeline value that frames wait on
+                .timelineSemaphore = VK_TRUE,
                 .bufferDeviceAddress = VK_TRUE,
         };
 
-        vkb::PhysicalDeviceSelector physicalDeviceSelector{vkbInstance};
-        auto selectionResult =
-                physicalDeviceSelector.set_minimum_version(1, 3)
-                        .set_required_features(vkPhysicalDeviceFeatures)
-                        .set_required_features_12(vkPhysicalDeviceVulkan12Features)
-                        .set_required_features_13(vkPhysicalDeviceVulkan13Features)
-                        .add_required_extension("VK_EXT_descriptor_indexing")
-                        .add_required_extension("VK_KHR_shader_non_semantic_info")
-                        .prefer_gpu_device_type(vkb::PreferredDeviceType::discrete)
-                        .allow_any_gpu_device_type(true)
-                        .set_surface(m_surface)
-                        .select();
+        auto selectPhysicalDevice = [&]() {
+            vkb::PhysicalDeviceSelector physicalDeviceSelector{vkbInstance};
+            return physicalDeviceSelector.set_minimum_version(1, 3)
+                    .set_required_features(vkPhysicalDeviceFeatures)
+                    .set_required_features_12(vkPhysicalDeviceVulkan12Features)
+                    .set_required_features_13(vkPhysicalDeviceVulkan13Features)
+                    .add_required_extension("VK_EXT_descriptor_indexing")
+                    .add_required_extension("VK_KHR_shader_non_semantic_info")
+                    .prefer_gpu_device_type(vkb::PreferredDeviceType::discrete)
+                    .allow_any_gpu_device_type(true)
+                    .set_surface(m_surface)
+                    .select();
+        };
 
+        auto selectionResult = selectPhysicalDevice();
         if (!selectionResult) {
             MOE_LOG_AND_THROW("Failed to select a valid physical device with proper features.");
         }
 
+        // the gpu driven path is optional, its features are only requested where the device has them
+        {
+            VkPhysicalDeviceVulkan12Features supported12 = {
+                    .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES,
+            };
+            VkPhysicalDeviceFeatures2 supported = {
+                    .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2,
+                    .pNext = &supported12,
+            };
+            vkGetPhysicalDeviceFeatures2(selectionResult->physical_device, &supported);
+
+            // draws start at their group's instance range and skip groups culling emptied
+            m_supportsGpuDriven = supported.features.drawIndirectFirstInstance && supported12.drawIndirectCount;
+            if (m_supportsGpuDriven) {
+                vkPhysicalDeviceFeatures.drawIndirectFirstInstance = VK_TRUE;
+                vkPhysicalDeviceVulkan12Features.drawIndirectCount = VK_TRUE;
+                auto withGpuDriven = selectPhysicalDevice();
+                if (withGpuDriven) {
+                    selectionResult = withGpuDriven;
+                } else {
+                    m_supportsGpuDriven = false;
+                }
+            }
+            if (!m_supportsGpuDriven) {
+                Logger::warn("GPU lacks drawIndirectFirstInstance or drawIndirectCount, the GPU driven path is unavailable");
+                m_enableGpuDriven = false;
+            }
+        }
+
         auto vkbPhysicalDevice = *selectionResult;
         m_physicalDevice = vkbPhysicalDevice.physical_device;
 
@@ -1343,6 +1320,17 @@ namespace moe {
         m_graphicsQueue = deviceResult->get_queue(vkb::QueueType::graphics).value();
         m_graphicsQueueFamilyIndex = deviceResult->get_queue_index(vkb::QueueType::graphics).value();
 
+        // a family that only transfers copies next to rendering instead of in between
+        auto transferQueue = deviceResult->get_dedicated_queue(vkb::QueueType::transfer);
+        if (m_useTransferQueue && transferQueue.has_value()) {
+            m_transferQueue = transferQueue.value();
+            m_transferQueueFamilyIndex = deviceResult->get_dedicated_queue_index(vkb::QueueType::transfer).value();
+            Logger::info("Uploading on dedicated transfer queue family {}", m_transferQueueFamilyIndex);
+        } else {
+            m_transferQueue = m_graphicsQueue;
+            m_transferQueueFamilyIndex = m_graphicsQueueFamilyIndex;
+        }
+
         Logger::info("Creating VMA instance...");
         VmaAllocatorCreateInfo allocatorInfo{};
         allocatorInfo.physicalDevice = m_physicalDevice;
@@ -1404,6 +1392,7 @@ namespace moe {
         initInfo.Device = m_device;
         initInfo.Queue = m_graphicsQueue;
         initInfo.DescriptorPool = imguiPool;
+        initInfo.PipelineCache = m_pipelineCache.get();
         initInfo.MinImageCount = FRAMES_IN_FLIGHT;
         initInfo.ImageCount = FRAMES_IN_FLIGHT;
         initInfo.UseDynamicRendering = true;
@@ -1551,6 +1540,22 @@ namespace moe {
         m_mainDeletionQueue.pushFunction([=] {
             vkDestroyCommandPool(m_device, m_immediateModeCommandPool, nullptr);
         });
+
+        // one slot for the render thread and one for every worker
+        auto recordingSlots = static_cast<uint32_t>(ThreadPoolScheduler::getInstance().workerCount()) + 1;
+        m_commandRecorder.init(*this, m_graphicsQueueFamilyIndex, recordingSlots);
+
+        m_mainDeletionQueue.pushFunction([&] {
+            m_commandRecorder.destroy();
+        });
+    }
+
+    void VulkanEngine::initUploadService() {
+        m_uploadService.init(*this, m_transferQueue, m_transferQueueFamilyIndex);
+
+        m_mainDeletionQueue.pushFunction([&] {
+            m_uploadService.destroy();
+        });
     }
 
     void VulkanEngine::initSyncPrimitives() {
@@ -1594,6 +1599,34 @@ namespace moe {
         });
     }
 
+    void VulkanEngine::initPipelineCache() {
+        m_pipelineCache.init(m_device, m_physicalDevice);
+
+        // pushed before any pipeline, so it is saved once all of them, imgui's too, went through it
+        m_mainDeletionQueue.pushFunction([&] {
+            m_pipelineCache.destroy();
+        });
+    }
+
+    void VulkanEngine::initFrameGraph() {
+        m_frameGraph.init(
+                [this](const VulkanTransientImageDesc& desc) {
+                    return allocateImage(desc.extent, desc.format, desc.usage);
+                },
+                [this](const VulkanAllocatedImage& image) {
+                    // frames in flight may still use it, the frame's deletion queue runs once its fence is waited on
+                    getCurrentFrame().deletionQueue.pushFunction([this, image]() mutable {
+                        destroyImage(image);
+                    });
+                });
+
+        m_mainDeletionQueue.pushFunction([&] {
+            m_frameGraph.destroy();
+            // the frames' queues were flushed before this one, the device is idle by now
+            getCurrentFrame().deletionQueue.flush();
+        });
+    }
+
     void VulkanEngine::initDescriptors() {
         Vector<VulkanDescriptorAllocator::PoolSizeRatio> ratios = {
                 {VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 1},
@@ -1639,6 +1672,7 @@ namespace moe {
         m_resourceLoader.init(*this);
 
         m_pipelines.skinningPipeline.init(*this);
+        m_pipelines.cullingPipeline.init(*this);
         //m_pipelines.meshPipeline.init(*this);
         //m_pipelines.skyBoxPipeline.init(*this);
         //m_pipelines.shadowMapPipeline.init(*this);
@@ -1688,6 +1722,7 @@ namespace moe {
             //m_pipelines.shadowMapPipeline.destroy();
             //m_pipelines.skyBoxPipeline.destroy();
             //m_pipelines.meshPipeline.destroy();
+            m_pipelines.cullingPipeline.destroy();
             m_pipelines.skinningPipeline.destroy();
 
             m_renderBus.destroy();
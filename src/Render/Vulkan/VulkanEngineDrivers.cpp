@@ -8,11 +8,13 @@ namespace moe {
 
     RenderableId VulkanLoader::load(Loader::GltfT, StringView path) {
         MOE_ASSERT(m_engine, "VulkanLoader not initialized");
+        MOE_MEMORY_TAG(Render);
         return m_engine->m_caches.objectCache.load(m_engine, path, ObjectLoader::Gltf).first;
     }
 
     ImageId VulkanLoader::load(Loader::ImageT, StringView path) {
         MOE_ASSERT(m_engine, "VulkanLoader not initialized");
+        MOE_MEMORY_TAG(Render);
         return m_engine->m_caches.imageCache.loadImageFromFile(
                 path,
                 VK_FORMAT_R8G8B8A8_SRGB,
@@ -21,6 +23,7 @@ namespace moe {
 
     ImageId VulkanLoader::load(Loader::ImageT, Span<uint8_t> imageData, uint32_t width, uint32_t height) {
         MOE_ASSERT(m_engine, "VulkanLoader not initialized");
+        MOE_MEMORY_TAG(Render);
         return m_engine->m_caches.imageCache.loadImageFromMemory(
                 imageData,
                 VkExtent2D{
@@ -33,6 +36,7 @@ namespace moe {
 
     ImageId VulkanLoader::load(Loader::ImageT, const Image& image) {
         MOE_ASSERT(m_engine, "VulkanLoader not initialized");
+        MOE_MEMORY_TAG(Render);
         return m_engine->m_caches.imageCache.loadImageFromMemory(
                 Span<uint8_t>(
                         const_cast<uint8_t*>(image.data()),// whatever
@@ -47,6 +51,7 @@ namespace moe {
 
     FontId VulkanLoader::load(Loader::FontT, StringView path, float fontSize, StringView glyphRange) {
         MOE_ASSERT(m_engine, "VulkanLoader not initialized");
+        MOE_MEMORY_TAG(Font);
         size_t outDataSize;
         auto fontData = FileReader::s_instance->readFile(path, outDataSize);
         if (!fontData) {
@@ -62,6 +67,7 @@ namespace moe {
 
     FontId VulkanLoader::load(Loader::FontT, Span<const uint8_t> fontData, float fontSize, StringView glyphRange) {
         MOE_ASSERT(m_engine, "VulkanLoader not initialized");
+        MOE_MEMORY_TAG(Font);
 
         VulkanFont font;
         font.init(*m_engine, {const_cast<uint8_t*>(fontData.data()), fontData.size()}, fontSize, glyphRange);
@@ -121,7 +127,9 @@ namespace moe {
         // sunlight + static lights + dynamic lights
         allLights.reserve(staticLights.size() + dynamicLights.size() + 1);
 
-        allLights.push_back(sunLight.toGPU());
+        if (hasSunlight()) {
+            allLights.push_back(sunLight.toGPU());
+        }
         for (const auto& light: staticLights) {
             allLights.push_back(light.toGPU());
         }
@@ -134,6 +142,11 @@ namespace moe {
             allLights.resize(BUS_LIGHT_WARNING_LIMIT);
         }
 
+        // without a sun a scene may have no lights at all, and an empty copy is invalid
+        if (allLights.empty()) {
+            return;
+        }
+
         lightBuffer.upload(cmdBuffer, allLights.data(), frameIndex, sizeof(VulkanGPULight) * allLights.size());
     }
 
@@ -176,6 +176,8 @@ namespace moe {
     }
 
     bool VulkanFont::ensureSize(float fontSize, StringView glyphRanges) {
+        MOE_MEMORY_TAG(Font);
+
         uint32_t key = faceKey(fontSize);
         if (m_faces.find(key) != m_faces.end()) return true;
 
@@ -230,6 +232,8 @@ namespace moe {
     }
 
     bool VulkanFont::lazyLoadCharacters(float fontSize) {
+        MOE_MEMORY_TAG(Font);
+
         uint32_t key = faceKey(fontSize);
         auto it = m_faces.find(key);
         if (it == m_faces.end()) return true;
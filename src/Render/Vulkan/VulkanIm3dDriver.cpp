@@ -127,7 +127,7 @@ namespace moe {
                 info.customizeBuilderFn(&builder);
             }
 
-            *info.outPipeline = builder.build(engine.m_device);
+            *info.outPipeline = builder.build(engine.m_device, &engine.m_pipelineCache);
 
             vkDestroyShaderModule(engine.m_device, vert, nullptr);
             vkDestroyShaderModule(engine.m_device, frag, nullptr);
@@ -229,7 +229,7 @@ namespace moe {
                 VkInit::renderingAttachmentInfo(
                         depthImageView,
                         nullptr,
-                        VK_IMAGE_LAYOUT_DEPTH_ATTACHMENT_OPTIMAL);
+                        VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL);
         auto renderInfo =
                 VkInit::renderingInfo(
                         extent,
@@ -20,8 +20,10 @@ namespace moe {
     Optional<VulkanAllocatedImage> VulkanImageCache::getImage(ImageId id) {
         MOE_ASSERT(m_initialized, "VulkanImageCache not initialized");
 
-        if (m_images.find(id) != m_images.end()) {
-            return m_images[id];
+        // a lookup only, sprites are recorded on worker threads
+        auto it = m_images.find(id);
+        if (it != m_images.end()) {
+            return it->second;
         }
 
         Logger::warn("ImageId {} not found in image cache", id);
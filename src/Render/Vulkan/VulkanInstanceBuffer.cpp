@@ -0,0 +1,60 @@
+#include "Render/Vulkan/VulkanInstanceBuffer.hpp"
+#include "Render/Vulkan/VulkanEngine.hpp"
+
+namespace moe {
+    void VulkanInstanceBuffer::init(VulkanEngine& engine, size_t initialCapacity) {
+        MOE_ASSERT(!m_initialized, "VulkanInstanceBuffer already initialized");
+        MOE_ASSERT(initialCapacity > 0, "Initial capacity must be greater than 0");
+
+        m_engine = &engine;
+        m_initialized = true;
+
+        for (size_t i = 0; i < Constants::FRAMES_IN_FLIGHT; ++i) {
+            allocate(initialCapacity, i);
+        }
+    }
+
+    void VulkanInstanceBuffer::destroy() {
+        MOE_ASSERT(m_initialized, "VulkanInstanceBuffer not initialized");
+
+        for (auto& swapData: m_swapData) {
+            m_engine->destroyBuffer(swapData.buffer);
+            swapData.capacity = 0;
+        }
+
+        m_engine = nullptr;
+        m_initialized = false;
+    }
+
+    VkDeviceAddress VulkanInstanceBuffer::upload(const Vector<VulkanInstanceData>& instances, size_t frameIndex) {
+        MOE_ASSERT(m_initialized, "VulkanInstanceBuffer not initialized");
+        MOE_ASSERT(frameIndex < Constants::FRAMES_IN_FLIGHT, "Invalid frame index");
+
+        auto& swapData = m_swapData[frameIndex];
+        if (instances.size() > swapData.capacity) {
+            size_t capacity = swapData.capacity;
+            while (capacity < instances.size()) {
+                capacity *= GROWTH_FACTOR;
+            }
+
+            m_engine->destroyBuffer(swapData.buffer);
+            allocate(capacity, frameIndex);
+        }
+
+        std::memcpy(
+                swapData.buffer.vmaAllocationInfo.pMappedData,
+                instances.data(),
+                instances.size() * sizeof(VulkanInstanceData));
+
+        return swapData.buffer.address;
+    }
+
+    void VulkanInstanceBuffer::allocate(size_t capacity, size_t frameIndex) {
+        auto& swapData = m_swapData[frameIndex];
+        swapData.buffer = m_engine->allocateBuffer(
+                capacity * sizeof(VulkanInstanceData),
+                VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+                VMA_MEMORY_USAGE_AUTO);
+        swapData.capacity = capacity;
+    }
+}// namespace moe
\ No newline at end of file
@@ -0,0 +1,96 @@
+#include "Render/Vulkan/VulkanInstancing.hpp"
+
+namespace moe {
+    void VulkanInstanceBatcher::push(const VulkanRenderPacket& packet, Grouping grouping, Vector<VulkanInstancedDraw>& draws) {
+        auto instanceIndex = static_cast<uint32_t>(m_instances.size());
+
+        m_instances.push_back(VulkanInstanceData::fromTransform(packet.transform, m_normalMatrices));
+
+        if (!draws.empty() && !packet.skinned && grouping != Grouping::None) {
+            auto& last = draws.back();
+            bool joins = !last.skinned
+                         && last.meshId == packet.meshId
+                         && (grouping == Grouping::Mesh || last.materialId == packet.materialId)
+                         && last.firstInstance + last.instanceCount == instanceIndex;
+            if (joins) {
+                ++last.instanceCount;
+                return;
+            }
+        }
+
+        draws.push_back(VulkanInstancedDraw{
+                .meshId = packet.meshId,
+                .materialId = packet.materialId,
+                .firstInstance = instanceIndex,
+                .instanceCount = 1,
+                .skinned = packet.skinned,
+                .skinnedVertexBufferAddr = packet.skinnedVertexBufferAddr,
+        });
+    }
+
+    namespace {
+        // finds the packet's group or opens a new one, skinned packets always open their own
+        uint32_t findOrAddGroup(
+                const VulkanRenderPacket& packet,
+                uint64_t key,
+                UnorderedMap<uint64_t, uint32_t>& lookup,
+                Vector<VulkanInstancedDraw>& groups) {
+            if (!packet.skinned) {
+                auto it = lookup.find(key);
+                if (it != lookup.end()) {
+                    ++groups[it->second].instanceCount;
+                    return it->second;
+                }
+            }
+
+            auto group = static_cast<uint32_t>(groups.size());
+            groups.push_back(VulkanInstancedDraw{
+                    .meshId = packet.meshId,
+                    .materialId = packet.materialId,
+                    .firstInstance = 0,
+                    .instanceCount = 1,
+                    .skinned = packet.skinned,
+                    .skinnedVertexBufferAddr = packet.skinnedVertexBufferAddr,
+            });
+            if (!packet.skinned) {
+                lookup.emplace(key, group);
+            }
+            return group;
+        }
+
+        // every group gets a range as large as its packet count, so the compute pass can never overflow it
+        void assignRanges(Vector<VulkanInstancedDraw>& groups) {
+            uint32_t firstInstance = 0;
+            for (auto& group: groups) {
+                group.firstInstance = firstInstance;
+                firstInstance += group.instanceCount;
+            }
+        }
+    }// namespace
+
+    void VulkanIndirectDrawBuilder::build(Span<const VulkanRenderPacket> packets) {
+        m_objects.clear();
+        m_gBufferGroups.clear();
+        m_shadowGroups.clear();
+        m_gBufferLookup.clear();
+        m_shadowLookup.clear();
+
+        m_objects.reserve(packets.size());
+        for (auto& packet: packets) {
+            auto meshKey = static_cast<uint64_t>(packet.meshId);
+            auto meshAndMaterialKey = (meshKey << 32) | static_cast<uint64_t>(packet.materialId);
+
+            m_objects.push_back(VulkanCullingObject{
+                    .instance = VulkanInstanceData::fromTransform(packet.transform),
+                    .center = glm::vec4(packet.bounds.center, 0.0f),
+                    .extent = glm::vec4(packet.bounds.extent, 0.0f),
+                    .gBufferGroup = findOrAddGroup(packet, meshAndMaterialKey, m_gBufferLookup, m_gBufferGroups),
+                    .shadowGroup = findOrAddGroup(packet, meshKey, m_shadowLookup, m_shadowGroups),
+                    .padding = {0, 0},
+            });
+        }
+
+        assignRanges(m_gBufferGroups);
+        assignRanges(m_shadowGroups);
+    }
+}// namespace moe
\ No newline at end of file
@@ -6,6 +6,8 @@
 
 #include <tiny_gltf.h>
 
+#include <chrono>
+
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtx/quaternion.hpp>
 
@@ -886,6 +888,9 @@ namespace moe {
                 auto& materialCache = engine.m_caches.materialCache;
                 auto& imageCache = engine.m_caches.imageCache;
 
+                auto loadStart = std::chrono::steady_clock::now();
+                auto uploadStatsBefore = engine.getUploadService().getStats();
+
                 const std::filesystem::path path = filename;
                 const auto parentPath = path.parent_path();
 
@@ -917,6 +922,7 @@ namespace moe {
                     VulkanSceneMesh vkMesh{};
                     vkMesh.primitives.resize(mesh.primitives.size());
                     vkMesh.primitiveMaterials.resize(mesh.primitives.size());
+                    vkMesh.primitiveBounds.resize(mesh.primitives.size(), VulkanBounds::unbounded());
 
                     for (int i = 0; i < mesh.primitives.size(); ++i) {
                         const auto& primitive = mesh.primitives[i];
@@ -939,6 +945,7 @@ namespace moe {
 
                         vkMesh.primitives[i] = meshId;
                         vkMesh.primitiveMaterials[i] = materialId;
+                        vkMesh.primitiveBounds[i] = VulkanBounds::fromMinMax(cpuMesh.min, cpuMesh.max);
                     }
 
                     vkScene.meshes.push_back(vkMesh);
@@ -999,6 +1006,15 @@ namespace moe {
                     vkScene.children.push_back(std::move(nodePtr));
                 }
 
+                // the copies themselves finish on the gpu later, stalls are the times loading waited for them
+                auto& uploadStats = engine.getUploadService().getStats();
+                Logger::info(
+                        "Loaded {} in {:.1f} ms, {} uploads, {} upload stalls",
+                        filename,
+                        std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - loadStart).count(),
+                        uploadStats.copies - uploadStatsBefore.copies,
+                        uploadStats.stalls - uploadStatsBefore.stalls);
+
                 return vkScene;
             }
         }// namespace GLTF
@@ -0,0 +1,198 @@
+#include "Render/Vulkan/VulkanMeshArena.hpp"
+#include "Render/Vulkan/VulkanEngine.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+namespace moe {
+    void VulkanMeshArena::init(VulkanEngine& engine) {
+        m_engine = &engine;
+
+        initPool(
+                m_vertices, INITIAL_VERTEX_CAPACITY, sizeof(Vertex),
+                VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+                        VK_BUFFER_USAGE_TRANSFER_SRC_BIT |
+                        VK_BUFFER_USAGE_TRANSFER_DST_BIT |
+                        VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT);
+        initPool(
+                m_indices, INITIAL_INDEX_CAPACITY, sizeof(uint32_t),
+                VK_BUFFER_USAGE_INDEX_BUFFER_BIT |
+                        VK_BUFFER_USAGE_TRANSFER_SRC_BIT |
+                        VK_BUFFER_USAGE_TRANSFER_DST_BIT);
+        initPool(
+                m_skinningData, INITIAL_SKINNING_DATA_CAPACITY, sizeof(SkinningData),
+                VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+                        VK_BUFFER_USAGE_TRANSFER_SRC_BIT |
+                        VK_BUFFER_USAGE_TRANSFER_DST_BIT |
+                        VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT);
+
+        m_generation = 0;
+        m_stats = {};
+        m_initialized = true;
+    }
+
+    void VulkanMeshArena::destroy() {
+        MOE_ASSERT(m_initialized, "VulkanMeshArena not initialized");
+
+        for (auto* pool: {&m_vertices, &m_indices, &m_skinningData}) {
+            m_engine->destroyBuffer(pool->buffer);
+            *pool = {};
+        }
+
+        m_engine = nullptr;
+        m_initialized = false;
+    }
+
+    VulkanGPUMeshBuffer VulkanMeshArena::upload(Span<uint32_t> indices, Span<Vertex> vertices, Span<SkinningData> skinningData) {
+        MOE_ASSERT(m_initialized, "VulkanMeshArena not initialized");
+        MOE_ASSERT(!indices.empty() && !vertices.empty(), "Cannot upload an empty mesh");
+
+        auto uploadStart = std::chrono::steady_clock::now();
+
+        const size_t vertBufferSize = vertices.size() * sizeof(Vertex);
+        const size_t indexBufferSize = indices.size() * sizeof(uint32_t);
+        const size_t skinningDataBufferSize = skinningData.size() * sizeof(SkinningData);
+
+        VulkanGPUMeshBuffer mesh{};
+        mesh.indexCount = static_cast<uint32_t>(indices.size());
+        mesh.vertexCount = static_cast<uint32_t>(vertices.size());
+        mesh.hasSkinningData = !skinningData.empty();
+
+        mesh.vertexOffset = allocate(m_vertices, mesh.vertexCount);
+        mesh.firstIndex = allocate(m_indices, mesh.indexCount);
+        if (mesh.hasSkinningData) {
+            mesh.skinningDataOffset = allocate(m_skinningData, static_cast<uint32_t>(skinningData.size()));
+        }
+
+        // the copies go out with the next frame, which waits for them on the gpu
+        auto& uploadService = m_engine->m_uploadService;
+        uploadService.uploadBuffer(
+                m_vertices.buffer.buffer, static_cast<VkDeviceSize>(mesh.vertexOffset) * sizeof(Vertex),
+                vertices.data(), vertBufferSize);
+        uploadService.uploadBuffer(
+                m_indices.buffer.buffer, static_cast<VkDeviceSize>(mesh.firstIndex) * sizeof(uint32_t),
+                indices.data(), indexBufferSize);
+        if (mesh.hasSkinningData) {
+            uploadService.uploadBuffer(
+                    m_skinningData.buffer.buffer, static_cast<VkDeviceSize>(mesh.skinningDataOffset) * sizeof(SkinningData),
+                    skinningData.data(), skinningDataBufferSize);
+        }
+
+        resolve(mesh);
+
+        ++m_stats.uploads;
+        m_stats.uploadMs += std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - uploadStart).count();
+
+        return mesh;
+    }
+
+    void VulkanMeshArena::free(const VulkanGPUMeshBuffer& mesh) {
+        MOE_ASSERT(m_initialized, "VulkanMeshArena not initialized");
+
+        m_vertices.allocator.free(mesh.vertexOffset);
+        m_indices.allocator.free(mesh.firstIndex);
+        if (mesh.hasSkinningData) {
+            m_skinningData.allocator.free(mesh.skinningDataOffset);
+        }
+    }
+
+    VulkanMeshArena::Compaction VulkanMeshArena::compact() {
+        MOE_ASSERT(m_initialized, "VulkanMeshArena not initialized");
+
+        Compaction compaction;
+        auto compactPool = [this](Pool& pool, Vector<VulkanRangeAllocator::Move>& moves) {
+            moves = pool.allocator.compact();
+            if (moves.empty()) {
+                return;
+            }
+
+            // ranges before the first move stayed where they were, but still have to reach the new buffer
+            Vector<VkBufferCopy> regions;
+            regions.reserve(moves.size() + 1);
+            if (moves.front().dstOffset > 0) {
+                regions.push_back({0, 0, static_cast<VkDeviceSize>(moves.front().dstOffset) * pool.stride});
+            }
+            for (auto& move: moves) {
+                regions.push_back({
+                        static_cast<VkDeviceSize>(move.srcOffset) * pool.stride,
+                        static_cast<VkDeviceSize>(move.dstOffset) * pool.stride,
+                        static_cast<VkDeviceSize>(move.count) * pool.stride,
+                });
+            }
+
+            // moves can overlap their own source, so they copy into a fresh buffer instead of in place
+            replaceBuffer(pool, pool.allocator.getCapacity(), regions);
+        };
+
+        compactPool(m_vertices, compaction.vertices);
+        compactPool(m_indices, compaction.indices);
+        compactPool(m_skinningData, compaction.skinningData);
+
+        ++m_stats.compactions;
+        return compaction;
+    }
+
+    void VulkanMeshArena::resolve(VulkanGPUMeshBuffer& mesh) const {
+        mesh.vertexBuffer = m_vertices.buffer;
+        mesh.indexBuffer = m_indices.buffer;
+        mesh.vertexBufferAddr = m_vertices.buffer.address + static_cast<VkDeviceAddress>(mesh.vertexOffset) * sizeof(Vertex);
+
+        if (mesh.hasSkinningData) {
+            mesh.skinningDataBuffer = m_skinningData.buffer;
+            mesh.skinningDataBufferAddr =
+                    m_skinningData.buffer.address + static_cast<VkDeviceAddress>(mesh.skinningDataOffset) * sizeof(SkinningData);
+        } else {
+            mesh.skinningDataBuffer = {};
+            mesh.skinningDataBufferAddr = 0;
+        }
+    }
+
+    void VulkanMeshArena::initPool(Pool& pool, uint32_t capacity, uint32_t stride, VkBufferUsageFlags usage) {
+        pool.usage = usage;
+        pool.stride = stride;
+        pool.allocator = VulkanRangeAllocator(capacity);
+        pool.buffer = m_engine->allocateBuffer(static_cast<size_t>(capacity) * stride, usage, VMA_MEMORY_USAGE_GPU_ONLY);
+    }
+
+    uint32_t VulkanMeshArena::allocate(Pool& pool, uint32_t count) {
+        auto offset = pool.allocator.allocate(count);
+        if (offset.has_value()) {
+            return offset.value();
+        }
+
+        uint32_t capacity = pool.allocator.getCapacity();
+        uint32_t newCapacity = std::max(capacity * 2, capacity + count);
+
+        // live ranges keep their offsets, so one copy of the whole old buffer carries them over
+        VkBufferCopy region{0, 0, static_cast<VkDeviceSize>(capacity) * pool.stride};
+        replaceBuffer(pool, newCapacity, Span<const VkBufferCopy>(&region, 1));
+        pool.allocator.grow(newCapacity);
+        ++m_stats.growths;
+
+        offset = pool.allocator.allocate(count);
+        MOE_ASSERT(offset.has_value(), "Grown arena must fit the allocation");
+        return offset.value();
+    }
+
+    void VulkanMeshArena::replaceBuffer(Pool& pool, uint32_t newCapacity, Span<const VkBufferCopy> regions) {
+        // uploads still queued for the old buffer have to land before it is copied
+        m_engine->m_uploadService.finish();
+        // frames in flight may still read the old buffer
+        vkDeviceWaitIdle(m_engine->m_device);
+
+        auto newBuffer = m_engine->allocateBuffer(static_cast<size_t>(newCapacity) * pool.stride, pool.usage, VMA_MEMORY_USAGE_GPU_ONLY);
+
+        if (!regions.empty()) {
+            m_engine->immediateSubmit([&](VkCommandBuffer cmdBuffer) {
+                vkCmdCopyBuffer(
+                        cmdBuffer,
+                        pool.buffer.buffer, newBuffer.buffer,
+                        static_cast<uint32_t>(regions.size()), regions.data());
+            });
+        }
+
+        m_engine->destroyBuffer(pool.buffer);
+        pool.buffer = newBuffer;
+        ++m_generation;
+    }
+}// namespace moe
\ No newline at end of file
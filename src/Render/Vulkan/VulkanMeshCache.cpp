@@ -6,6 +6,8 @@
 namespace moe {
     void VulkanMeshCache::init(VulkanEngine& engine) {
         m_engine = &engine;
+        m_arena.init(engine);
+        m_arenaGeneration = m_arena.getGeneration();
         m_initialized = true;
 
         defaults.rectMeshId = loadMesh(getDefaultRectMesh());
@@ -14,7 +16,7 @@ namespace moe {
     MeshId VulkanMeshCache::loadMesh(VulkanCPUMesh cpuMesh) {
         MOE_ASSERT(m_initialized, "VulkanMeshCache not initialized");
 
-        auto buffer = m_engine->uploadMesh(cpuMesh.indices, cpuMesh.vertices, cpuMesh.skinningData);
+        auto buffer = m_arena.upload(cpuMesh.indices, cpuMesh.vertices, cpuMesh.skinningData);
         MeshId id = m_idAllocator.allocateId();
         m_meshes.emplace(
                 id,
@@ -24,6 +26,11 @@ namespace moe {
                         .max = cpuMesh.max,
                 });
 
+        // the upload grew the arena, earlier meshes still point at the old buffers
+        if (m_arena.getGeneration() != m_arenaGeneration) {
+            resolveMeshes();
+        }
+
         return id;
     }
 
@@ -37,14 +44,37 @@ namespace moe {
         return std::nullopt;
     }
 
-    void VulkanMeshCache::destroy() {
+    void VulkanMeshCache::unloadMesh(MeshId id) {
+        MOE_ASSERT(m_initialized, "VulkanMeshCache not initialized");
+
+        auto it = m_meshes.find(id);
+        if (it == m_meshes.end()) {
+            Logger::warn("Trying to unload invalid mesh id {}", id);
+            return;
+        }
+
+        m_arena.free(it->second.gpuBuffer);
+        m_meshes.erase(it);
+        m_idAllocator.recycleId(id);
+    }
+
+    void VulkanMeshCache::compactArena() {
+        MOE_ASSERT(m_initialized, "VulkanMeshCache not initialized");
+
+        auto compaction = m_arena.compact();
         for (auto& [id, mesh]: m_meshes) {
-            m_engine->destroyBuffer(mesh.gpuBuffer.vertexBuffer);
-            m_engine->destroyBuffer(mesh.gpuBuffer.indexBuffer);
-            if (mesh.gpuBuffer.hasSkinningData) {
-                m_engine->destroyBuffer(mesh.gpuBuffer.skinningDataBuffer);
+            auto& buffer = mesh.gpuBuffer;
+            buffer.vertexOffset = VulkanRangeAllocator::remap(compaction.vertices, buffer.vertexOffset);
+            buffer.firstIndex = VulkanRangeAllocator::remap(compaction.indices, buffer.firstIndex);
+            if (buffer.hasSkinningData) {
+                buffer.skinningDataOffset = VulkanRangeAllocator::remap(compaction.skinningData, buffer.skinningDataOffset);
             }
         }
+        resolveMeshes();
+    }
+
+    void VulkanMeshCache::destroy() {
+        m_arena.destroy();
 
         m_idAllocator.reset();
         m_meshes.clear();
@@ -52,4 +82,11 @@ namespace moe {
         m_engine = nullptr;
         m_initialized = false;
     }
+
+    void VulkanMeshCache::resolveMeshes() {
+        for (auto& [id, mesh]: m_meshes) {
+            m_arena.resolve(mesh.gpuBuffer);
+        }
+        m_arenaGeneration = m_arena.getGeneration();
+    }
 }// namespace moe
\ No newline at end of file
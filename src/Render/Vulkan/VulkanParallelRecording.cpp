@@ -0,0 +1,25 @@
+#include "Render/Vulkan/VulkanParallelRecording.hpp"
+
+#include <algorithm>
+
+namespace moe {
+    namespace VkParallel {
+        uint32_t chunkCount(size_t count, size_t minPerChunk, uint32_t maxChunks) {
+            if (count == 0 || maxChunks == 0) {
+                return 0;
+            }
+            size_t chunks = std::max<size_t>(1, count / std::max<size_t>(1, minPerChunk));
+            return static_cast<uint32_t>(std::min<size_t>(chunks, maxChunks));
+        }
+
+        ChunkRange chunkRange(size_t count, uint32_t chunks, uint32_t chunk) {
+            MOE_ASSERT(chunk < chunks, "Chunk out of range");
+
+            // the first count % chunks chunks take one item more
+            size_t base = count / chunks;
+            size_t extra = count % chunks;
+            size_t begin = chunk * base + std::min<size_t>(chunk, extra);
+            return {begin, begin + base + (chunk < extra ? 1 : 0)};
+        }
+    }// namespace VkParallel
+}// namespace moe
\ No newline at end of file
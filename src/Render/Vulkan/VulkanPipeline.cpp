@@ -20,7 +20,7 @@ namespace moe {
         shaderStages.clear();
     }
 
-    VkPipeline VulkanPipelineBuilder::build(VkDevice device) {
+    VkPipeline VulkanPipelineBuilder::build(VkDevice device, VulkanPipelineCache* cache) {
         VkPipelineViewportStateCreateInfo viewportState{};
         viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
         viewportState.pNext = nullptr;
@@ -77,7 +77,12 @@ namespace moe {
         pipelineInfo.pDynamicState = &dynamicStateInfo;
 
         VkPipeline pipeline;
-        if (vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &pipeline) != VK_SUCCESS) {
+        auto start = std::chrono::high_resolution_clock::now();
+        VkResult result = vkCreateGraphicsPipelines(device, cache ? cache->get() : VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &pipeline);
+        if (cache) {
+            cache->recordCreation(std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count());
+        }
+        if (result != VK_SUCCESS) {
             Logger::warn("Pipeline creation failed");
             return VK_NULL_HANDLE;
         }
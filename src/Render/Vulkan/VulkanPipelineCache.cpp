@@ -0,0 +1,102 @@
+#include "Render/Vulkan/VulkanPipelineCache.hpp"
+
+#include <fstream>
+#include <iterator>
+
+namespace moe {
+    void VulkanPipelineCache::init(VkDevice device, VkPhysicalDevice physicalDevice, StringView path) {
+        MOE_ASSERT(!m_initialized, "VulkanPipelineCache already initialized");
+
+        m_device = device;
+        m_path = String(path);
+        m_stats = {};
+
+        VkPhysicalDeviceProperties properties;
+        vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+        m_identity = VulkanPipelineCacheIdentity::fromProperties(properties);
+
+        Vector<uint8_t> file;
+        {
+            std::ifstream stream(m_path, std::ios::binary);
+            if (stream) {
+                file.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+            }
+        }
+
+        VkPipelineCacheCreateInfo cacheInfo{};
+        cacheInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+
+        auto blob = VkPipelineCacheFile::validate(file, m_identity);
+        if (blob) {
+            cacheInfo.initialDataSize = blob->size();
+            cacheInfo.pInitialData = blob->data();
+            m_stats.warm = true;
+            m_stats.loadedBytes = blob->size();
+        } else if (!file.empty()) {
+            Logger::info("Pipeline cache at {} is stale or corrupt, starting cold", m_path);
+        }
+
+        if (vkCreatePipelineCache(m_device, &cacheInfo, nullptr, &m_cache) != VK_SUCCESS) {
+            // the data passed every check but the driver still refused it, an empty cache always works
+            Logger::warn("Driver rejected pipeline cache at {}, starting cold", m_path);
+            cacheInfo.initialDataSize = 0;
+            cacheInfo.pInitialData = nullptr;
+            m_stats.warm = false;
+            m_stats.loadedBytes = 0;
+            MOE_VK_CHECK(vkCreatePipelineCache(m_device, &cacheInfo, nullptr, &m_cache));
+        }
+
+        m_initialized = true;
+    }
+
+    void VulkanPipelineCache::destroy() {
+        MOE_ASSERT(m_initialized, "VulkanPipelineCache not initialized");
+
+        save();
+        vkDestroyPipelineCache(m_device, m_cache, nullptr);
+        m_cache = VK_NULL_HANDLE;
+
+        m_initialized = false;
+    }
+
+    void VulkanPipelineCache::save() const {
+        size_t size = 0;
+        if (vkGetPipelineCacheData(m_device, m_cache, &size, nullptr) != VK_SUCCESS || size == 0) {
+            return;
+        }
+        Vector<uint8_t> blob(size);
+        if (vkGetPipelineCacheData(m_device, m_cache, &size, blob.data()) != VK_SUCCESS) {
+            Logger::warn("Failed to read pipeline cache data, not saving it");
+            return;
+        }
+        blob.resize(size);
+
+        auto file = VkPipelineCacheFile::serialize(m_identity, blob);
+
+        std::error_code ec;
+        std::filesystem::path target{m_path};
+        if (target.has_parent_path()) {
+            std::filesystem::create_directories(target.parent_path(), ec);
+        }
+
+        auto temp = target;
+        temp += ".tmp";
+        {
+            std::ofstream stream(temp, std::ios::binary | std::ios::trunc);
+            stream.write(reinterpret_cast<const char*>(file.data()), static_cast<std::streamsize>(file.size()));
+            if (!stream) {
+                Logger::warn("Failed to write pipeline cache to {}", temp.string());
+                std::filesystem::remove(temp, ec);
+                return;
+            }
+        }
+
+        std::filesystem::rename(temp, target, ec);
+        if (ec) {
+            Logger::warn("Failed to replace pipeline cache at {}: {}", m_path, ec.message());
+            std::filesystem::remove(temp, ec);
+            return;
+        }
+        Logger::info("Saved pipeline cache to {} ({} KB)", m_path, file.size() / 1024);
+    }
+}// namespace moe
\ No newline at end of file
@@ -0,0 +1,102 @@
+#include "Render/Vulkan/VulkanPipelineCache.hpp"
+
+#include <cstring>
+
+namespace moe {
+    namespace {
+        constexpr uint32_t FILE_MAGIC = 0x50434f4d;// "MOCP"
+        constexpr uint32_t FILE_VERSION = 1;
+
+        struct FileHeader {
+            uint32_t magic;
+            uint32_t version;
+            uint32_t vendorID;
+            uint32_t deviceID;
+            uint32_t driverVersion;
+            uint8_t pipelineCacheUUID[VK_UUID_SIZE];
+            uint64_t blobSize;
+            uint64_t blobHash;
+        };
+
+        // fnv-1a, a truncated or bit flipped blob is rejected before the driver ever sees it
+        uint64_t hashBytes(const uint8_t* data, size_t size) {
+            uint64_t hash = 14695981039346656037ull;
+            for (size_t i = 0; i < size; ++i) {
+                hash ^= data[i];
+                hash *= 1099511628211ull;
+            }
+            return hash;
+        }
+    }// namespace
+
+    VulkanPipelineCacheIdentity VulkanPipelineCacheIdentity::fromProperties(const VkPhysicalDeviceProperties& properties) {
+        VulkanPipelineCacheIdentity identity;
+        identity.vendorID = properties.vendorID;
+        identity.deviceID = properties.deviceID;
+        identity.driverVersion = properties.driverVersion;
+        std::memcpy(identity.pipelineCacheUUID.data(), properties.pipelineCacheUUID, VK_UUID_SIZE);
+        return identity;
+    }
+
+    namespace VkPipelineCacheFile {
+        Vector<uint8_t> serialize(const VulkanPipelineCacheIdentity& identity, Span<const uint8_t> blob) {
+            FileHeader header{};
+            header.magic = FILE_MAGIC;
+            header.version = FILE_VERSION;
+            header.vendorID = identity.vendorID;
+            header.deviceID = identity.deviceID;
+            header.driverVersion = identity.driverVersion;
+            std::memcpy(header.pipelineCacheUUID, identity.pipelineCacheUUID.data(), VK_UUID_SIZE);
+            header.blobSize = blob.size();
+            header.blobHash = hashBytes(blob.data(), blob.size());
+
+            Vector<uint8_t> file(sizeof(FileHeader) + blob.size());
+            std::memcpy(file.data(), &header, sizeof(FileHeader));
+            if (!blob.empty()) {
+                std::memcpy(file.data() + sizeof(FileHeader), blob.data(), blob.size());
+            }
+            return file;
+        }
+
+        Optional<Span<const uint8_t>> validate(Span<const uint8_t> file, const VulkanPipelineCacheIdentity& identity) {
+            if (file.size() < sizeof(FileHeader)) {
+                return std::nullopt;
+            }
+
+            FileHeader header;
+            std::memcpy(&header, file.data(), sizeof(FileHeader));
+            if (header.magic != FILE_MAGIC || header.version != FILE_VERSION) {
+                return std::nullopt;
+            }
+            // a driver update keeps the uuid on some vendors but changes what the blob means
+            if (header.vendorID != identity.vendorID
+                || header.deviceID != identity.deviceID
+                || header.driverVersion != identity.driverVersion
+                || std::memcmp(header.pipelineCacheUUID, identity.pipelineCacheUUID.data(), VK_UUID_SIZE) != 0) {
+                return std::nullopt;
+            }
+
+            auto blob = file.subspan(sizeof(FileHeader));
+            if (header.blobSize != blob.size() || header.blobHash != hashBytes(blob.data(), blob.size())) {
+                return std::nullopt;
+            }
+
+            // the driver's own header, checked too since drivers are not required to reject a foreign blob
+            VkPipelineCacheHeaderVersionOne driverHeader;
+            if (blob.size() < sizeof(driverHeader)) {
+                return std::nullopt;
+            }
+            std::memcpy(&driverHeader, blob.data(), sizeof(driverHeader));
+            if (driverHeader.headerSize < sizeof(driverHeader)
+                || driverHeader.headerSize > blob.size()
+                || driverHeader.headerVersion != VK_PIPELINE_CACHE_HEADER_VERSION_ONE
+                || driverHeader.vendorID != identity.vendorID
+                || driverHeader.deviceID != identity.deviceID
+                || std::memcmp(driverHeader.pipelineCacheUUID, identity.pipelineCacheUUID.data(), VK_UUID_SIZE) != 0) {
+                return std::nullopt;
+            }
+
+            return blob;
+        }
+    }// namespace VkPipelineCacheFile
+}// namespace moe
\ No newline at end of file
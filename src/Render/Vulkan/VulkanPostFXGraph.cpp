@@ -1,17 +1,61 @@
 #include "Render/Vulkan/VulkanPostFXGraph.hpp"
 #include "Render/Vulkan/VulkanEngine.hpp"
 #include "Render/Vulkan/VulkanInitializers.hpp"
+#include "Render/Vulkan/VulkanTransientImages.hpp"
 #include "Render/Vulkan/VulkanUtils.hpp"
 
+#include <limits>
+
 
 MOE_BEGIN_NAMESPACE
 
+namespace {
+    // the previous holder of the image may still be sampling or writing it, its contents are discarded
+    VkImageMemoryBarrier2 attachmentWriteBarrier(VkImage image) {
+        return VkImageMemoryBarrier2{
+                .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2,
+                .srcStageMask = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
+                .srcAccessMask = VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT,
+                .dstStageMask = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
+                .dstAccessMask = VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT,
+                .oldLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+                .newLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+                .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                .image = image,
+                .subresourceRange = VkUtils::makeImageSubresourceRange(VK_IMAGE_ASPECT_COLOR_BIT),
+        };
+    }
+
+    VkImageMemoryBarrier2 sampledReadBarrier(VkImage image) {
+        return VkImageMemoryBarrier2{
+                .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2,
+                .srcStageMask = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
+                .srcAccessMask = VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT,
+                .dstStageMask = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
+                .dstAccessMask = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
+                .oldLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+                .newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                .image = image,
+                .subresourceRange = VkUtils::makeImageSubresourceRange(VK_IMAGE_ASPECT_COLOR_BIT),
+        };
+    }
+
+    size_t imageBytes(VkFormat format, VkExtent3D extent) {
+        return VkUtils::getBytesPerPixelFromFormat(format) * extent.width * extent.height * extent.depth;
+    }
+}// namespace
+
 void VulkanPostFXGraph::destroy() {
     MOE_ASSERT(initialized, "VulkanPostFXGraph not initialized");
 
     // images managed by image cache, no need to destroy here
     nameToImageIndex.clear();
     compiledStages.clear();
+    compiledStagesOrder.clear();
+    transientImages.clear();
     stages.clear();
     globalInputInfos.clear();
     globalOutputInfo = {};
@@ -24,10 +68,14 @@ void VulkanPostFXGraph::copyToInput(
         VulkanAllocatedImage& src, VkImageLayout srcImageLayout) {
     MOE_ASSERT(initialized, "VulkanPostFXGraph not initialized");
 
-    VkUtils::transitionImage(
-            cmdBuffer, src.image,
-            srcImageLayout,
-            VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+    // a source already in transfer layout is synchronized by the caller and left as is
+    bool transitionSrc = srcImageLayout != VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    if (transitionSrc) {
+        VkUtils::transitionImage(
+                cmdBuffer, src.image,
+                srcImageLayout,
+                VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+    }
 
     auto it = nameToImageIndex.find(inputName);
     MOE_ASSERT(it != nameToImageIndex.end(), "Input name not found in post FX graph");
@@ -48,19 +96,25 @@ void VulkanPostFXGraph::copyToInput(
             VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
             VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
 
-    VkUtils::transitionImage(
-            cmdBuffer, src.image,
-            VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
-            srcImageLayout);
+    if (transitionSrc) {
+        VkUtils::transitionImage(
+                cmdBuffer, src.image,
+                VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                srcImageLayout);
+    }
 }
 
 void VulkanPostFXGraph::copyFromOutput(VkCommandBuffer cmdBuffer, VulkanAllocatedImage& dst, VkImageLayout dstImageLayout) {
     MOE_ASSERT(initialized, "VulkanPostFXGraph not initialized");
 
-    VkUtils::transitionImage(
-            cmdBuffer, dst.image,
-            dstImageLayout,
-            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+    // as in copyToInput, a destination already in transfer layout belongs to the caller
+    bool transitionDst = dstImageLayout != VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    if (transitionDst) {
+        VkUtils::transitionImage(
+                cmdBuffer, dst.image,
+                dstImageLayout,
+                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+    }
 
     auto it = nameToImageIndex.find(globalOutputInfo.name);
     MOE_ASSERT(it != nameToImageIndex.end(), "Output name not found in post FX graph");
@@ -76,10 +130,12 @@ void VulkanPostFXGraph::copyFromOutput(VkCommandBuffer cmdBuffer, VulkanAllocate
 
     VkUtils::copyImage(cmdBuffer, srcImage.image, dst.image, srcExtent, dstExtent);
 
-    VkUtils::transitionImage(
-            cmdBuffer, dst.image,
-            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-            dstImageLayout);
+    if (transitionDst) {
+        VkUtils::transitionImage(
+                cmdBuffer, dst.image,
+                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                dstImageLayout);
+    }
 
     VkUtils::transitionImage(
             cmdBuffer, srcImage.image,
@@ -108,25 +164,12 @@ void VulkanPostFXGraph::buildGraph() {
         compiledStage.outputFormat = stage.outputFormat;
         compiledStage.outputExtent = stage.outputExtent;
 
+        // images are only given out once the order is known, see allocateTransientImages
         nameToImageIndex[stage.name] = index;
-        auto imageId =
-                engine->m_caches.imageCache.addImage(engine->allocateImage(
-                        stage.outputExtent, stage.outputFormat,
-                        VK_IMAGE_USAGE_SAMPLED_BIT |
-                                VK_IMAGE_USAGE_TRANSFER_SRC_BIT |
-                                VK_IMAGE_USAGE_TRANSFER_DST_BIT |
-                                VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT,
-                        false));
-
-        auto image =
-                engine->m_caches.imageCache.getImage(imageId).value();
-
         compiledStages.emplace(
                 index,
                 VulkanCompiledPostFXStage{
                         .index = index,
-                        .outputImage = std::move(image),
-                        .outputImageId = imageId,
                         .outputFormat = stage.outputFormat,
                         .outputExtent = stage.outputExtent,
                         .isGlobalInput = stage.isGlobalInput,
@@ -192,6 +235,101 @@ void VulkanPostFXGraph::resolveDependencies() {
             "Cyclic dependency detected in post FX graph");
 }
 
+void VulkanPostFXGraph::allocateTransientImages() {
+    constexpr VkImageUsageFlags usage =
+            VK_IMAGE_USAGE_SAMPLED_BIT |
+            VK_IMAGE_USAGE_TRANSFER_SRC_BIT |
+            VK_IMAGE_USAGE_TRANSFER_DST_BIT |
+            VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+
+    Vector<uint32_t> steps(compiledStages.size());
+    for (uint32_t step = 0; step < compiledStagesOrder.size(); ++step) {
+        steps[compiledStagesOrder[step]] = step;
+    }
+
+    const uint32_t outputIndex = nameToImageIndex[globalOutputInfo.name];
+
+    // a stage's image is live from its own step to the step of its last reader
+    Vector<VulkanTransientImageDesc> descs(compiledStages.size());
+    for (auto& [index, compiledStage]: compiledStages) {
+        auto& desc = descs[index];
+        desc.format = compiledStage.outputFormat;
+        desc.extent = compiledStage.outputExtent;
+        desc.usage = usage;
+        // copyToInput writes every global input before exec starts
+        desc.firstUse = compiledStage.isGlobalInput ? 0 : steps[index];
+        desc.lastUse = desc.firstUse;
+        for (auto readerIndex: compiledStage.outputIndices) {
+            desc.lastUse = std::max(desc.lastUse, steps[readerIndex]);
+        }
+        // copyFromOutput reads it after exec is done
+        if (index == outputIndex) {
+            desc.lastUse = std::numeric_limits<uint32_t>::max();
+        }
+    }
+
+    auto assignment = VkTransient::assign(descs);
+
+    stats = {};
+    for (auto descIndex: assignment.physicalDescs) {
+        auto& desc = descs[descIndex];
+        auto imageId =
+                engine->m_caches.imageCache.addImage(
+                        engine->allocateImage(desc.extent, desc.format, desc.usage, false));
+        transientImages.push_back(TransientImage{
+                .image = engine->m_caches.imageCache.getImage(imageId).value(),
+                .imageId = imageId,
+        });
+        stats.transientBytes += imageBytes(desc.format, desc.extent);
+    }
+
+    for (auto& [index, compiledStage]: compiledStages) {
+        auto& transientImage = transientImages[assignment.physicalIndices[index]];
+        compiledStage.physicalIndex = assignment.physicalIndices[index];
+        compiledStage.outputImage = transientImage.image;
+        compiledStage.outputImageId = transientImage.imageId;
+        stats.unaliasedBytes += imageBytes(compiledStage.outputFormat, compiledStage.outputExtent);
+    }
+
+    stats.logicalImages = static_cast<uint32_t>(compiledStages.size());
+    stats.physicalImages = static_cast<uint32_t>(transientImages.size());
+}
+
+void VulkanPostFXGraph::planBarriers() {
+    // a stage's image moves to the sampled layout right before its first reader, in the same barrier batch
+    // global inputs leave copyToInput in that layout already
+    Vector<bool> transitioned(compiledStages.size(), false);
+    for (auto index: compiledStagesOrder) {
+        auto& compiledStage = compiledStages[index];
+        compiledStage.firstReadIndices.clear();
+        if (compiledStage.isGlobalInput) {
+            continue;
+        }
+        for (auto inputIndex: compiledStage.inputIndices) {
+            if (compiledStages[inputIndex].isGlobalInput || transitioned[inputIndex]) {
+                continue;
+            }
+            transitioned[inputIndex] = true;
+            compiledStage.firstReadIndices.push_back(inputIndex);
+        }
+    }
+}
+
+void VulkanPostFXGraph::recordBarriers(VkCommandBuffer cmdBuffer) {
+    if (barrierScratch.empty()) {
+        return;
+    }
+
+    VkDependencyInfo dependencyInfo{};
+    dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+    dependencyInfo.imageMemoryBarrierCount = static_cast<uint32_t>(barrierScratch.size());
+    dependencyInfo.pImageMemoryBarriers = barrierScratch.data();
+    vkCmdPipelineBarrier2(cmdBuffer, &dependencyInfo);
+
+    ++stats.barrierBatches;
+    stats.imageBarriers += static_cast<uint32_t>(barrierScratch.size());
+    barrierScratch.clear();
+}
 
 void VulkanPostFXGraph::logCompilationResult() {
     if (!enableCompilationLog) {
@@ -229,9 +367,10 @@ void VulkanPostFXGraph::logCompilationResult() {
                     }
                 }
             }
-            ss << "]";
+            ss << "]\n";
+            ss << "  Transient Image: " << compiledStages[idx].physicalIndex;
         } else {
-            ss << "  (Global Input Stage)";
+            ss << "  (Global Input Stage), Transient Image: " << compiledStages[idx].physicalIndex;
         }
         ss << "\n";
     }
@@ -240,15 +379,22 @@ void VulkanPostFXGraph::logCompilationResult() {
     ss << " " << globalOutputInfo.name;
     ss << "\n";
 
+    ss << "Transient Images: " << stats.physicalImages << " for " << stats.logicalImages << " stages, "
+       << stats.transientBytes / (1024 * 1024) << " MB (" << stats.unaliasedBytes / (1024 * 1024) << " MB unaliased)\n";
+
     compilationLog = ss.str();
 }
 
 void VulkanPostFXGraph::compile() {
     compiledStages.clear();
+    compiledStagesOrder.clear();
+    transientImages.clear();
     nameToImageIndex.clear();
 
     buildGraph();
     resolveDependencies();
+    allocateTransientImages();
+    planBarriers();
 
     logCompilationResult();
 }
@@ -257,6 +403,9 @@ void VulkanPostFXGraph::compile() {
 void VulkanPostFXGraph::exec(VkCommandBuffer cmdBuffer) {
     MOE_ASSERT(initialized, "VulkanPostFXGraph not initialized");
 
+    stats.barrierBatches = 0;
+    stats.imageBarriers = 0;
+
     for (auto& index: compiledStagesOrder) {
         auto& compiledStage = compiledStages[index];
         if (compiledStage.isGlobalInput) {
@@ -270,10 +419,11 @@ void VulkanPostFXGraph::exec(VkCommandBuffer cmdBuffer) {
         }
 
         auto& outputImage = compiledStage.outputImage;
-        VkUtils::transitionImage(
-                cmdBuffer, outputImage.image,
-                VK_IMAGE_LAYOUT_UNDEFINED,
-                VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+        for (auto& inputIndex: compiledStage.firstReadIndices) {
+            barrierScratch.push_back(sampledReadBarrier(compiledStages[inputIndex].outputImage.image));
+        }
+        barrierScratch.push_back(attachmentWriteBarrier(outputImage.image));
+        recordBarriers(cmdBuffer);
 
         auto clearValue = VkClearValue{.color = {{0.0f, 0.0f, 0.0f, 1.0f}}};
         auto colorAttachment =
@@ -287,11 +437,13 @@ void VulkanPostFXGraph::exec(VkCommandBuffer cmdBuffer) {
         vkCmdBeginRendering(cmdBuffer, &renderInfo);
         compiledStage.recordFunc(cmdBuffer, inputImages);
         vkCmdEndRendering(cmdBuffer);
+    }
 
-        VkUtils::transitionImage(
-                cmdBuffer, outputImage.image,
-                VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
-                VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    // the output has no reader stage, copyFromOutput expects it in the sampled layout like any input
+    auto& outputStage = compiledStages[nameToImageIndex[globalOutputInfo.name]];
+    if (!outputStage.isGlobalInput) {
+        barrierScratch.push_back(sampledReadBarrier(outputStage.outputImage.image));
+        recordBarriers(cmdBuffer);
     }
 }
 
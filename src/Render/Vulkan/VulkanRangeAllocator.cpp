@@ -0,0 +1,125 @@
+#include "Render/Vulkan/VulkanRangeAllocator.hpp"
+
+#include <algorithm>
+
+namespace moe {
+    VulkanRangeAllocator::VulkanRangeAllocator(uint32_t capacity)
+        : m_capacity(capacity) {
+        if (capacity > 0) {
+            m_freeRanges.push_back({0, capacity});
+        }
+    }
+
+    Optional<uint32_t> VulkanRangeAllocator::allocate(uint32_t count) {
+        MOE_ASSERT(count > 0, "Cannot allocate an empty range");
+
+        for (auto it = m_freeRanges.begin(); it != m_freeRanges.end(); ++it) {
+            if (it->count < count) {
+                continue;
+            }
+
+            uint32_t offset = it->offset;
+            if (it->count == count) {
+                m_freeRanges.erase(it);
+            } else {
+                it->offset += count;
+                it->count -= count;
+            }
+
+            m_allocations.emplace(offset, count);
+            m_used += count;
+            return offset;
+        }
+        return std::nullopt;
+    }
+
+    void VulkanRangeAllocator::free(uint32_t offset) {
+        auto allocation = m_allocations.find(offset);
+        MOE_ASSERT(allocation != m_allocations.end(), "Freeing a range that was never allocated");
+
+        uint32_t count = allocation->second;
+        m_allocations.erase(allocation);
+        m_used -= count;
+
+        auto next = std::lower_bound(
+                m_freeRanges.begin(), m_freeRanges.end(), offset,
+                [](const Range& range, uint32_t value) { return range.offset < value; });
+
+        bool mergesPrev = next != m_freeRanges.begin() && std::prev(next)->offset + std::prev(next)->count == offset;
+        bool mergesNext = next != m_freeRanges.end() && offset + count == next->offset;
+
+        if (mergesPrev && mergesNext) {
+            std::prev(next)->count += count + next->count;
+            m_freeRanges.erase(next);
+        } else if (mergesPrev) {
+            std::prev(next)->count += count;
+        } else if (mergesNext) {
+            next->offset = offset;
+            next->count += count;
+        } else {
+            m_freeRanges.insert(next, {offset, count});
+        }
+    }
+
+    void VulkanRangeAllocator::grow(uint32_t newCapacity) {
+        MOE_ASSERT(newCapacity >= m_capacity, "Range allocators only grow");
+
+        uint32_t added = newCapacity - m_capacity;
+        if (added == 0) {
+            return;
+        }
+
+        if (!m_freeRanges.empty() && m_freeRanges.back().offset + m_freeRanges.back().count == m_capacity) {
+            m_freeRanges.back().count += added;
+        } else {
+            m_freeRanges.push_back({m_capacity, added});
+        }
+        m_capacity = newCapacity;
+    }
+
+    Vector<VulkanRangeAllocator::Move> VulkanRangeAllocator::compact() {
+        Vector<Range> live;
+        live.reserve(m_allocations.size());
+        for (auto& [offset, count]: m_allocations) {
+            live.push_back({offset, count});
+        }
+        std::sort(live.begin(), live.end(), [](const Range& a, const Range& b) { return a.offset < b.offset; });
+
+        Vector<Move> moves;
+        m_allocations.clear();
+
+        uint32_t packed = 0;
+        for (auto& range: live) {
+            if (range.offset != packed) {
+                moves.push_back({range.offset, packed, range.count});
+            }
+            m_allocations.emplace(packed, range.count);
+            packed += range.count;
+        }
+
+        m_freeRanges.clear();
+        if (packed < m_capacity) {
+            m_freeRanges.push_back({packed, m_capacity - packed});
+        }
+
+        return moves;
+    }
+
+    uint32_t VulkanRangeAllocator::remap(const Vector<Move>& moves, uint32_t offset) {
+        auto it = std::lower_bound(
+                moves.begin(), moves.end(), offset,
+                [](const Move& move, uint32_t value) { return move.srcOffset < value; });
+        if (it != moves.end() && it->srcOffset == offset) {
+            return it->dstOffset;
+        }
+        return offset;
+    }
+
+    uint32_t VulkanRangeAllocator::getLargestFreeRange() const {
+        uint32_t largest = 0;
+        for (auto& range: m_freeRanges) {
+            largest = std::max(largest, range.count);
+        }
+        return largest;
+    }
+}// namespace moe
\ No newline at end of file
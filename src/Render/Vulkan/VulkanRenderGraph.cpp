@@ -0,0 +1,475 @@
+#include "Render/Vulkan/VulkanRenderGraph.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace moe {
+    namespace {
+        struct AccessInfo {
+            VkPipelineStageFlags2 stages;
+            VkAccessFlags2 access;
+            VkImageLayout layout;
+        };
+
+        AccessInfo getAccessInfo(VulkanRGAccess access) {
+            switch (access) {
+                case VulkanRGAccess::ColorAttachment:
+                    return {VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
+                            VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT,
+                            VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL};
+                case VulkanRGAccess::DepthAttachment:
+                    return {VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT,
+                            VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+                            VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL};
+                case VulkanRGAccess::SampledFragment:
+                    return {VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
+                            VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
+                            VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL};
+                case VulkanRGAccess::StorageReadCompute:
+                    return {VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                            VK_ACCESS_2_SHADER_STORAGE_READ_BIT,
+                            VK_IMAGE_LAYOUT_GENERAL};
+                case VulkanRGAccess::StorageWriteCompute:
+                    return {VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                            VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                            VK_IMAGE_LAYOUT_GENERAL};
+                case VulkanRGAccess::StorageReadVertex:
+                    return {VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT,
+                            VK_ACCESS_2_SHADER_STORAGE_READ_BIT,
+                            VK_IMAGE_LAYOUT_GENERAL};
+                case VulkanRGAccess::IndirectRead:
+                    return {VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT,
+                            VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT,
+                            VK_IMAGE_LAYOUT_UNDEFINED};
+                case VulkanRGAccess::TransferSrc:
+                    return {VK_PIPELINE_STAGE_2_ALL_TRANSFER_BIT,
+                            VK_ACCESS_2_TRANSFER_READ_BIT,
+                            VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL};
+                case VulkanRGAccess::TransferDst:
+                    return {VK_PIPELINE_STAGE_2_ALL_TRANSFER_BIT,
+                            VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL};
+                case VulkanRGAccess::Present:
+                    // the present waits on a semaphore, the barrier only has to finish the layout transition
+                    return {VK_PIPELINE_STAGE_2_NONE,
+                            VK_ACCESS_2_NONE,
+                            VK_IMAGE_LAYOUT_PRESENT_SRC_KHR};
+            }
+            MOE_ASSERT(false, "Unknown render graph access");
+            return {};
+        }
+
+        // only writes have to be made available, reads are left out of the source access of a barrier
+        constexpr VkAccessFlags2 WRITE_ACCESS =
+                VK_ACCESS_2_SHADER_WRITE_BIT
+                | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT
+                | VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT
+                | VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT
+                | VK_ACCESS_2_TRANSFER_WRITE_BIT
+                | VK_ACCESS_2_MEMORY_WRITE_BIT;
+
+        // handles are pointers or 64 bit integers depending on the platform
+        template<typename Handle>
+        uint64_t handleKey(Handle handle) {
+            return (uint64_t) handle;
+        }
+    }// namespace
+
+    VulkanRenderGraph::PassBuilder& VulkanRenderGraph::PassBuilder::read(VulkanRGResourceId resource, VulkanRGAccess access) {
+        m_graph->addUse(m_pass, resource, access, false);
+        return *this;
+    }
+
+    VulkanRenderGraph::PassBuilder& VulkanRenderGraph::PassBuilder::write(VulkanRGResourceId resource, VulkanRGAccess access) {
+        m_graph->addUse(m_pass, resource, access, true);
+        return *this;
+    }
+
+    VulkanRenderGraph::PassBuilder& VulkanRenderGraph::PassBuilder::sideEffect() {
+        m_graph->m_passes[m_pass].sideEffect = true;
+        return *this;
+    }
+
+    void VulkanRenderGraph::init(ImageAllocator allocator, ImageReleaser releaser) {
+        MOE_ASSERT(!m_initialized, "VulkanRenderGraph already initialized");
+
+        m_allocateImage = std::move(allocator);
+        m_releaseImage = std::move(releaser);
+        m_frame = 0;
+
+        m_initialized = true;
+    }
+
+    void VulkanRenderGraph::destroy() {
+        MOE_ASSERT(m_initialized, "VulkanRenderGraph not initialized");
+
+        for (auto& pooled: m_imagePool) {
+            m_releaseImage(pooled.image);
+        }
+        m_imagePool.clear();
+        m_states.clear();
+        m_resources.clear();
+        m_passes.clear();
+        m_compiledPasses.clear();
+
+        m_initialized = false;
+    }
+
+    void VulkanRenderGraph::beginFrame() {
+        MOE_ASSERT(m_initialized, "VulkanRenderGraph not initialized");
+
+        ++m_frame;
+        m_resources.clear();
+        m_passes.clear();
+        m_compiledPasses.clear();
+        m_imageBarriers.clear();
+        m_bufferBarriers.clear();
+    }
+
+    VulkanRGResourceId VulkanRenderGraph::importImage(StringView name, VkImage image, VkImageAspectFlags aspect) {
+        return addResource(Resource{
+                .name = String(name),
+                .type = ResourceType::Image,
+                .image = image,
+                .aspect = aspect,
+        });
+    }
+
+    VulkanRGResourceId VulkanRenderGraph::importAcquiredImage(StringView name, VkImage image, VkPipelineStageFlags2 waitStage) {
+        auto resource = importImage(name, image, VK_IMAGE_ASPECT_COLOR_BIT);
+
+        // whatever the image went through before, the first use only has to wait for the semaphore
+        auto& state = m_states[handleKey(image)];
+        state = HandleState{};
+        state.readStages = waitStage;
+        state.lastFrame = m_frame;
+
+        return resource;
+    }
+
+    VulkanRGResourceId VulkanRenderGraph::importBuffer(StringView name, VkBuffer buffer) {
+        return addResource(Resource{
+                .name = String(name),
+                .type = ResourceType::Buffer,
+                .buffer = buffer,
+        });
+    }
+
+    VulkanRGResourceId VulkanRenderGraph::createImage(StringView name, VkFormat format, VkExtent3D extent, VkImageUsageFlags usage, VkImageAspectFlags aspect) {
+        return addResource(Resource{
+                .name = String(name),
+                .type = ResourceType::Image,
+                .aspect = aspect,
+                .transient = true,
+                .transientDesc = VulkanTransientImageDesc{format, extent, usage, 0, 0},
+        });
+    }
+
+    VulkanRenderGraph::PassBuilder VulkanRenderGraph::addPass(StringView name, Function<void(VkCommandBuffer)>&& record) {
+        MOE_ASSERT(m_initialized, "VulkanRenderGraph not initialized");
+
+        m_passes.push_back(Pass{
+                .name = String(name),
+                .record = std::move(record),
+        });
+        return PassBuilder{*this, static_cast<uint32_t>(m_passes.size() - 1)};
+    }
+
+    void VulkanRenderGraph::compile() {
+        MOE_ASSERT(m_initialized, "VulkanRenderGraph not initialized");
+
+        m_stats = {};
+        cullPasses();
+        allocateTransientImages();
+        planBarriers();
+        releaseStaleState();
+    }
+
+    const VulkanAllocatedImage& VulkanRenderGraph::getImage(VulkanRGResourceId resource) const {
+        MOE_ASSERT(resource < m_resources.size(), "Invalid render graph resource");
+        MOE_ASSERT(m_resources[resource].transient, "Only transient images are allocated by the render graph");
+
+        return m_imagePool[m_resources[resource].poolIndex].image;
+    }
+
+    VulkanRGResourceId VulkanRenderGraph::addResource(Resource&& resource) {
+        MOE_ASSERT(m_initialized, "VulkanRenderGraph not initialized");
+
+        m_resources.push_back(std::move(resource));
+        return static_cast<VulkanRGResourceId>(m_resources.size() - 1);
+    }
+
+    void VulkanRenderGraph::addUse(uint32_t pass, VulkanRGResourceId resource, VulkanRGAccess access, bool write) {
+        MOE_ASSERT(resource < m_resources.size(), "Invalid render graph resource");
+
+        auto info = getAccessInfo(access);
+        auto& uses = m_passes[pass].uses;
+        for (auto& use: uses) {
+            if (use.resource != resource) {
+                continue;
+            }
+            MOE_ASSERT((m_resources[resource].type == ResourceType::Buffer || use.layout == info.layout),
+                       "A pass cannot use one image in two layouts");
+            use.stages |= info.stages;
+            use.access |= info.access;
+            use.write = use.write || write;
+            return;
+        }
+
+        uses.push_back(Use{
+                .resource = resource,
+                .stages = info.stages,
+                .access = info.access,
+                .layout = info.layout,
+                .write = write,
+        });
+    }
+
+    void VulkanRenderGraph::cullPasses() {
+        // a pass lives if it has side effects or writes something a later live pass uses
+        Vector<bool> needed(m_resources.size(), false);
+        for (size_t i = m_passes.size(); i-- > 0;) {
+            auto& pass = m_passes[i];
+
+            bool live = pass.sideEffect;
+            for (auto& use: pass.uses) {
+                live = live || (use.write && needed[use.resource]);
+            }
+
+            pass.culled = !live;
+            if (!live) {
+                ++m_stats.culledPasses;
+                continue;
+            }
+
+            // a write keeps what it does not overwrite, so the passes writing before it stay live too
+            for (auto& use: pass.uses) {
+                needed[use.resource] = true;
+            }
+        }
+        m_stats.passes = static_cast<uint32_t>(m_passes.size()) - m_stats.culledPasses;
+    }
+
+    void VulkanRenderGraph::allocateTransientImages() {
+        constexpr uint32_t UNUSED = std::numeric_limits<uint32_t>::max();
+
+        for (auto& resource: m_resources) {
+            resource.transientDesc.firstUse = UNUSED;
+            resource.transientDesc.lastUse = 0;
+        }
+
+        // lifetimes in steps of the live passes, a culled pass neither allocates nor keeps an image alive
+        uint32_t step = 0;
+        for (auto& pass: m_passes) {
+            if (pass.culled) {
+                continue;
+            }
+            for (auto& use: pass.uses) {
+                auto& desc = m_resources[use.resource].transientDesc;
+                desc.firstUse = std::min(desc.firstUse, step);
+                desc.lastUse = std::max(desc.lastUse, step);
+            }
+            ++step;
+        }
+
+        Vector<VulkanTransientImageDesc> descs;
+        Vector<VulkanRGResourceId> descResources;
+        for (VulkanRGResourceId id = 0; id < m_resources.size(); ++id) {
+            auto& resource = m_resources[id];
+            if (resource.transient && resource.transientDesc.firstUse != UNUSED) {
+                descs.push_back(resource.transientDesc);
+                descResources.push_back(id);
+            }
+        }
+
+        auto assignment = VkTransient::assign(descs);
+
+        // physical images take a pooled image of the same kind, so steady frames never allocate
+        for (auto& pooled: m_imagePool) {
+            pooled.used = false;
+        }
+        Vector<uint32_t> physicalPoolIndices;
+        physicalPoolIndices.reserve(assignment.physicalDescs.size());
+        for (auto descIndex: assignment.physicalDescs) {
+            auto& desc = descs[descIndex];
+            auto it = std::find_if(m_imagePool.begin(), m_imagePool.end(), [&](const PooledImage& pooled) {
+                return !pooled.used
+                       && pooled.format == desc.format
+                       && pooled.usage == desc.usage
+                       && pooled.extent.width == desc.extent.width
+                       && pooled.extent.height == desc.extent.height
+                       && pooled.extent.depth == desc.extent.depth;
+            });
+            if (it == m_imagePool.end()) {
+                m_imagePool.push_back(PooledImage{
+                        .image = m_allocateImage(desc),
+                        .format = desc.format,
+                        .extent = desc.extent,
+                        .usage = desc.usage,
+                });
+                it = m_imagePool.end() - 1;
+            }
+            it->used = true;
+            physicalPoolIndices.push_back(static_cast<uint32_t>(it - m_imagePool.begin()));
+        }
+
+        // images no frame wants anymore, e.g. after a resize, go back to the owner
+        Vector<uint32_t> remap(m_imagePool.size());
+        uint32_t kept = 0;
+        for (uint32_t i = 0; i < m_imagePool.size(); ++i) {
+            if (!m_imagePool[i].used) {
+                m_states.erase(handleKey(m_imagePool[i].image.image));
+                m_releaseImage(m_imagePool[i].image);
+                continue;
+            }
+            remap[i] = kept;
+            m_imagePool[kept++] = m_imagePool[i];
+        }
+        m_imagePool.resize(kept);
+
+        for (size_t i = 0; i < descResources.size(); ++i) {
+            auto& resource = m_resources[descResources[i]];
+            resource.poolIndex = remap[physicalPoolIndices[assignment.physicalIndices[i]]];
+            resource.image = m_imagePool[resource.poolIndex].image.image;
+        }
+
+        m_stats.transientImages = static_cast<uint32_t>(descs.size());
+        m_stats.physicalImages = static_cast<uint32_t>(assignment.physicalDescs.size());
+    }
+
+    void VulkanRenderGraph::planBarriers() {
+        m_compiledPasses.clear();
+        m_imageBarriers.clear();
+        m_bufferBarriers.clear();
+
+        Vector<bool> touched(m_resources.size(), false);
+        for (uint32_t passIndex = 0; passIndex < m_passes.size(); ++passIndex) {
+            auto& pass = m_passes[passIndex];
+            if (pass.culled) {
+                continue;
+            }
+
+            auto compiled = CompiledPass{
+                    .pass = passIndex,
+                    .firstImageBarrier = static_cast<uint32_t>(m_imageBarriers.size()),
+                    .imageBarrierCount = 0,
+                    .firstBufferBarrier = static_cast<uint32_t>(m_bufferBarriers.size()),
+                    .bufferBarrierCount = 0,
+            };
+
+            for (auto& use: pass.uses) {
+                auto& resource = m_resources[use.resource];
+                bool isImage = resource.type == ResourceType::Image;
+                auto key = isImage ? handleKey(resource.image) : handleKey(resource.buffer);
+                if (key == 0) {
+                    continue;
+                }
+
+                auto& state = m_states[key];
+
+                // the first write of a resource in a frame discards it, nothing is carried over from the last frame
+                bool discard = use.write && !touched[use.resource];
+                touched[use.resource] = true;
+
+                auto oldLayout = discard ? VK_IMAGE_LAYOUT_UNDEFINED : state.layout;
+                bool transition = isImage && oldLayout != use.layout;
+
+                VkPipelineStageFlags2 srcStages;
+                VkAccessFlags2 srcAccess;
+                bool needsBarrier;
+                if (use.write || transition) {
+                    // writes and layout transitions wait for every earlier use,
+                    // reads since the last write already waited on it and made it available, so they stand in for it
+                    bool read = state.readStages != VK_PIPELINE_STAGE_2_NONE;
+                    srcStages = read ? state.readStages : state.writeStages;
+                    srcAccess = read ? VK_ACCESS_2_NONE : state.writeAccess;
+                    needsBarrier = transition || srcStages != VK_PIPELINE_STAGE_2_NONE;
+
+                    if (isImage) {
+                        state.layout = use.layout;
+                    }
+                    if (use.write) {
+                        state.writeStages = use.stages;
+                        state.writeAccess = use.access & WRITE_ACCESS;
+                        state.readStages = VK_PIPELINE_STAGE_2_NONE;
+                        state.readAccess = VK_ACCESS_2_NONE;
+                    } else {
+                        // later reads in other stages still have to wait for the transition
+                        state.writeStages = use.stages;
+                        state.writeAccess = VK_ACCESS_2_NONE;
+                        state.readStages = use.stages;
+                        state.readAccess = use.access;
+                    }
+                } else {
+                    // a read only waits once per stage and access on the last write
+                    bool covered = (use.stages & ~state.readStages) == 0 && (use.access & ~state.readAccess) == 0;
+                    srcStages = state.writeStages;
+                    srcAccess = state.writeAccess;
+                    needsBarrier = state.writeStages != VK_PIPELINE_STAGE_2_NONE && !covered;
+
+                    state.readStages |= use.stages;
+                    state.readAccess |= use.access;
+                }
+                state.lastFrame = m_frame;
+
+                if (!needsBarrier) {
+                    continue;
+                }
+
+                if (isImage) {
+                    m_imageBarriers.push_back(VkImageMemoryBarrier2{
+                            .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2,
+                            .srcStageMask = srcStages,
+                            .srcAccessMask = srcAccess,
+                            .dstStageMask = use.stages,
+                            .dstAccessMask = use.access,
+                            .oldLayout = oldLayout,
+                            .newLayout = use.layout,
+                            .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                            .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                            .image = resource.image,
+                            .subresourceRange = VkImageSubresourceRange{
+                                    .aspectMask = resource.aspect,
+                                    .baseMipLevel = 0,
+                                    .levelCount = VK_REMAINING_MIP_LEVELS,
+                                    .baseArrayLayer = 0,
+                                    .layerCount = VK_REMAINING_ARRAY_LAYERS,
+                            },
+                    });
+                    ++compiled.imageBarrierCount;
+                } else {
+                    m_bufferBarriers.push_back(VkBufferMemoryBarrier2{
+                            .sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2,
+                            .srcStageMask = srcStages,
+                            .srcAccessMask = srcAccess,
+                            .dstStageMask = use.stages,
+                            .dstAccessMask = use.access,
+                            .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                            .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                            .buffer = resource.buffer,
+                            .offset = 0,
+                            .size = VK_WHOLE_SIZE,
+                    });
+                    ++compiled.bufferBarrierCount;
+                }
+            }
+
+            if (compiled.imageBarrierCount > 0 || compiled.bufferBarrierCount > 0) {
+                ++m_stats.barrierBatches;
+            }
+            m_stats.imageBarriers += compiled.imageBarrierCount;
+            m_stats.bufferBarriers += compiled.bufferBarrierCount;
+            m_compiledPasses.push_back(compiled);
+        }
+    }
+
+    void VulkanRenderGraph::releaseStaleState() {
+        for (auto it = m_states.begin(); it != m_states.end();) {
+            if (m_frame - it->second.lastFrame > STATE_RETENTION_FRAMES) {
+                it = m_states.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+}// namespace moe
\ No newline at end of file
@@ -0,0 +1,25 @@
+#include "Render/Vulkan/VulkanRenderGraph.hpp"
+
+namespace moe {
+    void VulkanRenderGraph::execute(VkCommandBuffer cmdBuffer) {
+        MOE_ASSERT(m_initialized, "VulkanRenderGraph not initialized");
+
+        for (auto& compiled: m_compiledPasses) {
+            if (compiled.imageBarrierCount > 0 || compiled.bufferBarrierCount > 0) {
+                const auto dependencyInfo = VkDependencyInfo{
+                        .sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
+                        .bufferMemoryBarrierCount = compiled.bufferBarrierCount,
+                        .pBufferMemoryBarriers = m_bufferBarriers.data() + compiled.firstBufferBarrier,
+                        .imageMemoryBarrierCount = compiled.imageBarrierCount,
+                        .pImageMemoryBarriers = m_imageBarriers.data() + compiled.firstImageBarrier,
+                };
+                vkCmdPipelineBarrier2(cmdBuffer, &dependencyInfo);
+            }
+
+            auto& pass = m_passes[compiled.pass];
+            if (pass.record) {
+                pass.record(cmdBuffer);
+            }
+        }
+    }
+}// namespace moe
\ No newline at end of file
@@ -19,9 +19,13 @@ namespace moe {
                         .meshId = sceneMesh.primitives[i],
                         .materialId = sceneMesh.primitiveMaterials[i],
                         .transform = worldTransform,
-                        .sortKey = 0,
                 };
 
+                // skinned vertices move away from the bind pose, their bounds are only known on the gpu
+                if (drawContext.jointMatrixStartIndex == INVALID_JOINT_MATRIX_START_INDEX && i < sceneMesh.primitiveBounds.size()) {
+                    packet.bounds = sceneMesh.primitiveBounds[i].transformed(worldTransform);
+                }
+
                 if (drawContext.jointMatrixStartIndex != INVALID_JOINT_MATRIX_START_INDEX) {
                     packet.skinned = true;
                     packet.jointMatrixStartIndex = drawContext.jointMatrixStartIndex;
@@ -30,6 +34,13 @@ namespace moe {
                     packet.jointMatrixStartIndex = INVALID_JOINT_MATRIX_START_INDEX;
                 }
 
+                packet.sortKey = VkSortKey::make(
+                        VkSortKey::Pass::Opaque,
+                        packet.skinned ? VkSortKey::Pipeline::Skinned : VkSortKey::Pipeline::Static,
+                        packet.materialId,
+                        packet.meshId,
+                        0);
+
                 packets.push_back(packet);
             }
         }
@@ -0,0 +1,80 @@
+#include "Render/Vulkan/VulkanSortKey.hpp"
+
+#include <algorithm>
+
+namespace moe {
+    namespace VkSortKey {
+        uint32_t quantizeDepth(const glm::mat4& viewProjection, const glm::vec3& position) {
+            constexpr float DEPTH_MAX = static_cast<float>((1u << DEPTH_BITS) - 1);
+
+            glm::vec4 clip = viewProjection * glm::vec4(position, 1.0f);
+            // behind a perspective camera, draw it first like anything at the near plane
+            if (clip.w <= 0.0f) {
+                return 0;
+            }
+            float depth = glm::clamp(clip.z / clip.w, 0.0f, 1.0f);
+            return static_cast<uint32_t>(depth * DEPTH_MAX);
+        }
+    }// namespace VkSortKey
+
+    void VulkanDrawSorter::sort(Vector<uint64_t>& keys, Vector<uint32_t>& indices) {
+        MOE_ASSERT(keys.size() == indices.size(), "Every index needs a key");
+
+        constexpr uint32_t DIGIT_BITS = 8;
+        constexpr uint32_t BUCKETS = 1u << DIGIT_BITS;
+        constexpr uint32_t DIGITS = 64 / DIGIT_BITS;
+
+        const size_t count = keys.size();
+        if (count < 2) {
+            return;
+        }
+
+        // every digit's histogram in one read of the keys
+        uint32_t histograms[DIGITS][BUCKETS] = {};
+        for (auto key: keys) {
+            for (uint32_t d = 0; d < DIGITS; ++d) {
+                ++histograms[d][(key >> (d * DIGIT_BITS)) & (BUCKETS - 1)];
+            }
+        }
+
+        m_keysScratch.resize(count);
+        m_indicesScratch.resize(count);
+
+        uint64_t* srcKeys = keys.data();
+        uint32_t* srcIndices = indices.data();
+        uint64_t* dstKeys = m_keysScratch.data();
+        uint32_t* dstIndices = m_indicesScratch.data();
+
+        for (uint32_t d = 0; d < DIGITS; ++d) {
+            auto& histogram = histograms[d];
+            const uint32_t shift = d * DIGIT_BITS;
+
+            // all keys share this digit, the pass would copy them in place
+            if (histogram[(srcKeys[0] >> shift) & (BUCKETS - 1)] == count) {
+                continue;
+            }
+
+            uint32_t offsets[BUCKETS];
+            uint32_t sum = 0;
+            for (uint32_t b = 0; b < BUCKETS; ++b) {
+                offsets[b] = sum;
+                sum += histogram[b];
+            }
+
+            for (size_t i = 0; i < count; ++i) {
+                auto slot = offsets[(srcKeys[i] >> shift) & (BUCKETS - 1)]++;
+                dstKeys[slot] = srcKeys[i];
+                dstIndices[slot] = srcIndices[i];
+            }
+
+            std::swap(srcKeys, dstKeys);
+            std::swap(srcIndices, dstIndices);
+        }
+
+        // an odd number of passes left the result in the scratch buffers
+        if (srcKeys != keys.data()) {
+            std::copy(srcKeys, srcKeys + count, keys.data());
+            std::copy(srcIndices, srcIndices + count, indices.data());
+        }
+    }
+}// namespace moe
\ No newline at end of file
@@ -0,0 +1,55 @@
+#include "Render/Vulkan/VulkanTransientImages.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+namespace moe {
+    namespace VkTransient {
+        namespace {
+            bool isCompatible(const VulkanTransientImageDesc& a, const VulkanTransientImageDesc& b) {
+                return a.format == b.format
+                       && a.extent.width == b.extent.width
+                       && a.extent.height == b.extent.height
+                       && a.extent.depth == b.extent.depth
+                       && a.usage == b.usage;
+            }
+        }// namespace
+
+        Assignment assign(Span<const VulkanTransientImageDesc> descs) {
+            Assignment assignment;
+            assignment.physicalIndices.resize(descs.size());
+
+            Vector<uint32_t> order(descs.size());
+            std::iota(order.begin(), order.end(), 0);
+            std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+                return descs[a].firstUse < descs[b].firstUse;
+            });
+
+            // the last step each physical image is read at, by whichever desc holds it now
+            Vector<uint32_t> busyUntil;
+            for (auto index: order) {
+                auto& desc = descs[index];
+                MOE_ASSERT(desc.firstUse <= desc.lastUse, "Transient image is read before it is written");
+
+                // a read at the same step as the write would be a feedback loop, so the free step must be strictly earlier
+                uint32_t chosen = static_cast<uint32_t>(busyUntil.size());
+                for (uint32_t p = 0; p < busyUntil.size(); ++p) {
+                    if (busyUntil[p] < desc.firstUse && isCompatible(descs[assignment.physicalDescs[p]], desc)) {
+                        chosen = p;
+                        break;
+                    }
+                }
+
+                if (chosen == busyUntil.size()) {
+                    busyUntil.push_back(desc.lastUse);
+                    assignment.physicalDescs.push_back(index);
+                } else {
+                    busyUntil[chosen] = desc.lastUse;
+                }
+                assignment.physicalIndices[index] = chosen;
+            }
+
+            return assignment;
+        }
+    }// namespace VkTransient
+}// namespace moe
\ No newline at end of file
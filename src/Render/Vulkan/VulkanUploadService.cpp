@@ -0,0 +1,398 @@
+#include "Render/Vulkan/VulkanUploadService.hpp"
+#include "Render/Vulkan/VulkanEngine.hpp"
+#include "Render/Vulkan/VulkanInitializers.hpp"
+#include "Render/Vulkan/VulkanUtils.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace moe {
+    void VulkanUploadService::init(VulkanEngine& engine, VkQueue queue, uint32_t queueFamilyIndex) {
+        m_engine = &engine;
+        m_queue = queue;
+        m_queueFamilyIndex = queueFamilyIndex;
+        m_graphicsQueueFamilyIndex = engine.m_graphicsQueueFamilyIndex;
+
+        auto poolInfo = VkInit::commandPoolCreateInfo(queueFamilyIndex, VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT);
+        MOE_VK_CHECK(vkCreateCommandPool(engine.m_device, &poolInfo, nullptr, &m_commandPool));
+
+        Array<VkCommandBuffer, BATCH_COUNT> cmdBuffers;
+        auto allocInfo = VkInit::commandBufferAllocateInfo(m_commandPool, BATCH_COUNT);
+        MOE_VK_CHECK(vkAllocateCommandBuffers(engine.m_device, &allocInfo, cmdBuffers.data()));
+        for (uint32_t i = 0; i < BATCH_COUNT; ++i) {
+            m_batches[i] = {};
+            m_batches[i].cmdBuffer = cmdBuffers[i];
+        }
+
+        VkSemaphoreTypeCreateInfo timelineInfo{};
+        timelineInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+        timelineInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+        timelineInfo.initialValue = 0;
+
+        auto semaphoreInfo = VkInit::semaphoreCreateInfo();
+        semaphoreInfo.pNext = &timelineInfo;
+        MOE_VK_CHECK(vkCreateSemaphore(engine.m_device, &semaphoreInfo, nullptr, &m_timeline));
+
+        m_ring = engine.allocateBuffer(STAGING_RING_SIZE, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_MEMORY_USAGE_CPU_ONLY);
+        m_ringHead = 0;
+        m_ringUsed = 0;
+
+        m_submittedValue = 0;
+        m_openBatch = NO_BATCH;
+        m_inFlight.clear();
+        m_stats = {};
+
+        m_initialized = true;
+    }
+
+    void VulkanUploadService::destroy() {
+        MOE_ASSERT(m_initialized, "VulkanUploadService not initialized");
+
+        vkDeviceWaitIdle(m_engine->m_device);
+
+        for (auto& batch: m_batches) {
+            for (auto& buffer: batch.oversizedStaging) {
+                m_engine->destroyBuffer(buffer);
+            }
+            batch = {};
+        }
+        m_inFlight.clear();
+        m_openBatch = NO_BATCH;
+
+        m_pendingBufferAcquires.clear();
+        m_pendingImageAcquires.clear();
+        m_pendingMipmaps.clear();
+
+        m_engine->destroyBuffer(m_ring);
+        vkDestroySemaphore(m_engine->m_device, m_timeline, nullptr);
+        vkDestroyCommandPool(m_engine->m_device, m_commandPool, nullptr);
+
+        m_engine = nullptr;
+        m_initialized = false;
+    }
+
+    VulkanUploadTicket VulkanUploadService::uploadBuffer(VkBuffer dst, VkDeviceSize dstOffset, const void* data, VkDeviceSize size) {
+        MOE_ASSERT(m_initialized, "VulkanUploadService not initialized");
+
+        auto staging = stage(size);
+        std::memcpy(staging.data, data, size);
+
+        auto& batch = openBatch();
+
+        VkBufferCopy copy{};
+        copy.srcOffset = staging.offset;
+        copy.dstOffset = dstOffset;
+        copy.size = size;
+        vkCmdCopyBuffer(batch.cmdBuffer, staging.buffer, dst, 1, &copy);
+
+        if (isDedicatedQueue()) {
+            VkBufferMemoryBarrier2 release{};
+            release.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2;
+            release.srcStageMask = VK_PIPELINE_STAGE_2_COPY_BIT;
+            release.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+            release.srcQueueFamilyIndex = m_queueFamilyIndex;
+            release.dstQueueFamilyIndex = m_graphicsQueueFamilyIndex;
+            release.buffer = dst;
+            release.offset = dstOffset;
+            release.size = size;
+            batch.bufferReleases.push_back(release);
+        }
+
+        ++batch.copies;
+        ++m_stats.copies;
+        m_stats.bytes += size;
+
+        return {batch.value};
+    }
+
+    VulkanUploadTicket VulkanUploadService::uploadImage(const VulkanAllocatedImage& image, Span<void* const> layers, VkDeviceSize layerSize, bool mipmap) {
+        MOE_ASSERT(m_initialized, "VulkanUploadService not initialized");
+
+        auto layerCount = static_cast<uint32_t>(layers.size());
+        auto staging = stage(layerSize * layerCount);
+        for (uint32_t i = 0; i < layerCount; ++i) {
+            std::memcpy(staging.data + layerSize * i, layers[i], layerSize);
+        }
+
+        auto& batch = openBatch();
+        auto cmdBuffer = batch.cmdBuffer;
+        VkExtent2D extent{image.imageExtent.width, image.imageExtent.height};
+
+        VkUtils::transitionImage(cmdBuffer, image.image, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+
+        Vector<VkBufferImageCopy> copyRegions(layerCount);
+        for (uint32_t i = 0; i < layerCount; ++i) {
+            auto& region = copyRegions[i];
+            region.bufferOffset = staging.offset + layerSize * i;
+            region.bufferRowLength = 0;
+            region.bufferImageHeight = 0;
+
+            region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            region.imageSubresource.mipLevel = 0;
+            region.imageSubresource.baseArrayLayer = i;
+            region.imageSubresource.layerCount = 1;
+            region.imageExtent = image.imageExtent;
+        }
+        vkCmdCopyBufferToImage(
+                cmdBuffer,
+                staging.buffer,
+                image.image,
+                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                static_cast<uint32_t>(copyRegions.size()),
+                copyRegions.data());
+
+        if (isDedicatedQueue()) {
+            // blits need a graphics queue, a mipmapped image stays a transfer destination until it is acquired
+            VkImageMemoryBarrier2 release{};
+            release.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+            release.srcStageMask = VK_PIPELINE_STAGE_2_COPY_BIT;
+            release.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+            release.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            release.newLayout = mipmap ? VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL : VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+            release.srcQueueFamilyIndex = m_queueFamilyIndex;
+            release.dstQueueFamilyIndex = m_graphicsQueueFamilyIndex;
+            release.image = image.image;
+            release.subresourceRange = VkUtils::makeImageSubresourceRange(VK_IMAGE_ASPECT_COLOR_BIT);
+            batch.imageReleases.push_back(release);
+            if (mipmap) {
+                batch.mipmapAfterAcquire.emplace_back(image.image, extent);
+            }
+        } else if (mipmap) {
+            VkUtils::generateMipmaps(cmdBuffer, image.image, extent);
+        } else {
+            VkUtils::transitionImage(cmdBuffer, image.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+        }
+
+        ++batch.copies;
+        ++m_stats.copies;
+        m_stats.bytes += layerSize * layerCount;
+
+        return {batch.value};
+    }
+
+    void VulkanUploadService::flush() {
+        MOE_ASSERT(m_initialized, "VulkanUploadService not initialized");
+
+        if (m_openBatch == NO_BATCH || m_batches[m_openBatch].copies == 0) {
+            return;
+        }
+
+        auto& batch = m_batches[m_openBatch];
+
+        if (!batch.bufferReleases.empty() || !batch.imageReleases.empty()) {
+            VkDependencyInfo dependencyInfo{};
+            dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+            dependencyInfo.bufferMemoryBarrierCount = static_cast<uint32_t>(batch.bufferReleases.size());
+            dependencyInfo.pBufferMemoryBarriers = batch.bufferReleases.data();
+            dependencyInfo.imageMemoryBarrierCount = static_cast<uint32_t>(batch.imageReleases.size());
+            dependencyInfo.pImageMemoryBarriers = batch.imageReleases.data();
+            vkCmdPipelineBarrier2(batch.cmdBuffer, &dependencyInfo);
+
+            // the acquiring half repeats the transfer with the destination's stages, see recordAcquires
+            for (auto barrier: batch.bufferReleases) {
+                barrier.srcStageMask = VK_PIPELINE_STAGE_2_NONE;
+                barrier.srcAccessMask = VK_ACCESS_2_NONE;
+                barrier.dstStageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+                barrier.dstAccessMask = VK_ACCESS_2_MEMORY_READ_BIT;
+                m_pendingBufferAcquires.push_back(barrier);
+            }
+            for (auto barrier: batch.imageReleases) {
+                barrier.srcStageMask = VK_PIPELINE_STAGE_2_NONE;
+                barrier.srcAccessMask = VK_ACCESS_2_NONE;
+                barrier.dstStageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+                barrier.dstAccessMask = VK_ACCESS_2_MEMORY_READ_BIT | VK_ACCESS_2_MEMORY_WRITE_BIT;
+                m_pendingImageAcquires.push_back(barrier);
+            }
+            m_pendingMipmaps.insert(m_pendingMipmaps.end(), batch.mipmapAfterAcquire.begin(), batch.mipmapAfterAcquire.end());
+
+            batch.bufferReleases.clear();
+            batch.imageReleases.clear();
+            batch.mipmapAfterAcquire.clear();
+        }
+
+        MOE_VK_CHECK(vkEndCommandBuffer(batch.cmdBuffer));
+
+        auto cmdSubmitInfo = VkInit::commandBufferSubmitInfo(batch.cmdBuffer);
+        auto signalInfo = VkInit::semaphoreSubmitInfo(m_timeline, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT);
+        signalInfo.value = batch.value;
+        auto submitInfo = VkInit::submitInfo(&cmdSubmitInfo, nullptr, &signalInfo);
+        MOE_VK_CHECK(vkQueueSubmit2(m_queue, 1, &submitInfo, VK_NULL_HANDLE));
+
+        m_submittedValue = batch.value;
+        m_inFlight.push_back(m_openBatch);
+        m_openBatch = NO_BATCH;
+        ++m_stats.submissions;
+
+        reclaim();
+    }
+
+    bool VulkanUploadService::isComplete(VulkanUploadTicket ticket) const {
+        return ticket.value <= getCompletedValue();
+    }
+
+    void VulkanUploadService::wait(VulkanUploadTicket ticket) {
+        MOE_ASSERT(m_initialized, "VulkanUploadService not initialized");
+
+        if (ticket.value > m_submittedValue) {
+            flush();
+        }
+        waitFor(ticket.value);
+        reclaim();
+    }
+
+    void VulkanUploadService::finish() {
+        MOE_ASSERT(m_initialized, "VulkanUploadService not initialized");
+
+        flush();
+        waitFor(m_submittedValue);
+        reclaim();
+
+        if (!m_pendingBufferAcquires.empty() || !m_pendingImageAcquires.empty()) {
+            m_engine->immediateSubmit([this](VkCommandBuffer cmdBuffer) {
+                recordAcquires(cmdBuffer);
+            });
+        }
+    }
+
+    void VulkanUploadService::recordAcquires(VkCommandBuffer cmdBuffer) {
+        MOE_ASSERT(m_initialized, "VulkanUploadService not initialized");
+
+        if (m_pendingBufferAcquires.empty() && m_pendingImageAcquires.empty()) {
+            return;
+        }
+
+        VkDependencyInfo dependencyInfo{};
+        dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+        dependencyInfo.bufferMemoryBarrierCount = static_cast<uint32_t>(m_pendingBufferAcquires.size());
+        dependencyInfo.pBufferMemoryBarriers = m_pendingBufferAcquires.data();
+        dependencyInfo.imageMemoryBarrierCount = static_cast<uint32_t>(m_pendingImageAcquires.size());
+        dependencyInfo.pImageMemoryBarriers = m_pendingImageAcquires.data();
+        vkCmdPipelineBarrier2(cmdBuffer, &dependencyInfo);
+
+        for (auto& [image, extent]: m_pendingMipmaps) {
+            VkUtils::generateMipmaps(cmdBuffer, image, extent);
+        }
+
+        m_pendingBufferAcquires.clear();
+        m_pendingImageAcquires.clear();
+        m_pendingMipmaps.clear();
+    }
+
+    VkSemaphoreSubmitInfo VulkanUploadService::getWaitInfo() const {
+        auto waitInfo = VkInit::semaphoreSubmitInfo(m_timeline, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT);
+        // waiting on a value the semaphore already reached costs nothing
+        waitInfo.value = m_submittedValue;
+        return waitInfo;
+    }
+
+    VulkanUploadService::Batch& VulkanUploadService::openBatch() {
+        if (m_openBatch != NO_BATCH) {
+            return m_batches[m_openBatch];
+        }
+
+        reclaim();
+        if (m_inFlight.size() == BATCH_COUNT) {
+            // every batch is still on the gpu, the oldest frees up first
+            waitFor(m_batches[m_inFlight.front()].value);
+            reclaim();
+        }
+
+        for (uint32_t i = 0; i < BATCH_COUNT; ++i) {
+            bool inFlight = std::find(m_inFlight.begin(), m_inFlight.end(), i) != m_inFlight.end();
+            if (!inFlight) {
+                m_openBatch = i;
+                break;
+            }
+        }
+        MOE_ASSERT(m_openBatch != NO_BATCH, "No free upload batch");
+
+        auto& batch = m_batches[m_openBatch];
+        batch.value = m_submittedValue + 1;
+        batch.copies = 0;
+
+        MOE_VK_CHECK(vkResetCommandBuffer(batch.cmdBuffer, 0));
+        auto beginInfo = VkInit::commandBufferBeginInfo(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+        MOE_VK_CHECK(vkBeginCommandBuffer(batch.cmdBuffer, &beginInfo));
+
+        return batch;
+    }
+
+    VulkanUploadService::Staging VulkanUploadService::stage(VkDeviceSize size) {
+        // half the ring would stall every other upload behind this one
+        if (size > STAGING_RING_SIZE / 2) {
+            auto buffer = m_engine->allocateBuffer(size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_MEMORY_USAGE_CPU_ONLY);
+            openBatch().oversizedStaging.push_back(buffer);
+            ++m_stats.oversized;
+            return {buffer.buffer, 0, static_cast<uint8_t*>(buffer.vmaAllocationInfo.pMappedData)};
+        }
+
+        VkDeviceSize offset = (m_ringHead + STAGING_ALIGNMENT - 1) & ~(STAGING_ALIGNMENT - 1);
+        VkDeviceSize padding = offset - m_ringHead;
+        if (offset + size > STAGING_RING_SIZE) {
+            // the tail of the ring is too short, skip it and start over at the front
+            padding = STAGING_RING_SIZE - m_ringHead;
+            offset = 0;
+        }
+
+        while (m_ringUsed + padding + size > STAGING_RING_SIZE) {
+            if (m_inFlight.empty()) {
+                // the open batch filled the ring on its own
+                flush();
+            }
+            waitFor(m_batches[m_inFlight.front()].value);
+            reclaim();
+        }
+
+        auto& batch = openBatch();
+        batch.stagingBytes += padding + size;
+        m_ringUsed += padding + size;
+        m_ringHead = offset + size;
+
+        return {m_ring.buffer, offset, static_cast<uint8_t*>(m_ring.vmaAllocationInfo.pMappedData) + offset};
+    }
+
+    uint64_t VulkanUploadService::getCompletedValue() const {
+        uint64_t value = 0;
+        MOE_VK_CHECK(vkGetSemaphoreCounterValue(m_engine->m_device, m_timeline, &value));
+        return value;
+    }
+
+    void VulkanUploadService::waitFor(uint64_t value) {
+        if (value <= getCompletedValue()) {
+            return;
+        }
+
+        auto stallStart = std::chrono::steady_clock::now();
+
+        VkSemaphoreWaitInfo waitInfo{};
+        waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+        waitInfo.semaphoreCount = 1;
+        waitInfo.pSemaphores = &m_timeline;
+        waitInfo.pValues = &value;
+        MOE_VK_CHECK(vkWaitSemaphores(m_engine->m_device, &waitInfo, UINT64_MAX));
+
+        ++m_stats.stalls;
+        m_stats.stallMs += std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - stallStart).count();
+    }
+
+    void VulkanUploadService::reclaim() {
+        if (m_inFlight.empty()) {
+            return;
+        }
+
+        auto completed = getCompletedValue();
+        while (!m_inFlight.empty() && m_batches[m_inFlight.front()].value <= completed) {
+            auto& batch = m_batches[m_inFlight.front()];
+
+            m_ringUsed -= batch.stagingBytes;
+            batch.stagingBytes = 0;
+            for (auto& buffer: batch.oversizedStaging) {
+                m_engine->destroyBuffer(buffer);
+            }
+            batch.oversizedStaging.clear();
+
+            m_inFlight.pop_front();
+        }
+    }
+}// namespace moe
\ No newline at end of file
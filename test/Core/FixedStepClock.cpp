@@ -0,0 +1,64 @@
+#include "Core/FixedStepClock.hpp"
+
+#include "SimulatedTime.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+using namespace std::chrono_literals;
+
+TEST_CASE("FixedStepClock measures jitter against the grid", "[core][fixed_step_clock]") {
+    moe::Test::SimulatedTime time;
+    // every other wake-up is a millisecond late, each interval is a step plus or minus 1ms
+    time.overshoots = {0ms, 1ms};
+
+    moe::FixedStepClock clock({.step = 10ms}, time.source());
+    clock.start();
+
+    for (int i = 0; i < 100; ++i) {
+        REQUIRE(clock.waitForNextTick() == 1);
+        time.now += 2ms;
+        clock.endTick();
+    }
+
+    auto stats = clock.collectStats();
+    REQUIRE(stats.ticks == 100);
+    REQUIRE(stats.catchUpTicks == 0);
+    REQUIRE(stats.droppedTicks == 0);
+    REQUIRE(stats.jitter.samples == 99);
+    REQUIRE(stats.jitter.p50Ms == 1.0f);
+    REQUIRE(stats.jitter.maxMs == 1.0f);
+    REQUIRE(stats.timingError.maxMs == 1.0f);
+    REQUIRE(stats.work.p50Ms == 2.0f);
+    // 2ms of work every 10ms
+    REQUIRE(stats.busyPercent > 19.0f);
+    REQUIRE(stats.busyPercent < 21.0f);
+}
+
+TEST_CASE("FixedStepClock catches up in bounded substeps after a stall", "[core][fixed_step_clock]") {
+    moe::Test::SimulatedTime time;
+    moe::FixedStepClock clock({.step = 10ms, .maxSubsteps = 4}, time.source());
+    clock.start();
+
+    REQUIRE(clock.waitForNextTick() == 1);
+    clock.endTick();
+
+    // two steps behind, both run back to back
+    time.now += 25ms;
+    REQUIRE(clock.waitForNextTick() == 2);
+    clock.endTick();
+    REQUIRE(clock.waitForNextTick() == 1);
+    clock.endTick();
+
+    // ten steps behind, only four may run back to back
+    time.now += 100ms;
+    REQUIRE(clock.waitForNextTick() == 4);
+    clock.endTick();
+
+    auto stats = clock.collectStats();
+    REQUIRE(stats.ticks == 8);
+    REQUIRE(stats.catchUpTicks == 4);
+    REQUIRE(stats.droppedTicks == 6);
+
+    // the grid restarts from the stall instead of chasing the dropped ticks
+    REQUIRE(clock.waitForNextTick() == 1);
+}
\ No newline at end of file
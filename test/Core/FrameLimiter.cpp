@@ -0,0 +1,115 @@
+#include "Core/FrameLimiter.hpp"
+
+#include "SimulatedTime.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("FrameTimeStats percentiles use nearest rank", "[core][frame_limiter]") {
+    moe::FrameTimeStats stats(100);
+    for (int i = 1; i <= 100; ++i) {
+        stats.push(static_cast<float>(i));
+    }
+
+    auto summary = stats.summarize();
+    REQUIRE(summary.samples == 100);
+    REQUIRE(summary.p50Ms == 50.0f);
+    REQUIRE(summary.p95Ms == 95.0f);
+    REQUIRE(summary.p99Ms == 99.0f);
+    REQUIRE(summary.maxMs == 100.0f);
+    REQUIRE(summary.meanMs == 50.5f);
+}
+
+TEST_CASE("FrameTimeStats rolls its window and counts missed frames", "[core][frame_limiter]") {
+    moe::FrameTimeStats stats(4);
+    stats.setTargetMs(10.0f);
+
+    // within tolerance, over, over, on time
+    stats.push(10.4f);
+    stats.push(12.0f);
+    stats.push(30.0f);
+    stats.push(9.0f);
+
+    auto summary = stats.summarize();
+    REQUIRE(summary.missedFrames == 2);
+    REQUIRE(summary.totalMissedFrames == 2);
+    REQUIRE(summary.maxMs == 30.0f);
+
+    // pushes the 10.4 and 12.0 samples out of the window
+    stats.push(8.0f);
+    stats.push(8.0f);
+
+    summary = stats.summarize();
+    REQUIRE(summary.samples == 4);
+    REQUIRE(summary.missedFrames == 1);
+    REQUIRE(summary.totalFrames == 6);
+    REQUIRE(summary.totalMissedFrames == 2);
+    REQUIRE(stats.getSample(0) == 30.0f);
+    REQUIRE(stats.getSample(3) == 8.0f);
+
+    float buckets[4];
+    stats.buildHistogram(buckets, 20.0f);
+    REQUIRE(buckets[1] == 3.0f);
+    // slower than the range lands in the last bucket
+    REQUIRE(buckets[3] == 1.0f);
+}
+
+TEST_CASE("FrameLimiter holds the target rate", "[core][frame_limiter]") {
+    using namespace std::chrono;
+    constexpr int FRAMES = 20;
+
+    moe::Test::SimulatedTime time;
+    moe::FrameLimiter limiter(200.0, moe::FrameLimiter::DEFAULT_SPIN_WINDOW, time.source());
+    REQUIRE(limiter.isLimited());
+
+    auto start = time.now;
+    for (int i = 0; i <= FRAMES; ++i) {
+        limiter.wait();
+        // work shorter than the period does not shift the grid
+        time.now += milliseconds(1);
+    }
+
+    // the first wait returns immediately, FRAMES periods of 5ms follow
+    REQUIRE(time.now - start == milliseconds(FRAMES * 5 + 1));
+}
+
+TEST_CASE("FrameLimiter absorbs late wake-ups without drifting", "[core][frame_limiter]") {
+    using namespace std::chrono;
+
+    moe::Test::SimulatedTime time;
+    // every wake-up is 2ms late, deadlines still advance by whole periods
+    time.overshoots = {milliseconds(2)};
+    moe::FrameLimiter limiter(100.0, moe::FrameLimiter::DEFAULT_SPIN_WINDOW, time.source());
+
+    auto start = time.now;
+    for (int i = 0; i <= 10; ++i) {
+        limiter.wait();
+    }
+    REQUIRE(time.now - start == milliseconds(10 * 10 + 2));
+
+    // a stall of more than a period resyncs instead of returning a burst of due slots
+    time.now += milliseconds(50);
+    auto stalled = time.now;
+    limiter.wait();
+    limiter.wait();
+    REQUIRE(time.now - stalled == milliseconds(10 + 2));
+}
+
+TEST_CASE("FrameLimiter poll consumes due slots only", "[core][frame_limiter]") {
+    using namespace std::chrono;
+
+    moe::FrameLimiter limiter(100.0);
+    auto t0 = moe::FrameLimiter::Clock::now();
+
+    REQUIRE(limiter.poll(t0));
+    REQUIRE_FALSE(limiter.poll(t0 + milliseconds(5)));
+    REQUIRE(limiter.poll(t0 + milliseconds(10)));
+    REQUIRE_FALSE(limiter.poll(t0 + milliseconds(11)));
+
+    // far behind resyncs instead of returning a burst of due slots
+    REQUIRE(limiter.poll(t0 + milliseconds(100)));
+    REQUIRE_FALSE(limiter.poll(t0 + milliseconds(101)));
+
+    moe::FrameLimiter unlimited;
+    REQUIRE(unlimited.poll(t0));
+    REQUIRE(unlimited.poll(t0));
+}
\ No newline at end of file
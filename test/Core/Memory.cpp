@@ -0,0 +1,88 @@
+#include "Core/Memory.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstring>
+#include <thread>
+
+namespace {
+    const moe::Memory::TagStats& statsOf(const std::array<moe::Memory::TagStats, moe::Memory::TAG_COUNT>& stats, moe::MemoryTag tag) {
+        return stats[static_cast<size_t>(tag)];
+    }
+}// namespace
+
+TEST_CASE("Memory tracks current, peak and live blocks per tag", "[core][memory]") {
+    auto before = statsOf(moe::Memory::getStats(), moe::MemoryTag::Audio);
+
+    void* a = moe::Memory::allocate(1000, 16, moe::MemoryTag::Audio);
+    void* b = moe::Memory::allocate(24, 16, moe::MemoryTag::Audio);
+    REQUIRE(a != nullptr);
+    REQUIRE(b != nullptr);
+
+    auto during = statsOf(moe::Memory::getStats(), moe::MemoryTag::Audio);
+    REQUIRE(during.currentBytes - before.currentBytes == 1024);
+    REQUIRE(during.liveAllocations - before.liveAllocations == 2);
+    REQUIRE(during.totalAllocations - before.totalAllocations == 2);
+    REQUIRE(during.peakBytes >= before.currentBytes + 1024);
+
+    moe::Memory::deallocate(a);
+    moe::Memory::deallocate(b);
+
+    auto after = statsOf(moe::Memory::getStats(), moe::MemoryTag::Audio);
+    REQUIRE(after.currentBytes == before.currentBytes);
+    REQUIRE(after.liveAllocations == before.liveAllocations);
+    REQUIRE(after.peakBytes == during.peakBytes);
+}
+
+TEST_CASE("Memory honours over-aligned requests and reallocation", "[core][memory]") {
+    for (size_t alignment: {size_t(32), size_t(64), size_t(256), size_t(4096)}) {
+        void* ptr = moe::Memory::allocate(100, alignment, moe::MemoryTag::Physics);
+        REQUIRE(ptr != nullptr);
+        REQUIRE(reinterpret_cast<uintptr_t>(ptr) % alignment == 0);
+        std::memset(ptr, 0xab, 100);
+
+        // the grown block keeps the alignment and the contents
+        auto* grown = static_cast<uint8_t*>(moe::Memory::reallocate(ptr, 300));
+        REQUIRE(reinterpret_cast<uintptr_t>(grown) % alignment == 0);
+        REQUIRE(grown[0] == 0xab);
+        REQUIRE(grown[99] == 0xab);
+
+        moe::Memory::deallocate(grown);
+    }
+}
+
+TEST_CASE("Memory frees blocks aligned just above the default alignment", "[core][memory]") {
+    // where max_align_t is 8, e.g. msvc x64, a 16 byte request is over-aligned while its header offset
+    // is still the plain header size; the free must go through the same allocator as the allocation
+    for (size_t alignment: {size_t(16), alignof(std::max_align_t) * 2}) {
+        void* ptr = moe::Memory::allocate(40, alignment, moe::MemoryTag::Physics);
+        REQUIRE(ptr != nullptr);
+        REQUIRE(reinterpret_cast<uintptr_t>(ptr) % alignment == 0);
+
+        auto* grown = moe::Memory::reallocate(ptr, 80);
+        REQUIRE(grown != nullptr);
+        REQUIRE(reinterpret_cast<uintptr_t>(grown) % alignment == 0);
+        moe::Memory::deallocate(grown);
+    }
+}
+
+TEST_CASE("MemoryTagScope nests and is per thread", "[core][memory]") {
+    REQUIRE(moe::Memory::getThreadTag() == moe::MemoryTag::General);
+    {
+        MOE_MEMORY_TAG(Render);
+        REQUIRE(moe::Memory::getThreadTag() == moe::MemoryTag::Render);
+        {
+            MOE_MEMORY_TAG(Font);
+            REQUIRE(moe::Memory::getThreadTag() == moe::MemoryTag::Font);
+
+            moe::MemoryTag otherThreadTag = moe::MemoryTag::Count;
+            std::thread other([&]() {
+                otherThreadTag = moe::Memory::getThreadTag();
+            });
+            other.join();
+            REQUIRE(otherThreadTag == moe::MemoryTag::General);
+        }
+        REQUIRE(moe::Memory::getThreadTag() == moe::MemoryTag::Render);
+    }
+    REQUIRE(moe::Memory::getThreadTag() == moe::MemoryTag::General);
+}
\ No newline at end of file
@@ -0,0 +1,100 @@
+#include "Core/MpscQueue.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <thread>
+
+namespace {
+    struct Message {
+        uint32_t producer{0};
+        uint32_t sequence{0};
+    };
+}// namespace
+
+TEST_CASE("MpscQueue keeps order and reports full and empty", "[core][mpsc]") {
+    moe::MpscQueue<int> queue(3);
+    REQUIRE(queue.capacity() == 4);
+
+    int value = 0;
+    REQUIRE_FALSE(queue.tryPop(value));
+
+    for (int i = 0; i < 4; ++i) {
+        REQUIRE(queue.tryPush(int(i)));
+    }
+    REQUIRE_FALSE(queue.tryPush(4));
+    REQUIRE(queue.sizeApprox() == 4);
+
+    // wraps around several laps
+    for (int i = 0; i < 20; ++i) {
+        REQUIRE(queue.tryPop(value));
+        REQUIRE(value == i);
+        REQUIRE(queue.tryPush(i + 4));
+    }
+
+    SECTION("drain stops at the limit") {
+        moe::Vector<int> seen;
+        REQUIRE(queue.drain([&](int v) { seen.push_back(v); }, 3) == 3);
+        REQUIRE(seen == moe::Vector<int>{20, 21, 22});
+        REQUIRE(queue.sizeApprox() == 1);
+    }
+}
+
+TEST_CASE("MpscQueue releases popped values", "[core][mpsc]") {
+    moe::MpscQueue<moe::SharedPtr<int>> queue(4);
+    auto shared = std::make_shared<int>(7);
+
+    REQUIRE(queue.tryPush(moe::SharedPtr<int>(shared)));
+    moe::SharedPtr<int> out;
+    REQUIRE(queue.tryPop(out));
+    out.reset();
+
+    // the cell must not keep the capture alive until it is reused
+    REQUIRE(shared.use_count() == 1);
+}
+
+TEST_CASE("MpscQueue delivers every message from concurrent producers", "[core][mpsc][concurrency]") {
+    constexpr uint32_t PRODUCERS = 4;
+    constexpr uint32_t MESSAGES = 20000;
+
+    // small on purpose, producers keep running into a full queue
+    moe::MpscQueue<Message> queue(64);
+
+    moe::Vector<std::thread> producers;
+    for (uint32_t p = 0; p < PRODUCERS; ++p) {
+        producers.emplace_back([&queue, p]() {
+            for (uint32_t i = 0; i < MESSAGES; ++i) {
+                while (!queue.tryPush(Message{p, i})) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    moe::Vector<uint32_t> nextSequence(PRODUCERS, 0);
+    bool outOfOrder = false;
+    uint32_t received = 0;
+    Message message;
+    while (received < PRODUCERS * MESSAGES) {
+        if (!queue.tryPop(message)) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        // each producer's messages arrive in the order it pushed them
+        if (message.sequence != nextSequence[message.producer]) {
+            outOfOrder = true;
+        }
+        nextSequence[message.producer] = message.sequence + 1;
+        ++received;
+    }
+
+    for (auto& producer: producers) {
+        producer.join();
+    }
+
+    REQUIRE_FALSE(outOfOrder);
+    REQUIRE_FALSE(queue.tryPop(message));
+    for (auto sequence: nextSequence) {
+        REQUIRE(sequence == MESSAGES);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,63 @@
+#include "Core/Task/ParallelFor.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <thread>
+
+TEST_CASE("parallelFor runs every chunk once and never shares a slot between threads", "[core][scheduler]") {
+    // the scheduler test needs exactly one worker, whichever runs first initializes it
+    moe::ThreadPoolScheduler::init(1);
+    auto& scheduler = moe::ThreadPoolScheduler::getInstance();
+
+    constexpr uint32_t SLOTS = 3;
+    constexpr uint32_t CHUNKS = 64;
+
+    for (int round = 0; round < 20; ++round) {
+        moe::Array<std::atomic_uint32_t, CHUNKS> runs{};
+        // a slot's owner, what is kept per slot must never be used by two threads at once
+        moe::Array<std::atomic<std::thread::id>, SLOTS> owners{};
+        std::atomic_bool shared{false};
+        std::atomic_bool outOfRange{false};
+
+        moe::parallelFor(scheduler, SLOTS, CHUNKS, [&](uint32_t slot, uint32_t chunk) {
+            if (slot >= SLOTS) {
+                outOfRange = true;
+                return;
+            }
+            auto self = std::this_thread::get_id();
+            auto expected = std::thread::id{};
+            if (!owners[slot].compare_exchange_strong(expected, self) && expected != self) {
+                shared = true;
+            }
+            runs[chunk].fetch_add(1);
+        });
+
+        REQUIRE_FALSE(outOfRange);
+        REQUIRE_FALSE(shared);
+        for (auto& count: runs) {
+            REQUIRE(count.load() == 1);
+        }
+        // the calling thread runs under slot 0, when the workers left it any chunk
+        auto callerSlotOwner = owners[0].load();
+        REQUIRE((callerSlotOwner == std::thread::id{} || callerSlotOwner == std::this_thread::get_id()));
+    }
+}
+
+TEST_CASE("parallelFor with a single slot runs every chunk on the calling thread in order", "[core][scheduler]") {
+    moe::ThreadPoolScheduler::init(1);
+
+    moe::Vector<uint32_t> order;
+    auto caller = std::this_thread::get_id();
+    bool otherThread = false;
+    moe::parallelFor(moe::ThreadPoolScheduler::getInstance(), 1, 16, [&](uint32_t slot, uint32_t chunk) {
+        otherThread |= slot != 0 || std::this_thread::get_id() != caller;
+        order.push_back(chunk);
+    });
+
+    REQUIRE_FALSE(otherThread);
+    REQUIRE(order.size() == 16);
+    for (uint32_t i = 0; i < 16; ++i) {
+        REQUIRE(order[i] == i);
+    }
+}
\ No newline at end of file
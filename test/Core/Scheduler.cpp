@@ -0,0 +1,51 @@
+#include "Core/Task/Scheduler.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <future>
+
+TEST_CASE("ThreadPoolScheduler picks high priority tasks before queued normal tasks", "[core][scheduler]") {
+    moe::ThreadPoolScheduler::init(1);
+    auto& scheduler = moe::ThreadPoolScheduler::getInstance();
+    REQUIRE(scheduler.workerCount() == 1);
+
+    // hold the only worker so everything below queues up behind it
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    std::atomic_bool blocked{false};
+    scheduler.schedule([released, &blocked]() {
+        blocked.store(true);
+        released.wait();
+    });
+    while (!blocked.load()) {
+        std::this_thread::yield();
+    }
+
+    std::mutex mutex;
+    moe::Vector<int> order;
+    std::atomic_int remaining{6};
+    auto record = [&](int value) {
+        return [&, value]() {
+            {
+                std::lock_guard lock(mutex);
+                order.push_back(value);
+            }
+            remaining.fetch_sub(1);
+        };
+    };
+
+    for (int i = 0; i < 3; ++i) {
+        scheduler.schedule(record(i));
+    }
+    for (int i = 3; i < 6; ++i) {
+        scheduler.schedule(record(i), moe::TaskPriority::High);
+    }
+
+    release.set_value();
+    while (remaining.load() != 0) {
+        std::this_thread::yield();
+    }
+
+    // each priority stays first in, first out
+    REQUIRE(order == moe::Vector<int>{3, 4, 5, 0, 1, 2});
+}
\ No newline at end of file
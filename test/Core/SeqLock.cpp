@@ -0,0 +1,66 @@
+#include "Core/DBuffer.hpp"
+#include "Core/SeqLock.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <thread>
+
+namespace {
+    struct Wide {
+        uint64_t values[6];
+    };
+}// namespace
+
+TEST_CASE("SeqLock never returns a torn value", "[core][seqlock][stress]") {
+    constexpr uint64_t STORE_COUNT = 200000;
+
+    moe::SeqLock<Wide> lock;
+    std::atomic_bool done{false};
+    std::atomic_bool failed{false};
+
+    std::thread writer([&]() {
+        for (uint64_t i = 1; i <= STORE_COUNT; ++i) {
+            Wide value;
+            for (auto& v: value.values) {
+                v = i;
+            }
+            lock.store(value);
+        }
+        done.store(true);
+    });
+
+    auto reader = [&]() {
+        uint64_t last = 0;
+        while (!done.load()) {
+            auto value = lock.load();
+            for (auto v: value.values) {
+                if (v != value.values[0]) {
+                    failed.store(true);
+                }
+            }
+            // values only ever increase
+            if (value.values[0] < last) {
+                failed.store(true);
+            }
+            last = value.values[0];
+        }
+    };
+
+    std::thread reader0(reader);
+    std::thread reader1(reader);
+
+    writer.join();
+    reader0.join();
+    reader1.join();
+
+    REQUIRE_FALSE(failed.load());
+    REQUIRE(lock.load().values[0] == STORE_COUNT);
+    REQUIRE(lock.sequence() == STORE_COUNT * 2);
+}
+
+TEST_CASE("DBuffer returns the last published value", "[core][seqlock]") {
+    moe::DBuffer<float> buffer;
+    buffer.publish(1.0f);
+    buffer.publish(2.0f);
+    REQUIRE(buffer.get() == 2.0f);
+}
\ No newline at end of file
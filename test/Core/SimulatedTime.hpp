@@ -0,0 +1,31 @@
+#pragma once
+
+#include "Core/FrameLimiter.hpp"
+
+#include <algorithm>
+
+namespace moe::Test {
+    // time only moves when the test says so, waits land on the deadline plus a scripted overshoot
+    struct SimulatedTime {
+        using Clock = Timing::Clock;
+
+        Clock::time_point now{};
+        Vector<Clock::duration> overshoots;
+        size_t waits{0};
+
+        Timing::TimeSource source() {
+            return {
+                    .now = [this] { return now; },
+                    .sleepUntil = [this](Clock::time_point deadline, Clock::duration, Clock::duration* outSpinTime) {
+                        auto overshoot = overshoots.empty() ? Clock::duration::zero() : overshoots[waits % overshoots.size()];
+                        ++waits;
+                        now = std::max(now, deadline + overshoot);
+                        if (outSpinTime) {
+                            *outSpinTime = Clock::duration::zero();
+                        }
+                        return now - deadline;
+                    },
+            };
+        }
+    };
+}// namespace moe::Test
\ No newline at end of file
@@ -0,0 +1,215 @@
+#include "Core/SnapshotChannel.hpp"
+#include "Core/TBuffer.hpp"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <thread>
+
+namespace {
+    struct BodyState {
+        uint64_t writtenAt{0};
+        float position[3]{};
+        float rotation[4]{};
+    };
+}// namespace
+
+TEST_CASE("SnapshotChannel publishes complete snapshots", "[core][snapshot]") {
+    moe::SnapshotChannel<int> channel;
+    channel.resize(4);
+
+    REQUIRE_FALSE(channel.acquire());
+
+    channel.write(0, 10);
+    channel.write(3, 13);
+    channel.publish(100);
+
+    REQUIRE(channel.acquire());
+    auto view = channel.view();
+    REQUIRE(view.size() == 4);
+    REQUIRE(view.version == 1);
+    REQUIRE(view.tick == 100);
+    REQUIRE(view[0] == 10);
+    REQUIRE(view[3] == 13);
+
+    // nothing new, the view stays valid and unchanged
+    REQUIRE_FALSE(channel.acquire());
+    REQUIRE(channel.view().version == 1);
+}
+
+TEST_CASE("SnapshotChannel tracks per entry versions", "[core][snapshot]") {
+    moe::SnapshotChannel<int> channel;
+    channel.resize(3);
+    channel.publish(0);
+
+    channel.write(1, 42);
+    channel.publish(1);
+
+    // several publishes without the consumer acquiring, recycled slots must catch up
+    for (int i = 0; i < 8; ++i) {
+        channel.write(2, i);
+        channel.publish(2 + i);
+    }
+
+    REQUIRE(channel.acquire());
+    auto view = channel.view();
+    REQUIRE(view.version == 10);
+    REQUIRE(view[1] == 42);
+    REQUIRE(view[2] == 7);
+    REQUIRE(view.entryVersions[0] == 1);
+    REQUIRE(view.entryVersions[1] == 2);
+    REQUIRE(view.entryVersions[2] == 10);
+    REQUIRE_FALSE(view.changedSince(1, 2));
+    REQUIRE(view.changedSince(2, 2));
+
+    auto latest = channel.latest();
+    REQUIRE(latest.version == view.version);
+    REQUIRE(latest.tick == view.tick);
+}
+
+TEST_CASE("SnapshotChannel handles resizing between publishes", "[core][snapshot]") {
+    moe::SnapshotChannel<int> channel;
+    channel.resize(2);
+    channel.write(1, 1);
+    channel.publish(0);
+
+    // shrinking drops pending changes of removed entries
+    channel.write(1, 5);
+    channel.resize(1);
+    channel.publish(1);
+
+    channel.resize(3);
+    channel.write(2, 2);
+    channel.publish(2);
+
+    REQUIRE(channel.acquire());
+    auto view = channel.view();
+    REQUIRE(view.size() == 3);
+    REQUIRE(view[1] == 0);
+    REQUIRE(view[2] == 2);
+}
+
+TEST_CASE("SnapshotChannel stays consistent under concurrent publishing", "[core][snapshot][stress]") {
+    constexpr size_t ENTRY_COUNT = 512;
+    constexpr uint64_t PUBLISH_COUNT = 20000;
+
+    moe::SnapshotChannel<BodyState> channel;
+    channel.resize(ENTRY_COUNT);
+    channel.edit(0).writtenAt = 1;
+    channel.publish(0);
+
+    std::atomic_bool failed{false};
+
+    std::thread producer([&]() {
+        uint64_t seed = 0x9E3779B97F4A7C15ull;
+        for (uint64_t tick = 1; tick <= PUBLISH_COUNT; ++tick) {
+            uint64_t version = channel.latest().version + 1;
+
+            // entry 0 changes every publish, the rest randomly
+            channel.edit(0).writtenAt = version;
+            for (int i = 0; i < 8; ++i) {
+                seed ^= seed << 13;
+                seed ^= seed >> 7;
+                seed ^= seed << 17;
+                auto& entry = channel.edit(seed % ENTRY_COUNT);
+                entry.writtenAt = version;
+                entry.position[0] = static_cast<float>(version);
+            }
+            channel.publish(tick);
+        }
+    });
+
+    std::thread consumer([&]() {
+        uint64_t lastVersion = 0;
+        while (lastVersion < PUBLISH_COUNT + 1) {
+            if (!channel.acquire()) {
+                std::this_thread::yield();
+                continue;
+            }
+
+            auto view = channel.view();
+            if (view.version < lastVersion || view[0].writtenAt != view.version) {
+                failed.store(true);
+                return;
+            }
+
+            for (size_t i = 0; i < view.size(); ++i) {
+                // an entry from a newer publish means the snapshot is torn
+                if (view[i].writtenAt > view.version ||
+                    (view[i].writtenAt != 0 && view.entryVersions[i] != view[i].writtenAt)) {
+                    failed.store(true);
+                    return;
+                }
+            }
+
+            if (channel.latest().version < view.version) {
+                failed.store(true);
+                return;
+            }
+            lastVersion = view.version;
+        }
+    });
+
+    producer.join();
+    consumer.join();
+
+    REQUIRE_FALSE(failed.load());
+}
+
+TEST_CASE("SnapshotChannel versus TBuffer", "[.][benchmark][snapshot]") {
+    for (size_t bodyCount: {size_t(1000), size_t(10000)}) {
+        moe::TBuffer<moe::UnorderedMap<uint32_t, BodyState>> tbuffer;
+        moe::SnapshotChannel<BodyState> channel;
+        channel.resize(bodyCount);
+
+        uint64_t tick = 0;
+        auto name = [bodyCount](const char* what) {
+            return moe::String(what) + " (" + std::to_string(bodyCount) + " bodies)";
+        };
+
+        BENCHMARK(name("TBuffer publish")) {
+            auto& map = tbuffer.getWriteBuffer();
+            map.clear();
+            for (uint32_t i = 0; i < bodyCount; ++i) {
+                map.emplace(i, BodyState{tick});
+            }
+            tbuffer.publish();
+            return ++tick;
+        };
+
+        BENCHMARK(name("TBuffer read")) {
+            tbuffer.updateReadBuffer();
+            uint64_t sum = 0;
+            for (auto& [id, state]: tbuffer.getReadBuffer()) {
+                sum += state.writtenAt;
+            }
+            return sum;
+        };
+
+        BENCHMARK(name("SnapshotChannel publish, all moved")) {
+            for (size_t i = 0; i < bodyCount; ++i) {
+                channel.edit(i).writtenAt = tick;
+            }
+            channel.publish(++tick);
+            return tick;
+        };
+
+        BENCHMARK(name("SnapshotChannel publish, 5% moved")) {
+            for (size_t i = 0; i < bodyCount; i += 20) {
+                channel.edit(i).writtenAt = tick;
+            }
+            channel.publish(++tick);
+            return tick;
+        };
+
+        BENCHMARK(name("SnapshotChannel read")) {
+            channel.acquire();
+            auto view = channel.view();
+            uint64_t sum = 0;
+            for (size_t i = 0; i < view.size(); ++i) {
+                sum += view[i].writtenAt;
+            }
+            return sum;
+        };
+    }
+}
\ No newline at end of file
@@ -0,0 +1,74 @@
+#include "Physics/CollisionLayers.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+using namespace moe::Physics;
+using namespace moe::Physics::Details;
+
+TEST_CASE("Default collision matrix is symmetric and keeps debris out of gameplay", "[physics][layers]") {
+    auto config = CollisionLayerConfig::createDefault();
+    REQUIRE(config.validate());
+    REQUIRE(config.objectLayers.size() == Layers::NUM_LAYERS);
+    REQUIRE(config.broadPhaseLayers.size() == BroadPhaseLayers::NUM_LAYERS);
+
+    for (JPH::ObjectLayer a = 0; a < Layers::NUM_LAYERS; ++a) {
+        for (JPH::ObjectLayer b = 0; b < Layers::NUM_LAYERS; ++b) {
+            REQUIRE(config.collides(a, b) == config.collides(b, a));
+        }
+    }
+
+    REQUIRE(config.collides(Layers::DEBRIS, Layers::STATIC));
+    REQUIRE_FALSE(config.collides(Layers::DEBRIS, Layers::DYNAMIC));
+    REQUIRE_FALSE(config.collides(Layers::DEBRIS, Layers::CHARACTER));
+    REQUIRE_FALSE(config.collides(Layers::STATIC, Layers::STATIC));
+    REQUIRE_FALSE(config.collides(Layers::PROJECTILE, Layers::PROJECTILE));
+    REQUIRE(config.collides(Layers::PROJECTILE, Layers::CHARACTER));
+
+    // the old two layer behaviour is preserved
+    REQUIRE(config.collides(Layers::NON_MOVING, Layers::MOVING));
+    REQUIRE(config.collides(Layers::MOVING, Layers::MOVING));
+}
+
+TEST_CASE("Layer filters are derived from the config", "[physics][layers]") {
+    auto config = CollisionLayerConfig::createDefault();
+
+    BPLayerInterfaceImpl broadPhaseLayerInterface(config);
+    ObjectVsBroadPhaseLayerFilterImpl objectVsBroadPhaseLayerFilter(config);
+    ObjectLayerFilterImpl objectLayerFilter(config);
+
+    REQUIRE(broadPhaseLayerInterface.GetNumBroadPhaseLayers() == BroadPhaseLayers::NUM_LAYERS);
+    REQUIRE(broadPhaseLayerInterface.GetBroadPhaseLayer(Layers::TRIGGER) == BroadPhaseLayers::TRIGGER);
+    REQUIRE(broadPhaseLayerInterface.GetBroadPhaseLayer(Layers::CHARACTER) == BroadPhaseLayers::MOVING);
+
+    for (JPH::ObjectLayer a = 0; a < Layers::NUM_LAYERS; ++a) {
+        for (JPH::ObjectLayer b = 0; b < Layers::NUM_LAYERS; ++b) {
+            REQUIRE(objectLayerFilter.ShouldCollide(a, b) == config.collides(a, b));
+
+            // the broad phase test must never reject a pair the object filter accepts
+            if (config.collides(a, b)) {
+                REQUIRE(objectVsBroadPhaseLayerFilter.ShouldCollide(a, broadPhaseLayerInterface.GetBroadPhaseLayer(b)));
+            }
+        }
+    }
+
+    // debris only ever sees the non moving tree
+    REQUIRE(objectVsBroadPhaseLayerFilter.ShouldCollide(Layers::DEBRIS, BroadPhaseLayers::NON_MOVING));
+    REQUIRE_FALSE(objectVsBroadPhaseLayerFilter.ShouldCollide(Layers::DEBRIS, BroadPhaseLayers::MOVING));
+    REQUIRE_FALSE(objectVsBroadPhaseLayerFilter.ShouldCollide(Layers::DEBRIS, BroadPhaseLayers::DEBRIS));
+}
+
+TEST_CASE("Collision layer config can be edited and validated", "[physics][layers]") {
+    auto config = CollisionLayerConfig::createDefault();
+
+    REQUIRE(config.findObjectLayer("projectile") == Layers::PROJECTILE);
+    REQUIRE(config.findBroadPhaseLayer("debris") == (JPH::BroadPhaseLayer::Type) BroadPhaseLayers::DEBRIS);
+    REQUIRE_FALSE(config.findObjectLayer("water").has_value());
+
+    config.setCollides(Layers::PROJECTILE, Layers::PROJECTILE, true);
+    config.setCollides(Layers::DEBRIS, Layers::STATIC, false);
+    REQUIRE(config.collides(Layers::PROJECTILE, Layers::PROJECTILE));
+    REQUIRE_FALSE(config.collides(Layers::STATIC, Layers::DEBRIS));
+
+    config.objectLayers[Layers::DEBRIS].broadPhaseLayer = 42;
+    REQUIRE_FALSE(config.validate());
+}
\ No newline at end of file
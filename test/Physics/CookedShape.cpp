@@ -0,0 +1,80 @@
+#include "Physics/CookedShape.hpp"
+
+#include "JoltTestHelpers.hpp"
+
+#include <Jolt/Physics/Collision/CastResult.h>
+#include <Jolt/Physics/Collision/RayCast.h>
+#include <Jolt/Physics/Collision/Shape/MeshShape.h>
+#include <Jolt/Physics/Collision/Shape/StaticCompoundShape.h>
+
+#include <catch2/catch_test_macros.hpp>
+
+using namespace moe::Physics;
+
+namespace {
+    // a ramp made of two triangles next to a box, covers mesh and convex children
+    JPH::ShapeRefC makeLevelShape() {
+        JPH::VertexList vertices{
+                JPH::Float3(0.0f, 0.0f, 0.0f),
+                JPH::Float3(10.0f, 0.0f, 0.0f),
+                JPH::Float3(0.0f, 0.0f, 10.0f),
+                JPH::Float3(10.0f, 5.0f, 10.0f),
+        };
+        JPH::IndexedTriangleList triangles{
+                JPH::IndexedTriangle(0, 2, 1, 0),
+                JPH::IndexedTriangle(1, 2, 3, 0),
+        };
+
+        JPH::Ref<JPH::StaticCompoundShapeSettings> settings = new JPH::StaticCompoundShapeSettings();
+        settings->AddShape(JPH::Vec3::sZero(), JPH::Quat::sIdentity(), new JPH::MeshShapeSettings(vertices, triangles));
+        settings->AddShape(JPH::Vec3(-5.0f, 1.0f, 0.0f), JPH::Quat::sIdentity(), new JPH::BoxShape(JPH::Vec3::sReplicate(1.0f)));
+
+        auto result = settings->Create();
+        REQUIRE_FALSE(result.HasError());
+        return result.Get();
+    }
+
+    float castDown(const JPH::Shape& shape, float x, float z) {
+        JPH::RayCast ray{JPH::Vec3(x, 20.0f, z), JPH::Vec3(0.0f, -40.0f, 0.0f)};
+        JPH::RayCastResult hit;
+        if (!shape.CastRay(ray, JPH::SubShapeIDCreator(), hit)) {
+            return -1.0f;
+        }
+        return hit.mFraction;
+    }
+}// namespace
+
+TEST_CASE("Cooked shapes restore to the same collision geometry", "[physics][cooking]") {
+    Test::ensureJoltInitialized();
+
+    auto shape = makeLevelShape();
+    auto data = CookedShape{shape}.serialize();
+    REQUIRE_FALSE(data.empty());
+
+    auto restored = CookedShape::deserialize({data.data(), data.size()});
+    REQUIRE(restored.has_value());
+    REQUIRE(restored->shape != nullptr);
+    REQUIRE(restored->shape->GetSubType() == shape->GetSubType());
+    REQUIRE(restored->shape->GetStats().mNumTriangles == shape->GetStats().mNumTriangles);
+
+    auto bounds = shape->GetLocalBounds();
+    auto restoredBounds = restored->shape->GetLocalBounds();
+    REQUIRE(restoredBounds.mMin == bounds.mMin);
+    REQUIRE(restoredBounds.mMax == bounds.mMax);
+
+    // the ramp, the flat part and the box hit at the same height, a miss stays a miss
+    for (auto [x, z]: {std::pair{8.0f, 8.0f}, std::pair{1.0f, 1.0f}, std::pair{-5.0f, 0.0f}, std::pair{30.0f, 30.0f}}) {
+        REQUIRE(castDown(*restored->shape, x, z) == castDown(*shape, x, z));
+    }
+}
+
+TEST_CASE("Cooked shapes reject foreign or truncated data", "[physics][cooking]") {
+    Test::ensureJoltInitialized();
+
+    moe::Vector<uint8_t> garbage(64, 0xAB);
+    REQUIRE_FALSE(CookedShape::deserialize({garbage.data(), garbage.size()}).has_value());
+
+    auto data = CookedShape{makeLevelShape()}.serialize();
+    data.resize(data.size() / 2);
+    REQUIRE_FALSE(CookedShape::deserialize({data.data(), data.size()}).has_value());
+}
\ No newline at end of file
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "Physics/JoltIncludes.hpp"
+
+namespace moe::Physics::Test {
+    // jolt's globals are set up once per test process and never torn down
+    inline void ensureJoltInitialized() {
+        static bool s_initialized = []() {
+            JPH::RegisterDefaultAllocator();
+            JPH::Factory::sInstance = new JPH::Factory();
+            JPH::RegisterTypes();
+            return true;
+        }();
+        (void) s_initialized;
+    }
+}// namespace moe::Physics::Test
\ No newline at end of file
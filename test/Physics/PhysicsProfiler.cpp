@@ -0,0 +1,114 @@
+#include "JoltTestHelpers.hpp"
+
+#include "Physics/CollisionLayers.hpp"
+#include "Physics/PhysicsProfiler.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+using namespace moe::Physics;
+using namespace moe::Physics::Details;
+
+namespace {
+    constexpr float DELTA_TIME = 1.0f / 60.0f;
+
+    // boxes resting on a floor, jolt must be initialized before one is created
+    struct ProfiledWorld {
+    public:
+        CollisionLayerConfig layers{CollisionLayerConfig::createDefault()};
+        BPLayerInterfaceImpl broadPhaseLayerInterface{layers};
+        ObjectVsBroadPhaseLayerFilterImpl objectVsBroadPhaseLayerFilter{layers};
+        ObjectLayerFilterImpl objectLayerFilter{layers};
+        JPH::PhysicsSystem system;
+        JPH::JobSystemThreadPool jobSystem{JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers, 3};
+        StepProfiler profiler;
+
+        explicit ProfiledWorld(bool profilePhases)
+            : profiler(jobSystem, 4 * 1024 * 1024, profilePhases) {
+            system.Init(256, 0, 4096, 4096,
+                        broadPhaseLayerInterface,
+                        objectVsBroadPhaseLayerFilter,
+                        objectLayerFilter);
+            system.SetContactListener(&profiler.getContactListener());
+
+            auto& bodyInterface = system.GetBodyInterface();
+            bodyInterface.CreateAndAddBody(
+                    JPH::BodyCreationSettings(
+                            new JPH::BoxShape(JPH::Vec3(20.0f, 0.5f, 20.0f)),
+                            JPH::RVec3(0.0f, -0.5f, 0.0f),
+                            JPH::Quat::sIdentity(),
+                            JPH::EMotionType::Static,
+                            Layers::STATIC),
+                    JPH::EActivation::DontActivate);
+
+            JPH::RefConst<JPH::Shape> box = new JPH::BoxShape(JPH::Vec3::sReplicate(0.4f));
+            for (int x = 0; x < 4; ++x) {
+                for (int z = 0; z < 4; ++z) {
+                    bodyInterface.CreateAndAddBody(
+                            JPH::BodyCreationSettings(
+                                    box,
+                                    JPH::RVec3(static_cast<float>(x) - 1.5f, 0.45f, static_cast<float>(z) - 1.5f),
+                                    JPH::Quat::sIdentity(),
+                                    JPH::EMotionType::Dynamic,
+                                    Layers::DYNAMIC),
+                            JPH::EActivation::Activate);
+                }
+            }
+            system.OptimizeBroadPhase();
+        }
+
+        ~ProfiledWorld() {
+            system.SetContactListener(nullptr);
+        }
+
+        TickStats step() {
+            TickStats stats;
+            REQUIRE(profiler.step(system, DELTA_TIME, stats) == JPH::EPhysicsUpdateError::None);
+            return stats;
+        }
+    };
+
+    float jobMs(const TickStats& stats) {
+        return stats.broadPhaseMs + stats.narrowPhaseMs + stats.solverMs + stats.integrateMs + stats.otherJobsMs;
+    }
+}// namespace
+
+TEST_CASE("Physics jobs are bucketed by phase", "[physics][profiler]") {
+    REQUIRE(classifyPhysicsJob("Broad Phase Prepare") == PhysicsPhase::BroadPhase);
+    REQUIRE(classifyPhysicsJob("UpdateBroadphaseFinalize") == PhysicsPhase::BroadPhase);
+    REQUIRE(classifyPhysicsJob("Find Collisions") == PhysicsPhase::NarrowPhase);
+    REQUIRE(classifyPhysicsJob("Find CCD Contacts") == PhysicsPhase::NarrowPhase);
+    REQUIRE(classifyPhysicsJob("Solve Velocity Constraints") == PhysicsPhase::Solver);
+    REQUIRE(classifyPhysicsJob("Integrate Velocity") == PhysicsPhase::Integrate);
+    REQUIRE(classifyPhysicsJob("Step Listeners") == PhysicsPhase::Other);
+    REQUIRE(classifyPhysicsJob(nullptr) == PhysicsPhase::Other);
+}
+
+TEST_CASE("StepProfiler reports the cost of a step", "[physics][profiler]") {
+    Test::ensureJoltInitialized();
+    ProfiledWorld world(true);
+
+    TickStats stats;
+    for (int i = 0; i < 10; ++i) {
+        stats = world.step();
+    }
+
+    REQUIRE(stats.stepMs > 0.0f);
+    REQUIRE(jobMs(stats) > 0.0f);
+    REQUIRE(stats.narrowPhaseMs > 0.0f);
+    REQUIRE(stats.numActiveBodies == 16);
+    // every box rests on the floor
+    REQUIRE(stats.numContacts >= 16);
+    REQUIRE(stats.tempAllocatorPeakBytes > 0);
+}
+
+TEST_CASE("StepProfiler skips job timing when phases are off", "[physics][profiler]") {
+    Test::ensureJoltInitialized();
+    ProfiledWorld world(false);
+
+    auto stats = world.step();
+    stats = world.step();
+
+    REQUIRE(stats.stepMs > 0.0f);
+    REQUIRE(jobMs(stats) == 0.0f);
+    REQUIRE(stats.numContacts >= 16);
+}
\ No newline at end of file
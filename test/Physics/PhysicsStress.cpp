@@ -0,0 +1,133 @@
+#include "JoltTestHelpers.hpp"
+
+#include "Physics/CollisionLayers.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+
+using namespace moe::Physics;
+using namespace moe::Physics::Details;
+
+namespace {
+    // jolt reports contacts from its job threads
+    struct LayerContactCounter final : public JPH::ContactListener {
+    public:
+        explicit LayerContactCounter(const CollisionLayerConfig& config)
+            : m_config(config) {}
+
+        std::atomic<uint64_t> filteredPairContacts{0};
+        std::atomic<uint64_t> triggerContacts{0};
+
+        void OnContactAdded(const JPH::Body& inBody1, const JPH::Body& inBody2, const JPH::ContactManifold&, JPH::ContactSettings&) override {
+            auto layer1 = inBody1.GetObjectLayer();
+            auto layer2 = inBody2.GetObjectLayer();
+            if (!m_config.collides(layer1, layer2)) {
+                filteredPairContacts.fetch_add(1, std::memory_order_relaxed);
+            }
+            if (layer1 == Layers::TRIGGER || layer2 == Layers::TRIGGER) {
+                triggerContacts.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+    private:
+        const CollisionLayerConfig& m_config;
+    };
+}// namespace
+
+TEST_CASE("20k bodies across all layers simulate within the configured capacity", "[physics][stress]") {
+    constexpr JPH::uint GRID_SIZE = 100;
+    constexpr JPH::uint BODY_COUNT = GRID_SIZE * GRID_SIZE * 2;
+    constexpr float RADIUS = 0.4f;
+    constexpr int STEPS = 30;
+
+    Test::ensureJoltInitialized();
+
+    auto layers = CollisionLayerConfig::createDefault();
+    BPLayerInterfaceImpl broadPhaseLayerInterface(layers);
+    ObjectVsBroadPhaseLayerFilterImpl objectVsBroadPhaseLayerFilter(layers);
+    ObjectLayerFilterImpl objectLayerFilter(layers);
+
+    JPH::PhysicsSystem system;
+    system.Init(BODY_COUNT + 1, 0, 131072, 65536,
+                broadPhaseLayerInterface,
+                objectVsBroadPhaseLayerFilter,
+                objectLayerFilter);
+
+    LayerContactCounter contacts(layers);
+    system.SetContactListener(&contacts);
+
+    auto& bodyInterface = system.GetBodyInterface();
+
+    // the floor's top face is at y = 0
+    bodyInterface.CreateAndAddBody(
+            JPH::BodyCreationSettings(
+                    new JPH::BoxShape(JPH::Vec3(60.0f, 0.5f, 60.0f)),
+                    JPH::RVec3(50.0f, -0.5f, 50.0f),
+                    JPH::Quat::sIdentity(),
+                    JPH::EMotionType::Static,
+                    Layers::STATIC),
+            JPH::EActivation::DontActivate);
+
+    JPH::RefConst<JPH::Shape> sphere = new JPH::SphereShape(RADIUS);
+    JPH::RefConst<JPH::Shape> triggerBox = new JPH::BoxShape(JPH::Vec3::sReplicate(RADIUS));
+
+    // two stacked grid levels, every tenth cell drops debris right into the previous dynamic body,
+    // projectiles fill another cell and the lower level gets triggers overlapping a dynamic body
+    JPH::BodyIDVector bodies;
+    bodies.reserve(BODY_COUNT);
+    for (JPH::uint i = 0; i < BODY_COUNT; ++i) {
+        JPH::uint cell = i % (GRID_SIZE * GRID_SIZE);
+        JPH::uint level = i / (GRID_SIZE * GRID_SIZE);
+        JPH::uint kind = i % 10;
+
+        auto position = [&](JPH::uint atCell) {
+            return JPH::RVec3(
+                    static_cast<float>(atCell % GRID_SIZE),
+                    RADIUS + 0.05f + static_cast<float>(level),
+                    static_cast<float>(atCell / GRID_SIZE));
+        };
+
+        JPH::BodyCreationSettings settings(sphere, position(cell), JPH::Quat::sIdentity(), JPH::EMotionType::Dynamic, Layers::DYNAMIC);
+        if (kind == 1) {
+            settings.mPosition = position(cell - 1);
+            settings.mObjectLayer = Layers::DEBRIS;
+        } else if (kind == 2) {
+            settings.mObjectLayer = Layers::PROJECTILE;
+        } else if (kind == 3 && level == 0) {
+            settings = JPH::BodyCreationSettings(triggerBox, position(cell - 3), JPH::Quat::sIdentity(), JPH::EMotionType::Static, Layers::TRIGGER);
+            settings.mIsSensor = true;
+        }
+
+        auto* body = bodyInterface.CreateBody(settings);
+        REQUIRE(body != nullptr);
+        bodies.push_back(body->GetID());
+    }
+
+    auto addState = bodyInterface.AddBodiesPrepare(bodies.data(), static_cast<int>(bodies.size()));
+    bodyInterface.AddBodiesFinalize(bodies.data(), static_cast<int>(bodies.size()), addState, JPH::EActivation::Activate);
+    system.OptimizeBroadPhase();
+
+    REQUIRE(system.GetNumBodies() == BODY_COUNT + 1);
+
+    JPH::TempAllocatorImpl tempAllocator(64 * 1024 * 1024);
+    JPH::JobSystemThreadPool jobSystem(JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers);
+
+    for (int step = 0; step < STEPS; ++step) {
+        auto errors = system.Update(1.0f / 60.0f, 1, &tempAllocator, &jobSystem);
+        REQUIRE(errors == JPH::EPhysicsUpdateError::None);
+    }
+
+    // the matrix is honored in the narrow phase, and the pairs it allows do report
+    REQUIRE(contacts.filteredPairContacts.load() == 0);
+    REQUIRE(contacts.triggerContacts.load() > 0);
+
+    // nothing that collides with static geometry fell through the floor
+    for (auto id: bodies) {
+        auto layer = bodyInterface.GetObjectLayer(id);
+        if (layer == Layers::TRIGGER) {
+            continue;
+        }
+        REQUIRE(bodyInterface.GetPosition(id).GetY() > 0.0f);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,171 @@
+#include "JoltTestHelpers.hpp"
+
+#include "Physics/CollisionLayers.hpp"
+#include "Physics/RollbackBuffer.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+
+using namespace moe::Physics;
+using namespace moe::Physics::Details;
+
+namespace {
+    constexpr float DELTA_TIME = 1.0f / 60.0f;
+
+    struct BodyState {
+        JPH::RVec3 position;
+        JPH::Quat rotation;
+        JPH::Vec3 linearVelocity;
+        JPH::Vec3 angularVelocity;
+
+        bool operator==(const BodyState& other) const {
+            return position == other.position &&
+                   rotation == other.rotation &&
+                   linearVelocity == other.linearVelocity &&
+                   angularVelocity == other.angularVelocity;
+        }
+    };
+
+    // a pile of boxes and spheres with a player sphere pushed through it by its inputs
+    // jolt must be initialized before one is created, the job system allocates through it
+    struct RollbackWorld {
+    public:
+        CollisionLayerConfig layers{CollisionLayerConfig::createDefault()};
+        BPLayerInterfaceImpl broadPhaseLayerInterface{layers};
+        ObjectVsBroadPhaseLayerFilterImpl objectVsBroadPhaseLayerFilter{layers};
+        ObjectLayerFilterImpl objectLayerFilter{layers};
+        JPH::PhysicsSystem system;
+        JPH::TempAllocatorImpl tempAllocator{16 * 1024 * 1024};
+        JPH::JobSystemThreadPool jobSystem{JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers, 3};
+
+        JPH::BodyID player;
+        moe::Vector<JPH::BodyID> bodies;
+
+        RollbackWorld() {
+            system.Init(1024, 0, 4096, 4096,
+                        broadPhaseLayerInterface,
+                        objectVsBroadPhaseLayerFilter,
+                        objectLayerFilter);
+
+            auto& bodyInterface = system.GetBodyInterface();
+            bodyInterface.CreateAndAddBody(
+                    JPH::BodyCreationSettings(
+                            new JPH::BoxShape(JPH::Vec3(20.0f, 0.5f, 20.0f)),
+                            JPH::RVec3(0.0f, -0.5f, 0.0f),
+                            JPH::Quat::sIdentity(),
+                            JPH::EMotionType::Static,
+                            Layers::STATIC),
+                    JPH::EActivation::DontActivate);
+
+            JPH::RefConst<JPH::Shape> box = new JPH::BoxShape(JPH::Vec3::sReplicate(0.4f));
+            JPH::RefConst<JPH::Shape> sphere = new JPH::SphereShape(0.4f);
+            for (int y = 0; y < 4; ++y) {
+                for (int x = 0; x < 4; ++x) {
+                    for (int z = 0; z < 4; ++z) {
+                        bodies.push_back(bodyInterface.CreateAndAddBody(
+                                JPH::BodyCreationSettings(
+                                        (x + y + z) % 2 == 0 ? box : sphere,
+                                        JPH::RVec3(static_cast<float>(x) - 1.5f, 0.5f + static_cast<float>(y) * 0.9f, static_cast<float>(z) - 1.5f),
+                                        JPH::Quat::sIdentity(),
+                                        JPH::EMotionType::Dynamic,
+                                        Layers::DYNAMIC),
+                                JPH::EActivation::Activate));
+                    }
+                }
+            }
+
+            player = bodyInterface.CreateAndAddBody(
+                    JPH::BodyCreationSettings(
+                            sphere,
+                            JPH::RVec3(-6.0f, 0.4f, 0.0f),
+                            JPH::Quat::sIdentity(),
+                            JPH::EMotionType::Dynamic,
+                            Layers::CHARACTER),
+                    JPH::EActivation::Activate);
+            bodies.push_back(player);
+        }
+
+        // the recorded input of a tick, steering the player into the pile
+        void applyInput(size_t tick) {
+            float t = static_cast<float>(tick);
+            system.GetBodyInterface().AddImpulse(player, JPH::Vec3(2.0f, 0.0f, 1.5f * std::sin(t * 0.2f)));
+        }
+
+        // one tick the way PhysicsEngine::mainLoop runs it: save, step, then drain the dispatched inputs
+        void runTick(RollbackBuffer& rollback, size_t tick) {
+            rollback.save(system, tick);
+            REQUIRE(system.Update(DELTA_TIME, 1, &tempAllocator, &jobSystem) == JPH::EPhysicsUpdateError::None);
+            applyInput(tick);
+        }
+
+        moe::Vector<BodyState> capture() {
+            auto& bodyInterface = system.GetBodyInterface();
+            moe::Vector<BodyState> states;
+            for (auto id: bodies) {
+                BodyState state;
+                bodyInterface.GetPositionAndRotation(id, state.position, state.rotation);
+                bodyInterface.GetLinearAndAngularVelocity(id, state.linearVelocity, state.angularVelocity);
+                states.push_back(state);
+            }
+            return states;
+        }
+    };
+}// namespace
+
+TEST_CASE("Rolling back 30 ticks and resimulating reaches the identical state", "[physics][rollback]") {
+    constexpr size_t TICKS = 90;
+    constexpr size_t ROLLBACK_TICKS = 30;
+
+    Test::ensureJoltInitialized();
+    RollbackWorld world;
+    RollbackBuffer rollback(64);
+
+    for (size_t tick = 0; tick < TICKS; ++tick) {
+        world.runTick(rollback, tick);
+    }
+    auto expected = world.capture();
+
+    REQUIRE(rollback.has(TICKS - ROLLBACK_TICKS));
+    REQUIRE(rollback.resimulate(
+            world.system,
+            TICKS - ROLLBACK_TICKS, TICKS,
+            DELTA_TIME,
+            world.tempAllocator,
+            world.jobSystem,
+            [&](size_t tick) { world.applyInput(tick); }));
+
+    auto resimulated = world.capture();
+    REQUIRE(resimulated.size() == expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        REQUIRE(resimulated[i] == expected[i]);
+    }
+
+    // the present was saved on the way, the next tick of the loop continues from it
+    REQUIRE(rollback.has(TICKS));
+
+    auto stats = rollback.getStats();
+    REQUIRE(stats.frameBytes > 0);
+    REQUIRE(stats.resimulateUsPerTick > 0.0f);
+}
+
+TEST_CASE("Rollback only reaches ticks still in the ring", "[physics][rollback]") {
+    Test::ensureJoltInitialized();
+    RollbackWorld world;
+    RollbackBuffer rollback(8);
+
+    for (size_t tick = 0; tick < 20; ++tick) {
+        world.runTick(rollback, tick);
+    }
+
+    REQUIRE_FALSE(rollback.has(11));
+    REQUIRE(rollback.has(12));
+    REQUIRE(rollback.has(19));
+    REQUIRE_FALSE(rollback.has(20));
+    REQUIRE_FALSE(rollback.restore(world.system, 4));
+
+    // the restored state is the one saved, not the present
+    auto present = world.capture();
+    REQUIRE(rollback.restore(world.system, 12));
+    REQUIRE_FALSE(world.capture() == present);
+}
\ No newline at end of file
@@ -0,0 +1,162 @@
+#include "JoltTestHelpers.hpp"
+
+#include "Physics/CollisionLayers.hpp"
+#include "Physics/SceneQuery.hpp"
+
+#include <Jolt/Physics/Collision/CastResult.h>
+#include <Jolt/Physics/Collision/RayCast.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <thread>
+
+using namespace moe::Physics;
+using namespace moe::Physics::Details;
+
+namespace {
+    constexpr int GRID_SIZE = 10;
+
+    // a floor with a grid of unit boxes on it, one box every four meters
+    struct QueryWorld {
+    public:
+        CollisionLayerConfig layers{CollisionLayerConfig::createDefault()};
+        BPLayerInterfaceImpl broadPhaseLayerInterface{layers};
+        ObjectVsBroadPhaseLayerFilterImpl objectVsBroadPhaseLayerFilter{layers};
+        ObjectLayerFilterImpl objectLayerFilter{layers};
+        JPH::PhysicsSystem system;
+
+        JPH::BodyID floor;
+        moe::Vector<JPH::BodyID> boxes;
+
+        QueryWorld() {
+            Test::ensureJoltInitialized();
+            system.Init(1024, 0, 1024, 1024,
+                        broadPhaseLayerInterface,
+                        objectVsBroadPhaseLayerFilter,
+                        objectLayerFilter);
+
+            auto& bodyInterface = system.GetBodyInterface();
+            floor = bodyInterface.CreateAndAddBody(
+                    JPH::BodyCreationSettings(
+                            new JPH::BoxShape(JPH::Vec3(50.0f, 0.5f, 50.0f)),
+                            JPH::RVec3(0.0f, -0.5f, 0.0f),
+                            JPH::Quat::sIdentity(),
+                            JPH::EMotionType::Static,
+                            Layers::STATIC),
+                    JPH::EActivation::DontActivate);
+
+            JPH::RefConst<JPH::Shape> box = new JPH::BoxShape(JPH::Vec3::sReplicate(0.5f));
+            for (int x = 0; x < GRID_SIZE; ++x) {
+                for (int z = 0; z < GRID_SIZE; ++z) {
+                    boxes.push_back(bodyInterface.CreateAndAddBody(
+                            JPH::BodyCreationSettings(
+                                    box,
+                                    JPH::RVec3(static_cast<float>(x * 4), 0.5f, static_cast<float>(z * 4)),
+                                    JPH::Quat::sIdentity(),
+                                    JPH::EMotionType::Dynamic,
+                                    Layers::DYNAMIC),
+                            JPH::EActivation::DontActivate));
+                }
+            }
+            system.OptimizeBroadPhase();
+        }
+    };
+
+    RayQuery rayDown(float x, float z) {
+        return {JPH::RVec3(x, 10.0f, z), JPH::Vec3(0.0f, -20.0f, 0.0f)};
+    }
+}// namespace
+
+TEST_CASE("Batched rays match one-off narrow phase queries", "[physics][scene_query]") {
+    moe::ThreadPoolScheduler::init(4);
+    QueryWorld world;
+
+    // enough rays to be split across the workers, a quarter of a meter apart so some hit boxes and some the floor
+    moe::Vector<RayQuery> rays;
+    for (int x = 0; x < 160; ++x) {
+        for (int z = 0; z < 10; ++z) {
+            rays.push_back(rayDown(static_cast<float>(x) * 0.25f, static_cast<float>(z) * 3.7f));
+        }
+    }
+    REQUIRE(rays.size() > SceneQueryBatcher::QUERIES_PER_TASK * 4);
+
+    SceneQueryBatcher batcher;
+    auto future = batcher.castRays(rays);
+    REQUIRE(batcher.pendingBatches() == 1);
+    batcher.execute(world.system, moe::ThreadPoolScheduler::getInstance());
+    REQUIRE(batcher.pendingBatches() == 0);
+
+    REQUIRE(future.isReady());
+    auto hits = future.get();
+    REQUIRE(hits.size() == rays.size());
+
+    for (size_t i = 0; i < rays.size(); ++i) {
+        JPH::RRayCast cast{rays[i].origin, rays[i].direction};
+        JPH::RayCastResult expected;
+        REQUIRE(world.system.GetNarrowPhaseQuery().CastRay(cast, expected));
+        REQUIRE(hits[i].hasHit());
+        REQUIRE(hits[i].body == expected.mBodyID);
+        REQUIRE(hits[i].fraction == expected.mFraction);
+    }
+}
+
+TEST_CASE("Query filters skip layers and the ignored body", "[physics][scene_query]") {
+    moe::ThreadPoolScheduler::init(4);
+    QueryWorld world;
+
+    auto onBox = rayDown(0.0f, 0.0f);
+    auto skipDynamic = onBox;
+    skipDynamic.filter.layerMask = ~(uint64_t{1} << Layers::DYNAMIC);
+    auto ignoreBox = onBox;
+    ignoreBox.filter.ignoreBody = world.boxes[0];
+    auto onlyDebris = onBox;
+    onlyDebris.filter.layerMask = uint64_t{1} << Layers::DEBRIS;
+    auto offTheFloor = rayDown(200.0f, 0.0f);
+
+    SceneQueryBatcher batcher;
+    auto future = batcher.castRays({onBox, skipDynamic, ignoreBox, onlyDebris, offTheFloor});
+    batcher.execute(world.system, moe::ThreadPoolScheduler::getInstance());
+    auto hits = future.get();
+
+    REQUIRE(hits[0].body == world.boxes[0]);
+    REQUIRE_THAT(hits[0].position.GetY(), Catch::Matchers::WithinAbs(1.0, 1e-4));
+    REQUIRE(hits[1].body == world.floor);
+    REQUIRE(hits[2].body == world.floor);
+    REQUIRE_THAT(hits[2].position.GetY(), Catch::Matchers::WithinAbs(0.0, 1e-4));
+    REQUIRE_FALSE(hits[3].hasHit());
+    REQUIRE_FALSE(hits[4].hasHit());
+}
+
+TEST_CASE("Shape cast callbacks run on the main thread", "[physics][scene_query]") {
+    moe::ThreadPoolScheduler::init(4);
+    moe::MainScheduler::getInstance().init();
+    QueryWorld world;
+
+    ShapeCastQuery sphereDown;
+    sphereDown.shape = new JPH::SphereShape(0.25f);
+    sphereDown.start = JPH::RMat44::sTranslation(JPH::RVec3(0.0f, 5.0f, 0.0f));
+    sphereDown.direction = JPH::Vec3(0.0f, -10.0f, 0.0f);
+
+    moe::Vector<ShapeCastHit> hits;
+    SceneQueryBatcher batcher;
+    batcher.castShapes({sphereDown}, [&](const moe::Vector<ShapeCastHit>& result) {
+        REQUIRE(moe::MainScheduler::getInstance().isMainThread());
+        hits = result;
+    });
+
+    // batches execute on the physics thread, a callback scheduled from there waits for the main thread
+    std::thread physicsThread([&]() {
+        batcher.execute(world.system, moe::ThreadPoolScheduler::getInstance());
+    });
+    physicsThread.join();
+    REQUIRE(hits.empty());
+    moe::MainScheduler::getInstance().processTasks();
+
+    REQUIRE(hits.size() == 1);
+    REQUIRE(hits[0].body == world.boxes[0]);
+    // the sphere touches the box top after falling 5 - 1 - 0.25 meters
+    REQUIRE_THAT(hits[0].fraction, Catch::Matchers::WithinAbs(0.375, 1e-3));
+    REQUIRE_THAT(hits[0].contactPoint.GetY(), Catch::Matchers::WithinAbs(1.0, 1e-3));
+    REQUIRE(hits[0].normal.GetY() > 0.99f);
+}
\ No newline at end of file
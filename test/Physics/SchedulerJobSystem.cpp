@@ -0,0 +1,103 @@
+#include "JoltTestHelpers.hpp"
+
+#include "Physics/CollisionLayers.hpp"
+#include "Physics/SchedulerJobSystem.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+using namespace moe::Physics;
+using namespace moe::Physics::Details;
+
+namespace {
+    struct BodyState {
+        JPH::RVec3 position;
+        JPH::Quat rotation;
+    };
+
+    // a pile of spheres dropped onto a floor, stepped for two seconds
+    moe::Vector<BodyState> simulatePile(JPH::JobSystem& jobSystem) {
+        constexpr int PILE_SIZE = 8;
+        constexpr int PILE_HEIGHT = 6;
+        constexpr int STEPS = 120;
+
+        auto layers = CollisionLayerConfig::createDefault();
+        BPLayerInterfaceImpl broadPhaseLayerInterface(layers);
+        ObjectVsBroadPhaseLayerFilterImpl objectVsBroadPhaseLayerFilter(layers);
+        ObjectLayerFilterImpl objectLayerFilter(layers);
+
+        JPH::PhysicsSystem system;
+        system.Init(1024, 0, 4096, 4096,
+                    broadPhaseLayerInterface,
+                    objectVsBroadPhaseLayerFilter,
+                    objectLayerFilter);
+
+        auto& bodyInterface = system.GetBodyInterface();
+        bodyInterface.CreateAndAddBody(
+                JPH::BodyCreationSettings(
+                        new JPH::BoxShape(JPH::Vec3(20.0f, 0.5f, 20.0f)),
+                        JPH::RVec3(0.0f, -0.5f, 0.0f),
+                        JPH::Quat::sIdentity(),
+                        JPH::EMotionType::Static,
+                        Layers::STATIC),
+                JPH::EActivation::DontActivate);
+
+        JPH::RefConst<JPH::Shape> sphere = new JPH::SphereShape(0.5f);
+        moe::Vector<JPH::BodyID> bodies;
+        for (int y = 0; y < PILE_HEIGHT; ++y) {
+            for (int x = 0; x < PILE_SIZE; ++x) {
+                for (int z = 0; z < PILE_SIZE; ++z) {
+                    // odd layers sit in the gaps of the layer below so the pile collapses sideways
+                    float offset = (y % 2) * 0.5f;
+                    JPH::BodyCreationSettings settings(
+                            sphere,
+                            JPH::RVec3(static_cast<float>(x) + offset - 4.0f, 0.6f + static_cast<float>(y) * 1.1f, static_cast<float>(z) + offset - 4.0f),
+                            JPH::Quat::sIdentity(),
+                            JPH::EMotionType::Dynamic,
+                            Layers::DYNAMIC);
+                    bodies.push_back(bodyInterface.CreateAndAddBody(settings, JPH::EActivation::Activate));
+                }
+            }
+        }
+
+        JPH::TempAllocatorImpl tempAllocator(16 * 1024 * 1024);
+        for (int step = 0; step < STEPS; ++step) {
+            REQUIRE(system.Update(1.0f / 60.0f, 1, &tempAllocator, &jobSystem) == JPH::EPhysicsUpdateError::None);
+        }
+
+        moe::Vector<BodyState> states;
+        for (auto id: bodies) {
+            BodyState state;
+            bodyInterface.GetPositionAndRotation(id, state.position, state.rotation);
+            states.push_back(state);
+        }
+        return states;
+    }
+}// namespace
+
+TEST_CASE("SchedulerJobSystem steps the same as jolt's thread pool", "[physics][job_system]") {
+    Test::ensureJoltInitialized();
+    moe::ThreadPoolScheduler::init(4);
+
+    moe::Vector<BodyState> reference;
+    {
+        JPH::JobSystemThreadPool threadPool(JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers);
+        reference = simulatePile(threadPool);
+    }
+
+    moe::Vector<BodyState> scheduled;
+    {
+        SchedulerJobSystem jobSystem(moe::ThreadPoolScheduler::getInstance(), JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers);
+        REQUIRE(jobSystem.GetMaxConcurrency() == 5);
+        scheduled = simulatePile(jobSystem);
+    }
+
+    // jolt is deterministic regardless of how its jobs are spread over threads
+    REQUIRE(reference.size() == scheduled.size());
+    for (size_t i = 0; i < reference.size(); ++i) {
+        REQUIRE(reference[i].position == scheduled[i].position);
+        REQUIRE(reference[i].rotation == scheduled[i].rotation);
+    }
+
+    // the pile actually moved
+    REQUIRE(reference.back().position.GetY() < 0.6f + 5.0f * 1.1f);
+}
\ No newline at end of file
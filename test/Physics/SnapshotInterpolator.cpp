@@ -0,0 +1,164 @@
+#include "Physics/SnapshotInterpolator.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <cmath>
+
+using namespace moe::Physics;
+using Catch::Matchers::WithinAbs;
+
+namespace {
+    using Clock = SnapshotInterpolator::Clock;
+
+    constexpr auto STEP = std::chrono::microseconds(16667);
+    constexpr float STEP_SECONDS = 0.016667f;
+
+    constexpr float VELOCITY = 3.0f;
+    constexpr float ANGULAR_VELOCITY = 2.0f;
+
+    const JPH::BodyID LINEAR_BODY(0, 1);
+    const JPH::BodyID WAVE_BODY(1, 1);
+
+    float seconds(Clock::duration duration) {
+        return std::chrono::duration_cast<std::chrono::duration<float>>(duration).count();
+    }
+
+    // constant velocity and spin
+    ObjectSnapshot linearMotion(float t) {
+        return ObjectSnapshot{
+                .bodyID = LINEAR_BODY,
+                .position = JPH::Vec3(VELOCITY * t, 1.0f, 0.0f),
+                .rotation = JPH::Quat::sRotation(JPH::Vec3::sAxisY(), ANGULAR_VELOCITY * t),
+        };
+    }
+
+    // curved motion, linear interpolation can only approximate it
+    ObjectSnapshot waveMotion(float t) {
+        return ObjectSnapshot{
+                .bodyID = WAVE_BODY,
+                .position = JPH::Vec3(0.0f, std::sin(4.0f * t), 0.0f),
+        };
+    }
+
+    // publishes the analytic motion at fixed ticks
+    struct AnalyticWorld {
+    public:
+        SnapshotView::Channel channel;
+        Clock::time_point start{Clock::now()};
+        uint64_t tick{0};
+
+        AnalyticWorld() { channel.resize(2); }
+
+        Clock::time_point tickTime(uint64_t index) const { return start + STEP * index; }
+
+        SnapshotView publish() {
+            float t = seconds(tickTime(tick) - start);
+            channel.write(0, linearMotion(t));
+            channel.write(1, waveMotion(t));
+            channel.publish(tick, tickTime(tick));
+            ++tick;
+
+            channel.acquire();
+            return SnapshotView(channel.view());
+        }
+    };
+
+    void requireClose(const ObjectSnapshot& actual, const ObjectSnapshot& expected, float tolerance) {
+        REQUIRE(actual.bodyID == expected.bodyID);
+        REQUIRE_THAT(actual.position.GetX(), WithinAbs(expected.position.GetX(), tolerance));
+        REQUIRE_THAT(actual.position.GetY(), WithinAbs(expected.position.GetY(), tolerance));
+        REQUIRE_THAT(actual.position.GetZ(), WithinAbs(expected.position.GetZ(), tolerance));
+        // q and -q are the same rotation
+        REQUIRE_THAT(std::abs(actual.rotation.Dot(expected.rotation)), WithinAbs(1.0f, tolerance));
+    }
+}// namespace
+
+TEST_CASE("SnapshotInterpolator follows analytic motion between ticks", "[physics][interpolation]") {
+    AnalyticWorld world;
+    SnapshotInterpolator interpolator(SnapshotInterpolator::Config{.delay = STEP});
+
+    REQUIRE(interpolator.update(world.publish()));
+    REQUIRE(interpolator.computeAlpha(world.tickTime(0)) == 1.0f);
+    requireClose(interpolator.getTransform(LINEAR_BODY, 1.0f).value(), linearMotion(0.0f), 1e-5f);
+
+    for (int i = 0; i < 60; ++i) {
+        auto view = world.publish();
+        REQUIRE(interpolator.update(view));
+        REQUIRE_FALSE(interpolator.update(view));
+
+        auto newest = world.tickTime(view.getTick());
+        for (float fraction: {0.0f, 0.25f, 0.5f, 0.9f}) {
+            auto now = newest + std::chrono::duration_cast<Clock::duration>(STEP * fraction);
+            float alpha = interpolator.computeAlpha(now);
+            REQUIRE_THAT(alpha, WithinAbs(fraction, 1e-3f));
+
+            // the frame shows the world as it was one step ago
+            float renderTime = seconds(now - world.start) - STEP_SECONDS;
+            requireClose(interpolator.getTransform(LINEAR_BODY, alpha).value(), linearMotion(renderTime), 1e-4f);
+            // chord error of a sine sampled every step, h^2 / 8 * max|f''|
+            requireClose(interpolator.getTransform(WAVE_BODY, alpha).value(), waveMotion(renderTime), 1e-3f);
+        }
+    }
+}
+
+TEST_CASE("SnapshotInterpolator caps extrapolation of a late tick", "[physics][interpolation]") {
+    AnalyticWorld world;
+    SnapshotInterpolator::Config config{.delay = STEP, .maxExtrapolation = std::chrono::milliseconds(8)};
+    SnapshotInterpolator interpolator(config);
+
+    interpolator.update(world.publish());
+    auto view = world.publish();
+    interpolator.update(view);
+
+    auto newest = world.tickTime(view.getTick());
+    float newestTime = seconds(newest - world.start);
+
+    // the next tick is 4ms late, keep moving along the last motion
+    float alpha = interpolator.computeAlpha(newest + STEP + std::chrono::milliseconds(4));
+    REQUIRE(alpha > 1.0f);
+    requireClose(interpolator.getTransform(LINEAR_BODY, alpha).value(), linearMotion(newestTime + 0.004f), 1e-4f);
+
+    // far too late, the body stops where the cap puts it
+    alpha = interpolator.computeAlpha(newest + STEP + std::chrono::milliseconds(100));
+    requireClose(interpolator.getTransform(LINEAR_BODY, alpha).value(), linearMotion(newestTime + 0.008f), 1e-4f);
+
+    // and it never goes further back than the previous tick
+    REQUIRE(interpolator.computeAlpha(newest - STEP) == 0.0f);
+}
+
+TEST_CASE("SnapshotInterpolator holds bodies that stopped and snaps reused slots", "[physics][interpolation]") {
+    SnapshotView::Channel channel;
+    channel.resize(2);
+    auto start = Clock::now();
+    SnapshotInterpolator interpolator(SnapshotInterpolator::Config{.delay = STEP});
+
+    auto publish = [&](uint64_t tick) {
+        channel.publish(tick, start + STEP * tick);
+        channel.acquire();
+        return interpolator.update(SnapshotView(channel.view()));
+    };
+
+    channel.write(0, ObjectSnapshot{.bodyID = LINEAR_BODY, .position = JPH::Vec3(0.0f, 0.0f, 0.0f)});
+    publish(0);
+    channel.write(0, ObjectSnapshot{.bodyID = LINEAR_BODY, .position = JPH::Vec3(1.0f, 0.0f, 0.0f)});
+    publish(1);
+    REQUIRE_THAT(interpolator.getTransform(LINEAR_BODY, 0.5f)->position.GetX(), WithinAbs(0.5f, 1e-6f));
+
+    // came to rest: the entry is not written again and must not keep blending
+    publish(2);
+    REQUIRE_THAT(interpolator.getTransform(LINEAR_BODY, 0.0f)->position.GetX(), WithinAbs(1.0f, 1e-6f));
+    REQUIRE_THAT(interpolator.getTransform(LINEAR_BODY, 1.4f)->position.GetX(), WithinAbs(1.0f, 1e-6f));
+
+    // the slot is reused by another body, it appears where it is instead of flying in
+    JPH::BodyID reused(0, 2);
+    channel.write(0, ObjectSnapshot{.bodyID = reused, .position = JPH::Vec3(-5.0f, 0.0f, 0.0f)});
+    publish(3);
+    REQUIRE_FALSE(interpolator.getTransform(LINEAR_BODY, 0.5f));
+    REQUIRE_THAT(interpolator.getTransform(reused, 0.0f)->position.GetX(), WithinAbs(-5.0f, 1e-6f));
+
+    // removed bodies vanish
+    channel.write(0, ObjectSnapshot{});
+    publish(4);
+    REQUIRE_FALSE(interpolator.getTransform(reused, 1.0f));
+}
\ No newline at end of file
@@ -0,0 +1,107 @@
+#include "Render/Vulkan/VulkanCulling.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <random>
+
+using namespace moe;
+
+namespace {
+    // looks down -z from the origin, like VulkanCamera with a zero yaw and pitch
+    VulkanFrustum makeCameraFrustum() {
+        auto view = glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+        auto projection = glm::perspective(glm::radians(60.0f), 1.0f, 0.1f, 100.0f);
+        projection[1][1] *= -1;
+        return VulkanFrustum::fromViewProjection(projection * view);
+    }
+
+    VulkanBounds box(glm::vec3 center, float halfSize) {
+        return {center, glm::vec3(halfSize)};
+    }
+}// namespace
+
+TEST_CASE("Bounds follow translation, rotation and scale", "[render][culling]") {
+    auto local = VulkanBounds::fromMinMax(glm::vec3(-1.0f, -2.0f, -3.0f), glm::vec3(1.0f, 2.0f, 3.0f));
+    REQUIRE(local.center == glm::vec3(0.0f));
+    REQUIRE(local.extent == glm::vec3(1.0f, 2.0f, 3.0f));
+
+    auto transform = glm::translate(glm::mat4(1.0f), glm::vec3(10.0f, 0.0f, 0.0f));
+    transform = glm::rotate(transform, glm::radians(90.0f), glm::vec3(0.0f, 0.0f, 1.0f));
+    transform = glm::scale(transform, glm::vec3(2.0f));
+    auto world = local.transformed(transform);
+
+    REQUIRE(glm::all(glm::lessThan(glm::abs(world.center - glm::vec3(10.0f, 0.0f, 0.0f)), glm::vec3(1e-4f))));
+    // a quarter turn around z swaps x and y
+    REQUIRE(glm::all(glm::lessThan(glm::abs(world.extent - glm::vec3(4.0f, 2.0f, 6.0f)), glm::vec3(1e-4f))));
+
+    REQUIRE(VulkanBounds::unbounded().transformed(transform).isUnbounded());
+}
+
+TEST_CASE("Frustum keeps what the camera sees", "[render][culling]") {
+    auto frustum = makeCameraFrustum();
+
+    REQUIRE(frustum.intersects(box({0.0f, 0.0f, -10.0f}, 1.0f)));
+    // straddling the near plane and the side planes
+    REQUIRE(frustum.intersects(box({0.0f, 0.0f, 0.0f}, 0.5f)));
+    REQUIRE(frustum.intersects(box({6.0f, 0.0f, -10.0f}, 1.0f)));
+
+    REQUIRE_FALSE(frustum.intersects(box({0.0f, 0.0f, 10.0f}, 1.0f)));
+    REQUIRE_FALSE(frustum.intersects(box({20.0f, 0.0f, -10.0f}, 1.0f)));
+    REQUIRE_FALSE(frustum.intersects(box({0.0f, -20.0f, -10.0f}, 1.0f)));
+    REQUIRE_FALSE(frustum.intersects(box({0.0f, 0.0f, -200.0f}, 1.0f)));
+
+    REQUIRE(frustum.intersects(VulkanBounds::unbounded()));
+}
+
+TEST_CASE("Orthographic light frustums cull along every axis", "[render][culling]") {
+    auto view = glm::lookAt(glm::vec3(0.0f, 50.0f, 0.0f), glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, 1.0f));
+    auto frustum = VulkanFrustum::fromViewProjection(glm::ortho(-10.0f, 10.0f, -10.0f, 10.0f, 0.0f, 100.0f) * view);
+
+    REQUIRE(frustum.intersects(box({0.0f, 0.0f, 0.0f}, 1.0f)));
+    REQUIRE(frustum.intersects(box({9.5f, -40.0f, 9.5f}, 1.0f)));
+
+    REQUIRE_FALSE(frustum.intersects(box({15.0f, 0.0f, 0.0f}, 1.0f)));
+    REQUIRE_FALSE(frustum.intersects(box({0.0f, 0.0f, -15.0f}, 1.0f)));
+    REQUIRE_FALSE(frustum.intersects(box({0.0f, 60.0f, 0.0f}, 1.0f)));
+    REQUIRE_FALSE(frustum.intersects(box({0.0f, -60.0f, 0.0f}, 1.0f)));
+}
+
+TEST_CASE("Batch culling matches culling one box at a time", "[render][culling]") {
+    auto frustum = makeCameraFrustum();
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> position(-50.0f, 50.0f);
+    std::uniform_real_distribution<float> size(0.1f, 5.0f);
+
+    // not a multiple of the lane count, the padding must never show up
+    constexpr size_t COUNT = 1003;
+
+    VulkanCullingBatch batch;
+    Vector<VulkanBounds> boxes;
+    for (size_t i = 0; i < COUNT; ++i) {
+        auto bounds = i % 100 == 0 ? VulkanBounds::unbounded() : box({position(rng), position(rng), position(rng)}, size(rng));
+        boxes.push_back(bounds);
+        batch.push(bounds);
+    }
+    REQUIRE(batch.size() == COUNT);
+
+    Vector<uint32_t> expected;
+    for (size_t i = 0; i < COUNT; ++i) {
+        if (frustum.intersects(boxes[i])) {
+            expected.push_back(static_cast<uint32_t>(i));
+        }
+    }
+
+    Vector<uint32_t> visible;
+    batch.cull(frustum, visible);
+
+    REQUIRE(visible == expected);
+    REQUIRE(!visible.empty());
+    REQUIRE(visible.size() < COUNT);
+
+    batch.clear();
+    visible.clear();
+    batch.cull(frustum, visible);
+    REQUIRE(batch.size() == 0);
+    REQUIRE(visible.empty());
+}
\ No newline at end of file
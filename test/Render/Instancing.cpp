@@ -0,0 +1,171 @@
+#include "Render/Vulkan/VulkanInstancing.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+using namespace moe;
+
+namespace {
+    VulkanRenderPacket makePacket(MeshId mesh, MaterialId material, glm::vec3 position, bool skinned = false) {
+        VulkanRenderPacket packet{};
+        packet.meshId = mesh;
+        packet.materialId = material;
+        packet.transform = glm::translate(glm::mat4(1.0f), position);
+        packet.skinned = skinned;
+        packet.skinnedVertexBufferAddr = skinned ? 0x1000 : 0;
+        return packet;
+    }
+
+    using Grouping = VulkanInstanceBatcher::Grouping;
+}// namespace
+
+TEST_CASE("Consecutive packets of one mesh and material share a draw", "[render][instancing]") {
+    Vector<VulkanRenderPacket> packets = {
+            makePacket(1, 7, {0.0f, 0.0f, 0.0f}),
+            makePacket(1, 7, {1.0f, 0.0f, 0.0f}),
+            makePacket(1, 7, {2.0f, 0.0f, 0.0f}),
+            makePacket(1, 8, {3.0f, 0.0f, 0.0f}),
+            makePacket(2, 8, {4.0f, 0.0f, 0.0f}),
+            // not next to the first run, so it starts its own draw
+            makePacket(1, 7, {5.0f, 0.0f, 0.0f}),
+    };
+
+    VulkanInstanceBatcher batcher;
+    Vector<VulkanInstancedDraw> draws;
+    for (auto& packet: packets) {
+        batcher.push(packet, Grouping::MeshAndMaterial, draws);
+    }
+
+    REQUIRE(draws.size() == 4);
+    REQUIRE(draws[0].firstInstance == 0);
+    REQUIRE(draws[0].instanceCount == 3);
+    REQUIRE(draws[1].firstInstance == 3);
+    REQUIRE(draws[1].instanceCount == 1);
+    REQUIRE(draws[3].meshId == 1);
+    REQUIRE(draws[3].materialId == 7);
+    REQUIRE(draws[3].firstInstance == 5);
+
+    // one instance per packet, in push order
+    auto& instances = batcher.getInstances();
+    REQUIRE(instances.size() == packets.size());
+    for (size_t i = 0; i < packets.size(); ++i) {
+        REQUIRE(instances[i].transform == packets[i].transform);
+    }
+}
+
+TEST_CASE("Depth only grouping ignores the material", "[render][instancing]") {
+    VulkanInstanceBatcher batcher{false};
+    Vector<VulkanInstancedDraw> draws;
+    batcher.push(makePacket(1, 7, {}), Grouping::Mesh, draws);
+    batcher.push(makePacket(1, 8, {}), Grouping::Mesh, draws);
+    batcher.push(makePacket(1, 9, {}), Grouping::Mesh, draws);
+
+    REQUIRE(draws.size() == 1);
+    REQUIRE(draws[0].instanceCount == 3);
+
+    batcher.clear();
+    draws.clear();
+    batcher.push(makePacket(1, 7, {}), Grouping::None, draws);
+    batcher.push(makePacket(1, 7, {}), Grouping::None, draws);
+    REQUIRE(draws.size() == 2);
+    REQUIRE(draws[1].firstInstance == 1);
+}
+
+TEST_CASE("Skinned packets always draw alone", "[render][instancing]") {
+    VulkanInstanceBatcher batcher;
+    Vector<VulkanInstancedDraw> draws;
+    batcher.push(makePacket(1, 7, {}), Grouping::MeshAndMaterial, draws);
+    batcher.push(makePacket(1, 7, {}, true), Grouping::MeshAndMaterial, draws);
+    batcher.push(makePacket(1, 7, {}, true), Grouping::MeshAndMaterial, draws);
+    batcher.push(makePacket(1, 7, {}), Grouping::MeshAndMaterial, draws);
+
+    REQUIRE(draws.size() == 4);
+    REQUIRE(draws[1].skinned);
+    REQUIRE(draws[1].skinnedVertexBufferAddr == 0x1000);
+    REQUIRE(draws[3].firstInstance == 3);
+}
+
+TEST_CASE("Passes sharing an instance list never merge across each other", "[render][instancing]") {
+    VulkanInstanceBatcher batcher{false};
+    Vector<VulkanInstancedDraw> firstPass;
+    Vector<VulkanInstancedDraw> secondPass;
+
+    batcher.push(makePacket(1, 7, {}), Grouping::Mesh, firstPass);
+    batcher.push(makePacket(1, 7, {}), Grouping::Mesh, firstPass);
+    batcher.push(makePacket(1, 7, {}), Grouping::Mesh, secondPass);
+    // the second pass's instance sits between, so this can't extend the first pass's draw
+    batcher.push(makePacket(1, 7, {}), Grouping::Mesh, firstPass);
+
+    REQUIRE(firstPass.size() == 2);
+    REQUIRE(firstPass[0].instanceCount == 2);
+    REQUIRE(firstPass[1].firstInstance == 3);
+    REQUIRE(secondPass.size() == 1);
+    REQUIRE(secondPass[0].firstInstance == 2);
+}
+
+TEST_CASE("Normal matrices are the inverse of the linear part", "[render][instancing]") {
+    auto transform = glm::translate(glm::mat4(1.0f), glm::vec3(3.0f, -2.0f, 1.0f));
+    transform = glm::rotate(transform, glm::radians(30.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    transform = glm::scale(transform, glm::vec3(2.0f, 0.5f, 1.0f));
+
+    VulkanRenderPacket packet = makePacket(1, 7, {});
+    packet.transform = transform;
+
+    VulkanInstanceBatcher batcher;
+    Vector<VulkanInstancedDraw> draws;
+    batcher.push(packet, Grouping::MeshAndMaterial, draws);
+
+    // what the shaders got from glm::inverse on the whole transform before
+    auto expected = glm::mat3(glm::inverse(transform));
+    auto& actual = batcher.getInstances()[0].clampedInverseTransform;
+    for (int c = 0; c < 3; ++c) {
+        REQUIRE(glm::all(glm::lessThan(glm::abs(actual[c] - expected[c]), glm::vec3(1e-5f))));
+    }
+}
+
+TEST_CASE("Indirect groups reserve a range per mesh and material", "[render][instancing]") {
+    Vector<VulkanRenderPacket> packets = {
+            makePacket(1, 7, {0.0f, 0.0f, 0.0f}),
+            makePacket(2, 7, {1.0f, 0.0f, 0.0f}),
+            // same mesh and material as the first, but not next to it
+            makePacket(1, 7, {2.0f, 0.0f, 0.0f}),
+            makePacket(1, 8, {3.0f, 0.0f, 0.0f}),
+            makePacket(1, 7, {4.0f, 0.0f, 0.0f}, true),
+    };
+
+    VulkanIndirectDrawBuilder builder;
+    builder.build(packets);
+
+    auto& objects = builder.getObjects();
+    REQUIRE(objects.size() == packets.size());
+
+    // (1, 7), (2, 7), (1, 8) and the skinned packet on its own
+    auto& gBufferGroups = builder.getGBufferGroups();
+    REQUIRE(gBufferGroups.size() == 4);
+    REQUIRE(objects[0].gBufferGroup == objects[2].gBufferGroup);
+    REQUIRE(gBufferGroups[objects[0].gBufferGroup].instanceCount == 2);
+    REQUIRE(gBufferGroups[objects[4].gBufferGroup].skinned);
+
+    // meshes 1 and 2 and the skinned packet, the material never splits a shadow group
+    auto& shadowGroups = builder.getShadowGroups();
+    REQUIRE(shadowGroups.size() == 3);
+    REQUIRE(objects[0].shadowGroup == objects[3].shadowGroup);
+    REQUIRE(shadowGroups[objects[0].shadowGroup].instanceCount == 3);
+
+    // ranges are back to back and cover every packet exactly once
+    for (auto* groups: {&gBufferGroups, &shadowGroups}) {
+        uint32_t firstInstance = 0;
+        for (auto& group: *groups) {
+            REQUIRE(group.firstInstance == firstInstance);
+            firstInstance += group.instanceCount;
+        }
+        REQUIRE(firstInstance == packets.size());
+    }
+
+    REQUIRE(objects[1].instance.transform == packets[1].transform);
+    REQUIRE(objects[1].center == glm::vec4(packets[1].bounds.center, 0.0f));
+
+    builder.build({});
+    REQUIRE(builder.getObjects().empty());
+    REQUIRE(builder.getGBufferGroups().empty());
+    REQUIRE(builder.getShadowGroups().empty());
+}
\ No newline at end of file
@@ -0,0 +1,28 @@
+#include "Render/Vulkan/VulkanParallelRecording.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+using namespace moe;
+
+TEST_CASE("Chunk ranges cover every item once and in order", "[render][parallel_recording]") {
+    REQUIRE(VkParallel::chunkCount(0, 64, 8) == 0);
+    REQUIRE(VkParallel::chunkCount(10, 64, 8) == 1);
+    REQUIRE(VkParallel::chunkCount(200, 64, 8) == 3);
+    REQUIRE(VkParallel::chunkCount(100000, 64, 8) == 8);
+    REQUIRE(VkParallel::chunkCount(100000, 64, 1) == 1);
+
+    for (size_t count: {1ull, 7ull, 64ull, 1000ull, 1001ull}) {
+        for (uint32_t chunks = 1; chunks <= 9; ++chunks) {
+            size_t next = 0;
+            for (uint32_t chunk = 0; chunk < chunks; ++chunk) {
+                auto range = VkParallel::chunkRange(count, chunks, chunk);
+                REQUIRE(range.begin == next);
+                REQUIRE(range.end >= range.begin);
+                // near equal, no chunk holds more than one item over another
+                REQUIRE(range.end - range.begin <= count / chunks + 1);
+                next = range.end;
+            }
+            REQUIRE(next == count);
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,96 @@
+#include "Render/Vulkan/VulkanPipelineCache.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstring>
+
+using namespace moe;
+
+namespace {
+    VulkanPipelineCacheIdentity makeIdentity() {
+        VulkanPipelineCacheIdentity identity;
+        identity.vendorID = 0x10de;
+        identity.deviceID = 0x2684;
+        identity.driverVersion = 0x8a3c4000;
+        for (uint32_t i = 0; i < VK_UUID_SIZE; ++i) {
+            identity.pipelineCacheUUID[i] = static_cast<uint8_t>(i * 7 + 1);
+        }
+        return identity;
+    }
+
+    // what a driver would hand back from vkGetPipelineCacheData: its header, then opaque data
+    Vector<uint8_t> makeDriverBlob(const VulkanPipelineCacheIdentity& identity, size_t payloadSize) {
+        VkPipelineCacheHeaderVersionOne header{};
+        header.headerSize = sizeof(header);
+        header.headerVersion = VK_PIPELINE_CACHE_HEADER_VERSION_ONE;
+        header.vendorID = identity.vendorID;
+        header.deviceID = identity.deviceID;
+        std::memcpy(header.pipelineCacheUUID, identity.pipelineCacheUUID.data(), VK_UUID_SIZE);
+
+        Vector<uint8_t> blob(sizeof(header) + payloadSize);
+        std::memcpy(blob.data(), &header, sizeof(header));
+        for (size_t i = 0; i < payloadSize; ++i) {
+            blob[sizeof(header) + i] = static_cast<uint8_t>(i * 31);
+        }
+        return blob;
+    }
+}// namespace
+
+TEST_CASE("Pipeline cache files round trip for the device that wrote them", "[render][pipelinecache]") {
+    auto identity = makeIdentity();
+    auto blob = makeDriverBlob(identity, 4096);
+
+    auto file = VkPipelineCacheFile::serialize(identity, blob);
+    auto loaded = VkPipelineCacheFile::validate(file, identity);
+
+    REQUIRE(loaded.has_value());
+    REQUIRE(loaded->size() == blob.size());
+    REQUIRE(std::memcmp(loaded->data(), blob.data(), blob.size()) == 0);
+}
+
+TEST_CASE("Pipeline cache files from another device or driver are rejected", "[render][pipelinecache]") {
+    auto identity = makeIdentity();
+    auto file = VkPipelineCacheFile::serialize(identity, makeDriverBlob(identity, 256));
+
+    // the driver version is only in our header, the driver's own header has no room for it
+    auto newDriver = identity;
+    newDriver.driverVersion += 1;
+    REQUIRE_FALSE(VkPipelineCacheFile::validate(file, newDriver).has_value());
+
+    auto otherDevice = identity;
+    otherDevice.deviceID += 1;
+    REQUIRE_FALSE(VkPipelineCacheFile::validate(file, otherDevice).has_value());
+
+    auto otherUUID = identity;
+    otherUUID.pipelineCacheUUID[5] ^= 0xff;
+    REQUIRE_FALSE(VkPipelineCacheFile::validate(file, otherUUID).has_value());
+
+    // our header matches, but the blob inside was written by someone else
+    auto foreign = identity;
+    foreign.vendorID = 0x1002;
+    auto mismatched = VkPipelineCacheFile::serialize(identity, makeDriverBlob(foreign, 256));
+    REQUIRE_FALSE(VkPipelineCacheFile::validate(mismatched, identity).has_value());
+}
+
+TEST_CASE("Truncated or corrupt pipeline cache files are rejected", "[render][pipelinecache]") {
+    auto identity = makeIdentity();
+    auto file = VkPipelineCacheFile::serialize(identity, makeDriverBlob(identity, 1024));
+
+    REQUIRE_FALSE(VkPipelineCacheFile::validate({}, identity).has_value());
+
+    auto truncated = file;
+    truncated.resize(truncated.size() - 1);
+    REQUIRE_FALSE(VkPipelineCacheFile::validate(truncated, identity).has_value());
+
+    auto flipped = file;
+    flipped[flipped.size() - 10] ^= 0x01;
+    REQUIRE_FALSE(VkPipelineCacheFile::validate(flipped, identity).has_value());
+
+    auto badMagic = file;
+    badMagic[0] ^= 0xff;
+    REQUIRE_FALSE(VkPipelineCacheFile::validate(badMagic, identity).has_value());
+
+    // a blob too small to hold the driver's header
+    auto tiny = VkPipelineCacheFile::serialize(identity, Vector<uint8_t>(8, 0));
+    REQUIRE_FALSE(VkPipelineCacheFile::validate(tiny, identity).has_value());
+}
\ No newline at end of file
@@ -0,0 +1,99 @@
+#include "Render/Vulkan/VulkanRangeAllocator.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+using namespace moe;
+
+TEST_CASE("Range allocator takes the first free range that fits", "[render][arena]") {
+    VulkanRangeAllocator allocator(100);
+
+    auto a = allocator.allocate(10);
+    auto b = allocator.allocate(20);
+    auto c = allocator.allocate(30);
+    REQUIRE(a == 0u);
+    REQUIRE(b == 10u);
+    REQUIRE(c == 30u);
+    REQUIRE(allocator.getUsed() == 60);
+    REQUIRE(allocator.getAllocationCount() == 3);
+
+    REQUIRE_FALSE(allocator.allocate(41).has_value());
+
+    // the hole b left fits a smaller range before the tail does
+    allocator.free(*b);
+    REQUIRE(allocator.getFreeRangeCount() == 2);
+    REQUIRE(allocator.allocate(15) == 10u);
+    REQUIRE(allocator.allocate(5) == 25u);
+    REQUIRE(allocator.getFreeRangeCount() == 1);
+}
+
+TEST_CASE("Range allocator merges freed neighbours", "[render][arena]") {
+    VulkanRangeAllocator allocator(30);
+
+    auto a = allocator.allocate(10);
+    auto b = allocator.allocate(10);
+    auto c = allocator.allocate(10);
+    REQUIRE(allocator.getFreeRangeCount() == 0);
+
+    allocator.free(*a);
+    allocator.free(*c);
+    REQUIRE(allocator.getFreeRangeCount() == 2);
+
+    // b joins both holes into one
+    allocator.free(*b);
+    REQUIRE(allocator.getFreeRangeCount() == 1);
+    REQUIRE(allocator.getLargestFreeRange() == 30);
+    REQUIRE(allocator.getUsed() == 0);
+    REQUIRE(allocator.allocate(30) == 0u);
+}
+
+TEST_CASE("Range allocator grows without moving live ranges", "[render][arena]") {
+    VulkanRangeAllocator allocator(16);
+
+    auto a = allocator.allocate(8);
+    auto b = allocator.allocate(4);
+    REQUIRE_FALSE(allocator.allocate(8).has_value());
+
+    // the free tail and the new space become one range
+    allocator.grow(32);
+    REQUIRE(allocator.getCapacity() == 32);
+    REQUIRE(allocator.getFreeRangeCount() == 1);
+    REQUIRE(allocator.allocate(20) == 12u);
+
+    allocator.free(*a);
+    allocator.free(*b);
+    REQUIRE(allocator.getUsed() == 20);
+}
+
+TEST_CASE("Compaction packs live ranges and reports every move", "[render][arena]") {
+    VulkanRangeAllocator allocator(64);
+
+    Vector<uint32_t> offsets;
+    for (int i = 0; i < 8; ++i) {
+        offsets.push_back(*allocator.allocate(8));
+    }
+    // free every other range, leaving four holes
+    for (int i = 1; i < 8; i += 2) {
+        allocator.free(offsets[i]);
+    }
+    REQUIRE(allocator.getFreeRangeCount() == 4);
+
+    auto moves = allocator.compact();
+
+    // the first range was already in place
+    REQUIRE(moves.size() == 3);
+    REQUIRE(VulkanRangeAllocator::remap(moves, offsets[0]) == 0);
+    REQUIRE(VulkanRangeAllocator::remap(moves, offsets[2]) == 8);
+    REQUIRE(VulkanRangeAllocator::remap(moves, offsets[4]) == 16);
+    REQUIRE(VulkanRangeAllocator::remap(moves, offsets[6]) == 24);
+    for (size_t i = 1; i < moves.size(); ++i) {
+        REQUIRE(moves[i - 1].srcOffset < moves[i].srcOffset);
+    }
+
+    REQUIRE(allocator.getFreeRangeCount() == 1);
+    REQUIRE(allocator.getLargestFreeRange() == 32);
+    REQUIRE(allocator.getUsed() == 32);
+
+    // compacted ranges are freed at their new offsets
+    allocator.free(VulkanRangeAllocator::remap(moves, offsets[6]));
+    REQUIRE(allocator.allocate(40) == 24u);
+}
\ No newline at end of file
@@ -0,0 +1,228 @@
+#include "Render/Vulkan/VulkanRenderGraph.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+using namespace moe;
+
+namespace {
+    // handles are never dereferenced, only compared
+    template<typename Handle>
+    Handle fakeHandle(uintptr_t value) {
+        return (Handle) value;
+    }
+
+    const VkImage SHADOW_MAP = fakeHandle<VkImage>(0x10);
+    const VkImage G_ALBEDO = fakeHandle<VkImage>(0x20);
+    const VkImage DRAW_IMAGE = fakeHandle<VkImage>(0x30);
+    const VkImage SWAPCHAIN = fakeHandle<VkImage>(0x40);
+    const VkBuffer SKINNED_VERTICES = fakeHandle<VkBuffer>(0x50);
+
+    struct GraphFixture {
+        VulkanRenderGraph graph;
+        uint32_t allocations{0};
+        uint32_t releases{0};
+
+        GraphFixture() {
+            graph.init(
+                    [this](const VulkanTransientImageDesc& desc) {
+                        ++allocations;
+                        return VulkanAllocatedImage{
+                                .image = fakeHandle<VkImage>(0x1000 + allocations),
+                                .imageExtent = desc.extent,
+                                .imageFormat = desc.format,
+                        };
+                    },
+                    [this](const VulkanAllocatedImage&) { ++releases; });
+        }
+
+        ~GraphFixture() { graph.destroy(); }
+
+        // the engine's frame cut down: skinning, shadows, g-buffer, lighting, present
+        void buildFrame(bool sunlight) {
+            graph.beginFrame();
+            auto skinned = graph.importBuffer("skinned_vertices", SKINNED_VERTICES);
+            auto shadowMap = graph.importImage("shadow_map", SHADOW_MAP, VK_IMAGE_ASPECT_DEPTH_BIT);
+            auto albedo = graph.importImage("g_albedo", G_ALBEDO);
+            auto draw = graph.importImage("draw", DRAW_IMAGE);
+            auto swapchain = graph.importAcquiredImage("swapchain", SWAPCHAIN, VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT);
+
+            graph.addPass("skinning", nullptr).write(skinned, VulkanRGAccess::StorageWriteCompute);
+            graph.addPass("shadows", nullptr)
+                    .read(skinned, VulkanRGAccess::StorageReadVertex)
+                    .write(shadowMap, VulkanRGAccess::DepthAttachment);
+            graph.addPass("gbuffer", nullptr)
+                    .read(skinned, VulkanRGAccess::StorageReadVertex)
+                    .write(albedo, VulkanRGAccess::ColorAttachment);
+            auto lighting = graph.addPass("lighting", nullptr);
+            lighting.read(albedo, VulkanRGAccess::SampledFragment).write(draw, VulkanRGAccess::ColorAttachment);
+            if (sunlight) {
+                lighting.read(shadowMap, VulkanRGAccess::SampledFragment);
+            }
+            graph.addPass("blit", nullptr)
+                    .read(draw, VulkanRGAccess::TransferSrc)
+                    .write(swapchain, VulkanRGAccess::TransferDst);
+            graph.addPass("present", nullptr).read(swapchain, VulkanRGAccess::Present).sideEffect();
+            graph.compile();
+        }
+
+        const VulkanRenderGraph::CompiledPass& compiledPass(StringView name) const {
+            for (auto& compiled: graph.getCompiledPasses()) {
+                if (graph.getPassName(compiled.pass) == name) {
+                    return compiled;
+                }
+            }
+            FAIL("pass was culled");
+            return graph.getCompiledPasses()[0];
+        }
+
+        const VkImageMemoryBarrier2* imageBarrier(StringView pass, VkImage image) const {
+            auto& compiled = compiledPass(pass);
+            for (uint32_t i = 0; i < compiled.imageBarrierCount; ++i) {
+                auto& barrier = graph.getImageBarriers()[compiled.firstImageBarrier + i];
+                if (barrier.image == image) {
+                    return &barrier;
+                }
+            }
+            return nullptr;
+        }
+    };
+}// namespace
+
+TEST_CASE("Render graph culls passes whose writes nothing uses", "[render][graph]") {
+    GraphFixture fixture;
+
+    fixture.buildFrame(false);
+    auto& stats = fixture.graph.getStats();
+    REQUIRE(stats.culledPasses == 1);
+    REQUIRE(fixture.graph.isCulled(1));
+    REQUIRE(fixture.graph.getCompiledPasses().size() == 5);
+
+    // the sun samples the shadow map, which keeps the shadow pass
+    fixture.buildFrame(true);
+    REQUIRE(fixture.graph.getStats().culledPasses == 0);
+    REQUIRE_FALSE(fixture.graph.isCulled(1));
+    REQUIRE(fixture.imageBarrier("shadows", SHADOW_MAP) != nullptr);
+}
+
+TEST_CASE("Render graph barriers each hazard once with precise stages and layouts", "[render][graph]") {
+    GraphFixture fixture;
+    fixture.buildFrame(true);
+
+    // the g-buffer discards, then hands the target to the fragment shader of lighting
+    auto* discard = fixture.imageBarrier("gbuffer", G_ALBEDO);
+    REQUIRE(discard != nullptr);
+    REQUIRE(discard->oldLayout == VK_IMAGE_LAYOUT_UNDEFINED);
+    REQUIRE(discard->newLayout == VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+
+    auto* sample = fixture.imageBarrier("lighting", G_ALBEDO);
+    REQUIRE(sample != nullptr);
+    REQUIRE(sample->srcStageMask == VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT);
+    REQUIRE(sample->srcAccessMask == VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT);
+    REQUIRE(sample->dstStageMask == VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT);
+    REQUIRE(sample->oldLayout == VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+    REQUIRE(sample->newLayout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+
+    // the shadow pass waits on skinning, the g-buffer reads in the same stage and needs nothing more
+    auto& shadows = fixture.compiledPass("shadows");
+    REQUIRE(shadows.bufferBarrierCount == 1);
+    auto& skinnedRead = fixture.graph.getBufferBarriers()[shadows.firstBufferBarrier];
+    REQUIRE(skinnedRead.srcStageMask == VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT);
+    REQUIRE(skinnedRead.dstStageMask == VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT);
+    REQUIRE(fixture.compiledPass("gbuffer").bufferBarrierCount == 0);
+
+    // lighting's reads and its write go out as one batch
+    auto& lighting = fixture.compiledPass("lighting");
+    REQUIRE(lighting.imageBarrierCount == 3);
+
+    // the acquired image waits on the semaphore's stage only, then moves to present
+    auto* acquire = fixture.imageBarrier("blit", SWAPCHAIN);
+    REQUIRE(acquire != nullptr);
+    REQUIRE(acquire->srcStageMask == VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT);
+    REQUIRE(acquire->oldLayout == VK_IMAGE_LAYOUT_UNDEFINED);
+    auto* present = fixture.imageBarrier("present", SWAPCHAIN);
+    REQUIRE(present != nullptr);
+    REQUIRE(present->srcStageMask == VK_PIPELINE_STAGE_2_ALL_TRANSFER_BIT);
+    REQUIRE(present->newLayout == VK_IMAGE_LAYOUT_PRESENT_SRC_KHR);
+
+    auto& stats = fixture.graph.getStats();
+    REQUIRE(stats.passes == 6);
+    // skinning is the first use of its buffer
+    REQUIRE(stats.barrierBatches == 5);
+}
+
+TEST_CASE("Render graph waits on the last frame's uses", "[render][graph]") {
+    GraphFixture fixture;
+    fixture.buildFrame(true);
+    REQUIRE(fixture.compiledPass("skinning").bufferBarrierCount == 0);
+
+    fixture.buildFrame(true);
+
+    // skinning overwrites what last frame's vertex shaders read
+    auto& skinning = fixture.compiledPass("skinning");
+    REQUIRE(skinning.bufferBarrierCount == 1);
+    auto& war = fixture.graph.getBufferBarriers()[skinning.firstBufferBarrier];
+    REQUIRE(war.srcStageMask == VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT);
+    REQUIRE(war.srcAccessMask == VK_ACCESS_2_NONE);
+
+    // the g-buffer discards what lighting sampled last frame, after lighting is done with it
+    auto* discard = fixture.imageBarrier("gbuffer", G_ALBEDO);
+    REQUIRE(discard != nullptr);
+    REQUIRE(discard->srcStageMask == VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT);
+    REQUIRE(discard->oldLayout == VK_IMAGE_LAYOUT_UNDEFINED);
+}
+
+TEST_CASE("Render graph aliases transient images and skips null handles", "[render][graph]") {
+    GraphFixture fixture;
+    constexpr VkExtent3D extent{1920, 1080, 1};
+    constexpr VkImageUsageFlags usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+
+    auto buildFrame = [&](bool withBloom) {
+        auto& graph = fixture.graph;
+        graph.beginFrame();
+        auto draw = graph.importImage("draw", DRAW_IMAGE);
+        auto unallocated = graph.importBuffer("unallocated", VK_NULL_HANDLE);
+        auto a = graph.createImage("a", VK_FORMAT_R16G16B16A16_SFLOAT, extent, usage);
+        auto b = graph.createImage("b", VK_FORMAT_R16G16B16A16_SFLOAT, extent, usage);
+        auto c = graph.createImage("c", VK_FORMAT_R16G16B16A16_SFLOAT, extent, usage);
+
+        graph.addPass("write_a", nullptr).write(a, VulkanRGAccess::ColorAttachment).write(unallocated, VulkanRGAccess::StorageWriteCompute);
+        graph.addPass("a_to_b", nullptr).read(a, VulkanRGAccess::SampledFragment).write(b, VulkanRGAccess::ColorAttachment);
+        if (withBloom) {
+            graph.addPass("b_to_c", nullptr).read(b, VulkanRGAccess::SampledFragment).write(c, VulkanRGAccess::ColorAttachment);
+            graph.addPass("c_to_draw", nullptr).read(c, VulkanRGAccess::SampledFragment).write(draw, VulkanRGAccess::ColorAttachment).sideEffect();
+        } else {
+            graph.addPass("b_to_draw", nullptr).read(b, VulkanRGAccess::SampledFragment).write(draw, VulkanRGAccess::ColorAttachment).sideEffect();
+        }
+        graph.compile();
+        return Array<VulkanRGResourceId, 3>{a, b, c};
+    };
+
+    auto ids = buildFrame(true);
+    REQUIRE(fixture.graph.getStats().transientImages == 3);
+    REQUIRE(fixture.graph.getStats().physicalImages == 2);
+    REQUIRE(fixture.allocations == 2);
+    // c is written once a was last read
+    REQUIRE(fixture.graph.getImage(ids[2]).image == fixture.graph.getImage(ids[0]).image);
+    REQUIRE(fixture.graph.getImage(ids[1]).image != fixture.graph.getImage(ids[0]).image);
+    REQUIRE(fixture.compiledPass("write_a").bufferBarrierCount == 0);
+
+    // c takes a's image, so its first write waits for a's last read
+    auto* alias = fixture.imageBarrier("b_to_c", fixture.graph.getImage(ids[2]).image);
+    REQUIRE(alias != nullptr);
+    REQUIRE(alias->srcStageMask == VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT);
+    REQUIRE(alias->oldLayout == VK_IMAGE_LAYOUT_UNDEFINED);
+
+    // steady frames reuse the pool
+    buildFrame(true);
+    REQUIRE(fixture.allocations == 2);
+    REQUIRE(fixture.releases == 0);
+
+    // a frame wanting fewer images hands the rest back
+    buildFrame(false);
+    REQUIRE(fixture.graph.getStats().physicalImages == 2);
+    REQUIRE(fixture.releases == 0);
+
+    fixture.graph.beginFrame();
+    fixture.graph.compile();
+    REQUIRE(fixture.releases == 2);
+}
\ No newline at end of file
@@ -0,0 +1,123 @@
+#include "Render/Vulkan/VulkanSortKey.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <random>
+
+using namespace moe;
+
+namespace {
+    struct Draw {
+        uint32_t material;
+        uint32_t mesh;
+    };
+
+    // what the passes count, a change of mesh is an index buffer bind
+    size_t countMeshChanges(const Vector<Draw>& draws, const Vector<uint32_t>& order) {
+        size_t changes = 0;
+        for (size_t i = 0; i < order.size(); ++i) {
+            if (i == 0 || draws[order[i]].mesh != draws[order[i - 1]].mesh) {
+                ++changes;
+            }
+        }
+        return changes;
+    }
+}// namespace
+
+TEST_CASE("Sort key fields round trip and order from pass down to depth", "[render][sort]") {
+    auto key = VkSortKey::make(VkSortKey::Pass::ShadowDepth, VkSortKey::Pipeline::Skinned, 1234, 5678, 42);
+    REQUIRE(VkSortKey::getPass(key) == VkSortKey::Pass::ShadowDepth);
+    REQUIRE(VkSortKey::getPipeline(key) == VkSortKey::Pipeline::Skinned);
+    REQUIRE(VkSortKey::getMaterial(key) == 1234);
+    REQUIRE(VkSortKey::getMesh(key) == 5678);
+    REQUIRE(VkSortKey::getDepth(key) == 42);
+
+    auto base = VkSortKey::make(VkSortKey::Pass::Opaque, VkSortKey::Pipeline::Static, 1, 1, 1);
+    REQUIRE(base < VkSortKey::make(VkSortKey::Pass::Opaque, VkSortKey::Pipeline::Static, 1, 1, 2));
+    REQUIRE(VkSortKey::make(VkSortKey::Pass::Opaque, VkSortKey::Pipeline::Static, 1, 1, 0xFFFF)
+            < VkSortKey::make(VkSortKey::Pass::Opaque, VkSortKey::Pipeline::Static, 1, 2, 0));
+    REQUIRE(VkSortKey::make(VkSortKey::Pass::Opaque, VkSortKey::Pipeline::Static, 1, 0xFFFFF, 0)
+            < VkSortKey::make(VkSortKey::Pass::Opaque, VkSortKey::Pipeline::Static, 2, 0, 0));
+    REQUIRE(VkSortKey::make(VkSortKey::Pass::Opaque, VkSortKey::Pipeline::Static, 0xFFFFF, 0, 0)
+            < VkSortKey::make(VkSortKey::Pass::Opaque, VkSortKey::Pipeline::Skinned, 0, 0, 0));
+    REQUIRE(VkSortKey::make(VkSortKey::Pass::Opaque, VkSortKey::Pipeline::Skinned, 0xFFFFF, 0xFFFFF, 0xFFFF)
+            < VkSortKey::make(VkSortKey::Pass::ShadowDepth, VkSortKey::Pipeline::Static, 0, 0, 0));
+}
+
+TEST_CASE("Pass policies keep the fields their pass needs", "[render][sort]") {
+    auto gatherKey = VkSortKey::make(VkSortKey::Pass::Opaque, VkSortKey::Pipeline::Skinned, 7, 9, 0);
+
+    auto opaque = VkSortKey::opaque(gatherKey, 100);
+    REQUIRE(VkSortKey::getPass(opaque) == VkSortKey::Pass::Opaque);
+    REQUIRE(VkSortKey::getPipeline(opaque) == VkSortKey::Pipeline::Skinned);
+    REQUIRE(VkSortKey::getMaterial(opaque) == 7);
+    REQUIRE(VkSortKey::getMesh(opaque) == 9);
+    REQUIRE(VkSortKey::getDepth(opaque) == 100);
+
+    auto shadow = VkSortKey::shadowDepth(gatherKey, 200);
+    REQUIRE(VkSortKey::getPass(shadow) == VkSortKey::Pass::ShadowDepth);
+    REQUIRE(VkSortKey::getPipeline(shadow) == VkSortKey::Pipeline::Skinned);
+    REQUIRE(VkSortKey::getMaterial(shadow) == 0);
+    REQUIRE(VkSortKey::getMesh(shadow) == 9);
+    REQUIRE(VkSortKey::getDepth(shadow) == 200);
+}
+
+TEST_CASE("Depth quantizes front to back and clamps", "[render][sort]") {
+    auto view = glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    auto viewProjection = glm::perspective(glm::radians(60.0f), 1.0f, 0.1f, 100.0f) * view;
+
+    auto nearDepth = VkSortKey::quantizeDepth(viewProjection, {0.0f, 0.0f, -1.0f});
+    auto farDepth = VkSortKey::quantizeDepth(viewProjection, {0.0f, 0.0f, -50.0f});
+    REQUIRE(nearDepth < farDepth);
+
+    REQUIRE(VkSortKey::quantizeDepth(viewProjection, {0.0f, 0.0f, 10.0f}) == 0);
+    REQUIRE(VkSortKey::quantizeDepth(viewProjection, {0.0f, 0.0f, -1000.0f}) == 0xFFFF);
+}
+
+TEST_CASE("Radix sort matches a stable sort and groups meshes", "[render][sort]") {
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<uint32_t> material(0, 15);
+    std::uniform_int_distribution<uint32_t> mesh(0, 63);
+    std::uniform_int_distribution<uint32_t> depth(0, 0xFFFF);
+
+    constexpr size_t COUNT = 5000;
+
+    Vector<Draw> draws;
+    Vector<uint64_t> keys;
+    Vector<uint32_t> indices;
+    for (uint32_t i = 0; i < COUNT; ++i) {
+        Draw draw{material(rng), mesh(rng)};
+        draws.push_back(draw);
+        auto gatherKey = VkSortKey::make(VkSortKey::Pass::Opaque, VkSortKey::Pipeline::Static, draw.material, draw.mesh, 0);
+        keys.push_back(VkSortKey::shadowDepth(gatherKey, depth(rng)));
+        indices.push_back(i);
+    }
+
+    Vector<uint32_t> expected = indices;
+    std::stable_sort(expected.begin(), expected.end(), [&](uint32_t a, uint32_t b) { return keys[a] < keys[b]; });
+
+    auto meshChangesBefore = countMeshChanges(draws, indices);
+
+    VulkanDrawSorter sorter;
+    sorter.sort(keys, indices);
+
+    REQUIRE(indices == expected);
+    REQUIRE(std::is_sorted(keys.begin(), keys.end()));
+
+    // one bind per distinct mesh once sorted, against one per draw in gather order
+    auto meshChangesAfter = countMeshChanges(draws, indices);
+    REQUIRE(meshChangesAfter <= 64);
+    REQUIRE(meshChangesAfter < meshChangesBefore / 10);
+}
+
+TEST_CASE("Radix sort keeps equal keys in order", "[render][sort]") {
+    Vector<uint64_t> keys{5, 1, 5, 1, 5};
+    Vector<uint32_t> indices{0, 1, 2, 3, 4};
+
+    VulkanDrawSorter sorter;
+    sorter.sort(keys, indices);
+
+    REQUIRE(keys == Vector<uint64_t>{1, 1, 5, 5, 5});
+    REQUIRE(indices == Vector<uint32_t>{1, 3, 0, 2, 4});
+}
\ No newline at end of file
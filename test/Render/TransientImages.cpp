@@ -0,0 +1,98 @@
+#include "Render/Vulkan/VulkanTransientImages.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <random>
+
+using namespace moe;
+
+namespace {
+    constexpr VkExtent3D EXTENT{1920, 1080, 1};
+    constexpr VkImageUsageFlags USAGE = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+
+    VulkanTransientImageDesc image(uint32_t firstUse, uint32_t lastUse, VkFormat format = VK_FORMAT_R16G16B16A16_SFLOAT) {
+        return {format, EXTENT, USAGE, firstUse, lastUse};
+    }
+
+    bool overlaps(const VulkanTransientImageDesc& a, const VulkanTransientImageDesc& b) {
+        return a.firstUse <= b.lastUse && b.firstUse <= a.lastUse;
+    }
+}// namespace
+
+TEST_CASE("Transient images with disjoint lifetimes share physical images", "[render][transient]") {
+    // the engine's post fx graph in execution order:
+    // #input, #input_2d, fxaa, ui_bloom_v, ui_bloom_h, blend_two, gamma_correction
+    Vector<VulkanTransientImageDesc> descs = {
+            image(0, 2),
+            image(0, 5),
+            image(2, 5),
+            image(3, 4),
+            image(4, 5),
+            image(5, 6),
+            image(6, std::numeric_limits<uint32_t>::max(), VK_FORMAT_B8G8R8A8_UNORM),
+    };
+
+    auto assignment = VkTransient::assign(descs);
+
+    REQUIRE(assignment.physicalIndices.size() == descs.size());
+    // four 16 bit float images at most are live at once, the 8 bit output never shares
+    REQUIRE(assignment.physicalDescs.size() == 5);
+    // ui_bloom_v takes the image #input left once fxaa read it
+    REQUIRE(assignment.physicalIndices[3] == assignment.physicalIndices[0]);
+    REQUIRE(assignment.physicalIndices[5] == assignment.physicalIndices[3]);
+}
+
+TEST_CASE("Transient images never share while live or when they differ", "[render][transient]") {
+    // written at the step the other is last read at
+    Vector<VulkanTransientImageDesc> touching = {image(0, 2), image(2, 3)};
+    auto touchingAssignment = VkTransient::assign(touching);
+    REQUIRE(touchingAssignment.physicalDescs.size() == 2);
+
+    Vector<VulkanTransientImageDesc> formats = {image(0, 1), image(2, 3, VK_FORMAT_R8G8B8A8_UNORM)};
+    REQUIRE(VkTransient::assign(formats).physicalDescs.size() == 2);
+
+    auto halfRes = image(2, 3);
+    halfRes.extent = {960, 540, 1};
+    Vector<VulkanTransientImageDesc> extents = {image(0, 1), halfRes};
+    REQUIRE(VkTransient::assign(extents).physicalDescs.size() == 2);
+
+    auto storage = image(2, 3);
+    storage.usage |= VK_IMAGE_USAGE_STORAGE_BIT;
+    Vector<VulkanTransientImageDesc> usages = {image(0, 1), storage};
+    REQUIRE(VkTransient::assign(usages).physicalDescs.size() == 2);
+}
+
+TEST_CASE("Transient image assignment is minimal and conflict free", "[render][transient]") {
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<uint32_t> start(0, 60);
+    std::uniform_int_distribution<uint32_t> length(0, 8);
+
+    Vector<VulkanTransientImageDesc> descs;
+    for (uint32_t i = 0; i < 200; ++i) {
+        auto first = start(rng);
+        descs.push_back(image(first, first + length(rng)));
+    }
+
+    auto assignment = VkTransient::assign(descs);
+
+    for (size_t a = 0; a < descs.size(); ++a) {
+        for (size_t b = a + 1; b < descs.size(); ++b) {
+            if (assignment.physicalIndices[a] == assignment.physicalIndices[b]) {
+                REQUIRE_FALSE(overlaps(descs[a], descs[b]));
+            }
+        }
+    }
+
+    // one compatible group, so the most images live at any step is the least that can work
+    size_t mostLive = 0;
+    for (uint32_t step = 0; step <= 68; ++step) {
+        size_t live = 0;
+        for (auto& desc: descs) {
+            live += desc.firstUse <= step && step <= desc.lastUse;
+        }
+        mostLive = std::max(mostLive, live);
+    }
+    REQUIRE(assignment.physicalDescs.size() == mostLive);
+}
\ No newline at end of file
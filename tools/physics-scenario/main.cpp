@@ -0,0 +1,292 @@
+#include "Physics/CollisionLayers.hpp"
+#include "Physics/PhysicsProfiler.hpp"
+#include "Physics/SchedulerJobSystem.hpp"
+
+#include "Core/FileWriter.hpp"
+#include "Core/Task/Scheduler.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+// headless physics scenarios for regression tracking
+// steps a scripted world as fast as it can, with the engine's job system and step profiler,
+// and writes the per tick stats and their summary as json
+
+namespace {
+    constexpr float DELTA_TIME = 1.0f / 60.0f;
+
+    struct Options {
+        moe::String scenario{"pile"};
+        uint32_t bodies{1000};
+        uint32_t ticks{600};
+        uint32_t warmupTicks{0};
+        uint32_t workers{4};
+        uint32_t tempAllocatorKb{32 * 1024};
+        bool profilePhases{true};
+        bool perTick{false};
+        moe::String jsonPath;
+    };
+
+    void printUsage() {
+        fmt::print(
+                "usage: moe-physics-scenario [options]\n"
+                "\n"
+                "options:\n"
+                "  --scenario <name>      pile (falling mixed shapes) or stack (box towers) (default pile)\n"
+                "  --bodies <n>           dynamic bodies in the scenario (default 1000)\n"
+                "  --ticks <n>            measured ticks (default 600)\n"
+                "  --warmup <n>           ticks stepped before measuring (default 0)\n"
+                "  --workers <n>          scheduler worker threads, fixed for comparable results (default 4)\n"
+                "  --temp-kb <n>          temp allocator size (default 32768)\n"
+                "  --no-phases            skip per phase job timing\n"
+                "  --per-tick             include every tick in the json, not only the summary\n"
+                "  --json <path>          write the json to a file instead of stdout\n");
+    }
+
+    struct ScenarioWorld {
+    public:
+        moe::Physics::CollisionLayerConfig config{moe::Physics::CollisionLayerConfig::createDefault()};
+        moe::Physics::Details::BPLayerInterfaceImpl broadPhaseLayerInterface{config};
+        moe::Physics::Details::ObjectVsBroadPhaseLayerFilterImpl objectVsBroadPhaseLayerFilter{config};
+        moe::Physics::Details::ObjectLayerFilterImpl objectLayerFilter{config};
+        JPH::PhysicsSystem system;
+
+        explicit ScenarioWorld(uint32_t bodyCount) {
+            system.Init(bodyCount + 1, 0, 65536, 32768,
+                        broadPhaseLayerInterface,
+                        objectVsBroadPhaseLayerFilter,
+                        objectLayerFilter);
+
+            system.GetBodyInterface().CreateAndAddBody(
+                    JPH::BodyCreationSettings(
+                            new JPH::BoxShape(JPH::Vec3(200.0f, 0.5f, 200.0f)),
+                            JPH::RVec3(0.0f, -0.5f, 0.0f),
+                            JPH::Quat::sIdentity(),
+                            JPH::EMotionType::Static,
+                            moe::Physics::Details::Layers::STATIC),
+                    JPH::EActivation::DontActivate);
+        }
+
+        void addDynamic(const JPH::Shape* shape, JPH::RVec3Arg position) {
+            system.GetBodyInterface().CreateAndAddBody(
+                    JPH::BodyCreationSettings(
+                            shape,
+                            position,
+                            JPH::Quat::sIdentity(),
+                            JPH::EMotionType::Dynamic,
+                            moe::Physics::Details::Layers::DYNAMIC),
+                    JPH::EActivation::Activate);
+        }
+    };
+
+    // a loose grid of boxes and spheres dropped onto the floor, collides, settles and falls asleep
+    void buildPile(ScenarioWorld& world, uint32_t bodyCount) {
+        JPH::RefConst<JPH::Shape> sphere = new JPH::SphereShape(0.5f);
+        JPH::RefConst<JPH::Shape> box = new JPH::BoxShape(JPH::Vec3::sReplicate(0.5f));
+
+        constexpr uint32_t ROW = 20;
+        for (uint32_t i = 0; i < bodyCount; ++i) {
+            float x = static_cast<float>(i % ROW) * 1.2f - ROW * 0.6f;
+            float z = static_cast<float>((i / ROW) % ROW) * 1.2f - ROW * 0.6f;
+            float y = 2.0f + static_cast<float>(i / (ROW * ROW)) * 1.5f;
+            world.addDynamic(i % 2 == 0 ? sphere.GetPtr() : box.GetPtr(), JPH::RVec3(x, y, z));
+        }
+    }
+
+    // towers of resting boxes, long lived contacts that keep the solver busy
+    void buildStack(ScenarioWorld& world, uint32_t bodyCount) {
+        JPH::RefConst<JPH::Shape> box = new JPH::BoxShape(JPH::Vec3::sReplicate(0.5f));
+
+        constexpr uint32_t HEIGHT = 10;
+        uint32_t towers = (bodyCount + HEIGHT - 1) / HEIGHT;
+        uint32_t row = std::max<uint32_t>(1, static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<float>(towers)))));
+        for (uint32_t i = 0; i < bodyCount; ++i) {
+            uint32_t tower = i / HEIGHT;
+            float x = static_cast<float>(tower % row) * 3.0f;
+            float z = static_cast<float>(tower / row) * 3.0f;
+            float y = 0.5f + static_cast<float>(i % HEIGHT) * 1.0f;
+            world.addDynamic(box.GetPtr(), JPH::RVec3(x, y, z));
+        }
+    }
+
+    struct Summary {
+        float mean{0.0f};
+        float p50{0.0f};
+        float p99{0.0f};
+        float max{0.0f};
+    };
+
+    template<typename F>
+    Summary summarize(const moe::Vector<moe::Physics::TickStats>& ticks, F&& value) {
+        moe::Vector<float> values;
+        values.reserve(ticks.size());
+        for (auto& tick: ticks) {
+            values.push_back(static_cast<float>(value(tick)));
+        }
+        if (values.empty()) {
+            return {};
+        }
+
+        std::sort(values.begin(), values.end());
+        Summary summary;
+        for (float v: values) {
+            summary.mean += v;
+        }
+        summary.mean /= static_cast<float>(values.size());
+        summary.p50 = values[values.size() / 2];
+        summary.p99 = values[std::min(values.size() - 1, values.size() * 99 / 100)];
+        summary.max = values.back();
+        return summary;
+    }
+
+    moe::String toJson(const Options& options, const moe::Vector<moe::Physics::TickStats>& ticks) {
+        moe::String json;
+        json += "{\n";
+        json += "  \"version\": 1,\n";
+        json += fmt::format("  \"scenario\": \"{}\",\n", options.scenario);
+        json += fmt::format("  \"bodies\": {},\n", options.bodies);
+        json += fmt::format("  \"ticks\": {},\n", options.ticks);
+        json += fmt::format("  \"warmup_ticks\": {},\n", options.warmupTicks);
+        json += fmt::format("  \"workers\": {},\n", options.workers);
+        json += fmt::format("  \"profile_phases\": {},\n", options.profilePhases);
+
+        auto metric = [&](const char* name, auto&& value, bool last = false) {
+            auto summary = summarize(ticks, value);
+            json += fmt::format(
+                    "    \"{}\": {{\"mean\": {:.4f}, \"p50\": {:.4f}, \"p99\": {:.4f}, \"max\": {:.4f}}}{}\n",
+                    name, summary.mean, summary.p50, summary.p99, summary.max, last ? "" : ",");
+        };
+
+        auto overruns = std::count_if(ticks.begin(), ticks.end(), [](auto& tick) { return tick.overrun; });
+
+        json += "  \"summary\": {\n";
+        json += fmt::format("    \"tick_overruns\": {},\n", overruns);
+        metric("step_ms", [](auto& t) { return t.stepMs; });
+        metric("broad_phase_ms", [](auto& t) { return t.broadPhaseMs; });
+        metric("narrow_phase_ms", [](auto& t) { return t.narrowPhaseMs; });
+        metric("solver_ms", [](auto& t) { return t.solverMs; });
+        metric("integrate_ms", [](auto& t) { return t.integrateMs; });
+        metric("other_jobs_ms", [](auto& t) { return t.otherJobsMs; });
+        metric("active_bodies", [](auto& t) { return t.numActiveBodies; });
+        metric("contacts", [](auto& t) { return t.numContacts; });
+        metric("temp_allocator_peak_bytes", [](auto& t) { return t.tempAllocatorPeakBytes; }, true);
+        json += "  }";
+
+        if (options.perTick) {
+            json += ",\n  \"per_tick\": [";
+            for (size_t i = 0; i < ticks.size(); ++i) {
+                auto& t = ticks[i];
+                json += i == 0 ? "\n" : ",\n";
+                json += fmt::format(
+                        "    {{\"tick\": {}, \"step_ms\": {:.4f}, \"broad_phase_ms\": {:.4f}, \"narrow_phase_ms\": {:.4f}, "
+                        "\"solver_ms\": {:.4f}, \"integrate_ms\": {:.4f}, \"other_jobs_ms\": {:.4f}, "
+                        "\"active_bodies\": {}, \"contacts\": {}, \"temp_allocator_peak_bytes\": {}, \"overrun\": {}}}",
+                        t.tick, t.stepMs, t.broadPhaseMs, t.narrowPhaseMs,
+                        t.solverMs, t.integrateMs, t.otherJobsMs,
+                        t.numActiveBodies, t.numContacts, t.tempAllocatorPeakBytes, t.overrun);
+            }
+            json += "\n  ]";
+        }
+
+        json += "\n}\n";
+        return json;
+    }
+}// namespace
+
+int main(int argc, char** argv) {
+    Options options;
+
+    for (int i = 1; i < argc; ++i) {
+        moe::StringView arg = argv[i];
+        auto next = [&]() -> moe::StringView {
+            if (i + 1 >= argc) {
+                fmt::print(stderr, "missing value for {}\n", arg);
+                std::exit(2);
+            }
+            return argv[++i];
+        };
+        auto nextUint = [&]() {
+            return static_cast<uint32_t>(std::strtoul(next().data(), nullptr, 10));
+        };
+
+        if (arg == "--scenario") {
+            options.scenario = moe::String(next());
+        } else if (arg == "--bodies") {
+            options.bodies = std::max<uint32_t>(1, nextUint());
+        } else if (arg == "--ticks") {
+            options.ticks = std::max<uint32_t>(1, nextUint());
+        } else if (arg == "--warmup") {
+            options.warmupTicks = nextUint();
+        } else if (arg == "--workers") {
+            options.workers = std::max<uint32_t>(1, nextUint());
+        } else if (arg == "--temp-kb") {
+            options.tempAllocatorKb = std::max<uint32_t>(64, nextUint());
+        } else if (arg == "--no-phases") {
+            options.profilePhases = false;
+        } else if (arg == "--per-tick") {
+            options.perTick = true;
+        } else if (arg == "--json") {
+            options.jsonPath = moe::String(next());
+        } else {
+            printUsage();
+            return arg == "--help" || arg == "-h" ? 0 : 2;
+        }
+    }
+
+    if (options.scenario != "pile" && options.scenario != "stack") {
+        fmt::print(stderr, "unknown scenario '{}'\n", options.scenario);
+        printUsage();
+        return 2;
+    }
+
+    JPH::RegisterDefaultAllocator();
+    JPH::Factory::sInstance = new JPH::Factory();
+    JPH::RegisterTypes();
+    moe::ThreadPoolScheduler::init(options.workers);
+
+    moe::Vector<moe::Physics::TickStats> ticks;
+    {
+        ScenarioWorld world(options.bodies);
+        if (options.scenario == "pile") {
+            buildPile(world, options.bodies);
+        } else {
+            buildStack(world, options.bodies);
+        }
+        world.system.OptimizeBroadPhase();
+
+        moe::Physics::SchedulerJobSystem jobSystem(moe::ThreadPoolScheduler::getInstance(), JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers);
+        moe::Physics::StepProfiler profiler(jobSystem, options.tempAllocatorKb * 1024, options.profilePhases);
+        world.system.SetContactListener(&profiler.getContactListener());
+
+        ticks.reserve(options.ticks);
+        for (uint32_t tick = 0; tick < options.warmupTicks + options.ticks; ++tick) {
+            moe::Physics::TickStats stats;
+            stats.tick = tick;
+            auto errors = profiler.step(world.system, DELTA_TIME, stats);
+            if (errors != JPH::EPhysicsUpdateError::None) {
+                fmt::print(stderr, "tick {}: physics capacity exceeded\n", tick);
+            }
+
+            stats.overrun = stats.stepMs > DELTA_TIME * 1000.0f;
+            if (tick >= options.warmupTicks) {
+                ticks.push_back(stats);
+            }
+        }
+
+        world.system.SetContactListener(nullptr);
+    }
+
+    moe::ThreadPoolScheduler::shutdown();
+    JPH::UnregisterTypes();
+    delete JPH::Factory::sInstance;
+    JPH::Factory::sInstance = nullptr;
+
+    auto json = toJson(options, ticks);
+    if (options.jsonPath.empty()) {
+        fmt::print("{}", json);
+        return 0;
+    }
+
+    return moe::FileWriter::writeToFile(options.jsonPath, moe::StringView(json)) ? 0 : 2;
+}
\ No newline at end of file